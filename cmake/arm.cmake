@@ -1,5 +1,4 @@
 option(PPLNN_USE_ARMV8_2 "Build arm server kernel with armv8.2-a support." ON)
-option(PPLNN_USE_NUMA "build with libnuma" OFF)
 option(PPLNN_USE_ANDROID_NDK "build with android ndk" OFF)
 
 set(PPLNN_USE_ARM ON)
@@ -37,11 +36,6 @@ if (PPLNN_USE_ARMV8_2_FP16)
     list(APPEND PPLNN_COMPILE_DEFINITIONS PPLNN_USE_ARMV8_2_FP16)
 endif()
 
-if (PPLNN_USE_NUMA)
-    list(APPEND PPLNN_LINK_LIBRARIES numa)
-    list(APPEND PPLNN_COMPILE_DEFINITIONS PPLNN_USE_NUMA)
-endif()
-
 if(PPLNN_ENABLE_SANITIZE_OPTIONS)
     if(CMAKE_CXX_COMPILER_ID MATCHES "GNU" OR CMAKE_CXX_COMPILER_ID MATCHES "Clang")
         set(__ASAN_FLAGS__ "-fsanitize=undefined -fsanitize=address -fsanitize=leak -fno-omit-frame-pointer")
@@ -28,6 +28,11 @@ public:
     virtual ~DeviceContext() {}
     virtual const char* GetType() const = 0;
     virtual ppl::common::RetCode Configure(uint32_t, ...) = 0;
+
+    /** @brief alignment in bytes of buffers of this device. buffers from callers must be aligned to be used directly. */
+    virtual uint64_t GetAlignment() const {
+        return 1;
+    }
 };
 
 }} // namespace ppl::nn
@@ -0,0 +1,51 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_COMMON_STARTUP_PROFILING_STATISTICS_H_
+#define _ST_HPC_PPL_NN_COMMON_STARTUP_PROFILING_STATISTICS_H_
+
+#include "ppl/nn/common/common.h"
+#include <vector>
+#include <string>
+#include <stdint.h>
+
+namespace ppl { namespace nn {
+
+struct PPLNN_PUBLIC StartupStageInfo final {
+    std::string name;
+    /** stages with larger `depth` are sub-stages of the nearest previous stage with smaller `depth` */
+    uint32_t depth;
+    uint64_t exec_microseconds;
+    /** resident memory of this process when the stage finishes. 0 if not available. */
+    uint64_t memory_bytes;
+    /** `memory_bytes` minus resident memory when the stage begins. negative if memory is released. */
+    int64_t memory_delta_bytes;
+    /**
+       peak resident memory of the whole process so far when the stage finishes, which may be reached by previous
+       stages. 0 if not available.
+    */
+    uint64_t process_peak_memory_bytes;
+};
+
+struct PPLNN_PUBLIC StartupProfilingStatistics final {
+    /** in the order of when stages begin */
+    std::vector<StartupStageInfo> stage_info;
+};
+
+}} // namespace ppl::nn
+
+#endif
@@ -21,11 +21,39 @@
 #include "ppl/nn/common/common.h"
 #include "ppl/nn/engines/x86/options.h"
 #include <stdint.h>
+#include <vector>
 
 namespace ppl { namespace nn { namespace x86 {
 
 struct PPLNN_PUBLIC EngineOptions final {
     uint32_t mm_policy = MM_COMPACT;
+
+    /**
+       @brief number of threads used by kernels of runtimes created by this engine.
+       0 means the current OpenMP setting of the calling thread is kept.
+    */
+    uint32_t thread_num = 0;
+
+    /**
+       @brief cores that kernel threads are bound to. the i-th thread is bound to `core_list[i]`.
+       empty means no binding is performed. if `thread_num` is 0, `core_list.size()` threads are used.
+    */
+    std::vector<int32_t> core_list;
+
+    /**
+       @brief bind engine to specified numa node, range [0, numa_max_node]. other value will not bind.
+       converted weights and runtime buffers are placed on this node, and if `core_list` is empty, it is set to
+       cpus of this node. to serve one model from several nodes, create one engine per node so that each node
+       has its own copy of weights.
+    */
+    int32_t numa_node_id = -1;
+
+    /**
+       @brief storage type of converted weights of Gemm layers running as fully connected layers.
+       weights are converted back to fp32 inside kernels, activations and accumulations stay in fp32.
+       it helps memory bound cases such as small batches with large weights, at the cost of precision.
+    */
+    uint32_t weight_compression = WEIGHT_COMPRESSION_NONE;
 };
 
 }}} // namespace ppl::nn::x86
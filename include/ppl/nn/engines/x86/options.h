@@ -55,6 +55,18 @@ enum {
     MM_MRU = 1,
 };
 
+/** @brief storage types of converted weights of fully connected layers */
+enum {
+    /** fp32 weights */
+    WEIGHT_COMPRESSION_NONE = 0,
+
+    /** fp16 weights, half of the memory and bandwidth. needs f16c */
+    WEIGHT_COMPRESSION_FP16 = 1,
+
+    /** int8 weights with one fp32 scale for each output channel, a quarter of the memory and bandwidth */
+    WEIGHT_COMPRESSION_INT8 = 2,
+};
+
 /** @brief options for x86::DeviceContext::Configure() */
 enum {
     /** @brief memory defragmentation. make sure that device is not used when performing defragmentations. */
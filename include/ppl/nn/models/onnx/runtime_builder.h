@@ -21,6 +21,7 @@
 #include "ppl/nn/common/common.h"
 #include "ppl/nn/engines/engine.h"
 #include "ppl/nn/runtime/runtime.h"
+#include "ppl/nn/common/startup_profiling_statistics.h"
 
 namespace ppl { namespace nn { namespace onnx {
 
@@ -56,6 +57,12 @@ public:
                                    uint32_t end_op_num) = 0;
 
     virtual ppl::common::RetCode Serialize(const char* output_file, const char* fmt) const = 0;
+
+    /**
+       @brief get time and memory usage of each stage.
+       @note available if `ORB_CONF_SET_STARTUP_PROFILING_FLAG` is set.
+    */
+    virtual ppl::common::RetCode GetStartupProfilingStatistics(StartupProfilingStatistics*) const = 0;
 };
 
 }}} // namespace ppl::nn::onnx
@@ -32,6 +32,39 @@ enum {
     */
     ORB_CONF_RESERVE_TENSOR = 0,
 
+    /**
+       @brief args: true/false. records time and memory usage of each stage in `Init()`, `Preprocess()` and
+       `CreateRuntime()`. results can be retrieved by `RuntimeBuilder::GetStartupProfilingStatistics()`.
+
+       @note call it before `Init()` to profile model parsing.
+    */
+    ORB_CONF_SET_STARTUP_PROFILING_FLAG,
+
+    /**
+       @brief args: true/false. reorders nodes in `Preprocess()` to reduce the peak memory usage of activations
+       estimated from tensor shapes. the original order is kept if it is not improved.
+
+       @note call it before `Preprocess()`.
+    */
+    ORB_CONF_ENABLE_MEMORY_AWARE_SORT,
+
+    /**
+       @brief args: true/false. takes dims of inputs in the model as fixed(symbolic dims are taken as 1), so that
+       `Shape` ops and shape computations depending on them are folded into constants in `Preprocess()`.
+
+       @note inputs MUST NOT be reshaped to other dims when running if this option is enabled.
+       @note call it before `Preprocess()`.
+    */
+    ORB_CONF_ENABLE_FIXED_INPUT_DIMS,
+
+    /**
+       @brief args: true/false. fuses Conv/Gemm/MatMul nodes that read the same input with different constant
+       weights into one wider node followed by a Split in `Preprocess()`, e.g. QKV projections in transformers.
+
+       @note call it before `Preprocess()`.
+    */
+    ORB_CONF_ENABLE_SIBLING_FUSION,
+
     ORB_CONF_MAX,
 };
 
@@ -32,6 +32,14 @@ enum {
     */
     PRB_CONF_RESERVE_TENSOR = 0,
 
+    /**
+       @brief args: true/false. reorders nodes in `Preprocess()` to reduce the peak memory usage of activations
+       estimated from tensor shapes. the original order is kept if it is not improved.
+
+       @note call it before `Preprocess()`.
+    */
+    PRB_CONF_ENABLE_MEMORY_AWARE_SORT,
+
     PRB_CONF_MAX,
 };
 
@@ -0,0 +1,73 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_RUNTIME_DYNAMIC_BATCHER_H_
+#define _ST_HPC_PPL_NN_RUNTIME_DYNAMIC_BATCHER_H_
+
+#include "ppl/common/retcode.h"
+#include "ppl/nn/common/common.h"
+#include <stdint.h>
+
+namespace ppl { namespace nn {
+
+struct PPLNN_PUBLIC DynamicBatcherOptions final {
+    /** max number of requests that are run in one inference */
+    uint32_t max_batch_size = 8;
+
+    /**
+       max time in microseconds that the first request of a batch waits for other requests.
+       larger values give larger batches and higher throughput at the cost of latency.
+    */
+    uint32_t max_delay_us = 2000;
+};
+
+struct PPLNN_PUBLIC DynamicBatcherStatistics final {
+    uint64_t request_count = 0;
+    uint64_t batch_count = 0;
+
+    /** time between a request being submitted and its batch being started */
+    uint64_t total_queue_time_us = 0;
+    uint64_t max_queue_time_us = 0;
+
+    /** time spent in running batches, including gathering inputs and scattering outputs */
+    uint64_t total_run_time_us = 0;
+};
+
+/**
+   @class DynamicBatcher
+   @brief collects concurrent single-sample requests into batches and runs them with one `Runtime`.
+*/
+class PPLNN_PUBLIC DynamicBatcher {
+public:
+    virtual ~DynamicBatcher() {}
+
+    /**
+       @brief runs one sample and blocks until its results are ready. can be called by multiple threads concurrently.
+       @param inputs data of one sample for each input of the runtime, in ndarray format with the data type of the
+       corresponding input tensor.
+       @param outputs buffers receiving results of one sample for each output of the runtime, in ndarray format with
+       the data type of the corresponding output tensor.
+    */
+    virtual ppl::common::RetCode Run(const void* const* inputs, void* const* outputs) = 0;
+
+    /** @brief gets statistics since this batcher is created. */
+    virtual ppl::common::RetCode GetStatistics(DynamicBatcherStatistics*) const = 0;
+};
+
+}} // namespace ppl::nn
+
+#endif
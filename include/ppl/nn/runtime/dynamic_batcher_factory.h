@@ -0,0 +1,38 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_RUNTIME_DYNAMIC_BATCHER_FACTORY_H_
+#define _ST_HPC_PPL_NN_RUNTIME_DYNAMIC_BATCHER_FACTORY_H_
+
+#include "ppl/nn/runtime/dynamic_batcher.h"
+#include "ppl/nn/runtime/runtime.h"
+
+namespace ppl { namespace nn {
+
+class PPLNN_PUBLIC DynamicBatcherFactory final {
+public:
+    /**
+       @brief creates a batcher that runs requests with `runtime`.
+       @note dims of inputs except the first(batch) dimension MUST be set before calling this function.
+       `runtime` is not owned by the batcher and MUST NOT be used by others until the batcher is destroyed.
+    */
+    static DynamicBatcher* Create(Runtime* runtime, const DynamicBatcherOptions&);
+};
+
+}} // namespace ppl::nn
+
+#endif
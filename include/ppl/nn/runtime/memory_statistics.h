@@ -0,0 +1,73 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_RUNTIME_MEMORY_STATISTICS_H_
+#define _ST_HPC_PPL_NN_RUNTIME_MEMORY_STATISTICS_H_
+
+#include "ppl/nn/common/common.h"
+#include <vector>
+#include <string>
+#include <stdint.h>
+
+namespace ppl { namespace nn {
+
+struct PPLNN_PUBLIC TensorMemoryInfo final {
+    std::string name;
+    uint64_t bytes;
+};
+
+struct PPLNN_PUBLIC MemoryStatistics final {
+    /** bytes of constant tensors */
+    uint64_t constant_bytes = 0;
+
+    /**
+       bytes of weights converted by kernels, such as reordered filters of convolutions. weights converted when
+       building the model are shared by all `Runtime` instances created by the same `RuntimeBuilder`.
+    */
+    uint64_t converted_weight_bytes = 0;
+
+    /** max size of temporary buffers used by kernels */
+    uint64_t tmp_buffer_bytes = 0;
+
+    /** bytes reserved from the system by memory managers of devices for activations and temporary buffers */
+    uint64_t allocated_bytes = 0;
+
+    /** max bytes of memory managers in use at the same time */
+    uint64_t peak_used_bytes = 0;
+
+    /** memory reserved but never used at the same time, i.e. `allocated_bytes - peak_used_bytes` */
+    uint64_t fragmented_bytes = 0;
+
+    /**
+       max bytes of activations alive at the same time, including inputs and outputs allocated by the `Runtime`.
+       available if `RUNTIME_CONF_SET_MEMORY_PROFILING_FLAG` is enabled.
+    */
+    uint64_t peak_activation_bytes = 0;
+
+    /** name of the kernel during whose execution `peak_activation_bytes` is reached */
+    std::string peak_kernel_name;
+
+    /** activations alive when `peak_activation_bytes` is reached. views of the same buffer are listed separately. */
+    std::vector<TensorMemoryInfo> peak_tensors;
+
+    /** bytes of activations written into the spill file since `RUNTIME_CONF_SET_MEMORY_BUDGET` is set */
+    uint64_t spilled_bytes = 0;
+};
+
+}} // namespace ppl::nn
+
+#endif
@@ -23,6 +23,7 @@
 #include "ppl/nn/common/device_context.h"
 #include "ppl/nn/runtime/tensor.h"
 #include "ppl/nn/runtime/profiling_statistics.h"
+#include "ppl/nn/runtime/memory_statistics.h"
 
 namespace ppl { namespace nn {
 
@@ -34,6 +35,20 @@ enum {
     */
     RUNTIME_CONF_SET_KERNEL_PROFILING_FLAG = 0,
 
+    /**
+       @brief args: true/false. records activations alive after each kernel to find the peak footprint.
+       @note this option may cause performance loss
+    */
+    RUNTIME_CONF_SET_MEMORY_PROFILING_FLAG = 1,
+
+    /**
+       @brief args: uint64_t budget in bytes, 0 disables it. reorders nodes to lower the peak of live activations
+       estimated from shapes known when building the model, and moves activations that are not needed soon into a
+       temporary file during `Run()` whenever live activations exceed the budget.
+       @note this option may cause performance loss. MUST NOT be set while `Run()` is in progress.
+    */
+    RUNTIME_CONF_SET_MEMORY_BUDGET = 2,
+
     RUNTIME_CONF_MAX,
 };
 
@@ -76,6 +91,30 @@ public:
     */
     virtual Tensor* GetOutputTensor(uint32_t idx) const = 0;
 
+    /**
+       @brief binds a caller-owned host buffer `buf` as the storage of input `idx`. data in `buf` described by `desc`
+       are used by the next `Run()`s, and dims of input `idx` are set to dims of `desc` before running.
+       `buf` is used by kernels directly if the input is on a host device, `buf` is aligned to the alignment of the
+       device(64 bytes for x86) and the input has the same data type and format as `desc`, otherwise data are
+       converted from `buf` at the beginning of `Run()`.
+       @param buf nullptr unbinds the buffer.
+       @note `buf` MUST be valid until it is unbound or this runtime is destroyed.
+    */
+    virtual ppl::common::RetCode BindInputBuffer(uint32_t idx, void* buf, const TensorShape& desc) = 0;
+
+    /**
+       @brief binds a caller-owned host buffer `buf` as the storage of output `idx`. results are available in `buf`
+       with data type and format of `desc` after `Run()` returns, without calling `CopyToHost()` or `ConvertToHost()`.
+       kernels write into `buf` directly if the output is on a host device, `buf` is aligned to the alignment of the
+       device and the output has the same data type and format as `desc`, otherwise results are converted into
+       `buf` at the end of `Run()`. real dims of the output can be
+       retrieved by `GetOutputTensor(idx)->GetShape()`.
+       @param buf nullptr unbinds the buffer.
+       @param desc describes `buf`. its size is the capacity of `buf`. `Run()` fails if results need more space.
+       @note `buf` MUST be valid until it is unbound or this runtime is destroyed.
+    */
+    virtual ppl::common::RetCode BindOutputBuffer(uint32_t idx, void* buf, const TensorShape& desc) = 0;
+
     /**
        @note the specified tensor(except for input/output/constant tensors) MUST be reserved first (usually by calling
        RuntimeBuilder::Configure). returns nullptr otherwise.
@@ -96,6 +135,12 @@ public:
        @note alailable if `PPLNN_ENABLE_KERNEL_PROFILING` is enabled.
     */
     virtual ppl::common::RetCode GetProfilingStatistics(ProfilingStatistics*) const = 0;
+
+    /**
+       @brief get memory usage of this runtime, grouped by category.
+       @note peak activation info is available after `Run()` if `RUNTIME_CONF_SET_MEMORY_PROFILING_FLAG` is enabled.
+    */
+    virtual ppl::common::RetCode GetMemoryStatistics(MemoryStatistics*) const = 0;
 };
 
 }} // namespace ppl::nn
@@ -68,7 +68,12 @@ public:
     */
     virtual void SetBufferPtr(void* buf) = 0;
 
-    /** @brief get the underlying buffer ptr */
+    /**
+       @brief get the underlying buffer ptr
+       @note some kernels cache data derived from their inputs(converted weights, for example). use
+       `CopyFromHost()`/`ConvertFromHost()` or `SetBufferPtr()` instead of writing via this pointer directly if the
+       content is changed between runs.
+    */
     virtual void* GetBufferPtr() const = 0;
 };
 
@@ -26,8 +26,12 @@ void RegisterDeviceContext(pybind11::module* m) {
              [](const PyDeviceContext& ctx) -> bool {
                  return (ctx.ptr);
              })
-        .def("GetType", [](const PyDeviceContext& ctx) -> const char* {
-            return ctx.ptr->GetType();
+        .def("GetType",
+             [](const PyDeviceContext& ctx) -> const char* {
+                 return ctx.ptr->GetType();
+             })
+        .def("GetAlignment", [](const PyDeviceContext& ctx) -> uint64_t {
+            return ctx.ptr->GetAlignment();
         });
 }
 
@@ -40,6 +40,10 @@ static const char* g_datatype2format[] = {
     "s", // DATATYPE_COMPLEX128 -> 16 bytes
 };
 
+const char* GetPyBufferFormat(ppl::common::datatype_t data_type) {
+    return g_datatype2format[data_type];
+}
+
 void RegisterNdArray(pybind11::module* m) {
     pybind11::class_<PyNdArray>(*m, "NdArray", pybind11::buffer_protocol())
         .def("__bool__",
@@ -48,7 +52,7 @@ void RegisterNdArray(pybind11::module* m) {
              })
         .def_buffer([](PyNdArray& arr) -> pybind11::buffer_info {
             return pybind11::buffer_info(arr.data.data(), ppl::common::GetSizeOfDataType(arr.data_type),
-                                         g_datatype2format[arr.data_type], arr.dims.size(), arr.dims, arr.strides);
+                                         GetPyBufferFormat(arr.data_type), arr.dims.size(), arr.dims, arr.strides);
         });
 }
 
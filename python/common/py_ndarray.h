@@ -30,6 +30,9 @@ struct PyNdArray final {
     std::vector<uint64_t> strides;
 };
 
+/** @brief returns the python buffer format string of `data_type` */
+const char* GetPyBufferFormat(ppl::common::datatype_t data_type);
+
 }}} // namespace ppl::nn::python
 
 #endif
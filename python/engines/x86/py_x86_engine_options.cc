@@ -17,16 +17,24 @@
 
 #include "ppl/nn/engines/x86/engine_options.h"
 #include "pybind11/pybind11.h"
+#include "pybind11/stl.h"
 
 namespace ppl { namespace nn { namespace python {
 
 void RegisterX86EngineOptions(pybind11::module* m) {
     pybind11::class_<x86::EngineOptions>(*m, "EngineOptions")
         .def(pybind11::init<>())
-        .def_readwrite("mm_policy", &x86::EngineOptions::mm_policy);
+        .def_readwrite("mm_policy", &x86::EngineOptions::mm_policy)
+        .def_readwrite("thread_num", &x86::EngineOptions::thread_num)
+        .def_readwrite("core_list", &x86::EngineOptions::core_list)
+        .def_readwrite("numa_node_id", &x86::EngineOptions::numa_node_id)
+        .def_readwrite("weight_compression", &x86::EngineOptions::weight_compression);
 
     m->attr("MM_COMPACT") = (uint32_t)x86::MM_COMPACT;
     m->attr("MM_MRU") = (uint32_t)x86::MM_MRU;
+    m->attr("WEIGHT_COMPRESSION_NONE") = (uint32_t)x86::WEIGHT_COMPRESSION_NONE;
+    m->attr("WEIGHT_COMPRESSION_FP16") = (uint32_t)x86::WEIGHT_COMPRESSION_FP16;
+    m->attr("WEIGHT_COMPRESSION_INT8") = (uint32_t)x86::WEIGHT_COMPRESSION_INT8;
 }
 
 }}} // namespace ppl::nn::python
@@ -42,19 +42,27 @@ void RegisterPmxRuntimeBuilder(pybind11::module* m) {
 
                  builder.engines = std::move(engine_list);
                  return builder.ptr->Init(model_file, engine_ptrs.data(), engine_ptrs.size());
-             })
+             },
+             pybind11::call_guard<pybind11::gil_scoped_release>())
         .def("Preprocess",
              [](PyPmxRuntimeBuilder& builder) -> RetCode {
                  return builder.ptr->Preprocess();
-             })
+             },
+             pybind11::call_guard<pybind11::gil_scoped_release>())
         .def("CreateRuntime",
              [](PyPmxRuntimeBuilder& builder) -> PyRuntime {
-                 return PyRuntime(builder.engines, builder.ptr->CreateRuntime());
+                 Runtime* runtime;
+                 {
+                     pybind11::gil_scoped_release no_gil;
+                     runtime = builder.ptr->CreateRuntime();
+                 }
+                 return PyRuntime(builder.engines, runtime);
              })
         .def("Serialize",
              [](const PyPmxRuntimeBuilder& builder, const char* output_file, const char* fmt) -> RetCode {
                  return builder.ptr->Serialize(output_file, fmt);
-             });
+             },
+             pybind11::call_guard<pybind11::gil_scoped_release>());
 }
 
 }}} // namespace ppl::nn::python
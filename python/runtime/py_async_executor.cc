@@ -0,0 +1,85 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "py_async_executor.h"
+using namespace std;
+
+namespace ppl { namespace nn { namespace python {
+
+void PyAsyncExecutor::Start(uint32_t thread_num) {
+    lock_guard<mutex> guard(lock_);
+    if (!workers_.empty()) {
+        return;
+    }
+
+    if (thread_num == 0) {
+        thread_num = thread::hardware_concurrency();
+        if (thread_num == 0) {
+            thread_num = 1;
+        }
+    }
+
+    stopped_ = false;
+    workers_.reserve(thread_num);
+    for (uint32_t i = 0; i < thread_num; ++i) {
+        workers_.emplace_back(&PyAsyncExecutor::Worker, this);
+    }
+}
+
+void PyAsyncExecutor::Stop() {
+    {
+        lock_guard<mutex> guard(lock_);
+        if (workers_.empty()) {
+            return;
+        }
+        stopped_ = true;
+    }
+    cond_.notify_all();
+
+    for (auto x = workers_.begin(); x != workers_.end(); ++x) {
+        x->join();
+    }
+    workers_.clear();
+}
+
+void PyAsyncExecutor::Submit(function<void()>&& task) {
+    {
+        lock_guard<mutex> guard(lock_);
+        tasks_.emplace_back(std::move(task));
+    }
+    cond_.notify_one();
+}
+
+void PyAsyncExecutor::Worker() {
+    while (true) {
+        function<void()> task;
+        {
+            unique_lock<mutex> guard(lock_);
+            cond_.wait(guard, [this]() -> bool {
+                return (stopped_ || !tasks_.empty());
+            });
+            if (tasks_.empty()) {
+                return; // stopped and all pending tasks are finished
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+        task();
+    }
+}
+
+}}} // namespace ppl::nn::python
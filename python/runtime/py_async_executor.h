@@ -0,0 +1,76 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_PYTHON_PY_ASYNC_EXECUTOR_H_
+#define _ST_HPC_PPL_NN_PYTHON_PY_ASYNC_EXECUTOR_H_
+
+#include <functional>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ppl { namespace nn { namespace python {
+
+/**
+   @class PyAsyncExecutor
+   @brief native threads used to run tasks without holding the GIL.
+*/
+class PyAsyncExecutor final {
+public:
+    static PyAsyncExecutor* Instance() {
+        static PyAsyncExecutor executor;
+        return &executor;
+    }
+
+    ~PyAsyncExecutor() {
+        Stop();
+    }
+
+    /** @brief starts `thread_num` threads if not started yet. 0 means using the number of hardware threads. */
+    void Start(uint32_t thread_num = 0);
+
+    /** @brief finishes pending tasks and joins all threads. MUST be called without holding the GIL. */
+    void Stop();
+
+    /** @note `task` is executed without holding the GIL. */
+    void Submit(std::function<void()>&& task);
+
+    uint32_t GetThreadNum() const {
+        return workers_.size();
+    }
+
+private:
+    void Worker();
+
+private:
+    bool stopped_ = false;
+    std::mutex lock_;
+    std::condition_variable cond_;
+    std::deque<std::function<void()>> tasks_;
+    std::vector<std::thread> workers_;
+
+private:
+    PyAsyncExecutor() {}
+    PyAsyncExecutor(const PyAsyncExecutor&) = delete;
+    PyAsyncExecutor& operator=(const PyAsyncExecutor&) = delete;
+};
+
+}}} // namespace ppl::nn::python
+
+#endif
@@ -17,13 +17,53 @@
 
 #include "py_runtime.h"
 #include "py_tensor.h"
+#include "py_async_executor.h"
 #include "../common/py_device_context.h"
+#include "ppl/nn/common/logger.h"
 #include "pybind11/pybind11.h"
 using namespace ppl::common;
 
 namespace ppl { namespace nn { namespace python {
 
+/** python objects used by an async task. they MUST be released with the GIL held. */
+struct PyAsyncRunContext final {
+    pybind11::object runtime;
+    pybind11::object future;
+};
+
+static pybind11::object RunAsync(pybind11::object self) {
+    auto runtime = self.cast<PyRuntime*>();
+    auto future = pybind11::module::import("concurrent.futures").attr("Future")();
+    future.attr("set_running_or_notify_cancel")();
+
+    auto ctx = new PyAsyncRunContext();
+    ctx->runtime = self; // keeps runtime alive until the task finishes
+    ctx->future = future;
+
+    auto executor = PyAsyncExecutor::Instance();
+    executor->Start();
+    executor->Submit([runtime, ctx]() -> void {
+        auto status = runtime->ptr->Run();
+
+        pybind11::gil_scoped_acquire gil;
+        try {
+            ctx->future.attr("set_result")(status);
+        } catch (const pybind11::error_already_set& e) {
+            LOG(ERROR) << "set result of async Run() failed: " << e.what();
+        }
+        delete ctx;
+    });
+
+    return future;
+}
+
 void RegisterRuntime(pybind11::module* m) {
+    // native threads must finish before the interpreter is finalized
+    pybind11::module::import("atexit").attr("register")(pybind11::cpp_function([]() -> void {
+        pybind11::gil_scoped_release no_gil;
+        PyAsyncExecutor::Instance()->Stop();
+    }));
+
     pybind11::class_<PyRuntime>(*m, "Runtime")
         .def("__bool__",
              [](const PyRuntime& runtime) -> bool {
@@ -33,22 +73,30 @@ void RegisterRuntime(pybind11::module* m) {
              [](const PyRuntime& runtime) -> uint32_t {
                  return runtime.ptr->GetInputCount();
              })
-        .def("GetInputTensor",
-             [](const PyRuntime& runtime, uint32_t idx) -> PyTensor {
-                 return PyTensor(runtime.ptr->GetInputTensor(idx));
-             })
+        // returned tensors keep the runtime alive because they may share buffers with host objects
+        .def(
+            "GetInputTensor",
+            [](PyRuntime& runtime, uint32_t idx) -> PyTensor {
+                return PyTensor(runtime.ptr->GetInputTensor(idx), &runtime.input_host_refs[idx]);
+            },
+            pybind11::keep_alive<0, 1>())
         .def("Run",
              [](const PyRuntime& runtime) -> RetCode {
                  return runtime.ptr->Run();
-             })
+             },
+             pybind11::call_guard<pybind11::gil_scoped_release>())
+        // returns a `concurrent.futures.Future` which can be awaited via `asyncio.wrap_future()`
+        .def("RunAsync", &RunAsync)
         .def("GetOutputCount",
              [](const PyRuntime& runtime) -> uint32_t {
                  return runtime.ptr->GetOutputCount();
              })
-        .def("GetOutputTensor",
-             [](const PyRuntime& runtime, uint32_t idx) -> PyTensor {
-                 return PyTensor(runtime.ptr->GetOutputTensor(idx));
-             })
+        .def(
+            "GetOutputTensor",
+            [](const PyRuntime& runtime, uint32_t idx) -> PyTensor {
+                return PyTensor(runtime.ptr->GetOutputTensor(idx));
+            },
+            pybind11::keep_alive<0, 1>())
         .def("GetDeviceContextCount",
              [](const PyRuntime& runtime) -> uint32_t {
                  return runtime.ptr->GetDeviceContextCount();
@@ -20,18 +20,21 @@
 
 #include "ppl/nn/engines/engine.h"
 #include "ppl/nn/runtime/runtime.h"
+#include "pybind11/pybind11.h"
 #include <vector>
 #include <memory>
 
 namespace ppl { namespace nn { namespace python {
 
 struct PyRuntime final {
-    PyRuntime(const std::vector<std::shared_ptr<Engine>>& e, Runtime* r) : engines(e), ptr(r) {}
+    PyRuntime(const std::vector<std::shared_ptr<Engine>>& e, Runtime* r)
+        : engines(e), ptr(r), input_host_refs(r ? r->GetInputCount() : 0) {}
     PyRuntime(PyRuntime&&) = default;
     PyRuntime& operator=(PyRuntime&&) = default;
 
     std::vector<std::shared_ptr<Engine>> engines; // retain engines
     std::unique_ptr<Runtime> ptr;
+    std::vector<pybind11::object> input_host_refs; // retain host objects shared with input tensors
 };
 
 }}} // namespace ppl::nn::python
@@ -18,6 +18,7 @@
 #include "py_tensor.h"
 #include "../common/py_device_context.h"
 #include "ppl/nn/common/logger.h"
+#include <cstring>
 #include <map>
 using namespace std;
 using namespace ppl::common;
@@ -39,7 +40,38 @@ static const map<string, datatype_t> g_format2datatype = {
     {"?", DATATYPE_BOOL}, //  -> unsigned char
 };
 
+static bool IsHostDevice(const DeviceContext* ctx) {
+    if (!ctx) {
+        return false;
+    }
+
+    auto type = ctx->GetType();
+    return (strcmp(type, "x86") == 0 || strcmp(type, "arm") == 0 || strcmp(type, "riscv") == 0 ||
+            strcmp(type, "cpu") == 0);
+}
+
+static bool IsContiguous(const pybind11::buffer_info& info) {
+    pybind11::ssize_t expected_stride = info.itemsize;
+    for (pybind11::ssize_t i = info.ndim - 1; i >= 0; --i) {
+        if (info.shape[i] > 1 && info.strides[i] != expected_stride) {
+            return false;
+        }
+        expected_stride *= info.shape[i];
+    }
+    return true;
+}
+
+void PyTensor::ReleaseHostRef() {
+    if (host_ref_ && host_ref_->ptr()) {
+        // detaches the shared buffer so that it will not be overwritten
+        tensor_->SetBufferPtr(nullptr);
+        *host_ref_ = pybind11::object();
+    }
+}
+
 RetCode PyTensor::ConvertFromHost(const pybind11::buffer& b) {
+    ReleaseHostRef();
+
     pybind11::buffer_info info = b.request();
 
     vector<int64_t> dims(info.ndim);
@@ -63,6 +95,8 @@ RetCode PyTensor::ConvertFromHost(const pybind11::buffer& b) {
     src_shape.SetDataFormat(DATAFORMAT_NDARRAY);
     src_shape.SetDataType(data_type);
 
+    pybind11::gil_scoped_release no_gil;
+
     auto status = tensor_->ReallocBuffer();
     if (status != RC_SUCCESS) {
         LOG(ERROR) << "realloc buffer of [" << shape->GetBytesIncludingPadding()
@@ -80,6 +114,69 @@ RetCode PyTensor::ConvertFromHost(const pybind11::buffer& b) {
     return RC_SUCCESS;
 }
 
+RetCode PyTensor::ShareFromHost(const pybind11::buffer& b) {
+    if (!host_ref_) {
+        LOG(ERROR) << "sharing host buffer is only supported by input tensors. tensor[" << tensor_->GetName()
+                   << "] is not an input.";
+        return RC_UNSUPPORTED;
+    }
+
+    if (!IsHostDevice(tensor_->GetDeviceContext())) {
+        LOG(ERROR) << "tensor[" << tensor_->GetName() << "] is not on host. use ConvertFromHost() instead.";
+        return RC_UNSUPPORTED;
+    }
+
+    pybind11::buffer_info info = b.request();
+
+    auto ref = g_format2datatype.find(info.format);
+    if (ref == g_format2datatype.end()) {
+        LOG(ERROR) << "unsupported data format[\"" << info.format << "\"]";
+        return RC_UNSUPPORTED;
+    }
+
+    auto shape = tensor_->GetShape();
+    if (shape->GetDataFormat() != DATAFORMAT_NDARRAY) {
+        LOG(ERROR) << "data format of tensor[" << tensor_->GetName() << "] is ["
+                   << GetDataFormatStr(shape->GetDataFormat()) << "], which cannot share buffer with host.";
+        return RC_UNSUPPORTED;
+    }
+    if (ref->second != shape->GetDataType()) {
+        LOG(ERROR) << "data type of host buffer [" << GetDataTypeStr(ref->second) << "] != data type of tensor["
+                   << tensor_->GetName() << "] [" << GetDataTypeStr(shape->GetDataType()) << "]";
+        return RC_INVALID_VALUE;
+    }
+    // buffers shared with tensors must satisfy the alignment requirement of kernels
+    auto alignment = tensor_->GetDeviceContext()->GetAlignment();
+    if ((uintptr_t)info.ptr % alignment != 0) {
+        LOG(ERROR) << "host buffer of tensor[" << tensor_->GetName() << "] is not aligned to [" << alignment
+                   << "] bytes.";
+        return RC_INVALID_VALUE;
+    }
+    if (!IsContiguous(info)) {
+        LOG(ERROR) << "host buffer of tensor[" << tensor_->GetName() << "] is not contiguous.";
+        return RC_INVALID_VALUE;
+    }
+
+    // checks the new shape before applying it, so that the tensor is left unchanged on failure
+    TensorShape new_shape = *shape;
+    vector<int64_t> dims(info.ndim);
+    for (pybind11::ssize_t i = 0; i < info.ndim; ++i) {
+        dims[i] = info.shape[i];
+    }
+    new_shape.Reshape(dims);
+
+    if (new_shape.GetBytesIncludingPadding() != new_shape.GetBytesExcludingPadding()) {
+        LOG(ERROR) << "tensor[" << tensor_->GetName() << "] requires paddings, which cannot share buffer with host.";
+        return RC_UNSUPPORTED;
+    }
+
+    *shape = new_shape;
+    tensor_->SetBufferPtr(info.ptr);
+    *host_ref_ = b;
+
+    return RC_SUCCESS;
+}
+
 PyNdArray PyTensor::ConvertToHost(datatype_t data_type, dataformat_t data_format) const {
     PyNdArray arr;
     if (tensor_->GetShape()->GetBytesExcludingPadding() == 0) {
@@ -119,8 +216,36 @@ PyNdArray PyTensor::ConvertToHost(datatype_t data_type, dataformat_t data_format
     return arr;
 }
 
+pybind11::buffer_info PyTensor::GetHostBufferInfo() const {
+    if (!IsHostDevice(tensor_->GetDeviceContext())) {
+        throw pybind11::buffer_error(string("tensor[") + tensor_->GetName() +
+                                     "] is not on host. use ConvertToHost() instead.");
+    }
+
+    auto shape = tensor_->GetShape();
+    if (shape->GetDataFormat() != DATAFORMAT_NDARRAY ||
+        shape->GetBytesIncludingPadding() != shape->GetBytesExcludingPadding()) {
+        throw pybind11::buffer_error(string("tensor[") + tensor_->GetName() +
+                                     "] is not a dense NDARRAY. use ConvertToHost() instead.");
+    }
+
+    auto dim_count = shape->GetRealDimCount();
+
+    vector<int64_t> dims(dim_count);
+    vector<uint64_t> strides(dim_count);
+    uint64_t stride = GetSizeOfDataType(shape->GetDataType());
+    for (int64_t i = (int64_t)dim_count - 1; i >= 0; --i) {
+        dims[i] = shape->GetDim(i);
+        strides[i] = stride;
+        stride *= dims[i];
+    }
+
+    return pybind11::buffer_info(tensor_->GetBufferPtr(), GetSizeOfDataType(shape->GetDataType()),
+                                 GetPyBufferFormat(shape->GetDataType()), dim_count, dims, strides);
+}
+
 void RegisterTensor(pybind11::module* m) {
-    pybind11::class_<PyTensor>(*m, "Tensor")
+    pybind11::class_<PyTensor>(*m, "Tensor", pybind11::buffer_protocol())
         .def("__bool__",
              [](const PyTensor& tensor) -> bool {
                  return (tensor.GetPtr());
@@ -140,10 +265,15 @@ void RegisterTensor(pybind11::module* m) {
         .def("GetName", &PyTensor::GetName, pybind11::return_value_policy::reference)
         .def("GetShape", &PyTensor::GetConstShape, pybind11::return_value_policy::reference)
         .def("ConvertFromHost", &PyTensor::ConvertFromHost)
+        // the buffer of `ndarray` is used by the input tensor directly and retained by the runtime
+        .def("ShareFromHost", &PyTensor::ShareFromHost)
         // use original data type and format if `datatype` or `dataformat` are unknown
         .def("ConvertToHost", &PyTensor::ConvertToHost, pybind11::return_value_policy::move,
              pybind11::arg("datatype") = (ppl::common::datatype_t)ppl::common::DATATYPE_UNKNOWN,
-             pybind11::arg("dataformat") = (ppl::common::dataformat_t)ppl::common::DATAFORMAT_NDARRAY);
+             pybind11::arg("dataformat") = (ppl::common::dataformat_t)ppl::common::DATAFORMAT_NDARRAY,
+             pybind11::call_guard<pybind11::gil_scoped_release>())
+        // zero-copy view of tensors on host, e.g. `numpy.array(tensor, copy=False)`
+        .def_buffer(&PyTensor::GetHostBufferInfo);
 }
 
 }}} // namespace ppl::nn::python
@@ -26,7 +26,8 @@ namespace ppl { namespace nn { namespace python {
 
 class PyTensor final {
 public:
-    PyTensor(Tensor* tensor) : tensor_(tensor) {}
+    /** `host_ref` is used to retain host objects whose buffers are shared with `tensor`. */
+    PyTensor(Tensor* tensor, pybind11::object* host_ref = nullptr) : tensor_(tensor), host_ref_(host_ref) {}
     PyTensor(PyTensor&&) = default;
     PyTensor& operator=(PyTensor&&) = default;
     Tensor* GetPtr() const {
@@ -39,11 +40,25 @@ public:
         return *tensor_->GetShape();
     }
     ppl::common::RetCode ConvertFromHost(const pybind11::buffer&);
+    /**
+       @brief uses the buffer of `b` as this tensor's data without copying.
+       @note `b` is retained until another buffer is set to this tensor.
+    */
+    ppl::common::RetCode ShareFromHost(const pybind11::buffer&);
     /** passing unknown means to use original type and format */
     PyNdArray ConvertToHost(ppl::common::datatype_t, ppl::common::dataformat_t) const;
+    /**
+       @brief exports the underlying buffer without copying.
+       @note data is valid until the next `Runtime::Run()`.
+    */
+    pybind11::buffer_info GetHostBufferInfo() const;
+
+private:
+    void ReleaseHostRef();
 
 private:
     Tensor* tensor_;
+    pybind11::object* host_ref_;
 };
 
 }}} // namespace ppl::nn::python
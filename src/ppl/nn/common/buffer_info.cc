@@ -30,28 +30,46 @@ BufferInfo::BufferInfo(BufferInfo&& info) {
     is_buffer_owner_ = info.is_buffer_owner_;
     buffer_ = info.buffer_;
     device_ = info.device_;
+    shared_ = info.shared_;
 
     info.buffer_.addr = nullptr;
     info.device_ = nullptr;
     info.is_buffer_owner_ = false;
+    info.shared_ = nullptr;
 }
 
 BufferInfo& BufferInfo::operator=(BufferInfo&& info) {
-    if (is_buffer_owner_ && device_) {
-        device_->Free(&buffer_);
-    }
+    ReleaseBuffer();
 
     is_buffer_owner_ = info.is_buffer_owner_;
     buffer_ = info.buffer_;
     device_ = info.device_;
+    shared_ = info.shared_;
 
     info.buffer_.addr = nullptr;
     info.device_ = nullptr;
     info.is_buffer_owner_ = false;
+    info.shared_ = nullptr;
 
     return *this;
 }
 
+void BufferInfo::ReleaseBuffer() {
+    if (shared_) {
+        --shared_->refcount;
+        if (shared_->refcount == 0) {
+            if (shared_->device) {
+                shared_->device->Free(&shared_->buffer);
+            }
+            delete shared_;
+        }
+        shared_ = nullptr;
+    } else if (is_buffer_owner_ && device_) {
+        device_->Free(&buffer_);
+    }
+    is_buffer_owner_ = false;
+}
+
 RetCode BufferInfo::SetDevice(Device* dev) {
     if (!dev) {
         LOG(ERROR) << "SetDevice failed: device is empty.";
@@ -63,9 +81,7 @@ RetCode BufferInfo::SetDevice(Device* dev) {
 }
 
 void BufferInfo::SetBuffer(const BufferDesc& buf, Device* device, bool is_buffer_owner) {
-    if (is_buffer_owner_ && device_) {
-        device_->Free(&buffer_);
-    }
+    ReleaseBuffer();
 
     if (device) {
         device_ = device;
@@ -75,12 +91,78 @@ void BufferInfo::SetBuffer(const BufferDesc& buf, Device* device, bool is_buffer
     is_buffer_owner_ = is_buffer_owner;
 }
 
+void BufferInfo::ShareBufferFrom(BufferInfo* src, uint64_t offset) {
+    if (src == this) {
+        return;
+    }
+
+    SharedBuffer* shared = src->shared_;
+    if (!shared) {
+        shared = new SharedBuffer();
+        shared->buffer = src->buffer_;
+        shared->refcount = 0;
+        if (src->is_buffer_owner_ && src->device_) {
+            shared->device = src->device_;
+            shared->refcount = 1;
+            src->shared_ = shared;
+            src->is_buffer_owner_ = false;
+        } else {
+            // borrowed from a buffer not owned by `src`. it will not be freed by views.
+            shared->device = nullptr;
+        }
+    }
+
+    // increases refcount before releasing the old buffer in case that `src` shares the same buffer with this one
+    ++shared->refcount;
+    ReleaseBuffer();
+    shared_ = shared;
+
+    buffer_ = src->buffer_;
+    if (buffer_.addr) {
+        buffer_.addr = static_cast<char*>(buffer_.addr) + offset;
+    }
+    if (src->device_) {
+        device_ = src->device_;
+    }
+}
+
+void BufferInfo::TransferBufferFrom(BufferInfo* src) {
+    if (src == this) {
+        return;
+    }
+
+    ReleaseBuffer();
+
+    is_buffer_owner_ = src->is_buffer_owner_;
+    buffer_ = src->buffer_;
+    shared_ = src->shared_;
+    if (src->device_) {
+        device_ = src->device_;
+    }
+
+    src->buffer_.addr = nullptr;
+    src->is_buffer_owner_ = false;
+    src->shared_ = nullptr;
+}
+
 RetCode BufferInfo::ReallocBuffer(const TensorShape& shape) {
     if (!device_) {
         LOG(ERROR) << "ReallocBuffer() failed: device not set.";
         return RC_PERMISSION_DENIED;
     }
 
+    if (shared_) {
+        if (shared_->refcount == 1 && shared_->buffer.addr == buffer_.addr && shared_->device == device_) {
+            // the last reference of a shared buffer. takes it back so that it can be reused.
+            buffer_ = shared_->buffer;
+            delete shared_;
+            shared_ = nullptr;
+            is_buffer_owner_ = true;
+        } else {
+            ReleaseBuffer();
+        }
+    }
+
     if (!is_buffer_owner_) {
         buffer_.addr = nullptr;
     }
@@ -98,17 +180,16 @@ RetCode BufferInfo::ReallocBuffer(const TensorShape& shape) {
 
 BufferDesc BufferInfo::DetachBuffer() {
     auto ret = buffer_;
+    if (shared_) {
+        ReleaseBuffer();
+    }
     buffer_.addr = nullptr;
     is_buffer_owner_ = false;
     return ret;
 }
 
 void BufferInfo::FreeBuffer() {
-    if (is_buffer_owner_ && device_) {
-        device_->Free(&buffer_);
-        is_buffer_owner_ = false;
-    }
-
+    ReleaseBuffer();
     buffer_.addr = nullptr;
 }
 
@@ -24,7 +24,7 @@ namespace ppl { namespace nn {
 
 class BufferInfo final {
 public:
-    BufferInfo() : is_buffer_owner_(false), device_(nullptr) {}
+    BufferInfo() : is_buffer_owner_(false), device_(nullptr), shared_(nullptr) {}
     BufferInfo(BufferInfo&&);
     BufferInfo& operator=(BufferInfo&&);
     ~BufferInfo();
@@ -33,6 +33,19 @@ public:
         return is_buffer_owner_;
     }
 
+    /** @brief tells whether the buffer is a reference-counted one created by `ShareBufferFrom()`. */
+    bool IsBufferShared() const {
+        return (shared_ != nullptr);
+    }
+
+    /**
+       @brief tells whether the buffer can be modified in place without affecting other `BufferInfo`s, i.e. it is
+       owned by this `BufferInfo` or it is shared but this is the only reference.
+    */
+    bool IsBufferExclusive() const {
+        return is_buffer_owner_ || (shared_ && shared_->device && shared_->refcount == 1);
+    }
+
     /**
        @brief set device used to manage buffer of this tensor
        @note fails when buffer_.addr is not null
@@ -50,7 +63,23 @@ public:
     */
     void SetBuffer(const BufferDesc& buf, Device* device = nullptr, bool is_buffer_owner = false);
 
-    /** @brief returns buffer_ to caller and reset buffer_. */
+    /**
+       @brief makes this `BufferInfo` a view of `src`'s buffer starting at `offset` bytes. old buffer of this tensor
+       will be freed or detached.
+       @note if `src` owns its buffer, the ownership is converted into a reference-counted one held by both `src` and
+       this `BufferInfo`. the underlying buffer is freed when the last reference is released. buffers not owned by
+       `src` are borrowed and must outlive this view.
+       @note `offset` is only valid for devices using host memory.
+    */
+    void ShareBufferFrom(BufferInfo* src, uint64_t offset = 0);
+
+    /** @brief moves buffer, ownership and shared reference of `src` into this `BufferInfo`. */
+    void TransferBufferFrom(BufferInfo* src);
+
+    /**
+       @brief returns buffer_ to caller and reset buffer_.
+       @note the reference of a shared buffer is released and the returned buffer is not owned by the caller.
+    */
     BufferDesc DetachBuffer();
 
     /** @brief frees the internal buffer */
@@ -63,6 +92,17 @@ public:
         return static_cast<T*>(buffer_.addr);
     }
 
+    /**
+       @brief returns the start of the device-managed buffer this `BufferInfo` refers to, which is the same for all
+       views of a shared buffer, or nullptr if the buffer is borrowed.
+    */
+    void* GetManagedBufferPtr() const {
+        if (shared_) {
+            return shared_->device ? shared_->buffer.addr : nullptr;
+        }
+        return is_buffer_owner_ ? buffer_.addr : nullptr;
+    }
+
     BufferDesc& GetBufferDesc() {
         return buffer_;
     }
@@ -70,10 +110,21 @@ public:
         return buffer_;
     }
 
+private:
+    struct SharedBuffer final {
+        BufferDesc buffer;
+        Device* device; // nullptr if the buffer is borrowed and should not be freed
+        uint32_t refcount;
+    };
+
+    /** @brief frees the owned buffer or drops the reference of the shared buffer. `buffer_` is left unchanged. */
+    void ReleaseBuffer();
+
 private:
     bool is_buffer_owner_;
     BufferDesc buffer_;
     Device* device_;
+    SharedBuffer* shared_;
 
 private:
     BufferInfo(const BufferInfo&) = delete;
@@ -28,6 +28,17 @@
 
 namespace ppl { namespace nn {
 
+struct DeviceMemoryUsage final {
+    /** bytes reserved from the system by the buffer manager of a device */
+    uint64_t allocated_bytes = 0;
+    /** max bytes handed out by the buffer manager at the same time */
+    uint64_t peak_used_bytes = 0;
+    /** max size of temporary buffers requested by kernels */
+    uint64_t tmp_buffer_bytes = 0;
+    /** bytes allocated by kernels via the allocator of a device, such as converted weights */
+    uint64_t allocator_bytes = 0;
+};
+
 class Device : public DeviceContext {
 public:
     virtual ~Device() {}
@@ -95,6 +106,14 @@ public:
 
     /** @brief get DataConverter that can process data on this device */
     virtual const DataConverter* GetDataConverter() const = 0;
+
+    /** @brief tells whether buffers of this device are host memory that can be accessed by cpu directly */
+    virtual bool IsHostMemory() const {
+        return false;
+    }
+
+    /** @brief adds memory used by this device to `usage`. devices that do not track memory leave it unchanged. */
+    virtual void GetMemoryUsage(DeviceMemoryUsage* usage) const {}
 };
 
 }} // namespace ppl::nn
@@ -71,6 +71,15 @@ public:
         return static_cast<T*>(acquire_func_(eid, EdgeObjectType<T>::value));
     }
 
+    /**
+       @brief gets the object of edge `eid` which may not be an input or output of this node.
+       @note the object is created if it does not exist.
+    */
+    template <typename T>
+    T* GetEdgeObject(edgeid_t eid) const {
+        return static_cast<T*>(acquire_func_(eid, EdgeObjectType<T>::value));
+    }
+
 protected:
     const ir::Node* node_ = nullptr;
     std::function<EdgeObject*(edgeid_t, uint32_t)> acquire_func_;
@@ -34,6 +34,14 @@ public:
         return info_.IsBufferOwner();
     }
 
+    bool IsBufferShared() const {
+        return info_.IsBufferShared();
+    }
+
+    bool IsBufferExclusive() const {
+        return info_.IsBufferExclusive();
+    }
+
     ppl::common::RetCode SetDevice(Device* dev) {
         return info_.SetDevice(dev);
     }
@@ -46,6 +54,14 @@ public:
         return info_.SetBuffer(buf, device, is_buffer_owner);
     }
 
+    void ShareBufferFrom(TensorBufferInfo* src, uint64_t offset = 0) {
+        info_.ShareBufferFrom(&src->info_, offset);
+    }
+
+    void TransferBufferFrom(TensorBufferInfo* src) {
+        info_.TransferBufferFrom(&src->info_);
+    }
+
     BufferDesc DetachBuffer() {
         return info_.DetachBuffer();
     }
@@ -63,6 +79,10 @@ public:
         return info_.GetBufferPtr<T>();
     }
 
+    void* GetManagedBufferPtr() const {
+        return info_.GetManagedBufferPtr();
+    }
+
     BufferDesc& GetBufferDesc() {
         return info_.GetBufferDesc();
     }
@@ -29,7 +29,8 @@ namespace ppl { namespace nn { namespace arm {
 
 class ArmDevice : public Device {
 public:
-    ArmDevice(uint64_t alignment, ppl::common::isa_t isa) : isa_(isa), allocator_(alignment), data_converter_(isa) {}
+    ArmDevice(uint64_t alignment, ppl::common::isa_t isa)
+        : isa_(isa), alignment_(alignment), allocator_(alignment), data_converter_(isa) {}
 
     void SetISA(ppl::common::isa_t isa) {
         isa_ = isa;
@@ -109,6 +110,14 @@ public:
         return Copy(dst, src, shape.GetBytesIncludingPadding());
     }
 
+    bool IsHostMemory() const override final {
+        return true;
+    }
+
+    uint64_t GetAlignment() const override final {
+        return alignment_;
+    }
+
     const char* GetType() const override final {
         return "arm";
     }
@@ -119,6 +128,7 @@ public:
 
 private:
     ppl::common::isa_t isa_;
+    const uint64_t alignment_;
     mutable ppl::common::GenericCpuAllocator allocator_;
     ArmDataConverter data_converter_;
 };
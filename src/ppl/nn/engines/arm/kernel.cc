@@ -26,10 +26,13 @@
 namespace ppl { namespace nn { namespace arm {
 
 ppl::common::RetCode ArmKernel::BeforeExecute(KernelExecContext* ctx) {
-    auto status = Reshape(ctx);
-    if (status != ppl::common::RC_SUCCESS) {
-        LOG(ERROR) << "reshape kernel[" << GetName() << "] failed: " << ppl::common::GetRetCodeStr(status);
-        return status;
+    ppl::common::RetCode status = ppl::common::RC_SUCCESS;
+    if (!ctx->IsOutputShapesReady()) {
+        status = Reshape(ctx);
+        if (status != ppl::common::RC_SUCCESS) {
+            LOG(ERROR) << "reshape kernel[" << GetName() << "] failed: " << ppl::common::GetRetCodeStr(status);
+            return status;
+        }
     }
 
     for (uint32_t i = 0; i < ctx->GetOutputCount(); ++i) {
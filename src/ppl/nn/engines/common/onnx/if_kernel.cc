@@ -49,6 +49,14 @@ RetCode IfKernel::SetExecutionInfo(const shared_ptr<ir::GraphTopo>& then_topo, c
         return status;
     }
 
+    // shapes of branches may depend on values of some tensors. run them without cache in this case.
+    if (then_branch_.EnableShapeCache() != RC_SUCCESS) {
+        LOG(DEBUG) << "shape cache is not applicable to then_branch of if kernel[" << GetName() << "]";
+    }
+    if (else_branch_.EnableShapeCache() != RC_SUCCESS) {
+        LOG(DEBUG) << "shape cache is not applicable to else_branch of if kernel[" << GetName() << "]";
+    }
+
     extra_inputs_of_then_branch_ = extra_inputs_of_then_branch;
     extra_inputs_of_else_branch_ = extra_inputs_of_else_branch;
 
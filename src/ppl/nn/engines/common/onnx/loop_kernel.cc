@@ -15,12 +15,12 @@
 // specific language governing permissions and limitations
 // under the License.
 
-#include "ppl/nn/common/tensor_buffer_info.h"
 #include "ppl/nn/runtime/runtime_impl.h"
 #include "ppl/nn/engines/common/onnx/loop_kernel.h"
 #include "ppl/nn/engines/utils.h"
 #include "ppl/nn/utils/generic_cpu_device.h"
 #include "ppl/nn/common/logger.h"
+#include <algorithm>
 using namespace std;
 using namespace ppl::common;
 
@@ -30,8 +30,7 @@ template <typename T>
 void DummyDeleter(T*) {}
 
 RetCode LoopKernel::SetExecutionInfo(const shared_ptr<ir::GraphTopo>& topo, const RuntimeGraphInfo* info,
-                                     const RuntimeAuxInfo* aux_info, const RuntimeInitInfo* init_info,
-                                     LoopConcatOutputFunc func) {
+                                     const RuntimeAuxInfo* aux_info, const RuntimeInitInfo* init_info) {
     auto status =
         subgraph_.Init(topo, shared_ptr<const RuntimeGraphInfo>(info, DummyDeleter<const RuntimeGraphInfo>),
                        shared_ptr<const RuntimeAuxInfo>(aux_info, DummyDeleter<const RuntimeAuxInfo>), *init_info);
@@ -40,7 +39,11 @@ RetCode LoopKernel::SetExecutionInfo(const shared_ptr<ir::GraphTopo>& topo, cons
         return status;
     }
 
-    concat_output_func_ = func;
+    // loop body usually sees the same input shapes in every iteration
+    if (subgraph_.EnableShapeCache() != RC_SUCCESS) {
+        LOG(DEBUG) << "shape cache is not applicable to body of loop kernel[" << GetName() << "]";
+    }
+
     return RC_SUCCESS;
 }
 
@@ -70,50 +73,109 @@ struct LoopInfo final {
     LoopInfo(const KernelExecContext& ctx) {
         loop_carried_dep_num = ctx.GetInputCount() - 2; // N
         scan_output_num = ctx.GetOutputCount() - loop_carried_dep_num; // K
-        intermediate_outputs.resize(scan_output_num);
+        scan_output_capacity.resize(scan_output_num, 0);
+        scan_output_item_bytes.resize(scan_output_num, 0);
     }
 
     uint32_t loop_carried_dep_num;
     uint32_t scan_output_num;
-    vector<vector<TensorBufferInfo>> intermediate_outputs;
+    /** number of iterations that can be stored in each scan output without reallocating */
+    vector<int64_t> scan_output_capacity;
+    /** bytes of each scan output produced by one iteration */
+    vector<uint64_t> scan_output_item_bytes;
 };
 
-static RetCode SaveSubgraphOutputs(RuntimeImpl* subgraph, LoopInfo* info) {
+/** initial capacity of scan outputs. capacities are doubled when needed and never exceed the max trip count. */
+static const int64_t g_init_scan_output_capacity = 64;
+
+/** appends scan outputs of iteration `iter` to the corresponding outputs of the loop kernel directly */
+static RetCode AppendScanOutputs(int64_t iter, int64_t max_trip_count, Device* kernel_dev, RuntimeImpl* subgraph,
+                                 LoopInfo* info, KernelExecContext* ctx) {
     for (uint32_t i = 0; i < info->scan_output_num; ++i) {
-        auto scan_output = subgraph->GetOutputTensorImpl(info->loop_carried_dep_num + i + 1); // +1 for skipping `cond`
+        auto src = subgraph->GetOutputTensorImpl(info->loop_carried_dep_num + i + 1); // +1 for skipping `cond`
+        auto dst = ctx->GetOutput<TensorImpl>(info->loop_carried_dep_num + i);
+        const uint64_t item_bytes = src->GetShape()->GetBytesIncludingPadding();
+
+        if (iter == 0) {
+            info->scan_output_item_bytes[i] = item_bytes;
+            info->scan_output_capacity[i] = 0;
+            dst->SetDevice(kernel_dev);
+        } else if (item_bytes != info->scan_output_item_bytes[i]) {
+            LOG(ERROR) << "size of scan output[" << src->GetName() << "] changes from ["
+                       << info->scan_output_item_bytes[i] << "] to [" << item_bytes << "] bytes.";
+            return RC_INVALID_VALUE;
+        }
 
-        TensorBufferInfo output_buffer;
-        if (scan_output->IsBufferOwner()) {
-            output_buffer.Reshape(*scan_output->GetShape());
-            output_buffer.SetBuffer(scan_output->GetBufferDesc(), scan_output->GetDevice(), true);
-            scan_output->DetachBuffer();
-        } else {
-            auto device = scan_output->GetDevice();
+        if (item_bytes == 0) {
+            continue;
+        }
+
+        if (iter >= info->scan_output_capacity[i]) {
+            const int64_t new_capacity =
+                std::min(max_trip_count, (iter == 0) ? g_init_scan_output_capacity : iter * 2);
 
-            output_buffer.SetDevice(scan_output->GetDevice());
-            output_buffer.Reshape(*scan_output->GetShape());
-            auto status = output_buffer.ReallocBuffer();
+            BufferDesc new_buffer;
+            auto status = kernel_dev->Realloc(new_capacity * item_bytes, &new_buffer);
             if (status != RC_SUCCESS) {
-                LOG(ERROR) << "alloc buffer for tensor[" << scan_output->GetName()
+                LOG(ERROR) << "alloc [" << new_capacity * item_bytes << "] bytes for scan output[" << dst->GetName()
                            << "] failed: " << GetRetCodeStr(status);
                 return status;
             }
 
-            status =
-                device->Copy(&output_buffer.GetBufferDesc(), scan_output->GetBufferDesc(), *scan_output->GetShape());
-            if (status != RC_SUCCESS) {
-                LOG(ERROR) << "copy data from tensor[" << scan_output->GetName()
-                           << "] failed: " << GetRetCodeStr(status);
-                return status;
+            if (iter > 0) {
+                status = kernel_dev->Copy(&new_buffer, dst->GetBufferDesc(), iter * item_bytes);
+                if (status != RC_SUCCESS) {
+                    LOG(ERROR) << "copy data of scan output[" << dst->GetName()
+                               << "] failed: " << GetRetCodeStr(status);
+                    kernel_dev->Free(&new_buffer);
+                    return status;
+                }
             }
+
+            // old buffer is freed here
+            dst->SetBuffer(new_buffer, kernel_dev, true);
+            info->scan_output_capacity[i] = new_capacity;
         }
 
-        info->intermediate_outputs[i].emplace_back(std::move(output_buffer));
+        BufferDesc cursor = dst->GetBufferDesc();
+        cursor.addr = (char*)(cursor.addr) + iter * item_bytes;
+
+        // srcs are already synchronized by subgraph->Sync()
+        auto status = src->GetDevice()->Copy(&cursor, src->GetBufferDesc(), item_bytes);
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "copy data from tensor[" << src->GetName() << "] to scan output[" << dst->GetName()
+                       << "] failed: " << GetRetCodeStr(status);
+            return status;
+        }
     }
 
     return RC_SUCCESS;
 }
 
+static bool IsSubgraphInput(const RuntimeImpl* subgraph, const TensorImpl* tensor) {
+    for (uint32_t i = 0; i < subgraph->GetInputCount(); ++i) {
+        if (subgraph->GetInputTensorImpl(i) == tensor) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+   @brief passes the buffer of `src` to `dst` without copying. the old buffer of `dst` is given back to `src`
+   and can be reused by the next iteration.
+*/
+static void SwapLoopCarriedBuffer(TensorImpl* src, TensorImpl* dst) {
+    // buffers not owned by `dst` are borrowed from inputs of the loop kernel and cannot be written
+    const bool is_dst_owner = dst->IsBufferOwner();
+    auto dst_buffer = dst->DetachBuffer();
+
+    dst->TransferBufferFrom(src);
+    if (is_dst_owner) {
+        src->SetBuffer(dst_buffer, nullptr, true);
+    }
+}
+
 static RetCode UpdateSubgraphInputs(int64_t trip_count, RuntimeImpl* subgraph,
                                     utils::GenericCpuDevice* tmp_cpu_device) {
     auto trip_count_tensor = subgraph->GetInputTensorImpl(0);
@@ -133,9 +195,13 @@ static RetCode UpdateSubgraphInputs(int64_t trip_count, RuntimeImpl* subgraph,
         }
 
         auto src = subgraph->GetOutputTensorImpl(i - 1);
+        if (src == dst) {
+            continue;
+        }
+
         *dst->GetShape() = *src->GetShape();
-        if (dst->GetDevice() == src->GetDevice()) {
-            dst->TransferBufferFrom(src);
+        if (dst->GetDevice() == src->GetDevice() && src->IsBufferOwner() && !IsSubgraphInput(subgraph, src)) {
+            SwapLoopCarriedBuffer(src, dst);
         } else {
             auto status = utils::CopyTensorBuffer(*src, dst, tmp_cpu_device);
             if (status != RC_SUCCESS) {
@@ -270,9 +336,8 @@ static RetCode SetOutputsFromInputs(const LoopInfo& info, const string& loop_ker
     return RC_SUCCESS;
 }
 
-static RetCode SetOutputsFromSubgraph(const LoopInfo& info, Device* kernel_dev, Device* tmp_cpu_device,
-                                      LoopConcatOutputFunc concat_output_func, RuntimeImpl* subgraph,
-                                      KernelExecContext* ctx) {
+static RetCode SetOutputsFromSubgraph(const LoopInfo& info, int64_t trip_count, Device* kernel_dev,
+                                      Device* tmp_cpu_device, RuntimeImpl* subgraph, KernelExecContext* ctx) {
     // copy loop carried deps from subgraph's output
     for (uint32_t i = 0; i < info.loop_carried_dep_num; ++i) {
         auto src = subgraph->GetOutputTensorImpl(i + 1);
@@ -290,33 +355,21 @@ static RetCode SetOutputsFromSubgraph(const LoopInfo& info, Device* kernel_dev,
         }
     }
 
-    for (uint32_t i = info.loop_carried_dep_num; i < ctx->GetOutputCount(); ++i) {
-        auto dst = ctx->GetOutput<TensorImpl>(i);
-
-        auto& outputs = info.intermediate_outputs[i];
-        auto& output_shape = *outputs[i].GetShape();
+    // data of scan outputs are already filled by AppendScanOutputs()
+    for (uint32_t i = 0; i < info.scan_output_num; ++i) {
+        auto& item_shape = *subgraph->GetOutputTensorImpl(info.loop_carried_dep_num + i + 1)->GetShape();
+        auto dst = ctx->GetOutput<TensorImpl>(info.loop_carried_dep_num + i);
 
-        vector<int64_t> dims(1 + output_shape.GetDimCount());
-        dims[0] = outputs.size();
-        for (uint32_t j = 0; j < output_shape.GetDimCount(); ++j) {
-            dims[j + 1] = output_shape.GetDim(j);
+        vector<int64_t> dims(1 + item_shape.GetDimCount());
+        dims[0] = trip_count;
+        for (uint32_t j = 0; j < item_shape.GetDimCount(); ++j) {
+            dims[j + 1] = item_shape.GetDim(j);
         }
 
         auto dst_shape = dst->GetShape();
-        dst_shape->SetDataType(output_shape.GetDataType());
-        dst_shape->SetDataFormat(output_shape.GetDataFormat());
+        dst_shape->SetDataType(item_shape.GetDataType());
+        dst_shape->SetDataFormat(item_shape.GetDataFormat());
         dst_shape->Reshape(dims.data(), dims.size());
-
-        auto status = dst->ReallocBuffer();
-        if (status != RC_SUCCESS) {
-            LOG(ERROR) << "ReallocBuffer for tensor[" << dst->GetName() << "] failed: " << GetRetCodeStr(status);
-            return status;
-        }
-
-        status = concat_output_func(outputs, &dst->GetBufferDesc());
-        if (status != RC_SUCCESS) {
-            return status;
-        }
     }
 
     return RC_SUCCESS;
@@ -389,11 +442,6 @@ RetCode LoopKernel::DoExecute(KernelExecContext* ctx) {
                 LOG(ERROR) << "UpdateSubgraphInputs failed: " << GetRetCodeStr(status);
                 return status;
             }
-            status = SaveSubgraphOutputs(&subgraph_, &loop_info);
-            if (status != RC_SUCCESS) {
-                LOG(ERROR) << "SaveSubgraphOutputs failed: " << GetRetCodeStr(status);
-                return status;
-            }
         }
 
         status = subgraph_.Run();
@@ -402,6 +450,12 @@ RetCode LoopKernel::DoExecute(KernelExecContext* ctx) {
             return status;
         }
 
+        status = AppendScanOutputs(trip_count, max_trip_count, device, &subgraph_, &loop_info, ctx);
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "AppendScanOutputs of loop kernel[" << GetName() << "] failed: " << GetRetCodeStr(status);
+            return status;
+        }
+
         ++trip_count;
         status = subgraph_.GetOutputTensorImpl(0)->CopyToHost(&keep_going);
         if (status != RC_SUCCESS) {
@@ -417,8 +471,7 @@ RetCode LoopKernel::DoExecute(KernelExecContext* ctx) {
             return status;
         }
     } else {
-        SaveSubgraphOutputs(&subgraph_, &loop_info);
-        status = SetOutputsFromSubgraph(loop_info, device, &tmp_cpu_device, concat_output_func_, &subgraph_, ctx);
+        status = SetOutputsFromSubgraph(loop_info, trip_count, device, &tmp_cpu_device, &subgraph_, ctx);
         if (status != RC_SUCCESS) {
             LOG(ERROR) << "SetOutputsFromSubgraph of loop kernel[" << GetName()
                        << "] failed: " << GetRetCodeStr(status);
@@ -32,8 +32,7 @@ LoopOp::~LoopOp() {
     engines_.clear();
 }
 
-RetCode LoopOp::Init(const utils::SharedResource& resource, ppl::nn::onnx::LoopParam* loop_param,
-                     LoopConcatOutputFunc concat_output_func) {
+RetCode LoopOp::Init(const utils::SharedResource& resource, ppl::nn::onnx::LoopParam* loop_param) {
     utils::SharedResource new_resource;
     for (auto x = resource.engines.begin(); x != resource.engines.end(); ++x) {
         auto e = (*x)->Create();
@@ -65,14 +64,13 @@ RetCode LoopOp::Init(const utils::SharedResource& resource, ppl::nn::onnx::LoopP
     }
 
     topo_ = loop_param->graph.topo;
-    concat_output_func_ = concat_output_func;
 
     return RC_SUCCESS;
 }
 
 KernelImpl* LoopOp::CreateKernelImpl() const {
     auto kernel = unique_ptr<LoopKernel>(new LoopKernel(node_));
-    auto status = kernel->SetExecutionInfo(topo_, &graph_info_, &aux_info_, &init_info_, concat_output_func_);
+    auto status = kernel->SetExecutionInfo(topo_, &graph_info_, &aux_info_, &init_info_);
     if (status != RC_SUCCESS) {
         LOG(ERROR) << "SetExecutionInfo of kernel[" << kernel->GetName() << "] failed: " << GetRetCodeStr(status);
         return nullptr;
@@ -62,9 +62,12 @@ RetCode CudaKernel::Init() {
 }
 
 RetCode CudaKernel::BeforeExecute(KernelExecContext* ctx) {
-    auto status = Reshape(ctx);
-    if (status != RC_SUCCESS) {
-        return status;
+    RetCode status = RC_SUCCESS;
+    if (!ctx->IsOutputShapesReady()) {
+        status = Reshape(ctx);
+        if (status != RC_SUCCESS) {
+            return status;
+        }
     }
 
     for (uint32_t i = 0; i < ctx->GetOutputCount(); ++i) {
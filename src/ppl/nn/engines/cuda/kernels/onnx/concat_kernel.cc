@@ -37,9 +37,12 @@ bool ConcatKernel::CanDoExecute(const KernelExecContext& ctx) const {
 }
 
 ppl::common::RetCode ConcatKernel::BeforeExecute(KernelExecContext* ctx) {
-    auto status = Reshape(ctx);
-    if (status != ppl::common::RC_SUCCESS) {
-        return status;
+    ppl::common::RetCode status = ppl::common::RC_SUCCESS;
+    if (!ctx->IsOutputShapesReady()) {
+        status = Reshape(ctx);
+        if (status != ppl::common::RC_SUCCESS) {
+            return status;
+        }
     }
 
     for (uint32_t i = 0; i < ctx->GetOutputCount(); ++i) {
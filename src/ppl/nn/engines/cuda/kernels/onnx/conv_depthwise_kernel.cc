@@ -25,9 +25,12 @@
 namespace ppl { namespace nn { namespace cuda {
 
 ppl::common::RetCode ConvDepthwiseKernel::BeforeExecute(KernelExecContext* ctx) {
-    auto status = Reshape(ctx);
-    if (status != ppl::common::RC_SUCCESS) {
-        return status;
+    ppl::common::RetCode status = ppl::common::RC_SUCCESS;
+    if (!ctx->IsOutputShapesReady()) {
+        status = Reshape(ctx);
+        if (status != ppl::common::RC_SUCCESS) {
+            return status;
+        }
     }
 
     for (uint32_t i = 0; i < ctx->GetOutputCount(); ++i) {
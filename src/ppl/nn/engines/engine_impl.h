@@ -67,6 +67,12 @@ public:
     /** @brief creates an instance of the same type as this engine */
     virtual EngineImpl* Create() = 0;
 
+    /**
+       @brief adds memory held by this engine to `usage`, such as weights converted by kernels, which is shared by all
+       `Runtime` instances created from it.
+    */
+    virtual void GetMemoryUsage(DeviceMemoryUsage* usage) const {}
+
 #ifdef PPLNN_ENABLE_PMX_MODEL
     virtual ppl::common::RetCode LoadConstants(const ConstantVisitor&, std::map<edgeid_t, BufferInfo>*) = 0;
 
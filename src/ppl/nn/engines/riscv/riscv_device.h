@@ -28,7 +28,7 @@ namespace ppl { namespace nn { namespace riscv {
 
 class RiscvDevice : public Device {
 public:
-    RiscvDevice(uint64_t alignment) : data_converter_(), allocator_(alignment) {}
+    RiscvDevice(uint64_t alignment) : alignment_(alignment), data_converter_(), allocator_(alignment) {}
 
     virtual ppl::common::RetCode AllocTmpBuffer(uint64_t bytes, BufferDesc* buffer) {
         return Realloc(bytes, buffer);
@@ -99,6 +99,14 @@ public:
         return &data_converter_;
     }
 
+    bool IsHostMemory() const override final {
+        return true;
+    }
+
+    uint64_t GetAlignment() const override final {
+        return alignment_;
+    }
+
     const char* GetType() const override final {
         return "riscv";
     }
@@ -108,6 +116,7 @@ public:
     }
 
 private:
+    const uint64_t alignment_;
     RiscvDataConverter data_converter_;
     mutable ppl::common::GenericCpuAllocator allocator_;
 };
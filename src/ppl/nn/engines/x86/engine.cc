@@ -19,10 +19,12 @@
 
 #include "ppl/nn/engines/x86/engine.h"
 #include "ppl/nn/engines/x86/engine_context.h"
+#include "ppl/nn/engines/x86/numa_tools.h"
 #include "ppl/nn/engines/x86/optimizer/opt_kernel_creator_manager.h"
 #include "ppl/nn/engines/x86/optimizer/opt_graph.h"
 #include "ppl/nn/engines/x86/engine_factory.h"
 #include "ppl/nn/engines/utils.h"
+#include "ppl/nn/utils/shared_resource.h"
 #include "ppl/nn/common/logger.h"
 #include "ppl/kernel/x86/common/simd_tools.h"
 #include "ppl/kernel/x86/common/general_include.h"
@@ -47,11 +49,42 @@ X86Engine::X86Engine() : EngineImpl("x86"), device_(X86_DEFAULT_ALIGNMENT, ppl::
 
 RetCode X86Engine::Init(const EngineOptions& options) {
     options_ = options;
+
+    if (options_.numa_node_id >= 0) {
+        if (!IsNumaNodeAvailable(options_.numa_node_id)) {
+            LOG(WARNING) << "engine will not bind to numa node [" << options_.numa_node_id << "].";
+            options_.numa_node_id = -1;
+        } else {
+            if (options_.core_list.empty()) {
+                auto status = GetNumaNodeCpus(options_.numa_node_id, &options_.core_list);
+                if (status != RC_SUCCESS) {
+                    LOG(ERROR) << "get cpus of numa node [" << options_.numa_node_id
+                               << "] failed: " << GetRetCodeStr(status);
+                    return status;
+                }
+            }
+            device_.SetNumaNodeId(options_.numa_node_id);
+            LOG(INFO) << "bind x86 engine to numa node [" << options_.numa_node_id << "] with ["
+                      << options_.core_list.size() << "] cores.";
+        }
+    }
+
+    if (!options_.core_list.empty()) {
+        if (options_.thread_num == 0) {
+            options_.thread_num = options_.core_list.size();
+        } else if (options_.core_list.size() < options_.thread_num) {
+            LOG(ERROR) << "core number [" << options_.core_list.size() << "] < thread number ["
+                       << options_.thread_num << "].";
+            return RC_INVALID_VALUE;
+        }
+    }
+
     return RC_SUCCESS;
 }
 
 EngineContext* X86Engine::CreateEngineContext() {
-    return new X86EngineContext(device_.GetISA(), options_.mm_policy);
+    return new X86EngineContext(device_.GetISA(), options_.mm_policy, options_.thread_num, options_.core_list,
+                                options_.numa_node_id);
 }
 
 bool X86Engine::Supports(const ir::Node* node) const {
@@ -67,7 +100,7 @@ RetCode X86Engine::DoOptimize(const utils::SharedResource& resource, ir::Graph*
         return status;
     }
 
-    status = opt_graph.DoOptimize(resource, &device_);
+    status = opt_graph.DoOptimize(resource, &device_, &options_);
     if (status != RC_SUCCESS) {
         LOG(ERROR) << "OptGraph DoOptimize failed: " << GetRetCodeStr(status);
         return status;
@@ -114,7 +147,11 @@ ppl::common::RetCode X86Engine::CalDataOmittedConstants(const ir::Graph& graph,
 }
 
 RetCode X86Engine::ProcessGraph(const utils::SharedResource& resource, ir::Graph* graph, RuntimePartitionInfo* info) {
-    auto status = DoOptimize(resource, graph, info);
+    RetCode status;
+    {
+        utils::StartupStageGuard __stage_guard(resource.startup_profiler, "DoOptimize");
+        status = DoOptimize(resource, graph, info);
+    }
     if (status != RC_SUCCESS) {
         LOG(ERROR) << "DoOptimize failed: " << GetRetCodeStr(status);
         return status;
@@ -127,7 +164,10 @@ RetCode X86Engine::ProcessGraph(const utils::SharedResource& resource, ir::Graph
         return status;
     }
 
-    status = utils::LoadConstants(*graph, &device_, &info->constants, &data_omitted_constants);
+    {
+        utils::StartupStageGuard __stage_guard(resource.startup_profiler, "LoadConstants");
+        status = utils::LoadConstants(*graph, &device_, &info->constants, &data_omitted_constants);
+    }
     if (status != RC_SUCCESS) {
         LOG(ERROR) << "LoadConstants failed: " << GetRetCodeStr(status);
         return status;
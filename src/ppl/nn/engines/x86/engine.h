@@ -33,6 +33,9 @@ public:
     bool Supports(const ir::Node*) const override;
     ppl::common::RetCode ProcessGraph(const utils::SharedResource&, ir::Graph*, RuntimePartitionInfo*) override;
     EngineImpl* Create() override;
+    void GetMemoryUsage(DeviceMemoryUsage* usage) const override {
+        device_.GetMemoryUsage(usage);
+    }
 
 #ifdef PPLNN_ENABLE_PMX_MODEL
     ppl::common::RetCode LoadConstants(const ConstantVisitor&, std::map<edgeid_t, BufferInfo>*) override;
@@ -0,0 +1,67 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/engines/x86/options.h"
+#include "ppl/nn/engines/x86/engine_context.h"
+#include "ppl/kernel/x86/common/threading_tools.h"
+using namespace std;
+using namespace ppl::common;
+
+namespace ppl { namespace nn { namespace x86 {
+
+/*
+  OpenMP keeps one thread team per thread that starts parallel regions, and the number of threads is an
+  attribute of the calling thread. runtimes created by different engines can therefore be run in different
+  threads with their own thread numbers and core bindings without oversubscribing the host. the applied
+  setting is recorded so that binding is done only when it changes. engines without these settings restore
+  the defaults, which may have been changed by other engines running in the same thread.
+*/
+struct ThreadingConfig final {
+    uint32_t thread_num = 0;
+    vector<int32_t> core_list;
+    // thread number of the calling thread before it is changed. 0 if not changed yet.
+    uint32_t default_thread_num = 0;
+};
+
+static thread_local ThreadingConfig g_applied_config;
+
+RetCode X86EngineContext::BeforeRun(const ir::GraphTopo*, RuntimeGraphResource*) {
+    if (g_applied_config.thread_num == thread_num_ && g_applied_config.core_list == core_list_) {
+        return RC_SUCCESS;
+    }
+
+    if (thread_num_ > 0) {
+        if (g_applied_config.default_thread_num == 0) {
+            g_applied_config.default_thread_num = ppl::kernel::x86::get_omp_max_threads();
+        }
+        ppl::kernel::x86::set_omp_num_threads(thread_num_);
+    } else if (g_applied_config.thread_num > 0) {
+        ppl::kernel::x86::set_omp_num_threads(g_applied_config.default_thread_num);
+    }
+
+    if (!core_list_.empty()) {
+        ppl::kernel::x86::set_omp_core_binding(core_list_.data(), core_list_.size(), 0);
+    } else if (!g_applied_config.core_list.empty()) {
+        ppl::kernel::x86::reset_omp_core_binding();
+    }
+
+    g_applied_config.thread_num = thread_num_;
+    g_applied_config.core_list = core_list_;
+    return RC_SUCCESS;
+}
+
+}}} // namespace ppl::nn::x86
@@ -20,6 +20,7 @@
 
 #include "ppl/nn/engines/x86/runtime_x86_device.h"
 #include "ppl/nn/engines/engine_context.h"
+#include <vector>
 
 namespace ppl { namespace nn { namespace x86 {
 
@@ -27,7 +28,9 @@ namespace ppl { namespace nn { namespace x86 {
 
 class X86EngineContext final : public EngineContext {
 public:
-    X86EngineContext(ppl::common::isa_t isa, uint32_t mm_policy) : device_(X86_DEFAULT_ALIGNMENT, isa, mm_policy) {}
+    X86EngineContext(ppl::common::isa_t isa, uint32_t mm_policy, uint32_t thread_num = 0,
+                     const std::vector<int32_t>& core_list = {}, int32_t numa_node_id = -1)
+        : device_(X86_DEFAULT_ALIGNMENT, isa, mm_policy, numa_node_id), thread_num_(thread_num), core_list_(core_list) {}
 
     Device* GetDevice() override {
         return &device_;
@@ -37,8 +40,13 @@ public:
         return "x86";
     }
 
+    /** @brief applies thread number and core binding of this context to the calling thread. */
+    ppl::common::RetCode BeforeRun(const ir::GraphTopo*, RuntimeGraphResource*) override;
+
 private:
     RuntimeX86Device device_;
+    uint32_t thread_num_;
+    std::vector<int32_t> core_list_;
 };
 
 }}} // namespace ppl::nn::x86
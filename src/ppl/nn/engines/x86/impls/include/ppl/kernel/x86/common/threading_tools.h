@@ -31,8 +31,14 @@ namespace ppl { namespace kernel { namespace x86 {
 */
 void set_omp_core_binding(const int32_t *cores, const int32_t num_cores, const int32_t mode);
 
+// restores the cpu affinity of the process, which is recorded at startup, to threads of parallel regions
+void reset_omp_core_binding();
+
 int32_t get_omp_max_threads();
 
+// sets the number of threads of parallel regions started by the calling thread
+void set_omp_num_threads(const int32_t num_threads);
+
 template<typename T1, typename T2>
 void parallel_task_distribution_1d(
     const T1 thread_id,
@@ -90,8 +90,10 @@ public:
     static const conv2d_fp32_algo_t DEPTHWISE       = 3;
     static const conv2d_fp32_algo_t IM2COL_GEMM     = 4;
     static const conv2d_fp32_algo_t DIRECT          = 5;
+    static const conv2d_fp32_algo_t SPARSE          = 6;
     static const conv2d_fp32_algo_t WINOGRAD_B2F3   = 32;
     static const conv2d_fp32_algo_t WINOGRAD_B4F3   = 33;
+    static const conv2d_fp32_algo_t WINOGRAD_B6F3   = 34;
     static const conv2d_fp32_algo_t GEMM_DIRECT_V2  = 61;
     static const conv2d_fp32_algo_t DIRECT_V2       = 62;
 };
@@ -346,8 +348,12 @@ public:
 
 class conv2d_algo_selector {
 public:
-    static conv2d_fp32_algo_info select_algo(const ppl::common::dataformat_t src_format, const conv2d_fp32_param &param, const ppl::common::isa_t isa_flags);
+    // filter is optional, sparse algorithms are only considered when it is given
+    static conv2d_fp32_algo_info select_algo(const ppl::common::dataformat_t src_format, const conv2d_fp32_param &param, const ppl::common::isa_t isa_flags, const float *filter = nullptr);
     static conv2d_fp32_manager *gen_algo(const conv2d_fp32_param &param, const conv2d_fp32_algo_info &algo_info, ppl::common::Allocator *allocator);
+    // estimated time of running n16cx DIRECT, WINOGRAD_B4F3 or WINOGRAD_B6F3 on the given output shape, in cycles.
+    // meant for choosing among these algorithms for the same conv. returns FLT_MAX for other algorithms.
+    static float estimate_cost(const conv2d_fp32_param &param, const conv2d_fp32_algo_t algo_type, const ppl::common::isa_t isa, const int64_t batch, const int64_t dst_h, const int64_t dst_w, const int64_t num_threads);
 };
 
 }}}; // namespace ppl::kernel::x86
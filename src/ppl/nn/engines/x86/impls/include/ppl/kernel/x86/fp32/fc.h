@@ -26,18 +26,30 @@
 
 namespace ppl { namespace kernel { namespace x86 {
 
+typedef uint32_t fc_weight_compression_t;
+
+class fc_weight_compression {
+public:
+    static const fc_weight_compression_t NONE = 0;
+    static const fc_weight_compression_t FP16 = 1; // ieee half precision
+    static const fc_weight_compression_t INT8 = 2; // symmetric, one scale for each output channel
+};
+
 struct fc_fp32_param {
     int64_t channels;
     int64_t num_output;
     fc_fuse_flag_t fuse_flag;
+    fc_weight_compression_t weight_compression;
 };
 
 typedef uint32_t fc_fp32_algo_t;
 
 class fc_fp32_algo {
 public:
-    static const fc_fp32_algo_t UNKNOWN  = 0;
-    static const fc_fp32_algo_t STANDARD = 1;
+    static const fc_fp32_algo_t UNKNOWN    = 0;
+    static const fc_fp32_algo_t STANDARD   = 1;
+    static const fc_fp32_algo_t SPARSE     = 2;
+    static const fc_fp32_algo_t COMPRESSED = 3;
 };
 
 struct fc_fp32_algo_info {
@@ -262,7 +274,8 @@ public:
 
 class fc_algo_selector {
 public:
-    static fc_fp32_algo_info select_algo(const ppl::common::dataformat_t &src_format, const fc_fp32_param &param, const ppl::common::isa_t &isa_flags);
+    // filter is optional, sparse algorithms are only considered when it is given
+    static fc_fp32_algo_info select_algo(const ppl::common::dataformat_t &src_format, const fc_fp32_param &param, const ppl::common::isa_t &isa_flags, const float *filter = nullptr);
     static fc_fp32_manager *gen_algo(const fc_fp32_param &param, const fc_fp32_algo_info &algo_info, ppl::common::Allocator *allocator);
 };
 
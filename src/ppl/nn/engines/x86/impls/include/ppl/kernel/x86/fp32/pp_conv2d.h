@@ -0,0 +1,240 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef __ST_PPL_KERNEL_X86_FP32_PP_CONV2D_H_
+#define __ST_PPL_KERNEL_X86_FP32_PP_CONV2D_H_
+
+#include "ppl/kernel/x86/common/general_include.h"
+#include "ppl/kernel/x86/fp32/conv2d.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+typedef uint32_t pp_conv2d_fp32_algo_t;
+typedef uint32_t pp_conv2d_fp32_mode_t;
+
+class pp_conv2d_fp32_algo {
+public:
+    static const pp_conv2d_fp32_algo_t UNKNOWN = 0;
+    static const pp_conv2d_fp32_algo_t DIRECT  = 1;
+};
+
+class pp_conv2d_fp32_mode {
+public:
+    static const pp_conv2d_fp32_mode_t UNKNOWN  = 0;
+    static const pp_conv2d_fp32_mode_t FUSE     = 1;
+    static const pp_conv2d_fp32_mode_t SEPARATE = 2;
+};
+
+struct pp_conv2d_fp32_algo_info {
+    pp_conv2d_fp32_algo_t algo_type;
+    ppl::common::isa_t isa;
+    ppl::common::dataformat_t input_format;
+    ppl::common::dataformat_t output_format;
+};
+
+// 2d pooling applied on conv output, dilation is always 1 and pads are symmetric.
+// mode is ppl::nn::onnx::PoolingParam::pooling_mode_t, ceil_mode is not supported.
+struct pp_conv2d_pooling_param {
+    int64_t mode;
+    int64_t kernel_h;
+    int64_t kernel_w;
+    int64_t stride_h;
+    int64_t stride_w;
+    int64_t pad_h;
+    int64_t pad_w;
+};
+
+class pp_conv2d_fp32_executor {
+protected:
+    conv2d_fp32_executor *conv2d_executor_;
+    const pp_conv2d_pooling_param *pooling_param_;
+    pp_conv2d_fp32_mode_t mode_; // available after prepare()
+    ppl::nn::TensorShape inter_shape_; // available after prepare()
+
+    const float *src_;
+    const ppl::nn::TensorShape *src_shape_;
+    float *dst_;
+    const ppl::nn::TensorShape *dst_shape_;
+
+    void *temp_buffer_;
+
+public:
+    pp_conv2d_fp32_executor()
+        : conv2d_executor_(nullptr)
+        , pooling_param_(nullptr)
+        , mode_(pp_conv2d_fp32_mode::UNKNOWN)
+        , src_(nullptr)
+        , src_shape_(nullptr)
+        , dst_(nullptr)
+        , dst_shape_(nullptr)
+        , temp_buffer_(nullptr) {}
+    pp_conv2d_fp32_executor(conv2d_fp32_executor *exec, const pp_conv2d_pooling_param *pooling_param)
+        : conv2d_executor_(exec)
+        , pooling_param_(pooling_param)
+        , mode_(pp_conv2d_fp32_mode::UNKNOWN)
+        , src_(nullptr)
+        , src_shape_(nullptr)
+        , dst_(nullptr)
+        , dst_shape_(nullptr)
+        , temp_buffer_(nullptr) {}
+
+    virtual uint64_t cal_temp_buffer_size() = 0;
+    virtual ppl::common::RetCode prepare() = 0;
+    virtual ppl::common::RetCode execute() = 0;
+    virtual ~pp_conv2d_fp32_executor() {}
+
+    pp_conv2d_fp32_mode_t mode() const {
+        return mode_;
+    }
+
+    const ppl::nn::TensorShape &inter_shape() const {
+        return inter_shape_;
+    }
+
+    void set_conv2d_executor(conv2d_fp32_executor *exec) {
+        conv2d_executor_ = exec;
+    }
+    conv2d_fp32_executor *conv2d_executor() const
+    {
+        return conv2d_executor_;
+    }
+
+    void set_pooling_param(const pp_conv2d_pooling_param *pooling_param)
+    {
+        pooling_param_ = pooling_param;
+    }
+    const pp_conv2d_pooling_param *pooling_param() const
+    {
+        return pooling_param_;
+    }
+
+    void set_src(const float *src)
+    {
+        src_ = src;
+    }
+    const float *src() const
+    {
+        return src_;
+    }
+
+    void set_src_shape(const ppl::nn::TensorShape *src_shape)
+    {
+        src_shape_ = src_shape;
+    }
+    const ppl::nn::TensorShape *src_shape() const
+    {
+        return src_shape_;
+    }
+
+    void set_dst(float *dst)
+    {
+        dst_ = dst;
+    }
+    float *dst() const
+    {
+        return dst_;
+    }
+
+    void set_dst_shape(const ppl::nn::TensorShape *dst_shape)
+    {
+        dst_shape_ = dst_shape;
+    }
+    const ppl::nn::TensorShape *dst_shape() const
+    {
+        return dst_shape_;
+    }
+
+    void set_temp_buffer(void *temp_buffer)
+    {
+        temp_buffer_ = temp_buffer;
+    }
+    void *temp_buffer() const
+    {
+        return temp_buffer_;
+    }
+};
+
+class pp_conv2d_fp32_manager {
+protected:
+    conv2d_fp32_manager *conv2d_manager_;
+    pp_conv2d_pooling_param pooling_param_;
+
+public:
+    pp_conv2d_fp32_manager() : conv2d_manager_(nullptr) {};
+    pp_conv2d_fp32_manager(conv2d_fp32_manager *mgr, const pp_conv2d_pooling_param &pooling_param)
+    {
+        this->conv2d_manager_ = mgr;
+        this->pooling_param_ = pooling_param;
+    }
+
+    virtual pp_conv2d_fp32_executor *gen_executor() = 0;
+
+    void set_conv2d_manager(conv2d_fp32_manager *mgr)
+    {
+        conv2d_manager_ = mgr;
+    }
+    conv2d_fp32_manager *conv2d_manager()
+    {
+        return conv2d_manager_;
+    }
+
+    void set_pooling_param(const pp_conv2d_pooling_param &pooling_param)
+    {
+        pooling_param_ = pooling_param;
+    }
+    const pp_conv2d_pooling_param &pooling_param() const
+    {
+        return pooling_param_;
+    }
+
+    ppl::common::RetCode gen_cvt_weights(const float *filter, const float *bias)
+    {
+        if (conv2d_manager_) {
+            return conv2d_manager_->gen_cvt_weights(filter, bias);
+        }
+        return ppl::common::RC_OTHER_ERROR;
+    }
+
+    void release_cvt_weights()
+    {
+        if (conv2d_manager_) conv2d_manager_->release_cvt_weights();
+    }
+
+    virtual ~pp_conv2d_fp32_manager() {};
+};
+
+// Post-Pooling Conv2d
+class pp_conv2d_algo_selector {
+public:
+    static pp_conv2d_fp32_algo_info select_algo(
+        const conv2d_fp32_algo_info &algo,
+        const conv2d_fp32_param &param,
+        const pp_conv2d_pooling_param &pooling_param);
+    static pp_conv2d_fp32_manager *gen_algo(
+        const conv2d_fp32_param &param,
+        const pp_conv2d_pooling_param &pooling_param,
+        const pp_conv2d_fp32_algo_info &algo_info,
+        ppl::common::Allocator *allocator);
+    static pp_conv2d_fp32_manager *gen_algo(
+        const pp_conv2d_fp32_algo_info &algo_info,
+        const pp_conv2d_pooling_param &pooling_param,
+        conv2d_fp32_manager *mgr);
+};
+
+}}};
+
+#endif
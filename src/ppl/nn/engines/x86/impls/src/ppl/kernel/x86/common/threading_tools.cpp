@@ -20,6 +20,8 @@
 #define _GNU_SOURCE
 #endif
 #include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
 #endif
 
 #include "ppl/kernel/x86/common/threading_tools.h"
@@ -51,10 +53,47 @@ void set_omp_core_binding(const int32_t *cores, const int32_t num_cores, const i
 #endif
 }
 
+#if defined(__linux__)
+static cpu_set_t get_process_cpuset()
+{
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    if (sched_getaffinity(0, sizeof(cpuset), &cpuset) != 0) {
+        const int64_t num_cpus = sysconf(_SC_NPROCESSORS_CONF);
+        for (int64_t i = 0; i < num_cpus && i < CPU_SETSIZE; ++i) {
+            CPU_SET(i, &cpuset);
+        }
+    }
+    return cpuset;
+}
+
+// recorded before any thread is bound
+static const cpu_set_t g_process_cpuset = get_process_cpuset();
+#endif
+
+void reset_omp_core_binding()
+{
+#if defined(__linux__)
+    PRAGMA_OMP_PARALLEL()
+    {
+        if (pthread_setaffinity_np(pthread_self(), sizeof(g_process_cpuset), &g_process_cpuset) != 0) {
+            LOG(ERROR) << "Resetting core binding failed";
+        }
+    }
+#endif
+}
+
 int32_t get_omp_max_threads()
 {
     return PPL_OMP_MAX_THREADS();
 }
+
+void set_omp_num_threads(const int32_t num_threads)
+{
+#ifdef PPL_USE_X86_OMP
+    omp_set_num_threads(num_threads);
+#endif
+}
 // A very naive version
 single_parallel_loop_config_t select_single_parallel_loop(
     const std::vector<int64_t> &iter_of_loop,
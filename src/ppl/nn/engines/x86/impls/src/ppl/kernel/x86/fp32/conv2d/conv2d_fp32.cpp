@@ -16,15 +16,18 @@
 // under the License.
 
 #include <new>
+#include <float.h>
 
 #include "ppl/kernel/x86/fp32/conv2d.h"
 
 #include "ppl/kernel/x86/fp32/conv2d/gemm_direct/fma/conv2d_n16cx_gemm_direct_fp32_fma.h"
 #include "ppl/kernel/x86/fp32/conv2d/winograd/fma/conv2d_n16cx_winograd_b4f3_fp32_fma.h"
+#include "ppl/kernel/x86/fp32/conv2d/winograd/fma/conv2d_n16cx_winograd_b6f3_fp32_fma.h"
 #include "ppl/kernel/x86/fp32/conv2d/depthwise/fma/conv2d_n16cx_depthwise_fp32_fma.h"
 #include "ppl/kernel/x86/fp32/conv2d/im2col_gemm/fma/conv2d_im2col_gemm_fp32_fma.h"
 #include "ppl/kernel/x86/fp32/conv2d/direct_ndarray/fma/conv2d_n16cx_direct_ndarray_fp32_fma.h"
 #include "ppl/kernel/x86/fp32/conv2d/direct/fma/conv2d_n16cx_direct_fp32_fma.h"
+#include "ppl/kernel/x86/fp32/conv2d/sparse/conv2d_n16cx_sparse_fp32.h"
 
 #ifdef PPL_USE_X86_AVX512
 #include "ppl/kernel/x86/fp32/conv2d/direct/avx512/conv2d_n16cx_direct_fp32_avx512.h"
@@ -32,6 +35,7 @@
 #include "ppl/kernel/x86/fp32/conv2d/depthwise/avx512/conv2d_n16cx_depthwise_fp32_avx512.h"
 #include "ppl/kernel/x86/fp32/conv2d/direct_ndarray/avx512/conv2d_n16cx_direct_ndarray_fp32_avx512.h"
 #include "ppl/kernel/x86/fp32/conv2d/winograd/avx512/conv2d_n16cx_winograd_b4f3_fp32_avx512.h"
+#include "ppl/kernel/x86/fp32/conv2d/winograd/avx512/conv2d_n16cx_winograd_b6f3_fp32_avx512.h"
 #endif
 
 #include "ppl/kernel/x86/fp32/conv2d/direct/sse/conv2d_n8cx_direct_fp32_sse.h"
@@ -130,7 +134,7 @@ ppl::common::RetCode conv2d_fp32_ref(
     return ppl::common::RC_SUCCESS;
 }
 
-conv2d_fp32_algo_info conv2d_algo_selector::select_algo(const ppl::common::dataformat_t src_format, const conv2d_fp32_param &param, const ppl::common::isa_t isa_flags)
+conv2d_fp32_algo_info conv2d_algo_selector::select_algo(const ppl::common::dataformat_t src_format, const conv2d_fp32_param &param, const ppl::common::isa_t isa_flags, const float *filter)
 {
     static conv2d_fp32_algo_info unknown_info = {
         conv2d_fp32_algo::UNKNOWN,
@@ -179,6 +183,14 @@ conv2d_fp32_algo_info conv2d_algo_selector::select_algo(const ppl::common::dataf
             }
         }
 
+        if (conv2d_n16cx_sparse_fp32_manager::is_profitable(param, filter, ppl::common::ISA_X86_AVX512)) {
+            return {
+                conv2d_fp32_algo::SPARSE,
+                ppl::common::ISA_X86_AVX512,
+                ppl::common::DATAFORMAT_N16CX,
+                ppl::common::DATAFORMAT_N16CX};
+        }
+
         if (param.is_pointwise()) {
             auto gd_mgr    = new conv2d_n16cx_gemm_direct_fp32_avx512_manager(param, nullptr);
             bool supported = gd_mgr->is_supported();
@@ -252,6 +264,14 @@ conv2d_fp32_algo_info conv2d_algo_selector::select_algo(const ppl::common::dataf
             }
         }
 
+        if (conv2d_n16cx_sparse_fp32_manager::is_profitable(param, filter, ppl::common::ISA_X86_FMA)) {
+            return {
+                conv2d_fp32_algo::SPARSE,
+                ppl::common::ISA_X86_FMA,
+                ppl::common::DATAFORMAT_N16CX,
+                ppl::common::DATAFORMAT_N16CX};
+        }
+
         if (param.is_pointwise()) {
             auto gd_mgr    = new conv2d_n16cx_gemm_direct_fp32_fma_manager(param, nullptr);
             bool supported = gd_mgr->is_supported();
@@ -321,6 +341,11 @@ conv2d_fp32_algo_info conv2d_algo_selector::select_algo(const ppl::common::dataf
 
 conv2d_fp32_manager *conv2d_algo_selector::gen_algo(const conv2d_fp32_param &param, const conv2d_fp32_algo_info &algo_info, ppl::common::Allocator *allocator)
 {
+    if (algo_info.algo_type == conv2d_fp32_algo::SPARSE &&
+        algo_info.input_format == ppl::common::DATAFORMAT_N16CX &&
+        algo_info.output_format == ppl::common::DATAFORMAT_N16CX) {
+        return new conv2d_n16cx_sparse_fp32_manager(param, allocator, algo_info.isa);
+    }
     if (algo_info.algo_type == conv2d_fp32_algo::GEMM_DIRECT &&
         algo_info.isa == ppl::common::ISA_X86_FMA &&
         algo_info.input_format == ppl::common::DATAFORMAT_N16CX &&
@@ -339,6 +364,12 @@ conv2d_fp32_manager *conv2d_algo_selector::gen_algo(const conv2d_fp32_param &par
         algo_info.output_format == ppl::common::DATAFORMAT_N16CX) {
         return new conv2d_n16cx_winograd_b4f3_fp32_fma_manager(param, allocator);
     }
+    if (algo_info.algo_type == conv2d_fp32_algo::WINOGRAD_B6F3 &&
+        algo_info.isa == ppl::common::ISA_X86_FMA &&
+        algo_info.input_format == ppl::common::DATAFORMAT_N16CX &&
+        algo_info.output_format == ppl::common::DATAFORMAT_N16CX) {
+        return new conv2d_n16cx_winograd_b6f3_fp32_fma_manager(param, allocator);
+    }
     if (algo_info.algo_type == conv2d_fp32_algo::DIRECT &&
         algo_info.isa == ppl::common::ISA_X86_FMA &&
         algo_info.input_format == ppl::common::DATAFORMAT_N16CX &&
@@ -364,6 +395,12 @@ conv2d_fp32_manager *conv2d_algo_selector::gen_algo(const conv2d_fp32_param &par
         algo_info.output_format == ppl::common::DATAFORMAT_N16CX) {
         return new conv2d_n16cx_winograd_b4f3_fp32_avx512_manager(param, allocator);
     }
+    if (algo_info.algo_type == conv2d_fp32_algo::WINOGRAD_B6F3 &&
+        algo_info.isa == ppl::common::ISA_X86_AVX512 &&
+        algo_info.input_format == ppl::common::DATAFORMAT_N16CX &&
+        algo_info.output_format == ppl::common::DATAFORMAT_N16CX) {
+        return new conv2d_n16cx_winograd_b6f3_fp32_avx512_manager(param, allocator);
+    }
     if (algo_info.algo_type == conv2d_fp32_algo::DIRECT &&
         algo_info.isa == ppl::common::ISA_X86_AVX512 &&
         algo_info.input_format == ppl::common::DATAFORMAT_N16CX &&
@@ -429,4 +466,147 @@ conv2d_fp32_manager *conv2d_algo_selector::gen_algo(const conv2d_fp32_param &par
     return nullptr;
 }
 
+/*
+  constants of the conv cost model. the efficiencies and the filter bandwidth are calibrated with test_conv2d on
+  3x3 stride 1 convs(16~512 channels, 2x2~56x56 outputs, some grouped or batched) running on a single core, for
+  both avx512 and fma kernels.
+*/
+// two fma ports and two load ports per core on haswell and later
+static const float CONV_COST_FMA_PER_CYCLE = 2.0f;
+static const float CONV_COST_LOAD_PER_CYCLE = 2.0f;
+// cycles before an accumulator can take the next fma, which bounds register blocks with few accumulators
+static const float CONV_COST_FMA_LATENCY = 4.0f;
+// filter bytes streamed per cycle. not scaled with threads, so it also stands for a saturated memory bandwidth.
+// small outputs are bound by reading the filter, which winograd makes 4x(b4f3) or 7.1x(b6f3) larger than direct.
+static const float CONV_COST_FILTER_BYTES_PER_CYCLE = 8.0f;
+// fraction of the register block throughput reached by the winograd gemm, leaving room for loads/stores
+static const float WINOGRAD_COST_GEMM_EFFICIENCY = 0.9f;
+// same for the direct kernel, which also reloads the source of each filter tap
+static const float DIRECT_COST_EFFICIENCY = 0.6f;
+// transformed tiles of one register block are expected to stay in this fraction of L2, the rest holds the filter
+static const float WINOGRAD_COST_L2_TILE_RATIO = 0.5f;
+// extra gemm time per L2 size of transformed tiles, which are streamed from L3 when they do not fit
+static const float WINOGRAD_COST_L2_MISS_PENALTY = 0.25f;
+// used when the L2 size is not reported by cpuid
+static const uint64_t WINOGRAD_COST_DEFAULT_L2_BYTES = 256 * 1024;
+
+// cycles of one input channel step of a register block with `oc_regs` x `cols` accumulators. it is bound by fmas,
+// by loads of `oc_regs` filter vectors plus `cols` broadcasts, or by the fma latency.
+static float register_block_cycles(const int64_t oc_regs, const int64_t cols)
+{
+    if (cols == 0) {
+        return 0.0f;
+    }
+    return max(max(oc_regs * cols / CONV_COST_FMA_PER_CYCLE, (oc_regs + cols) / CONV_COST_LOAD_PER_CYCLE), CONV_COST_FMA_LATENCY);
+}
+
+// `cols` columns(output pixels for direct, tiles for winograd) in register blocks of `kr_blk` and a tail block
+static float row_cycles(const int64_t oc_regs, const int64_t cols, const int64_t kr_blk)
+{
+    return (cols / kr_blk) * register_block_cycles(oc_regs, kr_blk) + register_block_cycles(oc_regs, cols % kr_blk);
+}
+
+float conv2d_algo_selector::estimate_cost(
+    const conv2d_fp32_param &param,
+    const conv2d_fp32_algo_t algo_type,
+    const ppl::common::isa_t isa,
+    const int64_t batch,
+    const int64_t dst_h,
+    const int64_t dst_w,
+    const int64_t num_threads)
+{
+    const int64_t ch_blk    = 16;
+    const bool is_avx512    = (isa & ppl::common::ISA_X86_AVX512) != 0;
+    const int64_t simd_w    = is_avx512 ? 16 : 8;
+    const int64_t ic_per_gp = round_up(param.channels / param.group, ch_blk);
+    const int64_t oc_per_gp = round_up(param.num_output / param.group, ch_blk);
+    const int64_t threads   = max<int64_t>(num_threads, 1);
+
+    // fraction of the threads kept busy when `tasks` equal tasks are spread over them
+    auto parallel_eff = [threads](const int64_t tasks) -> float {
+        return (float)tasks / round_up(max<int64_t>(tasks, 1), threads);
+    };
+
+    if (algo_type == conv2d_fp32_algo::DIRECT) {
+        // register blocks chosen by the n16cx direct executors
+        int64_t oc_kr_blk = ch_blk;
+        int64_t ow_kr_blk = min<int64_t>(dst_w, 6);
+        if (is_avx512) {
+            static const int64_t oc2ow_table[4]  = {14, 14, 9, 6};
+            static const int64_t ow2oc_table[14] = {4, 4, 4, 4, 4, 4, 3, 3, 3, 2, 2, 2, 2, 2};
+            if (oc_per_gp <= 4 * ch_blk) {
+                oc_kr_blk = oc_per_gp;
+                ow_kr_blk = min<int64_t>(dst_w, oc2ow_table[oc_per_gp / ch_blk - 1]);
+            } else {
+                ow_kr_blk = min<int64_t>(dst_w, 14);
+                oc_kr_blk = ow2oc_table[ow_kr_blk - 1] * ch_blk;
+            }
+        }
+
+        // taps reading the padding are skipped in height only, as the source is padded in width for small outputs
+        const int64_t ext_kernel_h = (param.kernel_h - 1) * param.dilation_h + 1;
+        const int64_t src_h        = (dst_h - 1) * param.stride_h + ext_kernel_h - 2 * param.pad_h;
+        int64_t taps_h             = 0;
+        for (int64_t oh = 0; oh < dst_h; ++oh) {
+            for (int64_t kh = 0; kh < param.kernel_h; ++kh) {
+                const int64_t ih = oh * param.stride_h - param.pad_h + kh * param.dilation_h;
+                taps_h += (ih >= 0 && ih < src_h) ? 1 : 0;
+            }
+        }
+
+        const float kernel_cost  = (float)batch * param.channels * div_up(oc_per_gp, oc_kr_blk) * taps_h * param.kernel_w *
+            row_cycles(oc_kr_blk / simd_w, dst_w, ow_kr_blk) / DIRECT_COST_EFFICIENCY;
+        const float filter_bytes = (float)param.group * ic_per_gp * oc_per_gp * param.kernel_h * param.kernel_w * sizeof(float);
+
+        // split over groups, batches, blocks of 64 output channels and output rows
+        const int64_t tasks = param.group * batch * div_up(oc_per_gp, 4 * ch_blk) * dst_h;
+        return max(kernel_cost / (threads * parallel_eff(tasks)), filter_bytes / CONV_COST_FILTER_BYTES_PER_CYCLE);
+    }
+
+    int64_t tile_out;
+    float src_trans_ops; // vector ops of a 1-D input transform
+    float dst_trans_ops; // vector ops of a 1-D output transform
+    if (algo_type == conv2d_fp32_algo::WINOGRAD_B4F3) {
+        tile_out      = 4;
+        src_trans_ops = 14;
+        dst_trans_ops = 10;
+    } else if (algo_type == conv2d_fp32_algo::WINOGRAD_B6F3) {
+        tile_out      = 6;
+        src_trans_ops = 24;
+        dst_trans_ops = 18;
+    } else {
+        return FLT_MAX;
+    }
+
+    const int64_t tile_in   = tile_out + 2;
+    const int64_t kr_blk    = is_avx512 ? 14 : 6; // tiles held in registers by the gemm kernel
+    const int64_t oc_kr_blk = 2 * simd_w;
+    const int64_t tiles     = batch * div_up(dst_h, tile_out) * div_up(dst_w, tile_out);
+
+    // a (tiles x ic) by (ic x oc) gemm for each of the tile_in x tile_in points
+    const float gemm_cost = (float)param.group * tile_in * tile_in * ic_per_gp * div_up(oc_per_gp, oc_kr_blk) *
+        row_cycles(oc_kr_blk / simd_w, tiles, kr_blk) / WINOGRAD_COST_GEMM_EFFICIENCY;
+
+    // 2-D transform = tile_in row passes + tile_in/tile_out column passes, one vector per 16 channels per pass
+    const float vec_per_ch_blk = (float)ch_blk / simd_w;
+    const float src_trans_cost = (float)param.group * tiles * (ic_per_gp / ch_blk) * vec_per_ch_blk * 2 * tile_in * src_trans_ops;
+    const float dst_trans_cost = (float)param.group * tiles * (oc_per_gp / ch_blk) * vec_per_ch_blk * (tile_in + tile_out) * dst_trans_ops;
+
+    // transformed tiles of one register block are reused from L2 across all output channels
+    const uint64_t l2_bytes  = ppl::common::GetCpuCacheL2() == 0 ? WINOGRAD_COST_DEFAULT_L2_BYTES : ppl::common::GetCpuCacheL2();
+    const uint64_t blk_bytes = (uint64_t)tile_in * tile_in * kr_blk * min<int64_t>(ic_per_gp, 16 * ch_blk) * sizeof(float);
+    const float l2_penalty   = blk_bytes > l2_bytes * WINOGRAD_COST_L2_TILE_RATIO
+        ? 1.0f + WINOGRAD_COST_L2_MISS_PENALTY * blk_bytes / l2_bytes
+        : 1.0f;
+
+    const float filter_bytes = (float)param.group * ic_per_gp * oc_per_gp * tile_in * tile_in * sizeof(float);
+
+    // the gemm is split over tile and output channel blocks, transforms over tiles and channel blocks
+    const int64_t gemm_tasks  = param.group * div_up(tiles, kr_blk) * div_up(oc_per_gp, oc_kr_blk);
+    const int64_t trans_tasks = param.group * tiles * (ic_per_gp / ch_blk);
+    const float compute_cost  = gemm_cost * l2_penalty / (threads * parallel_eff(gemm_tasks)) +
+        (src_trans_cost + dst_trans_cost) / (threads * parallel_eff(trans_tasks));
+    return max(compute_cost, filter_bytes / CONV_COST_FILTER_BYTES_PER_CYCLE);
+}
+
 }}}; // namespace ppl::kernel::x86
@@ -0,0 +1,219 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <string.h>
+
+#include "ppl/kernel/x86/fp32/conv2d/sparse/conv2d_n16cx_sparse_fp32.h"
+#include "ppl/kernel/x86/fp32/conv2d/sparse/conv2d_n16cx_sparse_kernel_fp32.h"
+#include "ppl/kernel/x86/common/array_param_helper.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+static const int64_t IC_DATA_BLK = conv2d_n16cx_sparse_kernel_fp32::config::IC_DATA_BLK;
+static const int64_t OC_DATA_BLK = conv2d_n16cx_sparse_kernel_fp32::config::OC_DATA_BLK;
+
+static const int64_t S_L2_BLK_MAX = 8;
+// dense gemm_direct is much faster with avx512, so it needs sparser weights to win.
+// both are inclusive and need no epsilon: cal_block_density() rounds like the literals.
+static const float FMA_MAX_BLOCK_DENSITY    = 0.3f;
+static const float AVX512_MAX_BLOCK_DENSITY = 0.2f;
+
+void conv2d_n16cx_sparse_fp32_executor::cal_kernel_tunning_param()
+{
+    const conv2d_fp32_param &cp = *conv_param_;
+    kernel_schedule_param &sp   = schedule_param_;
+
+    const int64_t dst_h = dst_shape_->GetDim(2);
+    const int64_t dst_w = dst_shape_->GetDim(3);
+
+    sp.padded_oc = round_up(cp.num_output, OC_DATA_BLK);
+    if (cp.stride_h == 1 && cp.stride_w == 1) {
+        sp.rows    = 1;
+        sp.row_len = dst_h * dst_w;
+    } else {
+        sp.rows    = dst_h;
+        sp.row_len = dst_w;
+    }
+
+    sp.s_ker_blk = conv2d_n16cx_sparse_kernel_fp32::max_s_regs(isa_);
+    // input pixels of one l2 block are shared by all output channel blocks
+    sp.s_l2_blk  = min(sp.row_len, S_L2_BLK_MAX * sp.s_ker_blk);
+}
+
+uint64_t conv2d_n16cx_sparse_fp32_executor::cal_temp_buffer_size()
+{
+    return 0;
+}
+
+ppl::common::RetCode conv2d_n16cx_sparse_fp32_executor::prepare()
+{
+    if (!conv_param_ || !src_shape_ || !dst_shape_ || ((conv_param_->fuse_flag & conv_fuse_flag::SUM) && !sum_src_shape_)) {
+        return ppl::common::RC_INVALID_VALUE;
+    }
+
+    cal_kernel_tunning_param();
+
+    return ppl::common::RC_SUCCESS;
+}
+
+ppl::common::RetCode conv2d_n16cx_sparse_fp32_executor::execute()
+{
+    if (!conv_param_ || !cvt_filter_ || !cvt_bias_ || !src_ || !dst_ || ((conv_param_->fuse_flag & conv_fuse_flag::SUM) && !sum_src_)) {
+        return ppl::common::RC_INVALID_VALUE;
+    }
+
+    const conv2d_fp32_param &cp     = *conv_param_;
+    const kernel_schedule_param &sp = schedule_param_;
+
+    const int64_t batch     = src_shape_->GetDim(0);
+    const int64_t src_h     = src_shape_->GetDim(2);
+    const int64_t src_w     = src_shape_->GetDim(3);
+    const int64_t dst_w     = dst_shape_->GetDim(3);
+    const int64_t dst_space = dst_shape_->GetDim(2) * dst_w;
+
+    const int64_t src_icb_stride = src_h * src_w * IC_DATA_BLK;
+    const int64_t src_b_stride   = round_up(src_shape_->GetDim(1), IC_DATA_BLK) * src_h * src_w;
+    const int64_t src_row_stride = cp.stride_h * src_w * IC_DATA_BLK;
+    const int64_t src_s_stride   = cp.stride_w * IC_DATA_BLK;
+    const int64_t dst_ocb_stride = dst_space * OC_DATA_BLK;
+    const int64_t dst_b_stride   = round_up(dst_shape_->GetDim(1), OC_DATA_BLK) * dst_space;
+
+    const bool with_sum   = cp.fuse_flag & conv_fuse_flag::SUM;
+    const bool with_relu  = cp.fuse_flag & conv_fuse_flag::RELU;
+    const bool with_relu6 = cp.fuse_flag & conv_fuse_flag::RELU6;
+
+    int64_t sum_src_b_stride = 0;
+    if (with_sum) {
+        sum_src_b_stride = round_up(sum_src_shape_->GetDim(1), OC_DATA_BLK) * dst_space;
+    }
+
+    uint64_t kernel_flags = 0;
+    if (with_sum) {
+        kernel_flags |= conv2d_n16cx_sparse_kernel_fp32::flag::ADD_HIS;
+    }
+    if (with_relu) {
+        kernel_flags |= conv2d_n16cx_sparse_kernel_fp32::flag::RELU;
+    } else if (with_relu6) {
+        kernel_flags |= conv2d_n16cx_sparse_kernel_fp32::flag::RELU6;
+    }
+
+    const sparse_weights_fp32::view flt = sparse_weights_fp32::get_view(cvt_filter_, cp.num_output);
+
+    const int64_t num_ocb    = sp.padded_oc / OC_DATA_BLK;
+    const int64_t num_sl2    = div_up(sp.row_len, sp.s_l2_blk);
+    const int64_t num_tasks  = batch * sp.rows * num_sl2 * num_ocb;
+
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t t = 0; t < num_tasks; ++t) {
+        // output channel blocks are the innermost so that neighbour threads share the same input pixels
+        const int64_t ocb = t % num_ocb;
+        const int64_t sl2 = (t / num_ocb) % num_sl2 * sp.s_l2_blk;
+        const int64_t row = (t / (num_ocb * num_sl2)) % sp.rows;
+        const int64_t b   = t / (num_ocb * num_sl2 * sp.rows);
+
+        const int64_t sl2_eff = min(sp.row_len - sl2, sp.s_l2_blk);
+        const int64_t s_body  = round(sl2_eff, sp.s_ker_blk);
+        const int64_t s_tail  = sl2_eff - s_body;
+        const int64_t dst_s   = row * dst_w + sl2;
+
+        int64_t ker_param[conv2d_n16cx_sparse_kernel_fp32::param_def::LENGTH];
+        array_param_helper ker_p(ker_param);
+        conv2d_n16cx_sparse_kernel_fp32 ker(ker_param, isa_);
+
+        const float *l_src = src_ + b * src_b_stride + row * src_row_stride + sl2 * src_s_stride;
+        float *l_dst       = dst_ + b * dst_b_stride + ocb * dst_ocb_stride + dst_s * OC_DATA_BLK;
+        const float *l_his = l_dst;
+        if (with_sum) {
+            l_his = sum_src_ + b * sum_src_b_stride + ocb * dst_ocb_stride + dst_s * OC_DATA_BLK;
+        }
+
+        ker_p.pick<const float*>(conv2d_n16cx_sparse_kernel_fp32::param_def::FLT_PTR_IDX)   = flt.values + flt.blk_ptr[ocb] * OC_DATA_BLK;
+        ker_p.pick<const int32_t*>(conv2d_n16cx_sparse_kernel_fp32::param_def::IDX_PTR_IDX) = flt.ic_idx + flt.blk_ptr[ocb];
+        ker_p.pick<const float*>(conv2d_n16cx_sparse_kernel_fp32::param_def::BIAS_PTR_IDX)  = cvt_bias_ + ocb * OC_DATA_BLK;
+        ker_p.pick<int64_t>(conv2d_n16cx_sparse_kernel_fp32::param_def::BLOCKS_IDX)         = flt.blk_ptr[ocb + 1] - flt.blk_ptr[ocb];
+        ker_p.pick<int64_t>(conv2d_n16cx_sparse_kernel_fp32::param_def::SRC_ICB_STRIDE_IDX) = src_icb_stride;
+        ker_p.pick<int64_t>(conv2d_n16cx_sparse_kernel_fp32::param_def::SRC_S_STRIDE_IDX)   = src_s_stride;
+        ker_p.pick<int64_t>(conv2d_n16cx_sparse_kernel_fp32::param_def::HIS_S_STRIDE_IDX)   = OC_DATA_BLK;
+        ker_p.pick<int64_t>(conv2d_n16cx_sparse_kernel_fp32::param_def::DST_S_STRIDE_IDX)   = OC_DATA_BLK;
+        ker_p.pick<int64_t>(conv2d_n16cx_sparse_kernel_fp32::param_def::FLAGS_IDX)          = kernel_flags;
+
+        if (s_body) {
+            ker_p.pick<const float*>(conv2d_n16cx_sparse_kernel_fp32::param_def::SRC_PTR_IDX) = l_src;
+            ker_p.pick<const float*>(conv2d_n16cx_sparse_kernel_fp32::param_def::HIS_PTR_IDX) = l_his;
+            ker_p.pick<float*>(conv2d_n16cx_sparse_kernel_fp32::param_def::DST_PTR_IDX)       = l_dst;
+            ker_p.pick<int64_t>(conv2d_n16cx_sparse_kernel_fp32::param_def::SPACE_IDX)        = s_body;
+            ker.execute(sp.s_ker_blk);
+        }
+        if (s_tail) {
+            ker_p.pick<const float*>(conv2d_n16cx_sparse_kernel_fp32::param_def::SRC_PTR_IDX) = l_src + s_body * src_s_stride;
+            ker_p.pick<const float*>(conv2d_n16cx_sparse_kernel_fp32::param_def::HIS_PTR_IDX) = l_his + s_body * OC_DATA_BLK;
+            ker_p.pick<float*>(conv2d_n16cx_sparse_kernel_fp32::param_def::DST_PTR_IDX)       = l_dst + s_body * OC_DATA_BLK;
+            ker_p.pick<int64_t>(conv2d_n16cx_sparse_kernel_fp32::param_def::SPACE_IDX)        = s_tail;
+            ker.execute(s_tail);
+        }
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+ppl::common::RetCode conv2d_n16cx_sparse_fp32_manager::gen_cvt_weights(const float *filter, const float *bias)
+{
+    if (cvt_bias_ != nullptr || cvt_filter_ != nullptr) {
+        return ppl::common::RC_PERMISSION_DENIED;
+    }
+
+    const int64_t padded_oc = round_up(param_.num_output, OC_DATA_BLK);
+
+    cvt_bias_size_ = padded_oc;
+    cvt_bias_      = (float *)allocator_->Alloc(cvt_bias_size_ * sizeof(float));
+    if (cvt_bias_ == nullptr) {
+        return ppl::common::RC_OUT_OF_MEMORY;
+    }
+
+    memcpy(cvt_bias_, bias, param_.num_output * sizeof(float));
+    memset(cvt_bias_ + param_.num_output, 0, (padded_oc - param_.num_output) * sizeof(float));
+
+    cvt_filter_size_ = sparse_weights_fp32::cal_packed_size(filter, param_.num_output, param_.channels);
+    cvt_filter_size_ /= sizeof(float);
+    cvt_filter_ = (float *)allocator_->Alloc(cvt_filter_size_ * sizeof(float));
+    if (cvt_filter_ == nullptr) {
+        return ppl::common::RC_OUT_OF_MEMORY;
+    }
+
+    return sparse_weights_fp32::pack(filter, param_.num_output, param_.channels, cvt_filter_);
+}
+
+bool conv2d_n16cx_sparse_fp32_manager::is_supported()
+{
+    return param_.group == 1 && param_.is_pointwise();
+}
+
+bool conv2d_n16cx_sparse_fp32_manager::is_profitable(const conv2d_fp32_param &param, const float *filter, const ppl::common::isa_t isa)
+{
+    if (filter == nullptr || param.group != 1 || !param.is_pointwise()) {
+        return false;
+    }
+    const float max_density = (isa & ppl::common::ISA_X86_AVX512) ? AVX512_MAX_BLOCK_DENSITY : FMA_MAX_BLOCK_DENSITY;
+    return sparse_weights_fp32::cal_block_density(filter, param.num_output, param.channels) <= max_density;
+}
+
+conv2d_fp32_executor *conv2d_n16cx_sparse_fp32_manager::gen_executor()
+{
+    return new conv2d_n16cx_sparse_fp32_executor(&param_, cvt_filter_, cvt_bias_, isa_);
+}
+
+}}}; // namespace ppl::kernel::x86
@@ -0,0 +1,75 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef __ST_PPL_KERNEL_X86_FP32_CONV2D_SPARSE_CONV2D_N16CX_SPARSE_FP32_H_
+#define __ST_PPL_KERNEL_X86_FP32_CONV2D_SPARSE_CONV2D_N16CX_SPARSE_FP32_H_
+
+#include "ppl/kernel/x86/fp32/conv2d.h"
+#include "ppl/kernel/x86/common/internal_include.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+// forward declare;
+class conv2d_n16cx_sparse_fp32_manager;
+
+// pointwise convolution with block-CSR weights, for pruned models
+class conv2d_n16cx_sparse_fp32_executor final : public conv2d_fp32_executor {
+public:
+    conv2d_n16cx_sparse_fp32_executor() {}
+    conv2d_n16cx_sparse_fp32_executor(const conv2d_fp32_param *conv_param, const float *cvt_filter, const float *bias, const ppl::common::isa_t isa)
+        : conv2d_fp32_executor(conv_param, cvt_filter, bias)
+        , isa_(isa) {}
+    uint64_t cal_temp_buffer_size() override;
+    ppl::common::RetCode prepare() override;
+    ppl::common::RetCode execute() override;
+
+private:
+    struct kernel_schedule_param {
+        int64_t padded_oc;
+        int64_t s_ker_blk;
+        int64_t s_l2_blk;
+        int64_t rows;    // rows processed separately, 1 if output pixels are contiguous in the input
+        int64_t row_len; // pixels of each row
+    } schedule_param_;
+
+    ppl::common::isa_t isa_ = ppl::common::ISA_UNKNOWN;
+
+    void cal_kernel_tunning_param();
+
+    friend conv2d_n16cx_sparse_fp32_manager;
+};
+
+class conv2d_n16cx_sparse_fp32_manager final : public conv2d_fp32_manager {
+public:
+    conv2d_n16cx_sparse_fp32_manager() {}
+    conv2d_n16cx_sparse_fp32_manager(const conv2d_fp32_param &param, ppl::common::Allocator *allocator, const ppl::common::isa_t isa)
+        : conv2d_fp32_manager(param, allocator)
+        , isa_(isa) {}
+    bool is_supported() override;
+    ppl::common::RetCode gen_cvt_weights(const float *filter, const float *bias) override;
+    conv2d_fp32_executor *gen_executor() override;
+
+    // true if the filter is sparse enough to run faster than dense algorithms
+    static bool is_profitable(const conv2d_fp32_param &param, const float *filter, const ppl::common::isa_t isa);
+
+private:
+    ppl::common::isa_t isa_ = ppl::common::ISA_UNKNOWN;
+};
+
+}}}; // namespace ppl::kernel::x86
+
+#endif
@@ -0,0 +1,136 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <string.h>
+
+#include "ppl/kernel/x86/fp32/conv2d/sparse/conv2d_n16cx_sparse_kernel_fp32.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+static const int64_t PACKED_ALIGN_ELTS = 16;
+
+static inline bool is_zero_block(const float *filter, const int64_t channels, const int64_t oc_eff)
+{
+    for (int64_t oc = 0; oc < oc_eff; ++oc) {
+        if (filter[oc * channels] != 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static int64_t cal_num_blocks(const float *filter, const int64_t num_output, const int64_t channels)
+{
+    const int64_t OC_DATA_BLK = sparse_weights_fp32::OC_DATA_BLK;
+    int64_t num_blks          = 0;
+    for (int64_t ocb = 0; ocb < num_output; ocb += OC_DATA_BLK) {
+        const int64_t oc_eff = min(num_output - ocb, OC_DATA_BLK);
+        for (int64_t ic = 0; ic < channels; ++ic) {
+            if (!is_zero_block(filter + ocb * channels + ic, channels, oc_eff)) {
+                ++num_blks;
+            }
+        }
+    }
+    return num_blks;
+}
+
+float sparse_weights_fp32::cal_block_density(const float *filter, const int64_t num_output, const int64_t channels)
+{
+    const int64_t total_blks = div_up(num_output, OC_DATA_BLK) * channels;
+    if (total_blks == 0) {
+        return 1.0f;
+    }
+    return float(cal_num_blocks(filter, num_output, channels)) / total_blks;
+}
+
+uint64_t sparse_weights_fp32::cal_packed_size(const float *filter, const int64_t num_output, const int64_t channels)
+{
+    const int64_t num_ocb  = div_up(num_output, OC_DATA_BLK);
+    const int64_t num_blks = cal_num_blocks(filter, num_output, channels);
+    return (round_up(num_ocb + 1, PACKED_ALIGN_ELTS) * sizeof(int32_t) +
+            round_up(num_blks, PACKED_ALIGN_ELTS) * sizeof(int32_t) +
+            num_blks * OC_DATA_BLK * sizeof(float));
+}
+
+ppl::common::RetCode sparse_weights_fp32::pack(const float *filter, const int64_t num_output, const int64_t channels, void *packed)
+{
+    const int64_t num_ocb = div_up(num_output, OC_DATA_BLK);
+    int32_t *blk_ptr      = (int32_t *)packed;
+    int32_t *ic_idx       = blk_ptr + round_up(num_ocb + 1, PACKED_ALIGN_ELTS);
+
+    int64_t num_blks = 0;
+    for (int64_t ocb = 0; ocb < num_ocb; ++ocb) {
+        blk_ptr[ocb]         = num_blks;
+        const float *l_flt   = filter + ocb * OC_DATA_BLK * channels;
+        const int64_t oc_eff = min(num_output - ocb * OC_DATA_BLK, OC_DATA_BLK);
+        for (int64_t ic = 0; ic < channels; ++ic) {
+            if (!is_zero_block(l_flt + ic, channels, oc_eff)) {
+                ic_idx[num_blks++] = ic;
+            }
+        }
+    }
+    blk_ptr[num_ocb] = num_blks;
+
+    float *values = (float *)(ic_idx + round_up(num_blks, PACKED_ALIGN_ELTS));
+    for (int64_t ocb = 0; ocb < num_ocb; ++ocb) {
+        const float *l_flt   = filter + ocb * OC_DATA_BLK * channels;
+        const int64_t oc_eff = min(num_output - ocb * OC_DATA_BLK, OC_DATA_BLK);
+        for (int64_t k = blk_ptr[ocb]; k < blk_ptr[ocb + 1]; ++k) {
+            float *l_val = values + k * OC_DATA_BLK;
+            for (int64_t oc = 0; oc < oc_eff; ++oc) {
+                l_val[oc] = l_flt[oc * channels + ic_idx[k]];
+            }
+            memset(l_val + oc_eff, 0, (OC_DATA_BLK - oc_eff) * sizeof(float));
+        }
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+sparse_weights_fp32::view sparse_weights_fp32::get_view(const void *packed, const int64_t num_output)
+{
+    const int64_t num_ocb = div_up(num_output, OC_DATA_BLK);
+
+    view v;
+    v.blk_ptr = (const int32_t *)packed;
+    v.ic_idx  = v.blk_ptr + round_up(num_ocb + 1, PACKED_ALIGN_ELTS);
+    v.values  = (const float *)(v.ic_idx + round_up(v.blk_ptr[num_ocb], PACKED_ALIGN_ELTS));
+    return v;
+}
+
+conv2d_n16cx_sparse_kernel_fp32::conv2d_n16cx_sparse_kernel_fp32(int64_t *param, const ppl::common::isa_t isa)
+    : param_(param)
+    , table_(fma_table_)
+{
+#ifdef PPL_USE_X86_AVX512
+    if (isa & ppl::common::ISA_X86_AVX512) {
+        table_ = avx512_table_;
+    }
+#endif
+}
+
+int64_t conv2d_n16cx_sparse_kernel_fp32::max_s_regs(const ppl::common::isa_t isa)
+{
+#ifdef PPL_USE_X86_AVX512
+    if (isa & ppl::common::ISA_X86_AVX512) {
+        return config::AVX512_MAX_S_REGS;
+    }
+#endif
+    return config::FMA_MAX_S_REGS;
+}
+
+}}}; // namespace ppl::kernel::x86
@@ -0,0 +1,113 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef __ST_PPL_KERNEL_X86_FP32_CONV2D_SPARSE_CONV2D_N16CX_SPARSE_KERNEL_FP32_H_
+#define __ST_PPL_KERNEL_X86_FP32_CONV2D_SPARSE_CONV2D_N16CX_SPARSE_KERNEL_FP32_H_
+
+#include "ppl/kernel/x86/common/internal_include.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+// Block-CSR weights of a [num_output, channels] matrix. One block is 16 output
+// channels x 1 input channel, matching the channel block of N16CX, so a block
+// is loaded with whole vectors and multiplied with one broadcast input value.
+//
+// Packed layout (64 bytes aligned sections):
+//   int32_t blk_ptr[num_ocb + 1]; // offset of the first block of each output channel block
+//   int32_t ic_idx[num_blks];     // input channel of each block
+//   float   values[num_blks * 16];
+class sparse_weights_fp32 {
+public:
+    static const int64_t OC_DATA_BLK = 16;
+
+    struct view {
+        const int32_t *blk_ptr;
+        const int32_t *ic_idx;
+        const float *values;
+    };
+
+    // ratio of blocks having any non-zero value
+    static float cal_block_density(const float *filter, const int64_t num_output, const int64_t channels);
+
+    static uint64_t cal_packed_size(const float *filter, const int64_t num_output, const int64_t channels);
+
+    static ppl::common::RetCode pack(const float *filter, const int64_t num_output, const int64_t channels, void *packed);
+
+    static view get_view(const void *packed, const int64_t num_output);
+};
+
+// computes SPACE pixels of one output channel block:
+//   dst[s][0:16] = act(bias[0:16] + his[s][0:16] + sum(flt[k][0:16] * src[s][ic_idx[k]]))
+// where src[s][ic] = src[s * SRC_S_STRIDE + (ic / 16) * SRC_ICB_STRIDE + ic % 16]
+class conv2d_n16cx_sparse_kernel_fp32 {
+public:
+    typedef void (*func_t)(int64_t*);
+
+    struct param_def {
+        static const int64_t SRC_PTR_IDX = 0;
+        static const int64_t HIS_PTR_IDX = 1;
+        static const int64_t DST_PTR_IDX = 2;
+        static const int64_t FLT_PTR_IDX = 3;
+        static const int64_t IDX_PTR_IDX = 4;
+        static const int64_t BIAS_PTR_IDX = 5;
+        static const int64_t BLOCKS_IDX = 6;
+        static const int64_t SPACE_IDX = 7;
+        static const int64_t SRC_ICB_STRIDE_IDX = 8;
+        static const int64_t SRC_S_STRIDE_IDX = 9;
+        static const int64_t HIS_S_STRIDE_IDX = 10;
+        static const int64_t DST_S_STRIDE_IDX = 11;
+        static const int64_t FLAGS_IDX = 12;
+        static const int64_t LENGTH = 13;
+    };
+
+    struct config {
+        static const int64_t IC_DATA_BLK = 16;
+        static const int64_t OC_DATA_BLK = sparse_weights_fp32::OC_DATA_BLK;
+        static const int64_t FMA_MAX_S_REGS = 6;
+        static const int64_t AVX512_MAX_S_REGS = 14;
+    };
+
+    typedef int64_t flag_t;
+    struct flag {
+        static const flag_t ADD_HIS = (1 << 1);
+        static const flag_t RELU = (1 << 11);
+        static const flag_t RELU6 = (1 << 12);
+    };
+
+    conv2d_n16cx_sparse_kernel_fp32(int64_t *param, const ppl::common::isa_t isa);
+    inline void set_param(int64_t *param) { this->param_ = param; }
+    inline int64_t *param() { return param_; }
+
+    static int64_t max_s_regs(const ppl::common::isa_t isa);
+
+    inline void execute(const int64_t s_reg) {
+        table_[s_reg - 1](param_);
+    }
+
+private:
+    int64_t *param_;
+    const func_t *table_;
+
+    static const func_t fma_table_[config::FMA_MAX_S_REGS];
+#ifdef PPL_USE_X86_AVX512
+    static const func_t avx512_table_[config::AVX512_MAX_S_REGS];
+#endif
+};
+
+}}}; // namespace ppl::kernel::x86
+
+#endif
@@ -0,0 +1,115 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <immintrin.h>
+
+#include "ppl/kernel/x86/fp32/conv2d/sparse/conv2d_n16cx_sparse_kernel_fp32.h"
+#include "ppl/kernel/x86/common/array_param_helper.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+template <int32_t u_s>
+void conv2d_n16cx_sparse_fp32_fma_blk1x6_kernel(int64_t *param)
+{
+    const int64_t OC_REG_ELTS = 8;
+
+    array_param_helper ker_p(param);
+
+    const int64_t src_icb_stride = ker_p.pick<const int64_t>(conv2d_n16cx_sparse_kernel_fp32::param_def::SRC_ICB_STRIDE_IDX);
+    const int64_t src_s_stride   = ker_p.pick<const int64_t>(conv2d_n16cx_sparse_kernel_fp32::param_def::SRC_S_STRIDE_IDX);
+    const int64_t his_s_stride   = ker_p.pick<const int64_t>(conv2d_n16cx_sparse_kernel_fp32::param_def::HIS_S_STRIDE_IDX);
+    const int64_t dst_s_stride   = ker_p.pick<const int64_t>(conv2d_n16cx_sparse_kernel_fp32::param_def::DST_S_STRIDE_IDX);
+    const int64_t kernel_flags   = ker_p.pick<const int64_t>(conv2d_n16cx_sparse_kernel_fp32::param_def::FLAGS_IDX);
+    const int64_t blocks         = ker_p.pick<const int64_t>(conv2d_n16cx_sparse_kernel_fp32::param_def::BLOCKS_IDX);
+    const float *flt             = ker_p.pick<const float*>(conv2d_n16cx_sparse_kernel_fp32::param_def::FLT_PTR_IDX);
+    const int32_t *idx           = ker_p.pick<const int32_t*>(conv2d_n16cx_sparse_kernel_fp32::param_def::IDX_PTR_IDX);
+    const float *bias            = ker_p.pick<const float*>(conv2d_n16cx_sparse_kernel_fp32::param_def::BIAS_PTR_IDX);
+
+    const float *src = ker_p.pick<const float*>(conv2d_n16cx_sparse_kernel_fp32::param_def::SRC_PTR_IDX);
+    const float *his = ker_p.pick<const float*>(conv2d_n16cx_sparse_kernel_fp32::param_def::HIS_PTR_IDX);
+    float *dst       = ker_p.pick<float*>(conv2d_n16cx_sparse_kernel_fp32::param_def::DST_PTR_IDX);
+    int64_t space    = ker_p.pick<const int64_t>(conv2d_n16cx_sparse_kernel_fp32::param_def::SPACE_IDX);
+
+    const __m256 vbias0 = _mm256_loadu_ps(bias + 0 * OC_REG_ELTS);
+    const __m256 vbias1 = _mm256_loadu_ps(bias + 1 * OC_REG_ELTS);
+
+    __m256 vacc0[u_s], vacc1[u_s];
+    do {
+        for (int32_t s = 0; s < u_s; ++s) {
+            vacc0[s] = vbias0;
+            vacc1[s] = vbias1;
+        }
+        if (kernel_flags & conv2d_n16cx_sparse_kernel_fp32::flag::ADD_HIS) {
+            for (int32_t s = 0; s < u_s; ++s) {
+                vacc0[s] = _mm256_add_ps(_mm256_loadu_ps(his + s * his_s_stride + 0 * OC_REG_ELTS), vacc0[s]);
+                vacc1[s] = _mm256_add_ps(_mm256_loadu_ps(his + s * his_s_stride + 1 * OC_REG_ELTS), vacc1[s]);
+            }
+        }
+
+        const float *k_flt = flt;
+        for (int64_t k = 0; k < blocks; ++k) {
+            const int64_t ic   = idx[k];
+            const float *k_src = src + (ic >> 4) * src_icb_stride + (ic & 15);
+            const __m256 vflt0 = _mm256_loadu_ps(k_flt + 0 * OC_REG_ELTS);
+            const __m256 vflt1 = _mm256_loadu_ps(k_flt + 1 * OC_REG_ELTS);
+            for (int32_t s = 0; s < u_s; ++s) {
+                const __m256 vsrc = _mm256_set1_ps(k_src[s * src_s_stride]);
+                vacc0[s]          = _mm256_fmadd_ps(vflt0, vsrc, vacc0[s]);
+                vacc1[s]          = _mm256_fmadd_ps(vflt1, vsrc, vacc1[s]);
+            }
+            k_flt += 2 * OC_REG_ELTS;
+        }
+
+        if (kernel_flags & (conv2d_n16cx_sparse_kernel_fp32::flag::RELU | conv2d_n16cx_sparse_kernel_fp32::flag::RELU6)) {
+            const __m256 vzero = _mm256_setzero_ps();
+            for (int32_t s = 0; s < u_s; ++s) {
+                vacc0[s] = _mm256_max_ps(vacc0[s], vzero);
+                vacc1[s] = _mm256_max_ps(vacc1[s], vzero);
+            }
+        }
+        if (kernel_flags & conv2d_n16cx_sparse_kernel_fp32::flag::RELU6) {
+            const __m256 vsix = _mm256_set1_ps(6.0f);
+            for (int32_t s = 0; s < u_s; ++s) {
+                vacc0[s] = _mm256_min_ps(vacc0[s], vsix);
+                vacc1[s] = _mm256_min_ps(vacc1[s], vsix);
+            }
+        }
+
+        for (int32_t s = 0; s < u_s; ++s) {
+            _mm256_storeu_ps(dst + s * dst_s_stride + 0 * OC_REG_ELTS, vacc0[s]);
+            _mm256_storeu_ps(dst + s * dst_s_stride + 1 * OC_REG_ELTS, vacc1[s]);
+        }
+
+        src += u_s * src_s_stride;
+        his += u_s * his_s_stride;
+        dst += u_s * dst_s_stride;
+        space -= u_s;
+    } while (space > 0);
+}
+
+const conv2d_n16cx_sparse_kernel_fp32::func_t
+    conv2d_n16cx_sparse_kernel_fp32::fma_table_[config::FMA_MAX_S_REGS] =
+{
+    conv2d_n16cx_sparse_fp32_fma_blk1x6_kernel<1>,
+    conv2d_n16cx_sparse_fp32_fma_blk1x6_kernel<2>,
+    conv2d_n16cx_sparse_fp32_fma_blk1x6_kernel<3>,
+    conv2d_n16cx_sparse_fp32_fma_blk1x6_kernel<4>,
+    conv2d_n16cx_sparse_fp32_fma_blk1x6_kernel<5>,
+    conv2d_n16cx_sparse_fp32_fma_blk1x6_kernel<6>,
+};
+
+}}}; // namespace ppl::kernel::x86
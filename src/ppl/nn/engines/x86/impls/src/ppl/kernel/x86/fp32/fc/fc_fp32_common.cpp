@@ -19,10 +19,12 @@
 
 #include "ppl/kernel/x86/fp32/fc.h"
 #include "ppl/kernel/x86/fp32/fc/fma/fc_fp32_fma.h"
+#include "ppl/kernel/x86/fp32/fc/fma/fc_compressed_fp32_fma.h"
+#include "ppl/kernel/x86/fp32/fc/sparse/fc_sparse_fp32.h"
 
 namespace ppl { namespace kernel { namespace x86 {
 
-fc_fp32_algo_info fc_algo_selector::select_algo(const ppl::common::dataformat_t &src_format, const fc_fp32_param &param, const ppl::common::isa_t &isa_flags)
+fc_fp32_algo_info fc_algo_selector::select_algo(const ppl::common::dataformat_t &src_format, const fc_fp32_param &param, const ppl::common::isa_t &isa_flags, const float *filter)
 {
     (void)src_format;
 
@@ -30,7 +32,32 @@ fc_fp32_algo_info fc_algo_selector::select_algo(const ppl::common::dataformat_t
         fc_fp32_algo::UNKNOWN,
         ppl::common::ISA_UNKNOWN};
 
+    // compressed weights are requested explicitly, so they take precedence over sparse weights
+    if (param.weight_compression != fc_weight_compression::NONE) {
+        if (isa_flags & ppl::common::ISA_X86_FMA) {
+            return {
+                fc_fp32_algo::COMPRESSED,
+                ppl::common::ISA_X86_FMA};
+        }
+        return unknown_info;
+    }
+
+    const bool use_sparse = fc_sparse_fp32_manager::is_profitable(param, filter);
+
+#ifdef PPL_USE_X86_AVX512
+    if ((isa_flags & ppl::common::ISA_X86_AVX512) && use_sparse) {
+        return {
+            fc_fp32_algo::SPARSE,
+            ppl::common::ISA_X86_AVX512};
+    }
+#endif
+
     if (isa_flags & ppl::common::ISA_X86_FMA) {
+        if (use_sparse) {
+            return {
+                fc_fp32_algo::SPARSE,
+                ppl::common::ISA_X86_FMA};
+        }
         return {
             fc_fp32_algo::STANDARD,
             ppl::common::ISA_X86_FMA};
@@ -46,6 +73,13 @@ fc_fp32_manager *fc_algo_selector::gen_algo(const fc_fp32_param &param, const fc
         algo_info.isa == ppl::common::ISA_X86_FMA) {
         fc_mgr = new fc_fp32_fma_manager(param, allocator);
     }
+    if (algo_info.algo_type == fc_fp32_algo::SPARSE) {
+        fc_mgr = new fc_sparse_fp32_manager(param, allocator, algo_info.isa);
+    }
+    if (algo_info.algo_type == fc_fp32_algo::COMPRESSED &&
+        algo_info.isa == ppl::common::ISA_X86_FMA) {
+        fc_mgr = new fc_compressed_fp32_fma_manager(param, allocator);
+    }
 
     return fc_mgr;
 }
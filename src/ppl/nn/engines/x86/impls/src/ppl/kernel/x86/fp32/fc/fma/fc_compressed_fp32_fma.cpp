@@ -0,0 +1,219 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#include <immintrin.h>
+#include <math.h>
+#include <string.h>
+
+#include "ppl/kernel/x86/fp32/fc/fma/fc_compressed_fp32_fma.h"
+#include "ppl/kernel/x86/fp32/fc/fma/fc_compressed_kernel_fp32_fma.h"
+#include "ppl/kernel/x86/common/array_param_helper.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+static const int64_t OC_DATA_BLK = fc_compressed_kernel_fp32_fma::config::OC_DATA_BLK;
+static const int64_t M_KER_BLK   = fc_compressed_kernel_fp32_fma::config::MAX_M_REGS;
+
+static const int64_t M_L2_BLK_MAX = 8 * M_KER_BLK;
+static const int64_t K_L2_BLK_MAX = 256;
+static const int64_t INT8_MAX_VAL = 127;
+
+static inline int64_t cal_flt_bytes(const fc_fp32_param &param)
+{
+    return param.weight_compression == fc_weight_compression::INT8 ? sizeof(int8_t) : sizeof(uint16_t);
+}
+
+void fc_compressed_fp32_fma_executor::cal_kernel_tunning_param()
+{
+    schedule_param_.m_l2_blk = min<int64_t>(src_shape_->GetDim(0), M_L2_BLK_MAX);
+    schedule_param_.k_l2_blk = div_up(fc_param_->channels, div_up(fc_param_->channels, K_L2_BLK_MAX));
+}
+
+uint64_t fc_compressed_fp32_fma_executor::cal_temp_buffer_size()
+{
+    return 64u;
+}
+
+ppl::common::RetCode fc_compressed_fp32_fma_executor::prepare()
+{
+    if (!fc_param_ || !src_shape_ || !dst_shape_) {
+        return ppl::common::RC_INVALID_VALUE;
+    }
+
+    cal_kernel_tunning_param();
+
+    return ppl::common::RC_SUCCESS;
+}
+
+ppl::common::RetCode fc_compressed_fp32_fma_executor::execute()
+{
+    if (!fc_param_ || !cvt_filter_ || !cvt_bias_ || !src_ || !dst_) {
+        return ppl::common::RC_INVALID_VALUE;
+    }
+
+    const fc_fp32_param &fp         = *fc_param_;
+    const kernel_schedule_param &sp = schedule_param_;
+
+    const int64_t batch     = src_shape_->GetDim(0);
+    const int64_t padded_oc = round_up(fp.num_output, OC_DATA_BLK);
+    const int64_t num_ocb   = padded_oc / OC_DATA_BLK;
+    const int64_t num_ml2   = div_up(batch, sp.m_l2_blk);
+    const int64_t num_tasks = num_ml2 * num_ocb;
+
+    const float *scale     = cvt_filter_;
+    const uint8_t *flt     = (const uint8_t *)(cvt_filter_ + padded_oc);
+    const int64_t ocb_size = fp.channels * OC_DATA_BLK * cal_flt_bytes(fp);
+
+    const int64_t flt_bytes = cal_flt_bytes(fp);
+    const bool with_relu    = fp.fuse_flag & fc_fuse_flag::RELU;
+
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t t = 0; t < num_tasks; ++t) {
+        const int64_t ocb     = t % num_ocb;
+        const int64_t ml2     = t / num_ocb * sp.m_l2_blk;
+        const int64_t ml2_eff = min(batch - ml2, sp.m_l2_blk);
+        const int64_t oc_eff  = min(fp.num_output - ocb * OC_DATA_BLK, OC_DATA_BLK);
+
+        int64_t ker_param[fc_compressed_kernel_fp32_fma::param_def::LENGTH];
+        array_param_helper ker_p(ker_param);
+        fc_compressed_kernel_fp32_fma ker(ker_param, fp.weight_compression);
+
+        // unaligned output channels are computed into a local buffer
+        float dst_buf[M_L2_BLK_MAX * OC_DATA_BLK];
+        const bool oc_unaligned = oc_eff != OC_DATA_BLK;
+        const float *l_src      = src_ + ml2 * fp.channels;
+        float *l_dst            = oc_unaligned ? dst_buf : dst_ + ml2 * fp.num_output + ocb * OC_DATA_BLK;
+        const int64_t l_dst_m_stride = oc_unaligned ? OC_DATA_BLK : fp.num_output;
+
+        ker_p.pick<const float*>(fc_compressed_kernel_fp32_fma::param_def::SCALE_PTR_IDX) = scale + ocb * OC_DATA_BLK;
+        ker_p.pick<const float*>(fc_compressed_kernel_fp32_fma::param_def::BIAS_PTR_IDX)  = cvt_bias_ + ocb * OC_DATA_BLK;
+        ker_p.pick<int64_t>(fc_compressed_kernel_fp32_fma::param_def::SRC_M_STRIDE_IDX)   = fp.channels;
+        ker_p.pick<int64_t>(fc_compressed_kernel_fp32_fma::param_def::DST_M_STRIDE_IDX)   = l_dst_m_stride;
+
+        for (int64_t kl2 = 0; kl2 < fp.channels; kl2 += sp.k_l2_blk) {
+            const int64_t kl2_eff = min(fp.channels - kl2, sp.k_l2_blk);
+            uint64_t kernel_flags = 0;
+            if (kl2 > 0) {
+                kernel_flags |= fc_compressed_kernel_fp32_fma::flag::LOAD_DST;
+            }
+            if (kl2 + kl2_eff >= fp.channels) {
+                kernel_flags |= fc_compressed_kernel_fp32_fma::flag::ADD_BIAS;
+                if (with_relu) {
+                    kernel_flags |= fc_compressed_kernel_fp32_fma::flag::RELU;
+                }
+            }
+            ker_p.pick<const uint8_t*>(fc_compressed_kernel_fp32_fma::param_def::FLT_PTR_IDX) = flt + ocb * ocb_size + kl2 * OC_DATA_BLK * flt_bytes;
+            ker_p.pick<int64_t>(fc_compressed_kernel_fp32_fma::param_def::K_IDX)              = kl2_eff;
+            ker_p.pick<int64_t>(fc_compressed_kernel_fp32_fma::param_def::FLAGS_IDX)          = kernel_flags;
+
+            const int64_t m_body = round(ml2_eff, M_KER_BLK);
+            const int64_t m_tail = ml2_eff - m_body;
+            if (m_body) {
+                ker_p.pick<const float*>(fc_compressed_kernel_fp32_fma::param_def::SRC_PTR_IDX) = l_src + kl2;
+                ker_p.pick<float*>(fc_compressed_kernel_fp32_fma::param_def::DST_PTR_IDX)       = l_dst;
+                ker_p.pick<int64_t>(fc_compressed_kernel_fp32_fma::param_def::M_IDX)            = m_body;
+                ker.execute(M_KER_BLK);
+            }
+            if (m_tail) {
+                ker_p.pick<const float*>(fc_compressed_kernel_fp32_fma::param_def::SRC_PTR_IDX) = l_src + m_body * fp.channels + kl2;
+                ker_p.pick<float*>(fc_compressed_kernel_fp32_fma::param_def::DST_PTR_IDX)       = l_dst + m_body * l_dst_m_stride;
+                ker_p.pick<int64_t>(fc_compressed_kernel_fp32_fma::param_def::M_IDX)            = m_tail;
+                ker.execute(m_tail);
+            }
+        }
+
+        if (oc_unaligned) {
+            for (int64_t m = 0; m < ml2_eff; ++m) {
+                memcpy(dst_ + (ml2 + m) * fp.num_output + ocb * OC_DATA_BLK, dst_buf + m * OC_DATA_BLK, oc_eff * sizeof(float));
+            }
+        }
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+ppl::common::RetCode fc_compressed_fp32_fma_manager::gen_cvt_weights(const float *filter, const float *bias)
+{
+    if (cvt_bias_ != nullptr || cvt_filter_ != nullptr) {
+        return ppl::common::RC_PERMISSION_DENIED;
+    }
+    if (param_.weight_compression != fc_weight_compression::FP16 &&
+        param_.weight_compression != fc_weight_compression::INT8) {
+        return ppl::common::RC_UNSUPPORTED;
+    }
+
+    const int64_t channels   = param_.channels;
+    const int64_t num_output = param_.num_output;
+    const int64_t padded_oc  = round_up(num_output, OC_DATA_BLK);
+    const int64_t ocb_size   = channels * OC_DATA_BLK * cal_flt_bytes(param_);
+
+    cvt_bias_size_ = padded_oc;
+    cvt_bias_      = (float *)allocator_->Alloc(cvt_bias_size_ * sizeof(float));
+    if (cvt_bias_ == nullptr) {
+        return ppl::common::RC_OUT_OF_MEMORY;
+    }
+
+    memcpy(cvt_bias_, bias, num_output * sizeof(float));
+    memset(cvt_bias_ + num_output, 0, (padded_oc - num_output) * sizeof(float));
+
+    cvt_filter_size_ = padded_oc + div_up(padded_oc / OC_DATA_BLK * ocb_size, sizeof(float));
+    cvt_filter_      = (float *)allocator_->Alloc(cvt_filter_size_ * sizeof(float));
+    if (cvt_filter_ == nullptr) {
+        return ppl::common::RC_OUT_OF_MEMORY;
+    }
+
+    float *scale = cvt_filter_;
+    uint8_t *flt = (uint8_t *)(cvt_filter_ + padded_oc);
+
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t oc = 0; oc < padded_oc; ++oc) {
+        const float *l_filter = filter + oc * channels;
+        const int64_t oc_blk  = oc % OC_DATA_BLK;
+        uint8_t *l_flt        = flt + oc / OC_DATA_BLK * ocb_size;
+        if (param_.weight_compression == fc_weight_compression::FP16) {
+            uint16_t *l_flt_fp16 = (uint16_t *)l_flt;
+            scale[oc]            = 1.0f;
+            for (int64_t ic = 0; ic < channels; ++ic) {
+                const float w = oc < num_output ? l_filter[ic] : 0.0f;
+                l_flt_fp16[ic * OC_DATA_BLK + oc_blk] = _cvtss_sh(w, _MM_FROUND_TO_NEAREST_INT);
+            }
+        } else {
+            int8_t *l_flt_int8 = (int8_t *)l_flt;
+            float max_abs      = 0.0f;
+            if (oc < num_output) {
+                for (int64_t ic = 0; ic < channels; ++ic) {
+                    max_abs = max(max_abs, fabsf(l_filter[ic]));
+                }
+            }
+            scale[oc]             = max_abs > 0.0f ? max_abs / INT8_MAX_VAL : 1.0f;
+            const float rcp_scale = 1.0f / scale[oc];
+            for (int64_t ic = 0; ic < channels; ++ic) {
+                const float w = oc < num_output ? l_filter[ic] : 0.0f;
+                const int64_t q = (int64_t)roundf(w * rcp_scale);
+                l_flt_int8[ic * OC_DATA_BLK + oc_blk] = (int8_t)min(max(q, -INT8_MAX_VAL), INT8_MAX_VAL);
+            }
+        }
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+fc_fp32_executor *fc_compressed_fp32_fma_manager::gen_executor()
+{
+    return new fc_compressed_fp32_fma_executor(&param_, cvt_filter_, cvt_bias_);
+}
+
+}}}; // namespace ppl::kernel::x86
@@ -0,0 +1,185 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#include <immintrin.h>
+
+#include "ppl/kernel/x86/fp32/fc/fma/fc_compressed_kernel_fp32_fma.h"
+#include "ppl/kernel/x86/common/array_param_helper.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+template <fc_weight_compression_t compression>
+inline void fc_compressed_fp32_fma_load_flt(const void *flt, __m256 &vflt0, __m256 &vflt1);
+
+template <>
+inline void fc_compressed_fp32_fma_load_flt<fc_weight_compression::FP16>(const void *flt, __m256 &vflt0, __m256 &vflt1)
+{
+    vflt0 = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *)flt + 0));
+    vflt1 = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *)flt + 1));
+}
+
+template <>
+inline void fc_compressed_fp32_fma_load_flt<fc_weight_compression::INT8>(const void *flt, __m256 &vflt0, __m256 &vflt1)
+{
+    const __m128i vq = _mm_loadu_si128((const __m128i *)flt);
+    vflt0            = _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(vq));
+    vflt1            = _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(_mm_unpackhi_epi64(vq, vq)));
+}
+
+template <fc_weight_compression_t compression, int32_t u_m>
+void fc_compressed_fp32_fma_blk1x6_kernel(int64_t *param)
+{
+    const int64_t OC_REG_ELTS = 8;
+    const int64_t OC_DATA_BLK = fc_compressed_kernel_fp32_fma::config::OC_DATA_BLK;
+    const int64_t FLT_BYTES   = compression == fc_weight_compression::INT8 ? 1 : 2;
+    // few rows cannot hide the latency of fma, so k is unrolled into independent accumulators
+    const int32_t u_k = u_m == 1 ? 4 : (u_m == 2 ? 2 : 1);
+
+    array_param_helper ker_p(param);
+
+    const int64_t K            = ker_p.pick<const int64_t>(fc_compressed_kernel_fp32_fma::param_def::K_IDX);
+    const int64_t src_m_stride = ker_p.pick<const int64_t>(fc_compressed_kernel_fp32_fma::param_def::SRC_M_STRIDE_IDX);
+    const int64_t dst_m_stride = ker_p.pick<const int64_t>(fc_compressed_kernel_fp32_fma::param_def::DST_M_STRIDE_IDX);
+    const int64_t kernel_flags = ker_p.pick<const int64_t>(fc_compressed_kernel_fp32_fma::param_def::FLAGS_IDX);
+    const uint8_t *flt         = ker_p.pick<const uint8_t*>(fc_compressed_kernel_fp32_fma::param_def::FLT_PTR_IDX);
+    const float *scale         = ker_p.pick<const float*>(fc_compressed_kernel_fp32_fma::param_def::SCALE_PTR_IDX);
+    const float *bias          = ker_p.pick<const float*>(fc_compressed_kernel_fp32_fma::param_def::BIAS_PTR_IDX);
+
+    const float *src = ker_p.pick<const float*>(fc_compressed_kernel_fp32_fma::param_def::SRC_PTR_IDX);
+    float *dst       = ker_p.pick<float*>(fc_compressed_kernel_fp32_fma::param_def::DST_PTR_IDX);
+    int64_t m        = ker_p.pick<const int64_t>(fc_compressed_kernel_fp32_fma::param_def::M_IDX);
+
+    __m256 vacc0[u_k][u_m], vacc1[u_k][u_m];
+    do {
+        for (int32_t u = 0; u < u_k; ++u) {
+            for (int32_t i = 0; i < u_m; ++i) {
+                vacc0[u][i] = _mm256_setzero_ps();
+                vacc1[u][i] = _mm256_setzero_ps();
+            }
+        }
+
+        const uint8_t *k_flt = flt;
+        const float *k_src   = src;
+        int64_t k            = K;
+        while (k >= u_k) {
+            for (int32_t u = 0; u < u_k; ++u) {
+                __m256 vflt0, vflt1;
+                fc_compressed_fp32_fma_load_flt<compression>(k_flt + u * OC_DATA_BLK * FLT_BYTES, vflt0, vflt1);
+                for (int32_t i = 0; i < u_m; ++i) {
+                    const __m256 vsrc = _mm256_set1_ps(k_src[i * src_m_stride + u]);
+                    vacc0[u][i]       = _mm256_fmadd_ps(vflt0, vsrc, vacc0[u][i]);
+                    vacc1[u][i]       = _mm256_fmadd_ps(vflt1, vsrc, vacc1[u][i]);
+                }
+            }
+            k_flt += u_k * OC_DATA_BLK * FLT_BYTES;
+            k_src += u_k;
+            k -= u_k;
+        }
+        while (k > 0) {
+            __m256 vflt0, vflt1;
+            fc_compressed_fp32_fma_load_flt<compression>(k_flt, vflt0, vflt1);
+            for (int32_t i = 0; i < u_m; ++i) {
+                const __m256 vsrc = _mm256_set1_ps(k_src[i * src_m_stride]);
+                vacc0[0][i]       = _mm256_fmadd_ps(vflt0, vsrc, vacc0[0][i]);
+                vacc1[0][i]       = _mm256_fmadd_ps(vflt1, vsrc, vacc1[0][i]);
+            }
+            k_flt += OC_DATA_BLK * FLT_BYTES;
+            k_src += 1;
+            k -= 1;
+        }
+        for (int32_t u = 1; u < u_k; ++u) {
+            for (int32_t i = 0; i < u_m; ++i) {
+                vacc0[0][i] = _mm256_add_ps(vacc0[0][i], vacc0[u][i]);
+                vacc1[0][i] = _mm256_add_ps(vacc1[0][i], vacc1[u][i]);
+            }
+        }
+
+        __m256 vbase0[u_m], vbase1[u_m];
+        for (int32_t i = 0; i < u_m; ++i) {
+            vbase0[i] = _mm256_setzero_ps();
+            vbase1[i] = _mm256_setzero_ps();
+        }
+        if (kernel_flags & fc_compressed_kernel_fp32_fma::flag::LOAD_DST) {
+            for (int32_t i = 0; i < u_m; ++i) {
+                vbase0[i] = _mm256_loadu_ps(dst + i * dst_m_stride + 0 * OC_REG_ELTS);
+                vbase1[i] = _mm256_loadu_ps(dst + i * dst_m_stride + 1 * OC_REG_ELTS);
+            }
+        }
+        if (kernel_flags & fc_compressed_kernel_fp32_fma::flag::ADD_BIAS) {
+            const __m256 vbias0 = _mm256_loadu_ps(bias + 0 * OC_REG_ELTS);
+            const __m256 vbias1 = _mm256_loadu_ps(bias + 1 * OC_REG_ELTS);
+            for (int32_t i = 0; i < u_m; ++i) {
+                vbase0[i] = _mm256_add_ps(vbase0[i], vbias0);
+                vbase1[i] = _mm256_add_ps(vbase1[i], vbias1);
+            }
+        }
+
+        if (compression == fc_weight_compression::INT8) {
+            const __m256 vscale0 = _mm256_loadu_ps(scale + 0 * OC_REG_ELTS);
+            const __m256 vscale1 = _mm256_loadu_ps(scale + 1 * OC_REG_ELTS);
+            for (int32_t i = 0; i < u_m; ++i) {
+                vacc0[0][i] = _mm256_fmadd_ps(vacc0[0][i], vscale0, vbase0[i]);
+                vacc1[0][i] = _mm256_fmadd_ps(vacc1[0][i], vscale1, vbase1[i]);
+            }
+        } else {
+            for (int32_t i = 0; i < u_m; ++i) {
+                vacc0[0][i] = _mm256_add_ps(vacc0[0][i], vbase0[i]);
+                vacc1[0][i] = _mm256_add_ps(vacc1[0][i], vbase1[i]);
+            }
+        }
+
+        if (kernel_flags & fc_compressed_kernel_fp32_fma::flag::RELU) {
+            const __m256 vzero = _mm256_setzero_ps();
+            for (int32_t i = 0; i < u_m; ++i) {
+                vacc0[0][i] = _mm256_max_ps(vacc0[0][i], vzero);
+                vacc1[0][i] = _mm256_max_ps(vacc1[0][i], vzero);
+            }
+        }
+
+        for (int32_t i = 0; i < u_m; ++i) {
+            _mm256_storeu_ps(dst + i * dst_m_stride + 0 * OC_REG_ELTS, vacc0[0][i]);
+            _mm256_storeu_ps(dst + i * dst_m_stride + 1 * OC_REG_ELTS, vacc1[0][i]);
+        }
+
+        src += u_m * src_m_stride;
+        dst += u_m * dst_m_stride;
+        m -= u_m;
+    } while (m > 0);
+}
+
+const fc_compressed_kernel_fp32_fma::func_t
+    fc_compressed_kernel_fp32_fma::fp16_table_[config::MAX_M_REGS] =
+{
+    fc_compressed_fp32_fma_blk1x6_kernel<fc_weight_compression::FP16, 1>,
+    fc_compressed_fp32_fma_blk1x6_kernel<fc_weight_compression::FP16, 2>,
+    fc_compressed_fp32_fma_blk1x6_kernel<fc_weight_compression::FP16, 3>,
+    fc_compressed_fp32_fma_blk1x6_kernel<fc_weight_compression::FP16, 4>,
+    fc_compressed_fp32_fma_blk1x6_kernel<fc_weight_compression::FP16, 5>,
+    fc_compressed_fp32_fma_blk1x6_kernel<fc_weight_compression::FP16, 6>,
+};
+
+const fc_compressed_kernel_fp32_fma::func_t
+    fc_compressed_kernel_fp32_fma::int8_table_[config::MAX_M_REGS] =
+{
+    fc_compressed_fp32_fma_blk1x6_kernel<fc_weight_compression::INT8, 1>,
+    fc_compressed_fp32_fma_blk1x6_kernel<fc_weight_compression::INT8, 2>,
+    fc_compressed_fp32_fma_blk1x6_kernel<fc_weight_compression::INT8, 3>,
+    fc_compressed_fp32_fma_blk1x6_kernel<fc_weight_compression::INT8, 4>,
+    fc_compressed_fp32_fma_blk1x6_kernel<fc_weight_compression::INT8, 5>,
+    fc_compressed_fp32_fma_blk1x6_kernel<fc_weight_compression::INT8, 6>,
+};
+
+}}}; // namespace ppl::kernel::x86
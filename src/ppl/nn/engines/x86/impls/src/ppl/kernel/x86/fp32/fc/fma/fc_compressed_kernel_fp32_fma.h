@@ -0,0 +1,79 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#ifndef __ST_PPL_KERNEL_X86_FP32_FC_FMA_FC_COMPRESSED_KERNEL_FP32_FMA_H_
+#define __ST_PPL_KERNEL_X86_FP32_FC_FMA_FC_COMPRESSED_KERNEL_FP32_FMA_H_
+
+#include "ppl/kernel/x86/fp32/fc.h"
+#include "ppl/kernel/x86/common/internal_include.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+// computes M rows of one output channel block with K compressed weights:
+//   dst[m][0:16] = act(bias[0:16] + dst[m][0:16] + scale[0:16] * sum(src[m][k] * flt[k][0:16]))
+// flt is fp16 or int8, and is converted to fp32 right after being loaded.
+// scale is only used by int8 weights, bias and dst are added by flags.
+class fc_compressed_kernel_fp32_fma {
+public:
+    typedef void (*func_t)(int64_t*);
+
+    struct param_def {
+        static const int64_t SRC_PTR_IDX = 0;
+        static const int64_t DST_PTR_IDX = 1;
+        static const int64_t FLT_PTR_IDX = 2;
+        static const int64_t SCALE_PTR_IDX = 3;
+        static const int64_t BIAS_PTR_IDX = 4;
+        static const int64_t K_IDX = 5;
+        static const int64_t SRC_M_STRIDE_IDX = 6;
+        static const int64_t DST_M_STRIDE_IDX = 7;
+        static const int64_t M_IDX = 8;
+        static const int64_t FLAGS_IDX = 9;
+        static const int64_t LENGTH = 10;
+    };
+
+    struct config {
+        static const int64_t OC_DATA_BLK = 16;
+        static const int64_t MAX_M_REGS = 6;
+    };
+
+    typedef int64_t flag_t;
+    struct flag {
+        static const flag_t LOAD_DST = (1 << 1);
+        static const flag_t ADD_BIAS = (1 << 8);
+        static const flag_t RELU = (1 << 11);
+    };
+
+    fc_compressed_kernel_fp32_fma(int64_t *param, const fc_weight_compression_t compression)
+        : param_(param)
+        , table_(compression == fc_weight_compression::INT8 ? int8_table_ : fp16_table_) {}
+    inline void set_param(int64_t *param) { this->param_ = param; }
+    inline int64_t *param() { return param_; }
+
+    inline void execute(const int64_t m_reg) {
+        table_[m_reg - 1](param_);
+    }
+
+private:
+    int64_t *param_;
+    const func_t *table_;
+
+    static const func_t fp16_table_[config::MAX_M_REGS];
+    static const func_t int8_table_[config::MAX_M_REGS];
+};
+
+}}}; // namespace ppl::kernel::x86
+
+#endif
@@ -0,0 +1,179 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <string.h>
+
+#include "ppl/kernel/x86/fp32/fc/sparse/fc_sparse_fp32.h"
+#include "ppl/kernel/x86/fp32/conv2d/sparse/conv2d_n16cx_sparse_kernel_fp32.h"
+#include "ppl/kernel/x86/common/array_param_helper.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+static const int64_t OC_DATA_BLK = conv2d_n16cx_sparse_kernel_fp32::config::OC_DATA_BLK;
+
+static const int64_t B_L2_BLK_MAX = 8;
+// inclusive. cal_block_density() rounds like the literal, so e.g. 2 of 5 blocks gives exactly 0.4f
+static const float MAX_BLOCK_DENSITY = 0.4f;
+
+void fc_sparse_fp32_executor::cal_kernel_tunning_param()
+{
+    kernel_schedule_param &sp = schedule_param_;
+
+    const int64_t batch = src_shape_->GetDim(0);
+
+    sp.b_ker_blk = conv2d_n16cx_sparse_kernel_fp32::max_s_regs(isa_);
+    sp.b_l2_blk  = min(batch, B_L2_BLK_MAX * sp.b_ker_blk);
+}
+
+uint64_t fc_sparse_fp32_executor::cal_temp_buffer_size()
+{
+    return 64u;
+}
+
+ppl::common::RetCode fc_sparse_fp32_executor::prepare()
+{
+    if (!fc_param_ || !src_shape_ || !dst_shape_) {
+        return ppl::common::RC_INVALID_VALUE;
+    }
+
+    cal_kernel_tunning_param();
+
+    return ppl::common::RC_SUCCESS;
+}
+
+ppl::common::RetCode fc_sparse_fp32_executor::execute()
+{
+    if (!fc_param_ || !cvt_filter_ || !cvt_bias_ || !src_ || !dst_) {
+        return ppl::common::RC_INVALID_VALUE;
+    }
+
+    const fc_fp32_param &fp         = *fc_param_;
+    const kernel_schedule_param &sp = schedule_param_;
+
+    const int64_t batch     = src_shape_->GetDim(0);
+    const int64_t num_ocb   = div_up(fp.num_output, OC_DATA_BLK);
+    const int64_t num_bl2   = div_up(batch, sp.b_l2_blk);
+    const int64_t num_tasks = num_bl2 * num_ocb;
+
+    uint64_t kernel_flags = 0;
+    if (fp.fuse_flag & fc_fuse_flag::RELU) {
+        kernel_flags |= conv2d_n16cx_sparse_kernel_fp32::flag::RELU;
+    }
+
+    const sparse_weights_fp32::view flt = sparse_weights_fp32::get_view(cvt_filter_, fp.num_output);
+
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t t = 0; t < num_tasks; ++t) {
+        const int64_t ocb     = t % num_ocb;
+        const int64_t bl2     = t / num_ocb * sp.b_l2_blk;
+        const int64_t bl2_eff = min(batch - bl2, sp.b_l2_blk);
+        const int64_t oc_eff  = min(fp.num_output - ocb * OC_DATA_BLK, OC_DATA_BLK);
+
+        int64_t ker_param[conv2d_n16cx_sparse_kernel_fp32::param_def::LENGTH];
+        array_param_helper ker_p(ker_param);
+        conv2d_n16cx_sparse_kernel_fp32 ker(ker_param, isa_);
+
+        const float *l_src = src_ + bl2 * fp.channels;
+        float *l_dst       = dst_ + bl2 * fp.num_output + ocb * OC_DATA_BLK;
+
+        ker_p.pick<const float*>(conv2d_n16cx_sparse_kernel_fp32::param_def::FLT_PTR_IDX)   = flt.values + flt.blk_ptr[ocb] * OC_DATA_BLK;
+        ker_p.pick<const int32_t*>(conv2d_n16cx_sparse_kernel_fp32::param_def::IDX_PTR_IDX) = flt.ic_idx + flt.blk_ptr[ocb];
+        ker_p.pick<const float*>(conv2d_n16cx_sparse_kernel_fp32::param_def::BIAS_PTR_IDX)  = cvt_bias_ + ocb * OC_DATA_BLK;
+        ker_p.pick<int64_t>(conv2d_n16cx_sparse_kernel_fp32::param_def::BLOCKS_IDX)         = flt.blk_ptr[ocb + 1] - flt.blk_ptr[ocb];
+        ker_p.pick<int64_t>(conv2d_n16cx_sparse_kernel_fp32::param_def::SRC_ICB_STRIDE_IDX) = OC_DATA_BLK; // ndarray
+        ker_p.pick<int64_t>(conv2d_n16cx_sparse_kernel_fp32::param_def::SRC_S_STRIDE_IDX)   = fp.channels;
+        ker_p.pick<const float*>(conv2d_n16cx_sparse_kernel_fp32::param_def::HIS_PTR_IDX)   = l_dst; // unused
+        ker_p.pick<int64_t>(conv2d_n16cx_sparse_kernel_fp32::param_def::HIS_S_STRIDE_IDX)   = 0;
+        ker_p.pick<int64_t>(conv2d_n16cx_sparse_kernel_fp32::param_def::FLAGS_IDX)          = kernel_flags;
+
+        if (oc_eff == OC_DATA_BLK) {
+            const int64_t b_body = round(bl2_eff, sp.b_ker_blk);
+            const int64_t b_tail = bl2_eff - b_body;
+            ker_p.pick<int64_t>(conv2d_n16cx_sparse_kernel_fp32::param_def::DST_S_STRIDE_IDX) = fp.num_output;
+            if (b_body) {
+                ker_p.pick<const float*>(conv2d_n16cx_sparse_kernel_fp32::param_def::SRC_PTR_IDX) = l_src;
+                ker_p.pick<float*>(conv2d_n16cx_sparse_kernel_fp32::param_def::DST_PTR_IDX)       = l_dst;
+                ker_p.pick<int64_t>(conv2d_n16cx_sparse_kernel_fp32::param_def::SPACE_IDX)        = b_body;
+                ker.execute(sp.b_ker_blk);
+            }
+            if (b_tail) {
+                ker_p.pick<const float*>(conv2d_n16cx_sparse_kernel_fp32::param_def::SRC_PTR_IDX) = l_src + b_body * fp.channels;
+                ker_p.pick<float*>(conv2d_n16cx_sparse_kernel_fp32::param_def::DST_PTR_IDX)       = l_dst + b_body * fp.num_output;
+                ker_p.pick<int64_t>(conv2d_n16cx_sparse_kernel_fp32::param_def::SPACE_IDX)        = b_tail;
+                ker.execute(b_tail);
+            }
+        } else {
+            // unaligned output channels are computed into a local buffer
+            float dst_buf[conv2d_n16cx_sparse_kernel_fp32::config::AVX512_MAX_S_REGS * OC_DATA_BLK];
+            ker_p.pick<int64_t>(conv2d_n16cx_sparse_kernel_fp32::param_def::DST_S_STRIDE_IDX) = OC_DATA_BLK;
+            ker_p.pick<float*>(conv2d_n16cx_sparse_kernel_fp32::param_def::DST_PTR_IDX)       = dst_buf;
+            for (int64_t b = 0; b < bl2_eff; b += sp.b_ker_blk) {
+                const int64_t b_eff = min(bl2_eff - b, sp.b_ker_blk);
+                ker_p.pick<const float*>(conv2d_n16cx_sparse_kernel_fp32::param_def::SRC_PTR_IDX) = l_src + b * fp.channels;
+                ker_p.pick<int64_t>(conv2d_n16cx_sparse_kernel_fp32::param_def::SPACE_IDX)        = b_eff;
+                ker.execute(b_eff);
+                for (int64_t bb = 0; bb < b_eff; ++bb) {
+                    memcpy(l_dst + (b + bb) * fp.num_output, dst_buf + bb * OC_DATA_BLK, oc_eff * sizeof(float));
+                }
+            }
+        }
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+ppl::common::RetCode fc_sparse_fp32_manager::gen_cvt_weights(const float *filter, const float *bias)
+{
+    if (cvt_bias_ != nullptr || cvt_filter_ != nullptr) {
+        return ppl::common::RC_PERMISSION_DENIED;
+    }
+
+    const int64_t padded_oc = round_up(param_.num_output, OC_DATA_BLK);
+
+    cvt_bias_size_ = padded_oc;
+    cvt_bias_      = (float *)allocator_->Alloc(cvt_bias_size_ * sizeof(float));
+    if (cvt_bias_ == nullptr) {
+        return ppl::common::RC_OUT_OF_MEMORY;
+    }
+
+    memcpy(cvt_bias_, bias, param_.num_output * sizeof(float));
+    memset(cvt_bias_ + param_.num_output, 0, (padded_oc - param_.num_output) * sizeof(float));
+
+    cvt_filter_size_ = sparse_weights_fp32::cal_packed_size(filter, param_.num_output, param_.channels);
+    cvt_filter_size_ /= sizeof(float);
+    cvt_filter_ = (float *)allocator_->Alloc(cvt_filter_size_ * sizeof(float));
+    if (cvt_filter_ == nullptr) {
+        return ppl::common::RC_OUT_OF_MEMORY;
+    }
+
+    return sparse_weights_fp32::pack(filter, param_.num_output, param_.channels, cvt_filter_);
+}
+
+bool fc_sparse_fp32_manager::is_profitable(const fc_fp32_param &param, const float *filter)
+{
+    if (filter == nullptr) {
+        return false;
+    }
+    return sparse_weights_fp32::cal_block_density(filter, param.num_output, param.channels) <= MAX_BLOCK_DENSITY;
+}
+
+fc_fp32_executor *fc_sparse_fp32_manager::gen_executor()
+{
+    return new fc_sparse_fp32_executor(&param_, cvt_filter_, cvt_bias_, isa_);
+}
+
+}}}; // namespace ppl::kernel::x86
@@ -15,6 +15,8 @@
 // specific language governing permissions and limitations
 // under the License.
 
+#include <immintrin.h>
+
 #include "ppl/kernel/x86/common/internal_include.h"
 
 #include <vector>
@@ -23,32 +25,71 @@
 
 namespace ppl { namespace kernel { namespace x86 {
 
-inline float calc_iou(
+// returns true if box i0 overlaps any of the first `num_kept` kept boxes by no less than `iou_threshold`
+static inline bool is_suppressed(
         const float *boxes,
         const float *areas,
         const int64_t i0,
-        const int64_t i1,
-        const int64_t offset)
+        const float *kept_x1,
+        const float *kept_y1,
+        const float *kept_x2,
+        const float *kept_y2,
+        const float *kept_areas,
+        const int64_t num_kept,
+        const float iou_threshold,
+        const float offset)
 {
-    float ix1 = boxes[i0 * 4 + 0];
-    float iy1 = boxes[i0 * 4 + 1];
-    float ix2 = boxes[i0 * 4 + 2];
-    float iy2 = boxes[i0 * 4 + 3];
-
-    float xx1 = max(ix1, boxes[i1 * 4 + 0]);
-    float yy1 = max(iy1, boxes[i1 * 4 + 1]);
-    float xx2 = min(ix2, boxes[i1 * 4 + 2]);
-    float yy2 = min(iy2, boxes[i1 * 4 + 3]);
-
-    float w = max(0.f, xx2 - xx1 + offset);
-    float h = max(0.f, yy2 - yy1 + offset);
-
-    float inter = w * h;
-    float ovr = inter / (areas[i0] + areas[i1] - inter);
-    return ovr;
+    const float ix1 = boxes[i0 * 4 + 0];
+    const float iy1 = boxes[i0 * 4 + 1];
+    const float ix2 = boxes[i0 * 4 + 2];
+    const float iy2 = boxes[i0 * 4 + 3];
+    const float iarea = areas[i0];
+
+    int64_t j = 0;
+
+    const __m128 v_ix1 = _mm_set1_ps(ix1);
+    const __m128 v_iy1 = _mm_set1_ps(iy1);
+    const __m128 v_ix2 = _mm_set1_ps(ix2);
+    const __m128 v_iy2 = _mm_set1_ps(iy2);
+    const __m128 v_iarea = _mm_set1_ps(iarea);
+    const __m128 v_offset = _mm_set1_ps(offset);
+    const __m128 v_thresh = _mm_set1_ps(iou_threshold);
+    const __m128 v_zero = _mm_setzero_ps();
+    for (; j + 4 <= num_kept; j += 4) {
+        const __m128 v_xx1 = _mm_max_ps(v_ix1, _mm_loadu_ps(kept_x1 + j));
+        const __m128 v_yy1 = _mm_max_ps(v_iy1, _mm_loadu_ps(kept_y1 + j));
+        const __m128 v_xx2 = _mm_min_ps(v_ix2, _mm_loadu_ps(kept_x2 + j));
+        const __m128 v_yy2 = _mm_min_ps(v_iy2, _mm_loadu_ps(kept_y2 + j));
+
+        const __m128 v_w = _mm_max_ps(v_zero, _mm_add_ps(_mm_sub_ps(v_xx2, v_xx1), v_offset));
+        const __m128 v_h = _mm_max_ps(v_zero, _mm_add_ps(_mm_sub_ps(v_yy2, v_yy1), v_offset));
+
+        const __m128 v_inter = _mm_mul_ps(v_w, v_h);
+        const __m128 v_ovr = _mm_div_ps(v_inter, _mm_sub_ps(_mm_add_ps(v_iarea, _mm_loadu_ps(kept_areas + j)), v_inter));
+        if (_mm_movemask_ps(_mm_cmpge_ps(v_ovr, v_thresh))) {
+            return true;
+        }
+    }
+    for (; j < num_kept; j++) {
+        float xx1 = max(ix1, kept_x1[j]);
+        float yy1 = max(iy1, kept_y1[j]);
+        float xx2 = min(ix2, kept_x2[j]);
+        float yy2 = min(iy2, kept_y2[j]);
+
+        float w = max(0.f, xx2 - xx1 + offset);
+        float h = max(0.f, yy2 - yy1 + offset);
+
+        float inter = w * h;
+        float ovr = inter / (iarea + kept_areas[j] - inter);
+        if (ovr >= iou_threshold) {
+            return true;
+        }
+    }
+
+    return false;
 }
 
-ppl::common::RetCode mmcv_nms_ndarray_fp32_naive(
+ppl::common::RetCode mmcv_nms_ndarray_fp32(
         const float *boxes,
         const float *scores,
         const uint32_t num_boxes_in,
@@ -62,40 +103,35 @@ ppl::common::RetCode mmcv_nms_ndarray_fp32_naive(
     uint32_t *sorted_index = sorted_index_.data();
     float *areas = areas_.data();
 
-    for (uint32_t i = 0; i < num_boxes_in; i++) {
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t i = 0; i < num_boxes_in; i++) {
         areas[i] = (boxes[i * 4 + 2] - boxes[i * 4 + 0] + offset) * (boxes[i * 4 + 3] - boxes[i * 4 + 1] + offset);
     }
     argsort(scores, sorted_index, num_boxes_in);
 
-    *num_boxes_out = 0;
+    // coordinates of kept boxes are gathered so that they can be compared in vectors
+    std::vector<float> kept_((size_t)num_boxes_in * 5);
+    float *kept_x1 = kept_.data() + 0 * num_boxes_in;
+    float *kept_y1 = kept_.data() + 1 * num_boxes_in;
+    float *kept_x2 = kept_.data() + 2 * num_boxes_in;
+    float *kept_y2 = kept_.data() + 3 * num_boxes_in;
+    float *kept_areas = kept_.data() + 4 * num_boxes_in;
+
+    int64_t num_kept = 0;
     for (uint32_t i = 0; i < num_boxes_in; i++) {
         int64_t idx = sorted_index[i];
-        bool keep = true;
-        for (int64_t j = 0; j < *num_boxes_out; j++) {
-            float iou = calc_iou(boxes, areas, idx, dst[j], offset);
-            if (iou >= iou_threshold) {
-                keep = false;
-                break;
-            }
-        }
-        if (keep) {
-            dst[(*num_boxes_out)++] = idx;
+        if (!is_suppressed(boxes, areas, idx, kept_x1, kept_y1, kept_x2, kept_y2, kept_areas, num_kept, iou_threshold, offset)) {
+            kept_x1[num_kept] = boxes[idx * 4 + 0];
+            kept_y1[num_kept] = boxes[idx * 4 + 1];
+            kept_x2[num_kept] = boxes[idx * 4 + 2];
+            kept_y2[num_kept] = boxes[idx * 4 + 3];
+            kept_areas[num_kept] = areas[idx];
+            dst[num_kept++] = idx;
         }
     }
 
+    *num_boxes_out = num_kept;
     return ppl::common::RC_SUCCESS;
 }
 
-ppl::common::RetCode mmcv_nms_ndarray_fp32(
-        const float *boxes,
-        const float *scores,
-        const uint32_t num_boxes_in,
-        const float iou_threshold,
-        const int64_t offset,
-        int64_t *dst,
-        int64_t *num_boxes_out)
-{
-    return mmcv_nms_ndarray_fp32_naive(boxes, scores, num_boxes_in, iou_threshold, offset, dst, num_boxes_out);
-}
-
 }}}; // namespace ppl::kernel::x86
@@ -15,7 +15,7 @@
 // specific language governing permissions and limitations
 // under the License.
 
-
+#include <immintrin.h>
 #include <algorithm>
 #include <vector>
 
@@ -23,106 +23,186 @@
 
 namespace ppl { namespace kernel { namespace x86 {
 
-inline float calc_iou(const float *p_boxes, int64_t i0, int64_t i1, bool centered)
+// boxes decoded to the terms used by iou calculation, stored as structure of arrays
+struct nms_decoded_boxes_fp32 {
+    std::vector<float> x_min;
+    std::vector<float> x_max;
+    std::vector<float> y_min;
+    std::vector<float> y_max;
+    std::vector<float> w;
+    std::vector<float> h;
+    std::vector<float> area;
+
+    void resize(const int64_t n)
+    {
+        x_min.resize(n);
+        x_max.resize(n);
+        y_min.resize(n);
+        y_max.resize(n);
+        w.resize(n);
+        h.resize(n);
+        area.resize(n);
+    }
+
+    void copy_from(const int64_t dst_idx, const nms_decoded_boxes_fp32 &src, const int64_t src_idx)
+    {
+        x_min[dst_idx] = src.x_min[src_idx];
+        x_max[dst_idx] = src.x_max[src_idx];
+        y_min[dst_idx] = src.y_min[src_idx];
+        y_max[dst_idx] = src.y_max[src_idx];
+        w[dst_idx]     = src.w[src_idx];
+        h[dst_idx]     = src.h[src_idx];
+        area[dst_idx]  = src.area[src_idx];
+    }
+};
+
+static inline void decode_box(const float *b, const bool centered, nms_decoded_boxes_fp32 *dst, const int64_t idx)
 {
-    const float *b0 = p_boxes + i0 * 4;
-    const float *b1 = p_boxes + i1 * 4;
-    float x_min, x_max, y_min, y_max;
-    float w0, w1, h0, h1;
+    float w, h;
     if (centered == true) { // tf_format: [x_center, y_center, width, height]
-        w0    = b0[2];
-        w1    = b1[2];
-        h0    = b0[3];
-        h1    = b1[3];
-        x_min = min(b0[0] - w0 / 2, b1[0] - w1 / 2);
-        x_max = max(b0[0] + w0 / 2, b1[0] + w1 / 2);
-        y_min = min(b0[1] - h0 / 2, b1[1] - h1 / 2);
-        y_max = max(b0[1] + h0 / 2, b1[1] + h1 / 2);
+        w                = b[2];
+        h                = b[3];
+        dst->x_min[idx] = b[0] - w / 2;
+        dst->x_max[idx] = b[0] + w / 2;
+        dst->y_min[idx] = b[1] - h / 2;
+        dst->y_max[idx] = b[1] + h / 2;
     } else { // pytorch_format: [y1, x1, y2, x2]
-        w0    = abs(b0[1] - b0[3]);
-        w1    = abs(b1[1] - b1[3]);
-        h0    = abs(b0[0] - b0[2]);
-        h1    = abs(b1[0] - b1[2]);
-        x_min = min(min(b0[1], b0[3]), min(b1[1], b1[3]));
-        x_max = max(max(b0[1], b0[3]), max(b1[1], b1[3]));
-        y_min = min(min(b0[0], b0[2]), min(b1[0], b1[2]));
-        y_max = max(max(b0[0], b0[2]), max(b1[0], b1[2]));
+        w                = abs(b[1] - b[3]);
+        h                = abs(b[0] - b[2]);
+        dst->x_min[idx] = min(b[1], b[3]);
+        dst->x_max[idx] = max(b[1], b[3]);
+        dst->y_min[idx] = min(b[0], b[2]);
+        dst->y_max[idx] = max(b[0], b[2]);
     }
+    dst->w[idx]    = w;
+    dst->h[idx]    = h;
+    dst->area[idx] = w * h;
+}
 
-    if (w0 + w1 <= x_max - x_min || h0 + h1 <= y_max - y_min) {
-        return 0;
+// returns true if box i0 of `boxes` overlaps any of the first `num_kept` boxes of `kept` by more than `iou_threshold`
+static inline bool is_suppressed(
+    const nms_decoded_boxes_fp32 &boxes,
+    const int64_t i0,
+    const nms_decoded_boxes_fp32 &kept,
+    const int64_t num_kept,
+    const float iou_threshold)
+{
+    const float x_min0 = boxes.x_min[i0];
+    const float x_max0 = boxes.x_max[i0];
+    const float y_min0 = boxes.y_min[i0];
+    const float y_max0 = boxes.y_max[i0];
+    const float w0     = boxes.w[i0];
+    const float h0     = boxes.h[i0];
+    const float area0  = boxes.area[i0];
+
+    int64_t j = 0;
+
+    const __m128 v_x_min0 = _mm_set1_ps(x_min0);
+    const __m128 v_x_max0 = _mm_set1_ps(x_max0);
+    const __m128 v_y_min0 = _mm_set1_ps(y_min0);
+    const __m128 v_y_max0 = _mm_set1_ps(y_max0);
+    const __m128 v_w0     = _mm_set1_ps(w0);
+    const __m128 v_h0     = _mm_set1_ps(h0);
+    const __m128 v_area0  = _mm_set1_ps(area0);
+    const __m128 v_thresh = _mm_set1_ps(iou_threshold);
+    for (; j + 4 <= num_kept; j += 4) {
+        const __m128 v_x_min = _mm_min_ps(v_x_min0, _mm_loadu_ps(kept.x_min.data() + j));
+        const __m128 v_x_max = _mm_max_ps(v_x_max0, _mm_loadu_ps(kept.x_max.data() + j));
+        const __m128 v_y_min = _mm_min_ps(v_y_min0, _mm_loadu_ps(kept.y_min.data() + j));
+        const __m128 v_y_max = _mm_max_ps(v_y_max0, _mm_loadu_ps(kept.y_max.data() + j));
+        const __m128 v_sum_w = _mm_add_ps(v_w0, _mm_loadu_ps(kept.w.data() + j));
+        const __m128 v_sum_h = _mm_add_ps(v_h0, _mm_loadu_ps(kept.h.data() + j));
+        const __m128 v_ext_w = _mm_sub_ps(v_x_max, v_x_min);
+        const __m128 v_ext_h = _mm_sub_ps(v_y_max, v_y_min);
+
+        const __m128 v_disjoint = _mm_or_ps(_mm_cmple_ps(v_sum_w, v_ext_w), _mm_cmple_ps(v_sum_h, v_ext_h));
+        const __m128 v_I        = _mm_mul_ps(_mm_sub_ps(v_sum_h, v_ext_h), _mm_sub_ps(v_sum_w, v_ext_w));
+        const __m128 v_U        = _mm_sub_ps(_mm_add_ps(v_area0, _mm_loadu_ps(kept.area.data() + j)), v_I);
+        const __m128 v_iou      = _mm_andnot_ps(v_disjoint, _mm_div_ps(v_I, v_U));
+        if (_mm_movemask_ps(_mm_cmpgt_ps(v_iou, v_thresh))) {
+            return true;
+        }
     }
+    for (; j < num_kept; ++j) {
+        const float x_min = min(x_min0, kept.x_min[j]);
+        const float x_max = max(x_max0, kept.x_max[j]);
+        const float y_min = min(y_min0, kept.y_min[j]);
+        const float y_max = max(y_max0, kept.y_max[j]);
+        const float w1    = kept.w[j];
+        const float h1    = kept.h[j];
 
-    float area0 = w0 * h0, area1 = w1 * h1;
-    float iw = w0 + w1 - (x_max - x_min);
-    float ih = h0 + h1 - (y_max - y_min);
-    float I  = ih * iw;
-    float U  = area0 + area1 - I;
+        float iou = 0;
+        if (!(w0 + w1 <= x_max - x_min || h0 + h1 <= y_max - y_min)) {
+            const float iw = w0 + w1 - (x_max - x_min);
+            const float ih = h0 + h1 - (y_max - y_min);
+            const float I  = ih * iw;
+            const float U  = area0 + kept.area[j] - I;
+            iou            = I / U;
+        }
+        if (iou > iou_threshold) {
+            return true;
+        }
+    }
 
-    return I / U;
+    return false;
 }
 
-static ppl::common::RetCode nms_ndarray_naive(
-    const float *boxes,
-    const float *scommons,
+static void nms_one_class(
+    const nms_decoded_boxes_fp32 &boxes,
+    const float *p_scores,
     const uint32_t num_boxes_in,
-    const uint32_t batch,
-    const uint32_t num_classes,
-    const bool center_point_box,
-    const int64_t maxoutput_boxes_per_batch_per_class,
+    const int64_t max_output_boxes,
     const float iou_threshold,
-    const float scommon_threshold,
-    int64_t *dst,
-    int64_t *num_boxes_out)
+    const float score_threshold,
+    std::vector<uint32_t> *selected)
 {
-    std::vector<uint32_t> sorted_index_;
-    std::vector<uint32_t> selected_index_;
-    sorted_index_.resize(num_boxes_in);
-    selected_index_.resize(num_boxes_in);
-    uint32_t *sorted_index   = sorted_index_.data();
-    uint32_t *selected_index = selected_index_.data();
+    // boxes whose scores are not greater than threshold are never selected
+    std::vector<uint32_t> candidates;
+    candidates.reserve(num_boxes_in);
+    for (uint32_t i = 0; i < num_boxes_in; ++i) {
+        if (p_scores[i] > score_threshold) {
+            candidates.push_back(i);
+        }
+    }
+    if (candidates.empty()) {
+        return;
+    }
 
-    uint64_t out_idx = 0;
-    for (int64_t n = 0; n < batch; n++) {
-        const float *p_boxes = boxes + n * num_boxes_in * 4;
-        for (int64_t c = 0; c < num_classes; c++) {
-            int64_t selected_num   = 0;
-            const float *p_scommons = scommons + (n * num_classes + c) * num_boxes_in;
-            argsort(p_scommons, sorted_index, num_boxes_in);
-            for (int64_t i = 0; i < num_boxes_in; i++) {
-                int64_t idx = sorted_index[i];
-                if (p_scommons[idx] <= scommon_threshold) {
-                    break;
-                }
-                bool keep = true;
-                for (int64_t j = 0; j < selected_num; j++) {
-                    float iou = calc_iou(p_boxes, idx, selected_index[j], center_point_box);
-                    if (iou > iou_threshold) {
-                        keep = false;
-                        break;
-                    }
-                }
-                if (keep) { // box i has not been suppressed
-                    selected_index[selected_num++] = idx;
-                }
-                if (selected_num >= maxoutput_boxes_per_batch_per_class) {
-                    break;
-                }
-            }
-            // process result
-            for (int64_t i = 0; i < selected_num; i++) {
-                int64_t *p_dst = dst + out_idx * 3;
-
-                p_dst[0] = n;
-                p_dst[1] = c;
-                p_dst[2] = selected_index[i];
-                out_idx++;
+    // same order as a stable sort by scores in descending order
+    auto cmp = [p_scores](const uint32_t a, const uint32_t b) {
+        return p_scores[a] > p_scores[b] || (p_scores[a] == p_scores[b] && a < b);
+    };
+
+    const int64_t num_candidates = candidates.size();
+    const int64_t max_selected   = max<int64_t>(1, min<int64_t>(max_output_boxes, num_candidates));
+    const int64_t min_sort_len   = 64;
+
+    nms_decoded_boxes_fp32 kept;
+    kept.resize(max_selected);
+    selected->reserve(max_selected);
+
+    // candidates are sorted lazily in growing chunks since the loop usually stops early
+    int64_t sorted_end = 0;
+    for (int64_t i = 0; i < num_candidates; ++i) {
+        if (i == sorted_end) {
+            const int64_t new_end = min(num_candidates, sorted_end + max(min_sort_len, sorted_end));
+            if (new_end < num_candidates) {
+                std::nth_element(candidates.begin() + sorted_end, candidates.begin() + new_end, candidates.end(), cmp);
             }
+            std::sort(candidates.begin() + sorted_end, candidates.begin() + new_end, cmp);
+            sorted_end = new_end;
         }
-    }
 
-    *num_boxes_out = out_idx;
-    return ppl::common::RC_SUCCESS;
+        const uint32_t idx         = candidates[i];
+        const int64_t selected_num = selected->size();
+        if (!is_suppressed(boxes, idx, kept, selected_num, iou_threshold)) {
+            kept.copy_from(selected_num, boxes, idx);
+            selected->push_back(idx);
+        }
+        if ((int64_t)selected->size() >= max_output_boxes) {
+            break;
+        }
+    }
 }
 
 ppl::common::RetCode nms_ndarray_fp32(
@@ -138,7 +218,43 @@ ppl::common::RetCode nms_ndarray_fp32(
     int64_t *dst,
     int64_t *num_boxes_out)
 {
-    return nms_ndarray_naive(boxes, scommons, num_boxes_in, batch, num_classes, center_point_box, maxoutput_boxes_per_batch_per_class, iou_threshold, scommon_threshold, dst, num_boxes_out);
+    std::vector<nms_decoded_boxes_fp32> decoded_boxes(batch);
+    for (int64_t n = 0; n < batch; n++) {
+        decoded_boxes[n].resize(num_boxes_in);
+    }
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t i = 0; i < (int64_t)batch * num_boxes_in; i++) {
+        const int64_t n = i / num_boxes_in;
+        decode_box(boxes + i * 4, center_point_box, &decoded_boxes[n], i - n * num_boxes_in);
+    }
+
+    // batch x class pairs are independent
+    const int64_t num_tasks = (int64_t)batch * num_classes;
+    std::vector<std::vector<uint32_t>> selected_index(num_tasks);
+    PRAGMA_OMP_PARALLEL_FOR_SCHEDULE(dynamic)
+    for (int64_t t = 0; t < num_tasks; t++) {
+        const int64_t n = t / num_classes;
+        nms_one_class(
+            decoded_boxes[n], scommons + t * num_boxes_in, num_boxes_in,
+            maxoutput_boxes_per_batch_per_class, iou_threshold, scommon_threshold, &selected_index[t]);
+    }
+
+    uint64_t out_idx = 0;
+    for (int64_t t = 0; t < num_tasks; t++) {
+        const int64_t n = t / num_classes;
+        const int64_t c = t - n * num_classes;
+        for (auto idx : selected_index[t]) {
+            int64_t *p_dst = dst + out_idx * 3;
+
+            p_dst[0] = n;
+            p_dst[1] = c;
+            p_dst[2] = idx;
+            out_idx++;
+        }
+    }
+
+    *num_boxes_out = out_idx;
+    return ppl::common::RC_SUCCESS;
 }
 
 }}}; // namespace ppl::kernel::x86
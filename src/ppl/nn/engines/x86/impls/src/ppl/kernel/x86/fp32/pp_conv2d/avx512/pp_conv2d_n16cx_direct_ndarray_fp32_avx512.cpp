@@ -0,0 +1,492 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <immintrin.h>
+#include <float.h>
+#include <vector>
+
+#include "ppl/kernel/x86/fp32/maxpool2d.h"
+#include "ppl/kernel/x86/fp32/averagepool2d.h"
+#include "ppl/kernel/x86/fp32/conv2d/direct_ndarray/avx512/conv2d_n16cx_direct_ndarray_fp32_avx512.h"
+#include "ppl/kernel/x86/fp32/conv2d/direct_ndarray/avx512/conv2d_n16cx_direct_ndarray_kernel_fp32_avx512.h"
+#include "ppl/kernel/x86/fp32/pp_conv2d/avx512/pp_conv2d_n16cx_direct_ndarray_fp32_avx512.h"
+#include "ppl/kernel/x86/common/array_param_helper.h"
+#include "ppl/nn/params/onnx/pooling_param.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+static const int64_t ASSUME_L2_BYTES = 256 * 1024;
+static const int64_t ASSUME_L3_BYTES = 2048 * 1024;
+static const float L2_RATIO = 0.251f;
+static const float L3_RATIO = 0.501f;
+
+static const int64_t OC_DATA_BLK = conv2d_n16cx_direct_ndarray_kernel_fp32_avx512::config::OC_DATA_BLK;
+
+static const int64_t OC_L2_BLK_MAX = 4 * OC_DATA_BLK;
+static const int64_t OH_L2_BLK_MIN = 8;
+static const int64_t POOL_OW_BLK = 4;
+
+template <bool is_max>
+static inline void pooling_n16cx_border_fp32_avx512(
+    const float **src_kh_list,
+    const int64_t src_kh_len,
+    const int64_t src_w,
+    const pp_conv2d_pooling_param &pl_p,
+    const bool exclude_pad,
+    const int64_t ow,
+    const int32_t use_nt_store,
+    float *dst)
+{
+    const int64_t iw_offset = ow * pl_p.stride_w - pl_p.pad_w;
+    const int64_t iw_start  = max<int64_t>(iw_offset, 0);
+    const int64_t iw_end    = min<int64_t>(iw_offset + pl_p.kernel_w, src_w);
+    __m512 zmm0 = is_max ? _mm512_set1_ps(-FLT_MAX) : _mm512_setzero_ps();
+    for (int64_t kh = 0; kh < src_kh_len; ++kh) {
+        const float *src = src_kh_list[kh] + iw_start * OC_DATA_BLK;
+        for (int64_t iw = iw_start; iw < iw_end; ++iw) {
+            zmm0 = is_max ? _mm512_max_ps(zmm0, _mm512_loadu_ps(src)) : _mm512_add_ps(zmm0, _mm512_loadu_ps(src));
+            src += OC_DATA_BLK;
+        }
+    }
+    if (!is_max) {
+        const int64_t pool_len = exclude_pad ? src_kh_len * (iw_end - iw_start) : pl_p.kernel_h * pl_p.kernel_w;
+        const __m512 zmm_scale = _mm512_set1_ps(1.0f / pool_len);
+        zmm0 = _mm512_mul_ps(zmm0, zmm_scale);
+    }
+    float *l_dst = dst + ow * OC_DATA_BLK;
+    if (use_nt_store) {
+        _mm512_stream_ps(l_dst, zmm0);
+    } else {
+        _mm512_storeu_ps(l_dst, zmm0);
+    }
+}
+
+// POOL_OW_BLK dst points whose windows lie inside the conv row
+template <bool is_max>
+static inline void pooling_n16cx_body_fp32_avx512(
+    const float **src_kh_list,
+    const int64_t src_kh_len,
+    const pp_conv2d_pooling_param &pl_p,
+    const __m512 &zmm_scale,
+    const int64_t ow,
+    const int32_t use_nt_store,
+    float *dst)
+{
+    const int64_t src_sw_stride = pl_p.stride_w * OC_DATA_BLK;
+    __m512 zmm0, zmm1, zmm2, zmm3;
+    zmm0 = is_max ? _mm512_set1_ps(-FLT_MAX) : _mm512_setzero_ps();
+    zmm1 = zmm0;
+    zmm2 = zmm0;
+    zmm3 = zmm0;
+    for (int64_t kh = 0; kh < src_kh_len; ++kh) {
+        const float *src = src_kh_list[kh] + (ow * pl_p.stride_w - pl_p.pad_w) * OC_DATA_BLK;
+        for (int64_t kw = 0; kw < pl_p.kernel_w; ++kw) {
+            zmm0 = is_max ? _mm512_max_ps(zmm0, _mm512_loadu_ps(src)) : _mm512_add_ps(zmm0, _mm512_loadu_ps(src));
+            zmm1 = is_max ? _mm512_max_ps(zmm1, _mm512_loadu_ps(src + src_sw_stride)) : _mm512_add_ps(zmm1, _mm512_loadu_ps(src + src_sw_stride));
+            zmm2 = is_max ? _mm512_max_ps(zmm2, _mm512_loadu_ps(src + 2 * src_sw_stride)) : _mm512_add_ps(zmm2, _mm512_loadu_ps(src + 2 * src_sw_stride));
+            zmm3 = is_max ? _mm512_max_ps(zmm3, _mm512_loadu_ps(src + 3 * src_sw_stride)) : _mm512_add_ps(zmm3, _mm512_loadu_ps(src + 3 * src_sw_stride));
+            src += OC_DATA_BLK;
+        }
+    }
+    if (!is_max) {
+        zmm0 = _mm512_mul_ps(zmm0, zmm_scale);
+        zmm1 = _mm512_mul_ps(zmm1, zmm_scale);
+        zmm2 = _mm512_mul_ps(zmm2, zmm_scale);
+        zmm3 = _mm512_mul_ps(zmm3, zmm_scale);
+    }
+    float *l_dst = dst + ow * OC_DATA_BLK;
+    if (use_nt_store) {
+        _mm512_stream_ps(l_dst + 0 * OC_DATA_BLK, zmm0);
+        _mm512_stream_ps(l_dst + 1 * OC_DATA_BLK, zmm1);
+        _mm512_stream_ps(l_dst + 2 * OC_DATA_BLK, zmm2);
+        _mm512_stream_ps(l_dst + 3 * OC_DATA_BLK, zmm3);
+    } else {
+        _mm512_storeu_ps(l_dst + 0 * OC_DATA_BLK, zmm0);
+        _mm512_storeu_ps(l_dst + 1 * OC_DATA_BLK, zmm1);
+        _mm512_storeu_ps(l_dst + 2 * OC_DATA_BLK, zmm2);
+        _mm512_storeu_ps(l_dst + 3 * OC_DATA_BLK, zmm3);
+    }
+}
+
+// pool one dst row of 16 channels from the conv rows of valid kh
+template <bool is_max>
+static void pooling_n16cx_row_fp32_avx512(
+    const float **src_kh_list,
+    const int64_t src_kh_len,
+    const int64_t src_w,
+    const pp_conv2d_pooling_param &pl_p,
+    const int64_t dst_w,
+    const int32_t use_nt_store,
+    float *dst)
+{
+    const bool exclude_pad = pl_p.mode == ppl::nn::onnx::PoolingParam::POOLING_AVERAGE_EXCLUDE;
+    const int64_t body_len = src_w + pl_p.pad_w - pl_p.kernel_w;
+    const int64_t ow_body_start = min<int64_t>(div_up(pl_p.pad_w, pl_p.stride_w), dst_w);
+    const int64_t ow_body_end = body_len < 0 ? ow_body_start : max<int64_t>(min<int64_t>(body_len / pl_p.stride_w + 1, dst_w), ow_body_start);
+    const __m512 zmm_scale = _mm512_set1_ps(1.0f / (exclude_pad ? src_kh_len * pl_p.kernel_w : pl_p.kernel_h * pl_p.kernel_w));
+
+    int64_t ow = 0;
+    for (; ow < ow_body_start; ++ow) {
+        pooling_n16cx_border_fp32_avx512<is_max>(src_kh_list, src_kh_len, src_w, pl_p, exclude_pad, ow, use_nt_store, dst);
+    }
+    for (; ow + POOL_OW_BLK <= ow_body_end; ow += POOL_OW_BLK) {
+        pooling_n16cx_body_fp32_avx512<is_max>(src_kh_list, src_kh_len, pl_p, zmm_scale, ow, use_nt_store, dst);
+    }
+    for (; ow < dst_w; ++ow) {
+        pooling_n16cx_border_fp32_avx512<is_max>(src_kh_list, src_kh_len, src_w, pl_p, exclude_pad, ow, use_nt_store, dst);
+    }
+}
+
+void pp_conv2d_n16cx_direct_ndarray_fp32_avx512_executor::init_preproc_param()
+{
+    auto dr_param = conv2d_executor_->conv_param();
+    schedule_param_.ic_per_grp = dr_param->channels / dr_param->group;
+    schedule_param_.oc_per_grp = dr_param->num_output / dr_param->group;
+    schedule_param_.padded_oc = round_up(schedule_param_.oc_per_grp, OC_DATA_BLK);
+    schedule_param_.dr_ker_blk = conv2d_n16cx_direct_ndarray_kernel_fp32_avx512::config::MAX_W_BLK;
+    schedule_param_.oc_ker_blk = conv2d_n16cx_direct_ndarray_kernel_fp32_avx512::config::MAX_OC_BLK;
+
+    inter_shape_.SetDimCount(src_shape_->GetDimCount());
+    inter_shape_.SetDim(0, src_shape_->GetDim(0));
+    inter_shape_.SetDim(1, dr_param->num_output);
+    const int64_t dr_ekh = (dr_param->kernel_h - 1) * dr_param->dilation_h + 1;
+    const int64_t dr_ekw = (dr_param->kernel_w - 1) * dr_param->dilation_w + 1;
+    const int64_t inter_h = ((src_shape_->GetDim(2) + 2 * dr_param->pad_h - dr_ekh) / dr_param->stride_h + 1);
+    const int64_t inter_w = ((src_shape_->GetDim(3) + 2 * dr_param->pad_w - dr_ekw) / dr_param->stride_w + 1);
+    inter_shape_.SetDim(2, inter_h);
+    inter_shape_.SetDim(3, inter_w);
+    inter_shape_.SetDataType(ppl::common::DATATYPE_FLOAT32);
+    inter_shape_.SetDataFormat(ppl::common::DATAFORMAT_N16CX);
+
+    conv2d_executor_->set_src_shape(src_shape_);
+    conv2d_executor_->set_dst_shape(&inter_shape_);
+}
+
+void pp_conv2d_n16cx_direct_ndarray_fp32_avx512_executor::cal_kernel_tunning_param()
+{
+    const conv2d_fp32_param &dr_p       = *conv2d_executor_->conv_param();
+    const pp_conv2d_pooling_param &pl_p = *pooling_param_;
+    kernel_schedule_param &sp           = schedule_param_;
+
+    const int64_t num_thread = PPL_OMP_MAX_THREADS();
+    const int64_t batch      = src_shape_->GetDim(0);
+    const int64_t src_h      = src_shape_->GetDim(2);
+    const int64_t src_w      = src_shape_->GetDim(3);
+    const int64_t dst_h      = dst_shape_->GetDim(2);
+    const int64_t dst_w      = dst_shape_->GetDim(3);
+    const int64_t inter_h    = inter_shape_.GetDim(2);
+    const int64_t inter_w    = inter_shape_.GetDim(3);
+
+    const float l2_cap_per_core = (ppl::common::GetCpuCacheL2() == 0 ? ASSUME_L2_BYTES : ppl::common::GetCpuCacheL2()) * L2_RATIO / sizeof(float);
+    const float l3_cap_all_core = (ppl::common::GetCpuCacheL3() == 0 ? (ASSUME_L3_BYTES * num_thread) : ppl::common::GetCpuCacheL3()) * L3_RATIO / sizeof(float);
+
+    sp.dr_unroll_w_start = -1;
+    sp.dr_unroll_w_end = -1;
+    for (int64_t iw = 0; iw < inter_w; ++iw) {
+        if (iw * dr_p.stride_w - dr_p.pad_w >= 0) {
+            sp.dr_unroll_w_start = iw;
+            break;
+        }
+    }
+    for (int64_t iw = inter_w - 1; iw >= 0; --iw) {
+        if (iw * dr_p.stride_w - dr_p.pad_w + dr_p.kernel_w <= src_w) {
+            sp.dr_unroll_w_end = iw + 1;
+            break;
+        }
+    }
+    if (sp.dr_unroll_w_start >= sp.dr_unroll_w_end || sp.dr_unroll_w_start < 0 || sp.dr_unroll_w_end < 0) {
+        sp.dr_unroll_w_start = sp.dr_unroll_w_end = inter_w;
+    }
+
+    // split channels before rows, conv rows shared by two oh blocks are computed twice
+    sp.oc_l2_blk = min(OC_L2_BLK_MAX, sp.padded_oc);
+    while (batch * div_up(sp.padded_oc, sp.oc_l2_blk) < num_thread && sp.oc_l2_blk > OC_DATA_BLK) {
+        sp.oc_l2_blk -= OC_DATA_BLK;
+    }
+
+    sp.oh_l2_blk = dst_h;
+    const int64_t task_bo = batch * div_up(sp.padded_oc, sp.oc_l2_blk);
+    const int64_t oh_thread = div_up(num_thread, task_bo);
+    if (oh_thread > 1) {
+        sp.oh_l2_blk = max(dst_h / oh_thread, OH_L2_BLK_MIN);
+    }
+    while (true
+        && task_bo * div_up(dst_h, sp.oh_l2_blk) < num_thread * 4
+        && task_bo % num_thread != 0
+        && sp.oh_l2_blk > OH_L2_BLK_MIN) {
+
+        if (dst_h / sp.oh_l2_blk <= 2) {
+            sp.oh_l2_blk /= 2;
+        } else {
+            sp.oh_l2_blk -= 1;
+        }
+    }
+    sp.oh_l2_blk = max<int64_t>(sp.oh_l2_blk, 1);
+
+    sp.use_nt_store = 0;
+    if (batch * sp.padded_oc * dst_h * dst_w > l3_cap_all_core * 3) {
+        sp.use_nt_store = 1;
+    }
+
+    const int64_t inter_buffer_len = pl_p.kernel_h * inter_w * sp.oc_l2_blk;
+    const int64_t feature_map_len = batch * (sp.ic_per_grp * src_h * src_w + sp.padded_oc * inter_h * inter_w);
+    const float recompute_ratio = float(max<int64_t>(pl_p.kernel_h - pl_p.stride_h, 0)) / (sp.oh_l2_blk * pl_p.stride_h);
+    const bool large_inter_cost = inter_buffer_len > (l2_cap_per_core / L2_RATIO); // inter buffer oversized
+    const bool small_feature_map = feature_map_len < (l2_cap_per_core * 2); // data already in L2 of one core, pooling reads it back for free
+    const bool heavy_recompute = recompute_ratio > 0.25f; // overlapped rows dominate small oh blocks
+    if (large_inter_cost || small_feature_map || heavy_recompute) {
+        mode_ = pp_conv2d_fp32_mode::SEPARATE;
+    } else {
+        mode_ = pp_conv2d_fp32_mode::FUSE;
+    }
+}
+
+uint64_t pp_conv2d_n16cx_direct_ndarray_fp32_avx512_executor::cal_temp_buffer_size()
+{
+    if (mode_ == pp_conv2d_fp32_mode::SEPARATE) {
+        schedule_param_.dr_temp_buffer_size = round_up(conv2d_executor_->cal_temp_buffer_size(), PPL_X86_CACHELINE_BYTES());
+        return schedule_param_.dr_temp_buffer_size + inter_shape_.GetBytesIncludingPadding();
+    } else {
+        const uint64_t inter_buffer_size = (uint64_t)pooling_param_->kernel_h * inter_shape_.GetDim(3) * schedule_param_.oc_l2_blk * sizeof(float);
+        return inter_buffer_size * PPL_OMP_MAX_THREADS();
+    }
+}
+
+ppl::common::RetCode pp_conv2d_n16cx_direct_ndarray_fp32_avx512_executor::prepare()
+{
+    bool dr_prepare_ready = conv2d_executor_ && conv2d_executor_->conv_param();
+    if (!dr_prepare_ready || !pooling_param_ || !src_shape_ || !dst_shape_) {
+        return ppl::common::RC_INVALID_VALUE;
+    }
+
+    init_preproc_param();
+    cal_kernel_tunning_param();
+
+    if (mode_ == pp_conv2d_fp32_mode::SEPARATE) {
+        return conv2d_executor_->prepare();
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+ppl::common::RetCode pp_conv2d_n16cx_direct_ndarray_fp32_avx512_executor::execute() {
+    if (mode_ == pp_conv2d_fp32_mode::SEPARATE) {
+        return separate_execute();
+    }
+    if (mode_ == pp_conv2d_fp32_mode::FUSE) {
+        return fuse_execute();
+    }
+    return ppl::common::RC_INVALID_VALUE;
+}
+
+ppl::common::RetCode pp_conv2d_n16cx_direct_ndarray_fp32_avx512_executor::separate_execute()
+{
+    if (!conv2d_executor_ || !pooling_param_ || !src_ || !dst_ || !temp_buffer_) {
+        return ppl::common::RC_INVALID_VALUE;
+    }
+    const pp_conv2d_pooling_param &pl_p = *pooling_param_;
+    uint8_t *dr_temp_buffer = (uint8_t *)temp_buffer_;
+    float *inter_buffer = (float*)(dr_temp_buffer + schedule_param_.dr_temp_buffer_size);
+    conv2d_executor_->set_src(src_);
+    conv2d_executor_->set_dst(inter_buffer);
+    conv2d_executor_->set_temp_buffer(dr_temp_buffer);
+
+    auto ret = conv2d_executor_->execute();
+    if (ppl::common::RC_SUCCESS != ret) {
+        return ret;
+    }
+    if (pl_p.mode == ppl::nn::onnx::PoolingParam::POOLING_MAX) {
+        return maxpool2d_n16cx_blk1x16_fp32_avx512(
+            &inter_shape_, dst_shape_, inter_buffer,
+            pl_p.kernel_h, pl_p.kernel_w, pl_p.stride_h, pl_p.stride_w,
+            pl_p.pad_h, pl_p.pad_w, dst_);
+    }
+    return averagepool2d_n16cx_blk1x16_fp32_avx512(
+        &inter_shape_, dst_shape_, inter_buffer,
+        pl_p.kernel_h, pl_p.kernel_w, pl_p.stride_h, pl_p.stride_w,
+        pl_p.pad_h, pl_p.pad_w, pl_p.mode, 0, dst_);
+}
+
+ppl::common::RetCode pp_conv2d_n16cx_direct_ndarray_fp32_avx512_executor::fuse_execute()
+{
+    bool dr_execute_ready = conv2d_executor_ && conv2d_executor_->conv_param() && conv2d_executor_->cvt_filter() && conv2d_executor_->cvt_bias();
+    if (!dr_execute_ready || !pooling_param_ || !src_ || !dst_ || !temp_buffer_) {
+        return ppl::common::RC_INVALID_VALUE;
+    }
+
+    auto dr_e = conv2d_executor_;
+    const conv2d_fp32_param &dr_p       = *dr_e->conv_param();
+    const pp_conv2d_pooling_param &pl_p = *pooling_param_;
+    const kernel_schedule_param &sp     = schedule_param_;
+
+    const int64_t batch         = src_shape_->GetDim(0);
+    const int64_t src_h         = src_shape_->GetDim(2);
+    const int64_t src_w         = src_shape_->GetDim(3);
+    const int64_t dst_h         = dst_shape_->GetDim(2);
+    const int64_t dst_w         = dst_shape_->GetDim(3);
+    const int64_t inter_h       = inter_shape_.GetDim(2);
+    const int64_t inter_w       = inter_shape_.GetDim(3);
+
+    const int64_t src_b_stride     = src_shape_->GetDim(1) * src_h * src_w;
+    const int64_t src_c_stride     = src_h * src_w;
+    const int64_t dr_flt_c_stride  = dr_p.kernel_h * dr_p.kernel_w * OC_DATA_BLK;
+    const int64_t dr_flt_oc_stride = sp.ic_per_grp * dr_p.kernel_h * dr_p.kernel_w;
+
+    // per thread ring buffer of kernel_h conv rows: [oc_l2_blk / OC_DATA_BLK][kernel_h][inter_w][OC_DATA_BLK]
+    const int64_t inter_h_stride  = inter_w * OC_DATA_BLK;
+    const int64_t inter_oc_stride = pl_p.kernel_h * inter_w;
+
+    const int64_t dst_b_stride   = round_up(dst_shape_->GetDim(1), OC_DATA_BLK) * dst_h * dst_w;
+    const int64_t dst_ocb_stride = dst_h * dst_w * OC_DATA_BLK;
+    const int64_t dst_h_stride   = dst_w * OC_DATA_BLK;
+
+    const bool dr_with_relu  = dr_p.fuse_flag & conv_fuse_flag::RELU;
+    const bool dr_with_relu6 = dr_p.fuse_flag & conv_fuse_flag::RELU6;
+
+    int64_t dr_ker_flags = 0;
+    if (dr_with_relu)  dr_ker_flags |= conv2d_n16cx_direct_ndarray_kernel_fp32_avx512::flag::RELU;
+    if (dr_with_relu6) dr_ker_flags |= conv2d_n16cx_direct_ndarray_kernel_fp32_avx512::flag::RELU6;
+
+    const uint64_t inter_buffer_len = (uint64_t)inter_oc_stride * sp.oc_l2_blk;
+
+#ifdef PPL_USE_X86_OMP_COLLAPSE
+    PRAGMA_OMP_PARALLEL_FOR_COLLAPSE(3)
+#endif
+    for (int64_t b = 0; b < batch; ++b) {
+#ifndef PPL_USE_X86_OMP_COLLAPSE
+        PRAGMA_OMP_PARALLEL_FOR()
+#endif
+        for (int64_t ocl2 = 0; ocl2 < sp.padded_oc; ocl2 += sp.oc_l2_blk) {
+            for (int64_t ohl2 = 0; ohl2 < dst_h; ohl2 += sp.oh_l2_blk) {
+                const int64_t ocl2_eff = min(sp.padded_oc - ocl2, sp.oc_l2_blk);
+                const int64_t ohl2_eff = min(dst_h - ohl2, sp.oh_l2_blk);
+
+                float *inter_buffer = (float*)temp_buffer_ + inter_buffer_len * PPL_OMP_THREAD_ID();
+                int64_t ih_scroll   = 0;
+
+                int64_t dr_ker_param[conv2d_n16cx_direct_ndarray_kernel_fp32_avx512::param_def::LENGTH];
+                array_param_helper dr_ker_p(dr_ker_param);
+                conv2d_n16cx_direct_ndarray_kernel_fp32_avx512 dr_ker(dr_ker_param);
+
+                std::vector<const float*> pl_src_kh_list(pl_p.kernel_h, nullptr);
+
+                dr_ker_p.pick<int64_t>(conv2d_n16cx_direct_ndarray_kernel_fp32_avx512::param_def::CHANNELS_IDX)           = sp.ic_per_grp;
+                dr_ker_p.pick<int64_t>(conv2d_n16cx_direct_ndarray_kernel_fp32_avx512::param_def::KH_IDX)                 = dr_p.kernel_h;
+                dr_ker_p.pick<int64_t>(conv2d_n16cx_direct_ndarray_kernel_fp32_avx512::param_def::KW_IDX)                 = dr_p.kernel_w;
+                dr_ker_p.pick<int64_t>(conv2d_n16cx_direct_ndarray_kernel_fp32_avx512::param_def::SW_IDX)                 = dr_p.stride_w;
+                dr_ker_p.pick<int64_t>(conv2d_n16cx_direct_ndarray_kernel_fp32_avx512::param_def::SRC_H_STRIDE_IDX)       = src_w;
+                dr_ker_p.pick<int64_t>(conv2d_n16cx_direct_ndarray_kernel_fp32_avx512::param_def::SRC_C_STRIDE_IDX)       = src_c_stride;
+                dr_ker_p.pick<int64_t>(conv2d_n16cx_direct_ndarray_kernel_fp32_avx512::param_def::FLT_C_STRIDE_IDX)       = dr_flt_c_stride;
+                dr_ker_p.pick<int64_t>(conv2d_n16cx_direct_ndarray_kernel_fp32_avx512::param_def::SUM_SRC_OCB_STRIDE_IDX) = inter_oc_stride * OC_DATA_BLK;
+                dr_ker_p.pick<int64_t>(conv2d_n16cx_direct_ndarray_kernel_fp32_avx512::param_def::DST_OCB_STRIDE_IDX)     = inter_oc_stride * OC_DATA_BLK;
+                dr_ker_p.pick<int64_t>(conv2d_n16cx_direct_ndarray_kernel_fp32_avx512::param_def::FLT_OCB_STRIDE_IDX)     = dr_flt_oc_stride * OC_DATA_BLK;
+                dr_ker_p.pick<int64_t>(conv2d_n16cx_direct_ndarray_kernel_fp32_avx512::param_def::FLAGS_IDX)              = dr_ker_flags;
+                for (int64_t oh = ohl2; oh < ohl2 + ohl2_eff; ++oh) {
+                    const int64_t ih_offset   = oh * pl_p.stride_h - pl_p.pad_h;
+                    const int64_t ih_start    = max<int64_t>(ih_offset, 0);
+                    const int64_t ih_end      = min<int64_t>(ih_offset + pl_p.kernel_h, inter_h);
+                    ih_scroll                 = max(ih_start, ih_scroll);
+
+                    for (int64_t ih = ih_scroll; ih < ih_end; ++ih) {
+                        const int64_t eh          = ih * dr_p.stride_h - dr_p.pad_h;
+                        const int64_t dr_kh_start = min<int64_t>(max<int64_t>(0 - eh, 0), dr_p.kernel_h - 1);
+                        const int64_t dr_kh_end   = max<int64_t>(min<int64_t>(src_h - eh, dr_p.kernel_h), 0);
+
+                        const int64_t iw_unroll_len  = sp.dr_unroll_w_end - sp.dr_unroll_w_start;
+                        const int64_t iw_unroll_body = round(iw_unroll_len, sp.dr_ker_blk);
+                        const int64_t iw_unroll_tail = iw_unroll_len - iw_unroll_body;
+
+                        const float *base_src  = src_ + b * src_b_stride + eh * src_w - dr_p.pad_w;
+                        float *base_dst        = inter_buffer + (ih % pl_p.kernel_h) * inter_h_stride;
+                        const float *base_flt  = dr_e->cvt_filter() + ocl2 * sp.ic_per_grp * dr_p.kernel_h * dr_p.kernel_w;
+                        const float *base_bias = dr_e->cvt_bias() + ocl2;
+
+                        dr_ker_p.pick<int64_t>(conv2d_n16cx_direct_ndarray_kernel_fp32_avx512::param_def::KH_START_IDX)      = dr_kh_start;
+                        dr_ker_p.pick<int64_t>(conv2d_n16cx_direct_ndarray_kernel_fp32_avx512::param_def::KH_END_IDX)        = dr_kh_end;
+                        dr_ker_p.pick<const float*>(conv2d_n16cx_direct_ndarray_kernel_fp32_avx512::param_def::FLT_PTR_IDX)  = base_flt;
+                        dr_ker_p.pick<const float*>(conv2d_n16cx_direct_ndarray_kernel_fp32_avx512::param_def::BIAS_PTR_IDX) = base_bias;
+                        for (int64_t oc = ocl2; oc < ocl2 + ocl2_eff; oc += sp.oc_ker_blk) {
+                            const int64_t oc_eff = min<int64_t>(ocl2 + ocl2_eff - oc, sp.oc_ker_blk);
+                            const int64_t oc_reg = div_up(oc_eff, OC_DATA_BLK);
+                            dr_ker_p.pick<const float*>(conv2d_n16cx_direct_ndarray_kernel_fp32_avx512::param_def::SRC_PTR_IDX) = base_src;
+                            dr_ker_p.pick<float*>(conv2d_n16cx_direct_ndarray_kernel_fp32_avx512::param_def::DST_PTR_IDX)       = base_dst;
+
+                            for (int64_t iw = 0; iw < sp.dr_unroll_w_start; ++iw) {
+                                const int64_t ew          = iw * dr_p.stride_w - dr_p.pad_w;
+                                const int64_t dr_kw_start = min<int64_t>(max<int64_t>(0 - ew, 0), dr_p.kernel_w - 1);
+                                const int64_t dr_kw_end   = max<int64_t>(min<int64_t>(src_w - ew, dr_p.kernel_w), 0);
+                                dr_ker_p.pick<int64_t>(conv2d_n16cx_direct_ndarray_kernel_fp32_avx512::param_def::KW_START_IDX) = dr_kw_start;
+                                dr_ker_p.pick<int64_t>(conv2d_n16cx_direct_ndarray_kernel_fp32_avx512::param_def::KW_END_IDX)   = dr_kw_end;
+                                dr_ker.execute_border(0, oc_reg);
+                            }
+
+                            if (iw_unroll_body) {
+                                dr_ker_p.pick<int64_t>(conv2d_n16cx_direct_ndarray_kernel_fp32_avx512::param_def::DST_WIDTH_IDX) = iw_unroll_body;
+                                dr_ker.execute(0, oc_reg, sp.dr_ker_blk);
+                            }
+                            if (iw_unroll_tail) {
+                                dr_ker_p.pick<int64_t>(conv2d_n16cx_direct_ndarray_kernel_fp32_avx512::param_def::DST_WIDTH_IDX) = iw_unroll_tail;
+                                dr_ker.execute(0, oc_reg, iw_unroll_tail);
+                            }
+
+                            for (int64_t iw = sp.dr_unroll_w_end; iw < inter_w; ++iw) {
+                                const int64_t ew          = iw * dr_p.stride_w - dr_p.pad_w;
+                                const int64_t dr_kw_start = min<int64_t>(max<int64_t>(0 - ew, 0), dr_p.kernel_w - 1);
+                                const int64_t dr_kw_end   = max<int64_t>(min<int64_t>(src_w - ew, dr_p.kernel_w), 0);
+                                dr_ker_p.pick<int64_t>(conv2d_n16cx_direct_ndarray_kernel_fp32_avx512::param_def::KW_START_IDX) = dr_kw_start;
+                                dr_ker_p.pick<int64_t>(conv2d_n16cx_direct_ndarray_kernel_fp32_avx512::param_def::KW_END_IDX)   = dr_kw_end;
+                                dr_ker.execute_border(0, oc_reg);
+                            }
+                            dr_ker_p.pick<const float*>(conv2d_n16cx_direct_ndarray_kernel_fp32_avx512::param_def::FLT_PTR_IDX)  += sp.oc_ker_blk * dr_flt_oc_stride;
+                            dr_ker_p.pick<const float*>(conv2d_n16cx_direct_ndarray_kernel_fp32_avx512::param_def::BIAS_PTR_IDX) += sp.oc_ker_blk;
+                            base_dst += sp.oc_ker_blk * inter_oc_stride;
+                        }
+                    }
+                    ih_scroll = ih_end;
+                    { // pooling session
+                        float *base_dst = dst_ + b * dst_b_stride + ocl2 * dst_h * dst_w + oh * dst_h_stride;
+                        for (int64_t oc = 0; oc < ocl2_eff; oc += OC_DATA_BLK) {
+                            for (int64_t ih = ih_start; ih < ih_end; ++ih) {
+                                pl_src_kh_list[ih - ih_start] = inter_buffer + (ih % pl_p.kernel_h) * inter_h_stride + oc * inter_oc_stride;
+                            }
+                            if (pl_p.mode == ppl::nn::onnx::PoolingParam::POOLING_MAX) {
+                                pooling_n16cx_row_fp32_avx512<true>(
+                                    pl_src_kh_list.data(), ih_end - ih_start, inter_w,
+                                    pl_p, dst_w, sp.use_nt_store, base_dst);
+                            } else {
+                                pooling_n16cx_row_fp32_avx512<false>(
+                                    pl_src_kh_list.data(), ih_end - ih_start, inter_w,
+                                    pl_p, dst_w, sp.use_nt_store, base_dst);
+                            }
+                            base_dst += dst_ocb_stride;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    if (sp.use_nt_store) {
+        PRAGMA_OMP_PARALLEL()
+        {
+            _mm_sfence();
+        }
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+}}}; // namespace ppl::kernel::x86
@@ -0,0 +1,143 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/kernel/x86/fp32/pp_conv2d.h"
+#include "ppl/nn/params/onnx/pooling_param.h"
+
+#include "ppl/kernel/x86/fp32/pp_conv2d/fma/pp_conv2d_n16cx_direct_ndarray_fp32_fma.h"
+#include "ppl/kernel/x86/fp32/conv2d/direct_ndarray/fma/conv2d_n16cx_direct_ndarray_fp32_fma.h"
+
+#ifdef PPL_USE_X86_AVX512
+#include "ppl/kernel/x86/fp32/pp_conv2d/avx512/pp_conv2d_n16cx_direct_ndarray_fp32_avx512.h"
+#include "ppl/kernel/x86/fp32/conv2d/direct_ndarray/avx512/conv2d_n16cx_direct_ndarray_fp32_avx512.h"
+#endif
+
+namespace ppl { namespace kernel { namespace x86 {
+
+static bool pp_conv2d_is_supported_pooling(const pp_conv2d_pooling_param &pooling_param)
+{
+    return true
+        && (pooling_param.mode == ppl::nn::onnx::PoolingParam::POOLING_MAX
+            || pooling_param.mode == ppl::nn::onnx::PoolingParam::POOLING_AVERAGE_EXCLUDE
+            || pooling_param.mode == ppl::nn::onnx::PoolingParam::POOLING_AVERAGE_INCLUDE)
+        && pooling_param.kernel_h > 0
+        && pooling_param.kernel_w > 0
+        && pooling_param.stride_h > 0
+        && pooling_param.stride_w > 0
+        && pooling_param.pad_h >= 0
+        && pooling_param.pad_w >= 0
+        && pooling_param.pad_h < pooling_param.kernel_h
+        && pooling_param.pad_w < pooling_param.kernel_w;
+}
+
+pp_conv2d_fp32_algo_info pp_conv2d_algo_selector::select_algo(
+    const conv2d_fp32_algo_info &algo,
+    const conv2d_fp32_param &param,
+    const pp_conv2d_pooling_param &pooling_param)
+{
+    if (true // direct_ndarray algo
+        && algo.algo_type == ppl::kernel::x86::conv2d_fp32_algo::DIRECT
+        && algo.input_format == ppl::common::DATAFORMAT_NDARRAY
+        && algo.output_format == ppl::common::DATAFORMAT_N16CX
+        && pp_conv2d_is_supported_pooling(pooling_param))
+    {
+        if (algo.isa == ppl::common::ISA_X86_FMA) {
+            if (true // direct_ndarray fma support param
+                && !(param.fuse_flag & ppl::kernel::x86::conv_fuse_flag::SUM)
+                && param.group == 1) {
+                return {
+                    pp_conv2d_fp32_algo::DIRECT,
+                    ppl::common::ISA_X86_FMA,
+                    ppl::common::DATAFORMAT_NDARRAY,
+                    ppl::common::DATAFORMAT_N16CX};
+            }
+        }
+
+#ifdef PPL_USE_X86_AVX512
+        if (algo.isa == ppl::common::ISA_X86_AVX512) {
+            if (true // direct_ndarray avx512 support param
+                && !(param.fuse_flag & ppl::kernel::x86::conv_fuse_flag::SUM)
+                && param.group == 1) {
+                return {
+                    pp_conv2d_fp32_algo::DIRECT,
+                    ppl::common::ISA_X86_AVX512,
+                    ppl::common::DATAFORMAT_NDARRAY,
+                    ppl::common::DATAFORMAT_N16CX};
+            }
+        }
+#endif
+    }
+
+    return {
+        pp_conv2d_fp32_algo::UNKNOWN,
+        ppl::common::ISA_UNKNOWN,
+        ppl::common::DATAFORMAT_UNKNOWN,
+        ppl::common::DATAFORMAT_UNKNOWN};
+}
+
+pp_conv2d_fp32_manager *pp_conv2d_algo_selector::gen_algo(
+    const conv2d_fp32_param &param,
+    const pp_conv2d_pooling_param &pooling_param,
+    const pp_conv2d_fp32_algo_info &algo_info,
+    ppl::common::Allocator *allocator)
+{
+    if (algo_info.algo_type == pp_conv2d_fp32_algo::DIRECT &&
+        algo_info.isa == ppl::common::ISA_X86_FMA &&
+        algo_info.input_format == ppl::common::DATAFORMAT_NDARRAY &&
+        algo_info.output_format == ppl::common::DATAFORMAT_N16CX) {
+        return new pp_conv2d_n16cx_direct_ndarray_fp32_fma_manager(
+            new conv2d_n16cx_direct_ndarray_fp32_fma_manager(param, allocator), pooling_param);
+    }
+
+#ifdef PPL_USE_X86_AVX512
+    if (algo_info.algo_type == pp_conv2d_fp32_algo::DIRECT &&
+        algo_info.isa == ppl::common::ISA_X86_AVX512 &&
+        algo_info.input_format == ppl::common::DATAFORMAT_NDARRAY &&
+        algo_info.output_format == ppl::common::DATAFORMAT_N16CX) {
+        return new pp_conv2d_n16cx_direct_ndarray_fp32_avx512_manager(
+            new conv2d_n16cx_direct_ndarray_fp32_avx512_manager(param, allocator), pooling_param);
+    }
+#endif
+
+    return nullptr;
+}
+
+pp_conv2d_fp32_manager *pp_conv2d_algo_selector::gen_algo(
+    const pp_conv2d_fp32_algo_info &algo_info,
+    const pp_conv2d_pooling_param &pooling_param,
+    conv2d_fp32_manager *mgr)
+{
+    if (algo_info.algo_type == pp_conv2d_fp32_algo::DIRECT &&
+        algo_info.isa == ppl::common::ISA_X86_FMA &&
+        algo_info.input_format == ppl::common::DATAFORMAT_NDARRAY &&
+        algo_info.output_format == ppl::common::DATAFORMAT_N16CX) {
+        return new pp_conv2d_n16cx_direct_ndarray_fp32_fma_manager(mgr, pooling_param);
+    }
+
+#ifdef PPL_USE_X86_AVX512
+    if (algo_info.algo_type == pp_conv2d_fp32_algo::DIRECT &&
+        algo_info.isa == ppl::common::ISA_X86_AVX512 &&
+        algo_info.input_format == ppl::common::DATAFORMAT_NDARRAY &&
+        algo_info.output_format == ppl::common::DATAFORMAT_N16CX) {
+        return new pp_conv2d_n16cx_direct_ndarray_fp32_avx512_manager(mgr, pooling_param);
+    }
+#endif
+
+    return nullptr;
+}
+
+}}};
@@ -88,6 +88,7 @@ Define_bool(sum, false, "(false) fuse eltwise sum");
 Define_bool(validate, false, "(false) do result validation");
 Define_float(eps, 1e-6f, "(1e-6) rel error trunk for validation");
 Define_bool(dynamic, false, "(false) prepare and alloc temp buffer for each run");
+Define_float(sparsity, 0.0f, "(0.0) ratio of zero 16x1 weight blocks, for sparse algorithms");
 Define_bool(profile, false, "(false) do profile and dump profile info");
 Define_bool(export_onnx_op_test, false, "(false) export cfg to ppl onnx op test format");
 #ifdef PPL_USE_X86_AVX512
@@ -145,6 +146,15 @@ static std::map<std::string, ppl::kernel::x86::conv2d_fp32_algo_info> algo_table
             ppl::common::DATAFORMAT_N16CX
         })
     },
+    {
+        "n16cx_winograd_b6f3_fp32_fma",
+        ppl::kernel::x86::conv2d_fp32_algo_info({
+            ppl::kernel::x86::conv2d_fp32_algo::WINOGRAD_B6F3,
+            ppl::common::ISA_X86_FMA,
+            ppl::common::DATAFORMAT_N16CX,
+            ppl::common::DATAFORMAT_N16CX
+        })
+    },
     {
         "n16cx_direct_fp32_fma",
         ppl::kernel::x86::conv2d_fp32_algo_info({
@@ -163,6 +173,15 @@ static std::map<std::string, ppl::kernel::x86::conv2d_fp32_algo_info> algo_table
             ppl::common::DATAFORMAT_N16CX
         })
     },
+    {
+        "n16cx_sparse_fp32_fma",
+        ppl::kernel::x86::conv2d_fp32_algo_info({
+            ppl::kernel::x86::conv2d_fp32_algo::SPARSE,
+            ppl::common::ISA_X86_FMA,
+            ppl::common::DATAFORMAT_N16CX,
+            ppl::common::DATAFORMAT_N16CX
+        })
+    },
     {
         "im2col_gemm_fp32_fma",
         ppl::kernel::x86::conv2d_fp32_algo_info({
@@ -200,6 +219,15 @@ static std::map<std::string, ppl::kernel::x86::conv2d_fp32_algo_info> algo_table
             ppl::common::DATAFORMAT_N16CX
         })
     },
+    {
+        "n16cx_winograd_b6f3_fp32_avx512",
+        ppl::kernel::x86::conv2d_fp32_algo_info({
+            ppl::kernel::x86::conv2d_fp32_algo::WINOGRAD_B6F3,
+            ppl::common::ISA_X86_AVX512,
+            ppl::common::DATAFORMAT_N16CX,
+            ppl::common::DATAFORMAT_N16CX
+        })
+    },
     {
         "n16cx_direct_fp32_avx512",
         ppl::kernel::x86::conv2d_fp32_algo_info({
@@ -218,6 +246,15 @@ static std::map<std::string, ppl::kernel::x86::conv2d_fp32_algo_info> algo_table
             ppl::common::DATAFORMAT_N16CX
         })
     },
+    {
+        "n16cx_sparse_fp32_avx512",
+        ppl::kernel::x86::conv2d_fp32_algo_info({
+            ppl::kernel::x86::conv2d_fp32_algo::SPARSE,
+            ppl::common::ISA_X86_AVX512,
+            ppl::common::DATAFORMAT_N16CX,
+            ppl::common::DATAFORMAT_N16CX
+        })
+    },
 #endif
     {
         "n8cx_direct_fp32_sse",
@@ -561,6 +598,20 @@ DEBUG_TAG(E);
         for (uint64_t i = 0; i < filter_shape.GetElementsIncludingPadding(); ++i) {
             filter[i] = (rand() % wei_mod + wei_shift) * wei_scale;
         }
+        if (Flag_sparsity > 0.0f) {
+            const int64_t flt_hw = param.kernel_h * param.kernel_w;
+            for (int64_t g = 0; g < param.group; ++g) {
+                for (int64_t o = 0; o < oc; o += 16) {
+                    for (int64_t i = 0; i < ic; ++i) {
+                        if (rand() < Flag_sparsity * RAND_MAX) {
+                            for (int64_t oo = o; oo < std::min<int64_t>(o + 16, oc); ++oo) {
+                                memset(filter + ((g * oc + oo) * ic + i) * flt_hw, 0, flt_hw * sizeof(float));
+                            }
+                        }
+                    }
+                }
+            }
+        }
         for (uint64_t i = 0; i < bias_shape.GetElementsIncludingPadding(); ++i) {
             bias[i] = (rand() % wei_mod + wei_shift) * wei_scale * 10.0f;
         }
@@ -61,6 +61,8 @@ Define_int32(min_iter, 20, "(20) min benchmark iterations");
 Define_float(min_second, 1.0f, "(1.0) min benchmark seconds");
 Define_bool(validate, false, "(false) do result validation");
 Define_float(eps, 1e-6f, "(1e-6) rel error trunk for validation");
+Define_int32(weight_compression, 0, "(0) weight compression, 0: none, 1: fp16, 2: int8, int8 needs a larger eps to validate");
+Define_float(sparsity, 0.0f, "(0.0) ratio of zero 16x1 weight blocks, sparse algorithm is selected for sparse enough weights");
 
 int main(int argc, char **argv) {
     simple_flags::parse_args(argc, argv);
@@ -142,6 +144,8 @@ int main(int argc, char **argv) {
         }
         param.channels = K;
         param.num_output = N;
+        param.fuse_flag = ppl::kernel::x86::fc_fuse_flag::NONE;
+        param.weight_compression = Flag_weight_compression;
         if (Flag_mb) {
             M = Flag_mb;
         }
@@ -154,14 +158,6 @@ int main(int argc, char **argv) {
 
 DEBUG_TAG(A);
         ppl::common::GenericCpuAllocator allocator(PPL_X86_CACHELINE_BYTES());
-        ppl::kernel::x86::fc_fp32_algo_info algoinfo;
-
-        algoinfo = ppl::kernel::x86::fc_algo_selector::select_algo(ppl::common::DATAFORMAT_NDARRAY, param, ppl::common::GetCpuISA());
-        if (algoinfo.algo_type == ppl::kernel::x86::fc_fp32_algo::UNKNOWN) {
-            std::cerr << "," << "unsupported case\n";
-            continue;
-        }
-        auto fc_mgr = ppl::kernel::x86::fc_algo_selector::gen_algo(param, algoinfo, &allocator);
 
 DEBUG_TAG(B);
 
@@ -219,11 +215,36 @@ DEBUG_TAG(E);
         for (uint64_t i = 0; i < filter_shape.GetElementsIncludingPadding(); ++i) {
             filter[i] = (rand() % wei_mod + wei_shift) * wei_scale;
         }
+        if (Flag_sparsity > 0.0f) {
+            for (int64_t n = 0; n < N; n += 16) {
+                for (int64_t k = 0; k < K; ++k) {
+                    if (rand() < Flag_sparsity * RAND_MAX) {
+                        for (int64_t nn = n; nn < std::min<int64_t>(n + 16, N); ++nn) {
+                            filter[nn * K + k] = 0.0f;
+                        }
+                    }
+                }
+            }
+        }
         for (uint64_t i = 0; i < bias_shape.GetElementsIncludingPadding(); ++i) {
             bias[i] = (rand() % wei_mod + wei_shift) * wei_scale;
         }
         memset(dst, 0, dst_shape.GetBytesIncludingPadding());
 
+DEBUG_TAG(F);
+        ppl::kernel::x86::fc_fp32_algo_info algoinfo;
+
+        algoinfo = ppl::kernel::x86::fc_algo_selector::select_algo(ppl::common::DATAFORMAT_NDARRAY, param, ppl::common::GetCpuISA(), filter);
+        if (algoinfo.algo_type == ppl::kernel::x86::fc_fp32_algo::UNKNOWN) {
+            std::cerr << "," << "unsupported case\n";
+            allocator.Free(src);
+            allocator.Free(filter);
+            allocator.Free(bias);
+            allocator.Free(dst);
+            continue;
+        }
+        auto fc_mgr = ppl::kernel::x86::fc_algo_selector::gen_algo(param, algoinfo, &allocator);
+
 DEBUG_TAG(H);
         if (Flag_validate) {
             dst_ref = (float*)allocator.Alloc(dst_shape.GetBytesIncludingPadding());
@@ -0,0 +1,309 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <iostream>
+#include <string>
+#include <fstream>
+#include <algorithm>
+#include <vector>
+#include <random>
+#include <chrono>
+
+#include <inttypes.h>
+#include <float.h>
+#include <string.h>
+
+#if defined(__linux__) && defined(PPL_USE_X86_OMP)
+#include <omp.h>
+#endif
+
+#include "ppl/kernel/x86/fp32/nms.h"
+#include "ppl/kernel/x86/fp32/mmcv_nms.h"
+#include "ppl/kernel/x86/common/math.h"
+#include "simple_flags.h"
+
+/*
+    typical cases:
+        b1box25200c80m100_nyolov5_640
+        b1box8400c80m100_nyolov8_640
+        b1box120087c80m100_nretinanet_800
+*/
+#define CASE_STRING_FMT() "b%" PRId64 "box%" PRId64 "c%" PRId64 "m%" PRId64 "_n%s"
+
+Define_bool_opt("--help", Flag_help, false, "show these help information");
+Define_string(cfg, "", "(required) nms config file, format:" CASE_STRING_FMT());
+Define_bool(mmcv, false, "(false) test mmcv_nms, only the first class of the first batch is used");
+Define_bool(center_point_box, false, "(false) boxes are in [x_center, y_center, width, height] format");
+Define_float(iou_threshold, 0.45f, "(0.45) iou threshold");
+Define_float(score_threshold, 0.25f, "(0.25) score threshold, not used by mmcv_nms");
+Define_int32(warm_up, 10, "(10) warm up iterations");
+Define_int32(min_iter, 20, "(20) min benchmark iterations");
+Define_float(min_second, 1.0f, "(1.0) min benchmark seconds");
+Define_bool(validate, false, "(false) do result validation");
+
+static float calc_iou_ref(const float *p_boxes, int64_t i0, int64_t i1, bool centered)
+{
+    const float *b0 = p_boxes + i0 * 4;
+    const float *b1 = p_boxes + i1 * 4;
+    float x_min, x_max, y_min, y_max;
+    float w0, w1, h0, h1;
+    if (centered) {
+        w0    = b0[2];
+        w1    = b1[2];
+        h0    = b0[3];
+        h1    = b1[3];
+        x_min = std::min(b0[0] - w0 / 2, b1[0] - w1 / 2);
+        x_max = std::max(b0[0] + w0 / 2, b1[0] + w1 / 2);
+        y_min = std::min(b0[1] - h0 / 2, b1[1] - h1 / 2);
+        y_max = std::max(b0[1] + h0 / 2, b1[1] + h1 / 2);
+    } else {
+        w0    = std::abs(b0[1] - b0[3]);
+        w1    = std::abs(b1[1] - b1[3]);
+        h0    = std::abs(b0[0] - b0[2]);
+        h1    = std::abs(b1[0] - b1[2]);
+        x_min = std::min(std::min(b0[1], b0[3]), std::min(b1[1], b1[3]));
+        x_max = std::max(std::max(b0[1], b0[3]), std::max(b1[1], b1[3]));
+        y_min = std::min(std::min(b0[0], b0[2]), std::min(b1[0], b1[2]));
+        y_max = std::max(std::max(b0[0], b0[2]), std::max(b1[0], b1[2]));
+    }
+
+    if (w0 + w1 <= x_max - x_min || h0 + h1 <= y_max - y_min) {
+        return 0;
+    }
+
+    float iw = w0 + w1 - (x_max - x_min);
+    float ih = h0 + h1 - (y_max - y_min);
+    float I  = ih * iw;
+    float U  = w0 * h0 + w1 * h1 - I;
+    return I / U;
+}
+
+static int64_t nms_ref(
+    const float *boxes, const float *scores, int64_t num_boxes, int64_t batch, int64_t num_classes,
+    bool centered, int64_t max_output, float iou_threshold, float score_threshold, int64_t *dst)
+{
+    std::vector<int64_t> sorted_index(num_boxes);
+    std::vector<int64_t> selected_index;
+    int64_t out_idx = 0;
+    for (int64_t n = 0; n < batch; n++) {
+        const float *p_boxes = boxes + n * num_boxes * 4;
+        for (int64_t c = 0; c < num_classes; c++) {
+            const float *p_scores = scores + (n * num_classes + c) * num_boxes;
+            ppl::kernel::x86::argsort(p_scores, sorted_index.data(), num_boxes);
+            selected_index.clear();
+            for (int64_t i = 0; i < num_boxes; i++) {
+                int64_t idx = sorted_index[i];
+                if (p_scores[idx] <= score_threshold) {
+                    break;
+                }
+                bool keep = true;
+                for (auto sel : selected_index) {
+                    if (calc_iou_ref(p_boxes, idx, sel, centered) > iou_threshold) {
+                        keep = false;
+                        break;
+                    }
+                }
+                if (keep) {
+                    selected_index.push_back(idx);
+                }
+                if ((int64_t)selected_index.size() >= max_output) {
+                    break;
+                }
+            }
+            for (auto sel : selected_index) {
+                dst[out_idx * 3 + 0] = n;
+                dst[out_idx * 3 + 1] = c;
+                dst[out_idx * 3 + 2] = sel;
+                out_idx++;
+            }
+        }
+    }
+    return out_idx;
+}
+
+// anchors are clustered around a few objects like outputs of real detectors
+static void gen_boxes(int64_t batch, int64_t num_boxes, bool centered, std::mt19937 *gen, float *boxes)
+{
+    const int64_t num_objects = 32;
+    std::uniform_real_distribution<float> pos_dist(0.f, 600.f);
+    std::uniform_real_distribution<float> size_dist(16.f, 200.f);
+    std::normal_distribution<float> jitter(0.f, 8.f);
+    for (int64_t n = 0; n < batch; ++n) {
+        std::vector<float> objects(num_objects * 4);
+        for (int64_t o = 0; o < num_objects; ++o) {
+            objects[o * 4 + 0] = pos_dist(*gen);
+            objects[o * 4 + 1] = pos_dist(*gen);
+            objects[o * 4 + 2] = size_dist(*gen);
+            objects[o * 4 + 3] = size_dist(*gen);
+        }
+        for (int64_t i = 0; i < num_boxes; ++i) {
+            const float *obj = objects.data() + ((*gen)() % num_objects) * 4;
+            const float cx   = obj[0] + jitter(*gen);
+            const float cy   = obj[1] + jitter(*gen);
+            const float w    = std::max(1.f, obj[2] + jitter(*gen));
+            const float h    = std::max(1.f, obj[3] + jitter(*gen));
+            float *b         = boxes + (n * num_boxes + i) * 4;
+            if (centered) {
+                b[0] = cx;
+                b[1] = cy;
+                b[2] = w;
+                b[3] = h;
+            } else if (Flag_mmcv) { // [x1, y1, x2, y2]
+                b[0] = cx - w / 2;
+                b[1] = cy - h / 2;
+                b[2] = cx + w / 2;
+                b[3] = cy + h / 2;
+            } else { // [y1, x1, y2, x2]
+                b[0] = cy - h / 2;
+                b[1] = cx - w / 2;
+                b[2] = cy + h / 2;
+                b[3] = cx + w / 2;
+            }
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    simple_flags::parse_args(argc, argv);
+    if (Flag_help) {
+        simple_flags::print_args_info();
+        return 0;
+    }
+
+    std::ifstream cfgfile;
+    cfgfile.open(Flag_cfg, std::ios_base::in | std::ios_base::binary);
+    if (!cfgfile.is_open()) {
+        std::cerr << "cannot open config file\n";
+        simple_flags::print_args_info();
+        return -1;
+    }
+
+    int32_t num_threads = 1;
+#if defined(__linux__) && defined(PPL_USE_X86_OMP)
+    num_threads = omp_get_max_threads();
+#endif
+
+    if (Flag_validate) {
+        Flag_warm_up = 0;
+        Flag_min_iter = 1;
+        Flag_min_second = 0;
+    }
+
+    std::cerr << "==============================================================\n";
+    fprintf(
+        stderr,
+        "num_threads=%d\nmmcv=%d\ncenter_point_box=%d\niou_threshold=%f\nscore_threshold=%f\n"
+        "warm_up=%d\nmin_iter=%d\nmin_second=%f\nvalidate=%d\n\n",
+        num_threads, Flag_mmcv, Flag_center_point_box, Flag_iou_threshold, Flag_score_threshold,
+        Flag_warm_up, Flag_min_iter, Flag_min_second, Flag_validate
+    );
+    std::cerr << "==============================================================\n";
+    std::cerr << "begin tests\n";
+    std::cerr << "line_no,case_string,num_selected,min_ms,avg_ms\n";
+
+    std::mt19937 gen(0);
+    char line[512];
+    int line_no = 0;
+    while (cfgfile.getline(line, 512, '\n')) {
+        ++line_no;
+
+        // skip comment
+        if (line[0] == '#' || line[0] == '\0') {
+            continue;
+        }
+
+        char case_name[100];
+        int64_t batch, num_boxes, num_classes, max_output;
+        if (5 != sscanf(line, CASE_STRING_FMT() "\n", &batch, &num_boxes, &num_classes, &max_output, case_name)) {
+            std::cerr << line_no << "," << line << ",invalid format\n";
+            continue;
+        }
+        if (Flag_mmcv) {
+            batch = 1;
+            num_classes = 1;
+        }
+        fprintf(stderr, "%d," CASE_STRING_FMT(), line_no, batch, num_boxes, num_classes, max_output, case_name);
+
+        const bool centered = Flag_center_point_box && !Flag_mmcv;
+        std::vector<float> boxes(batch * num_boxes * 4);
+        std::vector<float> scores(batch * num_classes * num_boxes);
+        gen_boxes(batch, num_boxes, centered, &gen, boxes.data());
+        std::uniform_real_distribution<float> score_dist(0.f, 1.f);
+        for (auto &s : scores) {
+            // most anchors have low confidence
+            const float r = score_dist(gen);
+            s = r * r * r;
+        }
+
+        const int64_t max_dst_num = Flag_mmcv ? num_boxes : batch * num_classes * std::min(num_boxes, max_output);
+        std::vector<int64_t> dst(max_dst_num * 3);
+        int64_t num_selected = 0;
+
+        auto execute = [&]() {
+            if (Flag_mmcv) {
+                return ppl::kernel::x86::mmcv_nms_ndarray_fp32(
+                    boxes.data(), scores.data(), num_boxes, Flag_iou_threshold, 0, dst.data(), &num_selected);
+            }
+            return ppl::kernel::x86::nms_ndarray_fp32(
+                boxes.data(), scores.data(), num_boxes, batch, num_classes, centered, max_output,
+                Flag_iou_threshold, Flag_score_threshold, dst.data(), &num_selected);
+        };
+
+        for (int32_t i = 0; i < Flag_warm_up; ++i) {
+            if (ppl::common::RC_SUCCESS != execute()) {
+                std::cerr << "," << "execute failed\n";
+                return -1;
+            }
+        }
+
+        std::chrono::high_resolution_clock::time_point start;
+        std::chrono::high_resolution_clock::time_point end;
+        double tot_exe_us = 0.;
+        double min_exe_us = DBL_MAX;
+        int64_t tot_exe_iter = 0;
+        for (; tot_exe_iter < Flag_min_iter || tot_exe_us < Flag_min_second * 1e6; ++tot_exe_iter) {
+            start = std::chrono::high_resolution_clock::now();
+            if (ppl::common::RC_SUCCESS != execute()) {
+                std::cerr << "," << "execute failed\n";
+                return -1;
+            }
+            end = std::chrono::high_resolution_clock::now();
+            double dur = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / 1e3;
+            tot_exe_us += dur;
+            if (dur < min_exe_us) {
+                min_exe_us = dur;
+            }
+        }
+        fprintf(stderr, ",%" PRId64 ",%.3f,%.3f", num_selected, min_exe_us / 1e3, tot_exe_us / tot_exe_iter / 1e3);
+
+        if (Flag_validate && !Flag_mmcv) {
+            std::vector<int64_t> dst_ref(max_dst_num * 3);
+            const int64_t num_selected_ref = nms_ref(
+                boxes.data(), scores.data(), num_boxes, batch, num_classes, centered, max_output,
+                Flag_iou_threshold, Flag_score_threshold, dst_ref.data());
+            if (num_selected_ref != num_selected ||
+                memcmp(dst.data(), dst_ref.data(), num_selected * 3 * sizeof(int64_t)) != 0) {
+                std::cerr << ",failed: expect " << num_selected_ref << " boxes";
+            } else {
+                std::cerr << ",pass";
+            }
+        }
+        std::cerr << "\n";
+    }
+
+    return 0;
+}
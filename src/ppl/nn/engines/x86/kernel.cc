@@ -16,6 +16,7 @@
 // under the License.
 
 #include "ppl/nn/engines/x86/kernel.h"
+#include "ppl/nn/engines/x86/utils.h"
 using namespace std;
 using namespace ppl::common;
 
@@ -26,10 +27,67 @@ using namespace ppl::common;
 namespace ppl { namespace nn { namespace x86 {
 
 RetCode X86Kernel::BeforeExecute(KernelExecContext* ctx) {
-    auto status = Reshape(ctx);
-    if (status != RC_SUCCESS) {
-        LOG(ERROR) << "reshape kernel[" << GetName() << "] failed: " << GetRetCodeStr(status);
-        return status;
+    RetCode status = RC_SUCCESS;
+    if (!ctx->IsOutputShapesReady()) {
+        status = Reshape(ctx);
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "reshape kernel[" << GetName() << "] failed: " << GetRetCodeStr(status);
+            return status;
+        }
+    }
+
+    if (common_param_ && !common_param_->concat_dst_views.empty()) {
+        status = BindConcatDstViews(ctx);
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "BindConcatDstViews of kernel[" << GetName() << "] failed: " << GetRetCodeStr(status);
+            return status;
+        }
+    }
+
+    return RC_SUCCESS;
+}
+
+RetCode X86Kernel::BindConcatDstViews(KernelExecContext* ctx) {
+    for (uint32_t i = 0; i < ctx->GetOutputCount(); ++i) {
+        auto& view = common_param_->concat_dst_views[i];
+        if (view.concat_output_id == INVALID_EDGEID) {
+            continue;
+        }
+
+        /*
+          shapes may differ from the ones seen by the optimizer. falls back to copying in concat. the view bound in
+          previous runs is dropped because the concat output it points to may have been freed.
+        */
+        auto output = ctx->GetOutput<TensorImpl>(i);
+        auto concat_output = ctx->GetEdgeObject<TensorImpl>(view.concat_output_id);
+        if (!concat_output || !TensorShapeEqual(*output->GetShape(), view.shape)) {
+            if (output->GetBoundBuffer()) {
+                output->BindBuffer(nullptr, TensorShape());
+            }
+            continue;
+        }
+
+        /*
+          the first producer allocates the concat output before the concat node is executed. a view bound to the
+          concat output itself, which happens when it is an input of another concat, is set by the concat node later.
+          the one left by previous runs is dropped here.
+        */
+        if (!concat_output->GetBufferPtr() ||
+            !TensorShapeEqual(*concat_output->GetShape(), view.concat_output_shape)) {
+            if (concat_output->GetBoundBuffer()) {
+                concat_output->BindBuffer(nullptr, TensorShape());
+            }
+            *concat_output->GetShape() = view.concat_output_shape;
+            concat_output->SetDevice(GetX86Device());
+            auto status = concat_output->ReallocBuffer();
+            if (status != RC_SUCCESS) {
+                LOG(ERROR) << "ReallocBuffer for tensor[" << concat_output->GetName()
+                           << "] failed: " << GetRetCodeStr(status);
+                return status;
+            }
+        }
+
+        output->BindBuffer(concat_output->GetBufferPtr<char>() + view.offset, view.shape);
     }
 
     return RC_SUCCESS;
@@ -45,6 +103,16 @@ bool X86Kernel::CanDoExecute(const KernelExecContext& ctx) const {
     return true;
 }
 
+bool X86Kernel::ShareBufferFrom(TensorImpl* src, TensorImpl* dst, uint64_t offset) const {
+    auto device = src->GetDevice();
+    if (!src->GetBufferPtr() || !device || !device->IsHostMemory() || dst->GetBoundBuffer()) {
+        return false;
+    }
+
+    dst->ShareBufferFrom(src, offset);
+    return true;
+}
+
 RetCode X86Kernel::Execute(KernelExecContext* ctx) {
 #ifdef PPLNN_ENABLE_KERNEL_PROFILING
     utils::CpuTimingGuard __timing_guard__(&begin_ts_, &end_ts_, ctx->IsProfilingEnabled());
@@ -65,6 +65,17 @@ protected:
         return GetX86Device()->GetISA();
     }
 
+    /**
+       @brief makes `dst` a view of the buffer of `src` starting at `offset` bytes instead of allocating a new one.
+       used by ops that only change metadata of their inputs.
+       @return false if `dst` cannot share the buffer, e.g. `dst` is bound to a caller-owned buffer.
+    */
+    bool ShareBufferFrom(TensorImpl* src, TensorImpl* dst, uint64_t offset = 0) const;
+
+    const X86CommonParam* GetCommonParam() const {
+        return common_param_;
+    }
+
     X86Device* GetX86Device() {
         return reinterpret_cast<X86Device*>(GetDevice());
     }
@@ -87,6 +98,9 @@ private:
 private:
     ppl::common::RetCode BeforeExecute(KernelExecContext*);
 
+    /** @brief binds outputs to parts of the outputs of following concat nodes. see `X86ConcatView`. */
+    ppl::common::RetCode BindConcatDstViews(KernelExecContext*);
+
 private:
     const X86CommonParam* common_param_ = nullptr;
     std::function<ppl::common::RetCode(InputOutputInfo*)> reshape_func_;
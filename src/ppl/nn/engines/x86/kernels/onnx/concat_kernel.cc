@@ -17,6 +17,8 @@
 
 #include "ppl/nn/engines/x86/kernels/onnx/concat_kernel.h"
 #include "ppl/nn/engines/x86/macros.h"
+#include "ppl/nn/engines/x86/utils.h"
+#include "ppl/kernel/x86/common/memory.h"
 #include "ppl/kernel/x86/fp32/concat.h"
 #include "ppl/kernel/x86/int64/concat.h"
 #include "ppl/kernel/x86/bool/concat.h"
@@ -60,6 +62,72 @@ ppl::common::RetCode ConcatKernel::DoExecute(KernelExecContext* ctx) {
     PPLNN_X86_DEBUG_TRACE("axis: %d\n", param_->axis);
     PPLNN_X86_DEBUG_TRACE("isa: %u\n", GetISA());
 
+    auto common_param = GetCommonParam();
+    if (common_param && !common_param->concat_src_views.empty() && concat_result->GetBufferPtr()) {
+        if (IsWrittenByProducers(*ctx, common_param->concat_src_views)) {
+            return CopyMisplacedInputs(ctx, common_param->concat_src_views);
+        }
+
+        // producers set the planned shape when allocating the output. infers the real one.
+        auto status = Reshape(ctx);
+        if (status != ppl::common::RC_SUCCESS) {
+            LOG(ERROR) << "reshape kernel[" << GetName() << "] failed: " << ppl::common::GetRetCodeStr(status);
+            return status;
+        }
+
+        // inputs may be written into the old buffer. keeps it until the concatenation is done.
+        const bool is_owner = concat_result->IsBufferOwner();
+        auto old_buffer = concat_result->DetachBuffer();
+        status = DoConcat(ctx);
+        if (is_owner) {
+            concat_result->GetDevice()->Free(&old_buffer);
+        }
+        return status;
+    }
+
+    return DoConcat(ctx);
+}
+
+bool ConcatKernel::IsWrittenByProducers(const KernelExecContext& ctx, const std::vector<X86ConcatView>& views) const {
+    auto concat_result = ctx.GetOutput<TensorImpl>(0);
+    if (views.size() != ctx.GetInputCount() ||
+        !TensorShapeEqual(*concat_result->GetShape(), views[0].concat_output_shape)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < ctx.GetInputCount(); ++i) {
+        if (!TensorShapeEqual(*ctx.GetInput<TensorImpl>(i)->GetShape(), views[i].shape)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+ppl::common::RetCode ConcatKernel::CopyMisplacedInputs(KernelExecContext* ctx,
+                                                       const std::vector<X86ConcatView>& views) {
+    auto concat_result = ctx->GetOutput<TensorImpl>(0);
+    PPLNN_X86_DEBUG_TRACE("Output [concat_result]:\n");
+    PPL_X86_TENSOR_PRINT_DEBUG_MSG(concat_result);
+
+    auto base = concat_result->GetBufferPtr<char>();
+    for (uint32_t i = 0; i < ctx->GetInputCount(); ++i) {
+        auto input = ctx->GetInput<TensorImpl>(i);
+        auto dst = base + views[i].offset;
+        // producers may not write into the given buffer, e.g. they reuse buffers of their inputs.
+        if (input->GetBufferPtr() != dst) {
+            auto status = ppl::kernel::x86::memory_copy(input->GetBufferPtr(),
+                                                        input->GetShape()->GetBytesIncludingPadding(), dst);
+            if (status != ppl::common::RC_SUCCESS) {
+                return status;
+            }
+        }
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+ppl::common::RetCode ConcatKernel::DoConcat(KernelExecContext* ctx) {
+    auto concat_result = ctx->GetOutput<TensorImpl>(0);
+
     PPLNN_X86_REALLOC_TENSOR_BUFFER(concat_result);
     PPLNN_X86_DEBUG_TRACE("Output [concat_result]:\n");
     PPL_X86_TENSOR_PRINT_DEBUG_MSG(concat_result);
@@ -36,6 +36,11 @@ private:
     ppl::common::RetCode DoExecute(KernelExecContext*) override;
     bool CanDoExecute(const KernelExecContext&) const override;
 
+    /** @brief tells whether inputs are supposed to be written into the output by their producers */
+    bool IsWrittenByProducers(const KernelExecContext&, const std::vector<X86ConcatView>&) const;
+    ppl::common::RetCode CopyMisplacedInputs(KernelExecContext*, const std::vector<X86ConcatView>&);
+    ppl::common::RetCode DoConcat(KernelExecContext*);
+
 private:
     const ppl::nn::onnx::ConcatParam* param_ = nullptr;
     std::vector<const void*> src_list_;
@@ -21,7 +21,132 @@
 
 namespace ppl { namespace nn { namespace x86 {
 
+Conv2dDynamicKernel::~Conv2dDynamicKernel() {
+    ReleaseExecutor();
+}
+
+void Conv2dDynamicKernel::ReleaseExecutor() {
+    if (executor_) {
+        delete executor_;
+        executor_ = nullptr;
+    }
+    if (mgr_) {
+        mgr_->release_cvt_weights();
+        delete mgr_;
+        mgr_ = nullptr;
+    }
+    cvt_weight_ptr_ = nullptr;
+    cvt_bias_ptr_ = nullptr;
+}
+
+ppl::common::RetCode Conv2dDynamicKernel::PrepareExecutor(const TensorImpl* X, const TensorImpl* W,
+                                                          const TensorImpl* B, const TensorImpl* Y) {
+    const int32_t num_output = W->GetShape()->GetDim(0);
+    const int32_t channels = W->GetShape()->GetDim(1) * param_->group;
+    const auto src_format = X->GetShape()->GetDataFormat();
+    const auto dst_format = Y->GetShape()->GetDataFormat();
+
+    if (!algo_selected_ || num_output != algo_num_output_ || channels != algo_channels_ ||
+        src_format != algo_src_format_ || dst_format != algo_dst_format_) {
+        ReleaseExecutor();
+
+        algo_selected_ = true;
+        algo_num_output_ = num_output;
+        algo_channels_ = channels;
+        algo_src_format_ = src_format;
+        algo_dst_format_ = dst_format;
+
+        ppl::kernel::x86::conv2d_fp32_param conv2d_param;
+        conv2d_param.kernel_h = param_->kernel_shape[0];
+        conv2d_param.kernel_w = param_->kernel_shape[1];
+        conv2d_param.stride_h = param_->strides[0];
+        conv2d_param.stride_w = param_->strides[1];
+        conv2d_param.pad_h = param_->pads[0];
+        conv2d_param.pad_w = param_->pads[1];
+        conv2d_param.dilation_h = param_->dilations[0];
+        conv2d_param.dilation_w = param_->dilations[1];
+        conv2d_param.group = param_->group;
+        conv2d_param.num_output = num_output;
+        conv2d_param.channels = channels;
+        conv2d_param.fuse_flag = 0;
+
+        auto algo_info =
+            ppl::kernel::x86::conv2d_algo_selector::select_algo(src_format, conv2d_param, GetISA());
+        if (algo_info.algo_type == ppl::kernel::x86::conv2d_fp32_algo::UNKNOWN ||
+            algo_info.input_format != src_format || algo_info.output_format != dst_format) {
+            return ppl::common::RC_SUCCESS;
+        }
+
+        mgr_ = ppl::kernel::x86::conv2d_algo_selector::gen_algo(conv2d_param, algo_info,
+                                                                 GetX86Device()->GetAllocator());
+        if (!mgr_) {
+            LOG(ERROR) << "gen conv2d algo[" << algo_info.algo_type << "] for kernel[" << GetName() << "] failed.";
+            return ppl::common::RC_OUT_OF_MEMORY;
+        }
+    }
+
+    if (!mgr_) {
+        return ppl::common::RC_SUCCESS;
+    }
+
+    const void* weight_ptr = W->GetBufferPtr();
+    const uint64_t weight_generation = W->GetGeneration();
+    const void* bias_ptr = B ? B->GetBufferPtr() : nullptr;
+    const uint64_t bias_generation = B ? B->GetGeneration() : 0;
+
+    if (!executor_ || weight_ptr != cvt_weight_ptr_ || weight_generation != cvt_weight_generation_ ||
+        bias_ptr != cvt_bias_ptr_ || bias_generation != cvt_bias_generation_) {
+        // executors refer to converted weights of the manager
+        if (executor_) {
+            delete executor_;
+            executor_ = nullptr;
+        }
+        mgr_->release_cvt_weights();
+        cvt_weight_ptr_ = nullptr;
+        cvt_bias_ptr_ = nullptr;
+
+        ppl::common::RetCode status;
+        if (B) {
+            status = mgr_->gen_cvt_weights(W->GetBufferPtr<float>(), B->GetBufferPtr<float>());
+        } else {
+            std::vector<float> zero_bias(num_output, 0.0f);
+            status = mgr_->gen_cvt_weights(W->GetBufferPtr<float>(), zero_bias.data());
+        }
+        if (status != ppl::common::RC_SUCCESS) {
+            LOG(ERROR) << "convert weights for kernel[" << GetName()
+                       << "] failed: " << ppl::common::GetRetCodeStr(status);
+            return status;
+        }
+
+        executor_ = mgr_->gen_executor();
+        if (!executor_) {
+            LOG(ERROR) << "gen executor for kernel[" << GetName() << "] failed.";
+            return ppl::common::RC_OUT_OF_MEMORY;
+        }
+
+        cvt_weight_ptr_ = weight_ptr;
+        cvt_weight_generation_ = weight_generation;
+        cvt_bias_ptr_ = bias_ptr;
+        cvt_bias_generation_ = bias_generation;
+    }
+
+    executor_->set_src_shape(X->GetShape());
+    executor_->set_dst_shape(Y->GetShape());
+
+    auto status = executor_->prepare();
+    if (status != ppl::common::RC_SUCCESS) {
+        LOG(ERROR) << "Prepare failed: " << ppl::common::GetRetCodeStr(status);
+        return status;
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
 uint64_t Conv2dDynamicKernel::CalcTmpBufferSize(const KernelExecContext& ctx) const {
+    if (executor_) {
+        return executor_->cal_temp_buffer_size();
+    }
+
     auto x = ctx.GetInput<TensorImpl>(0);
     auto w = ctx.GetInput<TensorImpl>(1);
     auto y = ctx.GetOutput<TensorImpl>(0);
@@ -86,9 +211,8 @@ ppl::common::RetCode Conv2dDynamicKernel::DoExecute(KernelExecContext* ctx) {
 
     const float* b_data = nullptr;
 
-    if (X->GetShape()->GetDataType() != ppl::common::DATATYPE_FLOAT32 ||
-        X->GetShape()->GetDataFormat() != ppl::common::DATAFORMAT_NDARRAY) {
-        LOG(ERROR) << "only support fp32 ndarray now.";
+    if (X->GetShape()->GetDataType() != ppl::common::DATATYPE_FLOAT32) {
+        LOG(ERROR) << "only support fp32 now.";
         return ppl::common::RC_UNSUPPORTED;
     }
 
@@ -108,6 +232,19 @@ ppl::common::RetCode Conv2dDynamicKernel::DoExecute(KernelExecContext* ctx) {
         b_data = B->GetBufferPtr<float>();
     }
 
+    auto rc = PrepareExecutor(X, W, B, Y);
+    if (rc != ppl::common::RC_SUCCESS) {
+        LOG(ERROR) << "prepare executor for kernel[" << GetName() << "] failed: " << ppl::common::GetRetCodeStr(rc);
+        return rc;
+    }
+
+    // the fallback kernel only handles ndarray
+    if (!executor_ && (X->GetShape()->GetDataFormat() != ppl::common::DATAFORMAT_NDARRAY ||
+                       Y->GetShape()->GetDataFormat() != ppl::common::DATAFORMAT_NDARRAY)) {
+        LOG(ERROR) << "only support fp32 ndarray now.";
+        return ppl::common::RC_UNSUPPORTED;
+    }
+
     PPLNN_X86_REALLOC_TENSOR_BUFFER(Y);
     PPLNN_X86_DEBUG_TRACE("Output [Y]:\n");
     PPL_X86_TENSOR_PRINT_DEBUG_MSG(Y);
@@ -126,6 +263,18 @@ ppl::common::RetCode Conv2dDynamicKernel::DoExecute(KernelExecContext* ctx) {
     auto tmp_buffer = tmp_buffer_desc.addr;
     PPLNN_X86_DEBUG_TRACE("buffer: %p\n", tmp_buffer);
 
+    if (executor_) {
+        executor_->set_temp_buffer(tmp_buffer);
+        executor_->set_src(X->GetBufferPtr<float>());
+        executor_->set_dst(Y->GetBufferPtr<float>());
+
+        rc = executor_->execute();
+        if (rc != ppl::common::RC_SUCCESS) {
+            LOG(ERROR) << "Execute failed: " << ppl::common::GetRetCodeStr(rc);
+            return rc;
+        }
+        return ppl::common::RC_SUCCESS;
+    }
 
     const int32_t batch = X->GetShape()->GetDim(0);
     const int32_t src_h = X->GetShape()->GetDim(2);
@@ -20,12 +20,14 @@
 
 #include "ppl/nn/engines/x86/kernel.h"
 #include "ppl/nn/params/onnx/conv_param.h"
+#include "ppl/kernel/x86/fp32/conv2d.h"
 
 namespace ppl { namespace nn { namespace x86 {
 
 class Conv2dDynamicKernel : public X86Kernel {
 public:
     Conv2dDynamicKernel(const ir::Node* node) : X86Kernel(node) {}
+    ~Conv2dDynamicKernel();
 
     void SetParam(const ppl::nn::onnx::ConvParam* p) {
         param_ = p;
@@ -35,8 +37,33 @@ private:
     uint64_t CalcTmpBufferSize(const KernelExecContext& ctx) const override;
     ppl::common::RetCode DoExecute(KernelExecContext*) override;
 
+    /**
+       @brief selects an optimized algorithm for formats of `X` and `Y` and converts `W` and `B` for it. converted
+       weights are reused until the buffer or generation of `W` or `B` changes.
+       @note `executor_` is left nullptr if no algorithm supports these formats.
+    */
+    ppl::common::RetCode PrepareExecutor(const TensorImpl* X, const TensorImpl* W, const TensorImpl* B,
+                                         const TensorImpl* Y);
+    void ReleaseExecutor();
+
 private:
     const ppl::nn::onnx::ConvParam* param_ = nullptr;
+
+    // key of the selected algorithm
+    bool algo_selected_ = false;
+    int32_t algo_num_output_ = 0;
+    int32_t algo_channels_ = 0;
+    ppl::common::dataformat_t algo_src_format_ = ppl::common::DATAFORMAT_UNKNOWN;
+    ppl::common::dataformat_t algo_dst_format_ = ppl::common::DATAFORMAT_UNKNOWN;
+
+    ppl::kernel::x86::conv2d_fp32_manager* mgr_ = nullptr;
+    ppl::kernel::x86::conv2d_fp32_executor* executor_ = nullptr;
+
+    // key of the converted weights
+    const void* cvt_weight_ptr_ = nullptr;
+    uint64_t cvt_weight_generation_ = 0;
+    const void* cvt_bias_ptr_ = nullptr;
+    uint64_t cvt_bias_generation_ = 0;
 };
 
 }}} // namespace ppl::nn::x86
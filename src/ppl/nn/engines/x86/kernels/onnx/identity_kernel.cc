@@ -31,8 +31,7 @@ ppl::common::RetCode IdentityKernel::DoExecute(KernelExecContext* ctx) {
 
     PPLNN_X86_DEBUG_TRACE("isa: %u\n", GetISA());
 
-    if (ctx->IsLastConsumerOfInput(0) && input->GetType() == TENSORTYPE_NORMAL) {
-        output->TransferBufferFrom(input);
+    if (ShareBufferFrom(input, output)) {
         PPLNN_X86_DEBUG_TRACE("Output [output]:\n");
         PPL_X86_TENSOR_PRINT_DEBUG_MSG(output);
     } else {
@@ -32,8 +32,7 @@ ppl::common::RetCode ReshapeKernel::DoExecute(KernelExecContext* ctx) {
     PPL_X86_TENSOR_PRINT_DEBUG_MSG(shape);
     PPLNN_X86_DEBUG_TRACE("isa: %u\n", GetISA());
 
-    if (ctx->IsLastConsumerOfInput(0) && data->GetType() == TENSORTYPE_NORMAL) {
-        reshaped->TransferBufferFrom(data);
+    if (ShareBufferFrom(data, reshaped)) {
         PPLNN_X86_DEBUG_TRACE("Output [reshaped]:\n");
         PPL_X86_TENSOR_PRINT_DEBUG_MSG(reshaped);
     } else {
@@ -22,6 +22,70 @@
 
 namespace ppl { namespace nn { namespace x86 {
 
+/**
+   @brief checks whether the output of slice is a contiguous part of the input, which means that all steps are 1, all
+   dims after the first sliced axis are kept and all dims before it are 1.
+   @param offset the offset of the output in bytes if it is contiguous
+*/
+static bool IsContiguousSlice(const TensorShape& src_shape, const TensorShape& dst_shape, const SliceParam& param,
+                              uint64_t* offset) {
+    if (src_shape.GetDataFormat() != ppl::common::DATAFORMAT_NDARRAY) {
+        return false;
+    }
+
+    const int64_t dim_count = src_shape.GetDimCount();
+    if (dim_count == 0 || dim_count != (int64_t)dst_shape.GetDimCount()) {
+        return false;
+    }
+
+    std::vector<int64_t> starts(dim_count, 0);
+    std::vector<int64_t> steps(dim_count, 1);
+    for (uint32_t i = 0; i < param.starts.size(); ++i) {
+        const int64_t axis = param.axes[i] < 0 ? param.axes[i] + dim_count : param.axes[i];
+        if (axis < 0 || axis >= dim_count) {
+            return false;
+        }
+        // the same normalization as slice_ndarray_common()
+        int64_t start = param.starts[i];
+        if (start >= src_shape.GetDim(axis)) {
+            start = src_shape.GetDim(axis) - 1;
+        }
+        if (start < 0) {
+            start += src_shape.GetDim(axis);
+        }
+        starts[axis] = start;
+        steps[axis] = param.steps[i];
+    }
+
+    int64_t axis = dim_count - 1;
+    while (axis >= 0 && dst_shape.GetDim(axis) == src_shape.GetDim(axis) && starts[axis] == 0 && steps[axis] == 1) {
+        --axis;
+    }
+    if (axis >= 0) {
+        if (starts[axis] < 0 || (steps[axis] != 1 && dst_shape.GetDim(axis) > 1)) {
+            return false;
+        }
+        for (int64_t i = 0; i < axis; ++i) {
+            if (dst_shape.GetDim(i) != 1) {
+                return false;
+            }
+        }
+    }
+
+    int64_t stride = ppl::common::GetSizeOfDataType(src_shape.GetDataType());
+    uint64_t bytes = 0;
+    for (int64_t i = dim_count - 1; i >= 0; --i) {
+        if (starts[i] < 0) {
+            return false;
+        }
+        bytes += starts[i] * stride;
+        stride *= src_shape.GetDim(i);
+    }
+
+    *offset = bytes;
+    return true;
+}
+
 ppl::common::RetCode SliceKernel::DoExecute(KernelExecContext* ctx) {
     PPLNN_X86_REQUIRED_INPUT(data, 0);
     PPLNN_X86_OPTIONAL_INPUT(starts_tensor, 1);
@@ -77,6 +141,14 @@ ppl::common::RetCode SliceKernel::DoExecute(KernelExecContext* ctx) {
 
     PPLNN_X86_DEBUG_TRACE("isa: %u\n", GetISA());
 
+    uint64_t offset = 0;
+    if (IsContiguousSlice(*data->GetShape(), *output->GetShape(), *param_, &offset) &&
+        ShareBufferFrom(data, output, offset)) {
+        PPLNN_X86_DEBUG_TRACE("Output [output]:\n");
+        PPL_X86_TENSOR_PRINT_DEBUG_MSG(output);
+        return ppl::common::RC_SUCCESS;
+    }
+
     PPLNN_X86_REALLOC_TENSOR_BUFFER(output);
     PPLNN_X86_DEBUG_TRACE("Output [output]:\n");
     PPL_X86_TENSOR_PRINT_DEBUG_MSG(output);
@@ -37,6 +37,50 @@ ppl::common::RetCode SplitKernel::DoExecute(KernelExecContext* ctx) {
     PPLNN_X86_DEBUG_TRACE("axis: %d\n", param_->axis);
     PPLNN_X86_DEBUG_TRACE("isa: %u\n", GetISA());
 
+    const int32_t real_axis =
+        param_->axis < 0 ? param_->axis + ctx->GetInput<TensorImpl>(0)->GetShape()->GetDimCount() : param_->axis;
+
+    auto data_type = input->GetShape()->GetDataType();
+    auto data_format = input->GetShape()->GetDataFormat();
+
+    /*
+      outputs are contiguous parts of the input if all dims before `axis` are 1. channel blocks of N16CX are
+      contiguous too if channels of all outputs except the last one are multiples of 16.
+    */
+    const bool is_n16cx_channel_split = (data_format == ppl::common::DATAFORMAT_N16CX && real_axis == 1);
+    bool is_contiguous = (data_format == ppl::common::DATAFORMAT_NDARRAY || real_axis == 0 || is_n16cx_channel_split);
+    for (int32_t i = 0; i < real_axis; ++i) {
+        if (input->GetShape()->GetDim(i) != 1) {
+            is_contiguous = false;
+            break;
+        }
+    }
+    if (is_contiguous && is_n16cx_channel_split) {
+        for (uint32_t i = 0; i + 1 < ctx->GetOutputCount(); ++i) {
+            if (ctx->GetOutput<TensorImpl>(i)->GetShape()->GetDim(1) % 16 != 0) {
+                is_contiguous = false;
+                break;
+            }
+        }
+    }
+    if (is_contiguous) {
+        uint64_t offset = 0;
+        uint32_t shared_count = 0;
+        for (uint32_t i = 0; i < ctx->GetOutputCount(); ++i) {
+            auto output = ctx->GetOutput<TensorImpl>(i);
+            if (!ShareBufferFrom(input, output, offset)) {
+                break;
+            }
+            PPLNN_X86_DEBUG_TRACE("Output [outputs[%u]]:\n", i);
+            PPL_X86_TENSOR_PRINT_DEBUG_MSG(output);
+            offset += output->GetShape()->GetBytesIncludingPadding();
+            ++shared_count;
+        }
+        if (shared_count == ctx->GetOutputCount()) {
+            return ppl::common::RC_SUCCESS;
+        }
+    }
+
     for (uint32_t i = 0; i < ctx->GetOutputCount(); ++i) {
         auto output = ctx->GetOutput<TensorImpl>(i);
         PPLNN_X86_REALLOC_TENSOR_BUFFER(output);
@@ -46,11 +90,6 @@ ppl::common::RetCode SplitKernel::DoExecute(KernelExecContext* ctx) {
         dst_shape_list[i] = output->GetShape();
     }
 
-    const int32_t real_axis =
-        param_->axis < 0 ? param_->axis + ctx->GetInput<TensorImpl>(0)->GetShape()->GetDimCount() : param_->axis;
-
-    auto data_type = input->GetShape()->GetDataType();
-    auto data_format = input->GetShape()->GetDataFormat();
     if (ppl::common::GetSizeOfDataType(data_type) == 4 && data_format == ppl::common::DATAFORMAT_N16CX &&
         real_axis == 1 && MayUseISA(ppl::common::ISA_X86_AVX)) {
         bool interleave_channels = false;
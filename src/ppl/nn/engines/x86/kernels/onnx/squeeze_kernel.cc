@@ -30,8 +30,7 @@ ppl::common::RetCode SqueezeKernel::DoExecute(KernelExecContext* ctx) {
 
     PPLNN_X86_DEBUG_TRACE("isa: %u\n", GetISA());
 
-    if (ctx->IsLastConsumerOfInput(0) && data->GetType() == TENSORTYPE_NORMAL) {
-        squeezed->TransferBufferFrom(data);
+    if (ShareBufferFrom(data, squeezed)) {
         PPLNN_X86_DEBUG_TRACE("Output [squeezed]:\n");
         PPL_X86_TENSOR_PRINT_DEBUG_MSG(squeezed);
     } else {
@@ -33,8 +33,7 @@ ppl::common::RetCode UnsqueezeKernel::DoExecute(KernelExecContext* ctx) {
     }
     PPLNN_X86_DEBUG_TRACE("isa: %u\n", GetISA());
 
-    if (ctx->IsLastConsumerOfInput(0) && data->GetType() == TENSORTYPE_NORMAL) {
-        expanded->TransferBufferFrom(data);
+    if (ShareBufferFrom(data, expanded)) {
         PPLNN_X86_DEBUG_TRACE("Output [expanded]:\n");
         PPL_X86_TENSOR_PRINT_DEBUG_MSG(expanded);
     } else {
@@ -0,0 +1,112 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#include <inttypes.h>
+#include "ppl/nn/utils/destructor.h"
+#include "ppl/nn/engines/x86/kernels/pmx/post_pooling_conv2d_kernel.h"
+
+#define CASE_STRING_FMT() \
+    "g%" PRId64 \
+    "_mb%" PRId64 \
+    "_ic%" PRId64 "ih%" PRId64 "iw%" PRId64 \
+    "_oc%" PRId64 "oh%" PRId64 "ow%" PRId64 \
+    "_kh%" PRId64 "kw%" PRId64 "sh%" PRId64 "sw%" PRId64 "ph%" PRId64 "pw%" PRId64 "dh%" PRId64 "dw%" PRId64 \
+    "_pm%" PRId64 "pkh%" PRId64 "pkw%" PRId64 "psh%" PRId64 "psw%" PRId64 "pph%" PRId64 "ppw%" PRId64 \
+    "_n%s"
+
+namespace ppl { namespace nn { namespace x86 {
+
+uint64_t PostPoolingConv2dKernel::CalcTmpBufferSize(const KernelExecContext& ctx) const {
+    return executor_->cal_temp_buffer_size();
+}
+
+ppl::common::RetCode PostPoolingConv2dKernel::DoExecute(KernelExecContext* ctx) {
+    PPLNN_X86_REQUIRED_INPUT(X, 0);
+    PPLNN_X86_REQUIRED_OUTPUT(Y, 0);
+
+    auto cv_p = executor_->conv2d_executor()->conv_param();
+    auto pl_p = executor_->pooling_param();
+
+    PPLNN_X86_DEBUG_TRACE("Op: %s\n", GetName().c_str());
+
+    PPLNN_X86_DEBUG_TRACE("Input [X]:\n");
+    PPL_X86_TENSOR_PRINT_DEBUG_MSG(X);
+
+    PPLNN_X86_DEBUG_TRACE("kernel_shape: %ld %ld, %ld %ld\n", cv_p->kernel_h, cv_p->kernel_w, pl_p->kernel_h, pl_p->kernel_w);
+    PPLNN_X86_DEBUG_TRACE("dilations: %ld %ld\n", cv_p->dilation_h, cv_p->dilation_w);
+    PPLNN_X86_DEBUG_TRACE("strides: %ld %ld, %ld %ld\n", cv_p->stride_h, cv_p->stride_w, pl_p->stride_h, pl_p->stride_w);
+    PPLNN_X86_DEBUG_TRACE("pads: %ld %ld, %ld %ld\n", cv_p->pad_h, cv_p->pad_w, pl_p->pad_h, pl_p->pad_w);
+    PPLNN_X86_DEBUG_TRACE("group: %ld\n", cv_p->group);
+    PPLNN_X86_DEBUG_TRACE("channels: %ld\n", cv_p->channels);
+    PPLNN_X86_DEBUG_TRACE("num_output: %ld\n", cv_p->num_output);
+    PPLNN_X86_DEBUG_TRACE("fuse_flag: %ld\n", cv_p->fuse_flag);
+    PPLNN_X86_DEBUG_TRACE("pooling_mode: %ld\n", pl_p->mode);
+    PPLNN_X86_DEBUG_TRACE("isa: %u\n", GetISA());
+
+    executor_->set_src_shape(X->GetShape());
+    executor_->set_dst_shape(Y->GetShape());
+
+    ppl::common::RetCode rc;
+    rc = executor_->prepare();
+    if (ppl::common::RC_SUCCESS != rc) {
+        LOG(ERROR) << "Prepare failed: " << ppl::common::GetRetCodeStr(rc);
+        return rc;
+    }
+
+#ifdef DUMP_CONV
+    fprintf(stderr, CASE_STRING_FMT() "\n", cv_p->group, X->GetShape()->GetDim(0),
+            cv_p->channels, X->GetShape()->GetDim(2), X->GetShape()->GetDim(3),
+            cv_p->num_output, Y->GetShape()->GetDim(2), Y->GetShape()->GetDim(3),
+            cv_p->kernel_h, cv_p->kernel_w, cv_p->stride_h, cv_p->stride_w,
+            cv_p->pad_h, cv_p->pad_w, cv_p->dilation_h - 1, cv_p->dilation_w - 1,
+            pl_p->mode, pl_p->kernel_h, pl_p->kernel_w, pl_p->stride_h, pl_p->stride_w,
+            pl_p->pad_h, pl_p->pad_w, GetName().c_str());
+#endif
+
+    PPLNN_X86_REALLOC_TENSOR_BUFFER(Y);
+    PPLNN_X86_DEBUG_TRACE("Output [Y]:\n");
+    PPL_X86_TENSOR_PRINT_DEBUG_MSG(Y);
+
+    // holds the conv row ring of each thread, or the whole conv output in SEPARATE mode
+    BufferDesc tmp_buffer_desc;
+    auto tmp_buffer_size = CalcTmpBufferSize(*ctx);
+    auto status = GetX86Device()->AllocTmpBuffer(tmp_buffer_size, &tmp_buffer_desc);
+    if (status != ppl::common::RC_SUCCESS) {
+        LOG(ERROR) << "alloc tmp buffer size[" << tmp_buffer_size << "] for kernel[" << GetName()
+                   << "] failed: " << ppl::common::GetRetCodeStr(status);
+        return status;
+    }
+    utils::Destructor __tmp_buffer_guard([this, &tmp_buffer_desc]() -> void {
+        GetX86Device()->FreeTmpBuffer(&tmp_buffer_desc);
+    });
+    auto tmp_buffer = tmp_buffer_desc.addr;
+    PPLNN_X86_DEBUG_TRACE("buffer: %p\n", tmp_buffer);
+    PPLNN_X86_DEBUG_TRACE("mode: %u\n", executor_->mode());
+
+    executor_->set_temp_buffer(tmp_buffer);
+    executor_->set_src(X->GetBufferPtr<float>());
+    executor_->set_dst(Y->GetBufferPtr<float>());
+
+    rc = executor_->execute();
+    if (ppl::common::RC_SUCCESS != rc) {
+        LOG(ERROR) << "Execute failed: " << ppl::common::GetRetCodeStr(rc);
+        return rc;
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+}}} // namespace ppl::nn::x86
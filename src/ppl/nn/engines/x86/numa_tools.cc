@@ -0,0 +1,95 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/engines/x86/numa_tools.h"
+#include "ppl/nn/common/logger.h"
+using namespace std;
+using namespace ppl::common;
+
+#if defined(__linux__) && defined(PPLNN_USE_NUMA)
+#include <numa.h>
+#include <unistd.h>
+#endif
+
+namespace ppl { namespace nn { namespace x86 {
+
+bool IsNumaNodeAvailable(int32_t numa_node_id) {
+    if (numa_node_id < 0) {
+        return false;
+    }
+#if defined(__linux__) && defined(PPLNN_USE_NUMA)
+    if (numa_available() < 0) {
+        LOG(WARNING) << "NUMA API check failed. current system does not support NUMA API.";
+        return false;
+    }
+    if (numa_node_id > numa_max_node()) {
+        LOG(WARNING) << "numa node id [" << numa_node_id << "] > max numa node id [" << numa_max_node() << "].";
+        return false;
+    }
+    return true;
+#else
+    LOG(WARNING) << "current build does not support NUMA.";
+    return false;
+#endif
+}
+
+RetCode GetNumaNodeCpus(int32_t numa_node_id, vector<int32_t>* cpus) {
+#if defined(__linux__) && defined(PPLNN_USE_NUMA)
+    auto mask = numa_allocate_cpumask();
+    if (!mask) {
+        return RC_OUT_OF_MEMORY;
+    }
+
+    if (numa_node_to_cpus(numa_node_id, mask) != 0) {
+        LOG(ERROR) << "get cpus of numa node [" << numa_node_id << "] failed.";
+        numa_free_cpumask(mask);
+        return RC_OTHER_ERROR;
+    }
+
+    const int32_t cpu_num = numa_num_configured_cpus();
+    for (int32_t i = 0; i < cpu_num; ++i) {
+        if (numa_bitmask_isbitset(mask, i)) {
+            cpus->push_back(i);
+        }
+    }
+
+    numa_free_cpumask(mask);
+    return RC_SUCCESS;
+#else
+    (void)numa_node_id;
+    (void)cpus;
+    return RC_UNSUPPORTED;
+#endif
+}
+
+void* NumaAllocator::Alloc(uint64_t bytes) {
+    auto addr = base_->Alloc(bytes);
+#if defined(__linux__) && defined(PPLNN_USE_NUMA)
+    if (addr) {
+        // only whole pages inside the block can be bound
+        const uintptr_t page_size = sysconf(_SC_PAGESIZE);
+        const uintptr_t begin = ((uintptr_t)addr + page_size - 1) & ~(page_size - 1);
+        const uintptr_t end = ((uintptr_t)addr + bytes) & ~(page_size - 1);
+        if (end > begin) {
+            numa_tonode_memory((void*)begin, end - begin, numa_node_id_);
+        }
+    }
+#endif
+    return addr;
+}
+
+}}} // namespace ppl::nn::x86
@@ -0,0 +1,59 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_ENGINES_X86_NUMA_TOOLS_H_
+#define _ST_HPC_PPL_NN_ENGINES_X86_NUMA_TOOLS_H_
+
+#include "ppl/common/allocator.h"
+#include "ppl/common/retcode.h"
+#include <vector>
+
+namespace ppl { namespace nn { namespace x86 {
+
+/** @brief checks whether `numa_node_id` is a valid node of the current system. */
+bool IsNumaNodeAvailable(int32_t numa_node_id);
+
+/** @brief gets ids of cpus that belong to `numa_node_id`. */
+ppl::common::RetCode GetNumaNodeCpus(int32_t numa_node_id, std::vector<int32_t>* cpus);
+
+/**
+   @brief an allocator that places pages of blocks returned by another allocator on the given numa node.
+   pages are bound before they are touched, so that they are allocated on that node no matter which thread
+   writes them first.
+*/
+class NumaAllocator final : public ppl::common::Allocator {
+public:
+    /** @note `base` is not owned by this allocator. */
+    NumaAllocator(ppl::common::Allocator* base, int32_t numa_node_id) : base_(base), numa_node_id_(numa_node_id) {}
+
+    void* Alloc(uint64_t bytes) override;
+    void Free(void* ptr) override {
+        base_->Free(ptr);
+    }
+
+private:
+    ppl::common::Allocator* base_;
+    const int32_t numa_node_id_;
+
+private:
+    NumaAllocator(const NumaAllocator&) = delete;
+    void operator=(const NumaAllocator&) = delete;
+};
+
+}}} // namespace ppl::nn::x86
+
+#endif
@@ -69,6 +69,22 @@ RetCode ConvOp::Init(const OptKernelOptions& options) {
     return RC_SUCCESS;
 }
 
+static void FillConv2dParam(const ppl::nn::onnx::ConvParam& conv_param, int32_t num_output, int32_t channels,
+                            ppl::kernel::x86::conv2d_fp32_param* conv2d_param) {
+    conv2d_param->kernel_h = conv_param.kernel_shape[0];
+    conv2d_param->kernel_w = conv_param.kernel_shape[1];
+    conv2d_param->stride_h = conv_param.strides[0];
+    conv2d_param->stride_w = conv_param.strides[1];
+    conv2d_param->pad_h = conv_param.pads[0];
+    conv2d_param->pad_w = conv_param.pads[1];
+    conv2d_param->dilation_h = conv_param.dilations[0];
+    conv2d_param->dilation_w = conv_param.dilations[1];
+    conv2d_param->group = conv_param.group;
+    conv2d_param->num_output = num_output;
+    conv2d_param->channels = channels;
+    conv2d_param->fuse_flag = 0;
+}
+
 ppl::common::RetCode ConvOp::SelectAlgorithm(const InputOutputInfo& info, const OptKernelOptions& options) {
     auto node = GetNode();
     auto graph_data = options.graph_data;
@@ -76,7 +92,7 @@ ppl::common::RetCode ConvOp::SelectAlgorithm(const InputOutputInfo& info, const
     auto weight_data_it = graph_data->constants.find(node->GetInput(1));
     if (weight_data_it == graph_data->constants.end()) {
         LOG(INFO) << "ConvOp constant weight not found, will use conv runtime.";
-        return ppl::common::RC_SUCCESS;
+        return SelectDynamicAlgorithm(info, options);
     }
 
     const float* weight_data = (const float*)weight_data_it->second.data.data();
@@ -86,7 +102,7 @@ ppl::common::RetCode ConvOp::SelectAlgorithm(const InputOutputInfo& info, const
         auto bias_data_it = graph_data->constants.find(node->GetInput(2));
         if (bias_data_it == graph_data->constants.end()) {
             LOG(INFO) << "ConvOp constant weight not found, will use conv runtime.";
-            return ppl::common::RC_SUCCESS;
+            return SelectDynamicAlgorithm(info, options);
         }
         bias_data = (const float*)bias_data_it->second.data.data();
     }
@@ -119,55 +135,62 @@ ppl::common::RetCode ConvOp::SelectAlgorithm(const InputOutputInfo& info, const
         const int32_t channels = weight_shape.dims[1] * param_->group;
 
         ppl::kernel::x86::conv2d_fp32_param& conv2d_param = conv2d_param_->param;
-        conv2d_param.kernel_h = conv_param.kernel_shape[0];
-        conv2d_param.kernel_w = conv_param.kernel_shape[1];
-        conv2d_param.stride_h = conv_param.strides[0];
-        conv2d_param.stride_w = conv_param.strides[1];
-        conv2d_param.pad_h = conv_param.pads[0];
-        conv2d_param.pad_w = conv_param.pads[1];
-        conv2d_param.dilation_h = conv_param.dilations[0];
-        conv2d_param.dilation_w = conv_param.dilations[1];
-        conv2d_param.group = conv_param.group;
-        conv2d_param.num_output = num_output;
-        conv2d_param.channels = channels;
-        conv2d_param.fuse_flag = 0;
+        FillConv2dParam(conv_param, num_output, channels, &conv2d_param);
 
         conv2d_param_->algo_info = ppl::kernel::x86::conv2d_algo_selector::select_algo(
-            info.GetInput<TensorImpl>(0)->GetShape()->GetDataFormat(), conv2d_param_->param, options.device->GetISA());
+            info.GetInput<TensorImpl>(0)->GetShape()->GetDataFormat(), conv2d_param_->param, options.device->GetISA(),
+            weight_data);
 
         if (conv2d_param_->algo_info.algo_type == ppl::kernel::x86::conv2d_fp32_algo::UNKNOWN) {
             LOG(INFO) << "Conv select algorithm failed, use fallback kernel";
         } else {
+            /*
+              B4F3 is the default. B6F3 is picked only if the output shape is known now and the cost model estimates
+              it to be faster, as its tile size is fixed when weights are converted.
+            */
+            if (conv2d_param_->algo_info.algo_type == ppl::kernel::x86::conv2d_fp32_algo::WINOGRAD_B4F3) {
+                auto y_shape = info.GetOutput<TensorImpl>(0)->GetShape();
+                auto x_shape = info.GetInput<TensorImpl>(0)->GetShape();
+                if (y_shape->GetDimCount() == 4 && x_shape->GetDim(0) > 0 && y_shape->GetDim(2) > 0 &&
+                    y_shape->GetDim(3) > 0) {
+                    const int64_t num_threads = ppl::kernel::x86::get_omp_max_threads();
+                    const float b4f3_cost = ppl::kernel::x86::conv2d_algo_selector::estimate_cost(
+                        conv2d_param, ppl::kernel::x86::conv2d_fp32_algo::WINOGRAD_B4F3, conv2d_param_->algo_info.isa,
+                        x_shape->GetDim(0), y_shape->GetDim(2), y_shape->GetDim(3), num_threads);
+                    const float b6f3_cost = ppl::kernel::x86::conv2d_algo_selector::estimate_cost(
+                        conv2d_param, ppl::kernel::x86::conv2d_fp32_algo::WINOGRAD_B6F3, conv2d_param_->algo_info.isa,
+                        x_shape->GetDim(0), y_shape->GetDim(2), y_shape->GetDim(3), num_threads);
+                    if (b6f3_cost < b4f3_cost) {
+                        conv2d_param_->algo_info.algo_type = ppl::kernel::x86::conv2d_fp32_algo::WINOGRAD_B6F3;
+                    }
+                }
+            }
+
             conv2d_param_->mgr = ppl::kernel::x86::conv2d_algo_selector::gen_algo(
                 conv2d_param_->param, conv2d_param_->algo_info, options.device->GetAllocator());
 
-            // winograd b4f3 avx512 may fallback to direct
-            if (conv2d_param_->algo_info.algo_type == ppl::kernel::x86::conv2d_fp32_algo::WINOGRAD_B4F3) {
+            // winograd falls back to direct when the cost model estimates direct to be faster on the runtime shape
+            const auto winograd_algo = conv2d_param_->algo_info.algo_type;
+            if (winograd_algo == ppl::kernel::x86::conv2d_fp32_algo::WINOGRAD_B4F3 ||
+                winograd_algo == ppl::kernel::x86::conv2d_fp32_algo::WINOGRAD_B6F3) {
+                const auto isa = conv2d_param_->algo_info.isa;
                 conv2d_param_->algo_info.algo_type = ppl::kernel::x86::conv2d_fp32_algo::DIRECT;
                 conv2d_param_->fallback_mgr = ppl::kernel::x86::conv2d_algo_selector::gen_algo(
                     conv2d_param_->param, conv2d_param_->algo_info, options.device->GetAllocator());
-                conv2d_param_->infer_fallback_func = [](const TensorImpl* X, const TensorImpl* Y,
-                                                        const ppl::kernel::x86::conv2d_fp32_param* param) -> bool {
+                conv2d_param_->infer_fallback_func = [winograd_algo, isa](
+                                                         const TensorImpl* X, const TensorImpl* Y,
+                                                         const ppl::kernel::x86::conv2d_fp32_param* param) -> bool {
                     const int64_t dst_h = Y->GetShape()->GetDim(2);
                     const int64_t dst_w = Y->GetShape()->GetDim(3);
                     const int64_t batch = X->GetShape()->GetDim(0);
-                    const int64_t num_tiles = batch * ((dst_h + 3) / 4) * ((dst_w + 3) / 4);
-                    const bool align_tiles = (dst_h % 4 == 0) && (dst_w % 4) == 0;
-
                     const int64_t num_threads = ppl::kernel::x86::get_omp_max_threads();
-                    if (num_threads > 4) { // Maybe memory bound. Just maybe.
-                        if (param->group > 4) {
-                            if (param->channels / param->group <= 2 * 1.801f * 16) { // Multigroup need more channels
-                                return true;
-                            }
-                        }
-                        if (param->group / num_threads > 1 && num_threads / batch <= 4) { // Many group but small batch
-                            return true;
-                        }
-                    }
-                    return num_tiles < (align_tiles ? 10 : 12);
+                    const float direct_cost = ppl::kernel::x86::conv2d_algo_selector::estimate_cost(
+                        *param, ppl::kernel::x86::conv2d_fp32_algo::DIRECT, isa, batch, dst_h, dst_w, num_threads);
+                    const float winograd_cost = ppl::kernel::x86::conv2d_algo_selector::estimate_cost(
+                        *param, winograd_algo, isa, batch, dst_h, dst_w, num_threads);
+                    return direct_cost < winograd_cost;
                 };
-                conv2d_param_->algo_info.algo_type = ppl::kernel::x86::conv2d_fp32_algo::WINOGRAD_B4F3;
+                conv2d_param_->algo_info.algo_type = winograd_algo;
             }
 
             if (bias_data != nullptr) {
@@ -191,6 +214,35 @@ ppl::common::RetCode ConvOp::SelectAlgorithm(const InputOutputInfo& info, const
     return RC_SUCCESS;
 }
 
+RetCode ConvOp::SelectDynamicAlgorithm(const InputOutputInfo& info, const OptKernelOptions& options) {
+    dynamic_algo_info_.algo_type = ppl::kernel::x86::conv2d_fp32_algo::UNKNOWN;
+
+    auto x_shape = info.GetInput<TensorImpl>(0)->GetShape();
+    auto w_shape = info.GetInput<TensorImpl>(1)->GetShape();
+    if (x_shape->GetDataType() != DATATYPE_FLOAT32 || w_shape->GetDimCount() != 4 || param_->pads.size() != 4 ||
+        param_->pads[0] != param_->pads[2] || param_->pads[1] != param_->pads[3]) {
+        return RC_SUCCESS;
+    }
+    // formats are fixed here, so the filter shape must be known
+    for (uint32_t i = 0; i < w_shape->GetDimCount(); ++i) {
+        if (w_shape->GetDim(i) <= 0) {
+            return RC_SUCCESS;
+        }
+    }
+
+    ppl::kernel::x86::conv2d_fp32_param conv2d_param;
+    FillConv2dParam(*param_, w_shape->GetDim(0), w_shape->GetDim(1) * param_->group, &conv2d_param);
+
+    dynamic_algo_info_ = ppl::kernel::x86::conv2d_algo_selector::select_algo(
+        x_shape->GetDataFormat(), conv2d_param, options.device->GetISA());
+    if (dynamic_algo_info_.algo_type == ppl::kernel::x86::conv2d_fp32_algo::UNKNOWN) {
+        LOG(INFO) << "no conv2d algorithm for runtime weights of [" << GetNode()->GetName()
+                  << "], use ndarray kernel.";
+    }
+
+    return RC_SUCCESS;
+}
+
 RetCode ConvOp::SelectFormat(const InputOutputInfo& info, vector<dataformat_t>* selected_input_formats,
                              vector<dataformat_t>* selected_output_formats) {
     if (conv2d_param_ && conv2d_param_->algo_info.algo_type != ppl::kernel::x86::conv2d_fp32_algo::UNKNOWN) {
@@ -199,6 +251,9 @@ RetCode ConvOp::SelectFormat(const InputOutputInfo& info, vector<dataformat_t>*
             selected_input_formats->at(info.GetInputCount() - 1) = conv2d_param_->algo_info.input_format;
         }
         selected_output_formats->at(0) = conv2d_param_->algo_info.output_format;
+    } else if (dynamic_algo_info_.algo_type != ppl::kernel::x86::conv2d_fp32_algo::UNKNOWN) {
+        selected_input_formats->at(0) = dynamic_algo_info_.input_format;
+        selected_output_formats->at(0) = dynamic_algo_info_.output_format;
     }
     return RC_SUCCESS;
 }
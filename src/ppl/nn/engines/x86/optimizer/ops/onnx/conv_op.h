@@ -25,9 +25,12 @@
 namespace ppl { namespace nn { namespace x86 {
 
 class PostDepthwiseConvOp;
+class PostPoolingConvOp;
 class ConvOp final : public X86OptKernel {
 public:
-    ConvOp(const ir::Node* node) : X86OptKernel(node), conv2d_param_(nullptr) {}
+    ConvOp(const ir::Node* node) : X86OptKernel(node), conv2d_param_(nullptr) {
+        dynamic_algo_info_.algo_type = ppl::kernel::x86::conv2d_fp32_algo::UNKNOWN;
+    }
 
     ~ConvOp();
     ppl::common::RetCode Init(const OptKernelOptions& options) override;
@@ -44,12 +47,21 @@ public:
     bool TryFuseReLU6();
     bool TryFuseSum();
 
+private:
+    /**
+       @brief selects data formats for weights supplied at runtime. Conv2dDynamicKernel selects the algorithm
+       and converts weights at runtime within these formats.
+    */
+    ppl::common::RetCode SelectDynamicAlgorithm(const InputOutputInfo& info, const OptKernelOptions& options);
+
 private:
     int32_t bias_term_ = 0;
     Conv2dParam* conv2d_param_;
+    ppl::kernel::x86::conv2d_fp32_algo_info dynamic_algo_info_;
     std::shared_ptr<ppl::nn::onnx::ConvParam> param_;
 
     friend PostDepthwiseConvOp;
+    friend PostPoolingConvOp;
 };
 
 }}} // namespace ppl::nn::x86
@@ -72,9 +72,17 @@ RetCode GemmOp::Init(const OptKernelOptions& options) {
         fc_param_->param.num_output = weight_shape.dims[0];
         fc_param_->param.channels = weight_shape.dims[1];
         fc_param_->param.fuse_flag = 0;
+        fc_param_->param.weight_compression = ppl::kernel::x86::fc_weight_compression::NONE;
+        if (options.engine_options) {
+            if (options.engine_options->weight_compression == WEIGHT_COMPRESSION_FP16) {
+                fc_param_->param.weight_compression = ppl::kernel::x86::fc_weight_compression::FP16;
+            } else if (options.engine_options->weight_compression == WEIGHT_COMPRESSION_INT8) {
+                fc_param_->param.weight_compression = ppl::kernel::x86::fc_weight_compression::INT8;
+            }
+        }
 
         fc_param_->algo_info = ppl::kernel::x86::fc_algo_selector::select_algo(
-            ppl::common::DATAFORMAT_NDARRAY, fc_param_->param, options.device->GetISA());
+            ppl::common::DATAFORMAT_NDARRAY, fc_param_->param, options.device->GetISA(), weight_data);
         if (fc_param_->algo_info.algo_type == ppl::kernel::x86::fc_fp32_algo::UNKNOWN) {
             LOG(INFO) << "FC select algorithm failed, use fallback kernel";
         } else {
@@ -191,13 +191,15 @@ RetCode OptGraph::TryToInferDims(X86Device* device) {
     return RC_SUCCESS;
 }
 
-RetCode OptGraph::DoOptimize(const utils::SharedResource& resource, X86Device* device) {
+RetCode OptGraph::DoOptimize(const utils::SharedResource& resource, X86Device* device,
+                             const EngineOptions* engine_options) {
     OptKernelOptions options;
     options.resource = &resource;
     options.graph_data = graph_->data.get();
     options.graph_topo = graph_->topo.get();
     options.tensors = &tensor_impls_;
     options.device = device;
+    options.engine_options = engine_options;
     options.info = info_;
 
     for (auto it = info_->kernels.begin(); it != info_->kernels.end(); ++it) {
@@ -245,6 +247,9 @@ RetCode OptGraph::DoOptimize(const utils::SharedResource& resource, X86Device* d
 
     opt_rule_manager->ApplyByTag("AfterLayoutOptimize", options);
 
+    // must be the last one because it depends on final formats and producers of tensors
+    opt_rule_manager->Apply("", "EliminateConcat", options);
+
 #ifdef SHOW_GRAPH_VIS
     std::string vis = utils::ToGraphviz(graph_->topo.get());
     std::ofstream out_file("./graph.dot");
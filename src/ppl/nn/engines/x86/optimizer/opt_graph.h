@@ -30,7 +30,7 @@ namespace ppl { namespace nn { namespace x86 {
 class OptGraph final {
 public:
     ppl::common::RetCode Init(const utils::SharedResource&, ir::Graph*, RuntimePartitionInfo*);
-    ppl::common::RetCode DoOptimize(const utils::SharedResource&, X86Device*);
+    ppl::common::RetCode DoOptimize(const utils::SharedResource&, X86Device*, const EngineOptions*);
 
 private:
     ppl::common::RetCode InitKernels(const ir::Graph* graph);
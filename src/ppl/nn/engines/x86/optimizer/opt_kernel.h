@@ -21,6 +21,7 @@
 #include "ppl/nn/runtime/opt_kernel.h"
 #include "ppl/nn/runtime/tensor_impl.h"
 #include "ppl/nn/engines/x86/x86_device.h"
+#include "ppl/nn/engines/x86/engine_options.h"
 #include "ppl/nn/engines/x86/x86_common_param.h"
 #include "ppl/nn/runtime/runtime_partition_info.h"
 #include <functional>
@@ -36,6 +37,7 @@ struct OptKernelOptions final {
     ir::GraphData* graph_data = nullptr;
     ir::GraphTopo* graph_topo = nullptr;
     X86Device* device = nullptr;
+    const EngineOptions* engine_options = nullptr;
     RuntimePartitionInfo* info = nullptr;
     std::map<edgeid_t, std::unique_ptr<TensorImpl>>* tensors = nullptr;
 };
@@ -74,6 +76,17 @@ public:
         common_param_.output_formats[idx] = format;
     }
 
+    /** @brief makes output `idx` be written into a part of the output of a following concat node */
+    void SetConcatDstView(uint32_t idx, const X86ConcatView& view) {
+        common_param_.concat_dst_views.resize(GetNode()->GetOutputCount());
+        common_param_.concat_dst_views[idx] = view;
+    }
+
+    /** @brief tells a concat node that its inputs are written into its output by their producers */
+    void SetConcatSrcViews(const std::vector<X86ConcatView>& views) {
+        common_param_.concat_src_views = views;
+    }
+
     virtual ppl::common::RetCode OmitConstantsData(std::map<edgeid_t, int64_t>* constants_data_refcount) {
         return ppl::common::RC_SUCCESS;
     }
@@ -21,12 +21,14 @@
 #include "ppl/nn/engines/x86/optimizer/rules/fuse_conv_activation.h"
 #include "ppl/nn/engines/x86/optimizer/rules/fuse_conv_eltwise.h"
 #include "ppl/nn/engines/x86/optimizer/rules/fuse_conv_depthwise.h"
+#include "ppl/nn/engines/x86/optimizer/rules/fuse_conv_pooling.h"
 #include "ppl/nn/engines/x86/optimizer/rules/fuse_gemm_activation.h"
 #include "ppl/nn/engines/x86/optimizer/rules/fuse_arithmetic_relu.h"
 #include "ppl/nn/engines/x86/optimizer/rules/fuse_batch_normalization_relu.h"
 #include "ppl/nn/engines/x86/optimizer/rules/fuse_channel_shuffle.h"
 #include "ppl/nn/engines/x86/optimizer/rules/fuse_swish.h"
 #include "ppl/nn/engines/x86/optimizer/rules/layout_optimize.h"
+#include "ppl/nn/engines/x86/optimizer/rules/eliminate_concat.h"
 
 namespace ppl { namespace nn { namespace x86 {
 
@@ -89,12 +91,14 @@ OptRuleManager::~OptRuleManager() {
 
 OptRuleManager::OptRuleManager() {
     REGISTER_OPT_RULE("", "LayoutOptimize", LayoutOptimize);
+    REGISTER_OPT_RULE("", "EliminateConcat", EliminateConcat);
 
     REGISTER_OPT_RULE("BeforeLayoutOptimize", "FuseChannelShuffle", FuseChannelShuffle);
 
     REGISTER_OPT_RULE("AfterLayoutOptimize", "FuseConvActivation", FuseConvActivation);
     REGISTER_OPT_RULE("AfterLayoutOptimize", "FuseConvEltwise", FuseConvEltwise);
     REGISTER_OPT_RULE("AfterLayoutOptimize", "FuseConvDepthwise", FuseConvDepthwise);
+    REGISTER_OPT_RULE("AfterLayoutOptimize", "FuseConvPooling", FuseConvPooling);
     REGISTER_OPT_RULE("AfterLayoutOptimize", "FuseArithmeticReLU", FuseArithmeticReLU);
     REGISTER_OPT_RULE("AfterLayoutOptimize", "FuseBatchNormalizationReLU", FuseBatchNormalizationReLU);
     REGISTER_OPT_RULE("AfterLayoutOptimize", "FuseGemmActivation", FuseGemmActivation);
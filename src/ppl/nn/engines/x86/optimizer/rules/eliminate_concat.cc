@@ -0,0 +1,168 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/engines/x86/optimizer/rules/eliminate_concat.h"
+#include "ppl/nn/engines/x86/optimizer/rules/utils.h"
+#include "ppl/nn/params/onnx/concat_param.h"
+#include "ppl/nn/common/logger.h"
+
+namespace ppl { namespace nn { namespace x86 {
+
+static uint32_t FindOutputIndex(const ir::Node* node, edgeid_t eid) {
+    for (uint32_t i = 0; i < node->GetOutputCount(); ++i) {
+        if (node->GetOutput(i) == eid) {
+            return i;
+        }
+    }
+    return UINT32_MAX;
+}
+
+// inputs are contiguous parts of the output if all dims before `axis` are 1. for N16CX, channels of inputs except the
+// last one must be multiples of 16 when concatenating on the channel axis.
+static bool IsContiguousConcat(const TensorShape& output_shape, int32_t axis) {
+    auto data_format = output_shape.GetDataFormat();
+    if (data_format == ppl::common::DATAFORMAT_N16CX) {
+        if (axis > 1) {
+            return false;
+        }
+    } else if (data_format != ppl::common::DATAFORMAT_NDARRAY) {
+        return false;
+    }
+
+    for (int32_t i = 0; i < axis; ++i) {
+        if (output_shape.GetDim(i) != 1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool HasStaticDims(const TensorShape& shape) {
+    if (shape.GetDimCount() == 0) {
+        return false;
+    }
+    for (uint32_t i = 0; i < shape.GetDimCount(); ++i) {
+        if (shape.GetDim(i) <= 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool EliminateConcat(const OptKernelOptions &options) {
+    auto graph_topo = options.graph_topo;
+    auto graph_data = options.graph_data;
+    auto info = options.info;
+    auto &tensors = *options.tensors;
+
+    for (auto it = graph_topo->CreateNodeIter(); it->IsValid(); it->Forward()) {
+        auto node = it->Get();
+        if (node->GetType().domain != "" || node->GetType().name != "Concat") {
+            continue;
+        }
+
+        // outputs of graph may be bound to caller-owned buffers and are left unchanged
+        auto output_id = node->GetOutput(0);
+        auto output_iter = tensors.find(output_id);
+        if (output_iter == tensors.end() || IsReservedEdge(tensors, output_id)) {
+            continue;
+        }
+        const TensorShape& output_shape = *output_iter->second->GetShape();
+        if (!HasStaticDims(output_shape)) {
+            continue;
+        }
+
+        auto param_ref = graph_data->attrs.find(node->GetId());
+        if (param_ref == graph_data->attrs.end()) {
+            continue;
+        }
+        auto param = (const ppl::nn::onnx::ConcatParam*)param_ref->second.get();
+        const int32_t dim_count = output_shape.GetDimCount();
+        const int32_t axis = param->axis < 0 ? param->axis + dim_count : param->axis;
+        if (axis < 0 || axis >= dim_count || !IsContiguousConcat(output_shape, axis)) {
+            continue;
+        }
+
+        std::vector<X86ConcatView> views(node->GetInputCount());
+        std::vector<X86OptKernel*> producers(node->GetInputCount());
+        std::vector<uint32_t> producer_output_indices(node->GetInputCount());
+        uint64_t offset = 0;
+        bool can_eliminate = true;
+        for (uint32_t i = 0; i < node->GetInputCount() && can_eliminate; ++i) {
+            auto input_id = node->GetInput(i);
+            auto input_edge = graph_topo->GetEdge(input_id);
+            auto input_iter = tensors.find(input_id);
+            if (!input_edge || input_iter == tensors.end() || input_edge->CalcConsumerCount() != 1 ||
+                IsReservedEdge(tensors, input_id) ||
+                graph_data->constants.find(input_id) != graph_data->constants.end()) {
+                can_eliminate = false;
+                break;
+            }
+            for (uint32_t j = 0; j < i; ++j) {
+                if (node->GetInput(j) == input_id) {
+                    can_eliminate = false;
+                    break;
+                }
+            }
+
+            auto producer_id = input_edge->GetProducer();
+            auto producer_iter = info->kernels.find(producer_id);
+            if (producer_id == INVALID_NODEID || producer_iter == info->kernels.end()) {
+                can_eliminate = false;
+                break;
+            }
+
+            const TensorShape& input_shape = *input_iter->second->GetShape();
+            if (!HasStaticDims(input_shape) || input_shape.GetDimCount() != output_shape.GetDimCount() ||
+                input_shape.GetDataType() != output_shape.GetDataType() ||
+                input_shape.GetDataFormat() != output_shape.GetDataFormat()) {
+                can_eliminate = false;
+                break;
+            }
+            if (input_shape.GetDataFormat() == ppl::common::DATAFORMAT_N16CX && axis == 1 &&
+                i + 1 < node->GetInputCount() && input_shape.GetDim(1) % 16 != 0) {
+                can_eliminate = false;
+                break;
+            }
+
+            producers[i] = (X86OptKernel*)producer_iter->second.get();
+            producer_output_indices[i] = FindOutputIndex(producers[i]->GetNode(), input_id);
+
+            views[i].concat_output_id = output_id;
+            views[i].offset = offset;
+            views[i].shape = input_shape;
+            views[i].concat_output_shape = output_shape;
+            offset += input_shape.GetBytesIncludingPadding();
+        }
+
+        if (!can_eliminate || offset != output_shape.GetBytesIncludingPadding()) {
+            continue;
+        }
+
+        for (uint32_t i = 0; i < node->GetInputCount(); ++i) {
+            producers[i]->SetConcatDstView(producer_output_indices[i], views[i]);
+        }
+        auto concat_kernel = (X86OptKernel*)info->kernels[node->GetId()].get();
+        concat_kernel->SetConcatSrcViews(views);
+
+        LOG(DEBUG) << "inputs of concat[" << node->GetName() << "] are written into its output directly.";
+    }
+
+    return false;
+}
+
+}}} // namespace ppl::nn::x86
@@ -0,0 +1,174 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#include "ppl/nn/engines/x86/optimizer/rules/fuse_conv_pooling.h"
+#include "ppl/nn/engines/x86/optimizer/rules/utils.h"
+#include "ppl/nn/engines/x86/optimizer/ops/onnx/conv_op.h"
+#include "ppl/nn/engines/x86/optimizer/ops/pmx/post_pooling_conv_op.h"
+#include "ppl/nn/params/onnx/pooling_param.h"
+
+namespace ppl { namespace nn { namespace x86 {
+
+// only 2d local pooling with symmetric pads, no dilation and floor rounding can be fused
+static bool GetFusablePoolingParam(const ir::Node *pool_node, const ir::GraphData *graph_data,
+                                   ppl::kernel::x86::pp_conv2d_pooling_param *pooling_param) {
+    auto it = graph_data->attrs.find(pool_node->GetId());
+    if (it == graph_data->attrs.end()) {
+        return false;
+    }
+    auto p = (const ppl::nn::onnx::PoolingParam*)(it->second.get());
+    if (p->global_pooling || p->ceil_mode || p->kernel_shape.size() != 2) {
+        return false;
+    }
+    for (auto d : p->dilations) {
+        if (d != 1) {
+            return false;
+        }
+    }
+
+    const int64_t pad_h = p->pads.size() >= 1 ? p->pads[0] : 0;
+    const int64_t pad_w = p->pads.size() >= 2 ? p->pads[1] : 0;
+    if ((p->pads.size() >= 3 && p->pads[2] != pad_h) ||
+        (p->pads.size() >= 4 && p->pads[3] != pad_w)) {
+        return false;
+    }
+
+    pooling_param->mode = pool_node->GetType().name == "MaxPool" ? ppl::nn::onnx::PoolingParam::POOLING_MAX : p->mode;
+    pooling_param->kernel_h = p->kernel_shape[0];
+    pooling_param->kernel_w = p->kernel_shape[1];
+    pooling_param->stride_h = p->strides.size() >= 1 ? p->strides[0] : 1;
+    pooling_param->stride_w = p->strides.size() >= 2 ? p->strides[1] : 1;
+    pooling_param->pad_h = pad_h;
+    pooling_param->pad_w = pad_w;
+    return true;
+}
+
+bool FuseConvPooling(const OptKernelOptions &options) {
+    bool graph_changed = false;
+    auto graph_topo = options.graph_topo;
+    auto graph_data = options.graph_data;
+    auto info = options.info;
+    auto &tensors = *options.tensors;
+
+    for (auto it = graph_topo->CreateNodeIter(); it->IsValid(); it->Forward()) {
+        auto node = it->Get();
+        if (node->GetType().domain == "" && node->GetType().name == "Conv") {
+            auto conv_node = node;
+            auto conv_output_edge_id = conv_node->GetOutput(0);
+            auto conv_out_edge = graph_topo->GetEdge(conv_output_edge_id);
+            if (conv_out_edge->CalcConsumerCount() != 1) {
+                continue;
+            }
+            if (IsReservedEdge(tensors, conv_output_edge_id)) {
+                continue;
+            }
+            auto pool_node = graph_topo->GetNode(conv_out_edge->CreateConsumerIter().Get());
+            if (pool_node->GetType().domain != "" ||
+                (pool_node->GetType().name != "MaxPool" && pool_node->GetType().name != "AveragePool")) {
+                continue;
+            }
+            if (pool_node->GetOutputCount() != 1) { // MaxPool with Indices
+                continue;
+            }
+            auto pool_output_edge_id = pool_node->GetOutput(0);
+            if (tensors[pool_output_edge_id]->GetShape()->GetDataFormat() != ppl::common::DATAFORMAT_N16CX) {
+                continue;
+            }
+
+            ppl::kernel::x86::pp_conv2d_pooling_param pooling_param;
+            if (!GetFusablePoolingParam(pool_node, graph_data, &pooling_param)) {
+                continue;
+            }
+
+            auto conv_kernel = reinterpret_cast<ConvOp*>(info->kernels[conv_node->GetId()].get());
+            auto pp_conv2d_param = PostPoolingConvOp::TryMakePostPoolingConv2dParam(conv_kernel, pooling_param);
+            if (pp_conv2d_param == nullptr) {
+                continue;
+            }
+
+            const std::string pp_conv2d_node_name =
+                    "PostPoolingConv_" + conv_node->GetName() + "_" + pool_node->GetName();
+            const ir::Node::Type type("pmx", "PostPoolingConv", 1);
+
+            // add node to graph topo
+            auto node_ret_pair = graph_topo->AddNode(pp_conv2d_node_name);
+            if (!node_ret_pair.second) {
+                LOG(ERROR) << "node[" << pp_conv2d_node_name << "] already exists.";
+                continue;
+            }
+            auto pp_conv2d_node = node_ret_pair.first;
+            pp_conv2d_node->SetType(type);
+
+            // add new node input/output
+            bool conv_has_bias = conv_kernel->GetBiasTerm();
+
+            auto conv_input = graph_topo->GetEdge(conv_node->GetInput(0));
+            auto conv_w = graph_topo->GetEdge(conv_node->GetInput(1));
+            auto conv_b = conv_has_bias ? graph_topo->GetEdge(conv_node->GetInput(2)) : nullptr;
+            auto conv_output = graph_topo->GetEdge(conv_node->GetOutput(0)); // pooling input
+            auto pool_output = graph_topo->GetEdge(pool_output_edge_id);
+            pp_conv2d_node->AddInput(conv_input->GetId());
+            pp_conv2d_node->AddOutput(pool_output->GetId());
+
+            // create opt kernel & set param and dataformat
+            X86OptKernel *opt_kernel = nullptr;
+            auto status = CreateX86OptKernel(options, pp_conv2d_node, &opt_kernel);
+            if (status != ppl::common::RC_SUCCESS) {
+                LOG(ERROR) << "Create OptKernel [" << pp_conv2d_node_name << "] failed: " << ppl::common::GetRetCodeStr(status);
+                graph_topo->DelNode(pp_conv2d_node->GetId());
+                continue;
+            }
+
+            auto pp_conv2d_kernel = reinterpret_cast<PostPoolingConvOp*>(opt_kernel);
+            pp_conv2d_kernel->SetPostPoolingConv2dParam(pp_conv2d_param);
+            pp_conv2d_kernel->SetOutputDataFormat( // save data format to pp_conv2d
+                    0, tensors[pool_output_edge_id].get()->GetShape()->GetDataFormat());
+
+            // change graph topo
+            conv_input->DelConsumer(conv_node->GetId());
+            conv_w->DelConsumer(conv_node->GetId());
+            if (conv_has_bias) conv_b->DelConsumer(conv_node->GetId());
+            // ====
+            pool_output->SetProducer(pp_conv2d_node->GetId());
+            // ====
+            conv_input->AddConsumer(pp_conv2d_node->GetId());
+
+            // delete kernel & tensors
+            bool del_conv_w = conv_w->CalcConsumerCount() == 0;
+            bool del_conv_b = conv_has_bias && conv_b->CalcConsumerCount() == 0;
+            info->kernels.erase(conv_node->GetId());
+            info->kernels.erase(pool_node->GetId());
+            tensors.erase(conv_output->GetId());
+            if (del_conv_w) tensors.erase(conv_w->GetId());
+            if (del_conv_b) tensors.erase(conv_b->GetId());
+
+            // delete unused node & edge
+            auto conv_w_id = conv_w->GetId();
+            auto conv_b_id = conv_has_bias ? conv_b->GetId() : INVALID_EDGEID;
+            graph_topo->DelNode(conv_node->GetId());
+            graph_topo->DelNode(pool_node->GetId());
+            graph_topo->DelEdge(conv_output->GetId());
+            if (del_conv_w) graph_topo->DelEdge(conv_w_id);
+            if (del_conv_b) graph_topo->DelEdge(conv_b_id);
+
+            graph_changed = true;
+        }
+    }
+
+    return graph_changed;
+}
+
+}}} // namespace ppl::nn::x86
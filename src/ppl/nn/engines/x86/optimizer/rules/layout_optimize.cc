@@ -17,6 +17,7 @@
 
 #include "ppl/nn/engines/x86/optimizer/rules/utils.h"
 #include "ppl/nn/engines/x86/optimizer/opt_rule_manager.h"
+#include "ppl/nn/utils/shared_resource.h"
 
 namespace ppl { namespace nn { namespace x86 {
 
@@ -217,7 +218,12 @@ bool LayoutOptimize(const OptKernelOptions &options) {
             return iter->second.get();
         });
 
-        auto status = kernel->SelectAlgorithm(IOinfo, options);
+        ppl::common::RetCode status;
+        {
+            utils::StartupStageGuard __stage_guard(options.resource->startup_profiler, "SelectAlgorithm",
+                                                   node->GetName());
+            status = kernel->SelectAlgorithm(IOinfo, options);
+        }
         if (status != ppl::common::RC_SUCCESS) {
             LOG(ERROR) << "kernel[" << node->GetName() << "] SelectAlgorithm failed: " << ppl::common::GetRetCodeStr(status);
             return false;
@@ -104,6 +104,7 @@ using namespace ppl::common;
 #include "ppl/nn/engines/x86/optimizer/ops/pmx/shape_operation_op.h"
 #include "ppl/nn/engines/x86/optimizer/ops/pmx/swish_op.h"
 #include "ppl/nn/engines/x86/optimizer/ops/pmx/post_depthwise_conv_op.h"
+#include "ppl/nn/engines/x86/optimizer/ops/pmx/post_pooling_conv_op.h"
 
 namespace ppl { namespace nn { namespace x86 {
 
@@ -234,6 +235,7 @@ void RegisterBuiltinOpImpls() {
     RegisterOptKernelCreator<ShapeOperationOp>("pmx", "Shape", 1, 1);
     RegisterOptKernelCreator<SwishOp>("pmx", "Swish", 1, 1);
     RegisterOptKernelCreator<PostDepthwiseConvOp>("pmx", "PostDepthwiseConv", 1, 1);
+    RegisterOptKernelCreator<PostPoolingConvOp>("pmx", "PostPoolingConv", 1, 1);
 }
 
 }}} // namespace ppl::nn::x86
@@ -29,16 +29,25 @@ namespace ppl { namespace nn { namespace x86 {
 
 static void DummyDeleter(ppl::common::Allocator*) {}
 
-RuntimeX86Device::RuntimeX86Device(uint64_t alignment, isa_t isa, uint32_t mm_policy)
-    : X86Device(alignment, isa), mm_policy_(mm_policy), tmp_buffer_size_(0) {
+RuntimeX86Device::RuntimeX86Device(uint64_t alignment, isa_t isa, uint32_t mm_policy, int32_t numa_node_id)
+    : X86Device(alignment, isa), mm_policy_(mm_policy), tmp_buffer_size_(0), max_tmp_buffer_bytes_(0) {
+    SetNumaNodeId(numa_node_id);
+
     if (mm_policy_ == MM_MRU) {
-        auto allocator_ptr = X86Device::GetAllocator();
+        auto allocator_ptr = GetRawAllocator();
         allocator_ = std::shared_ptr<Allocator>(allocator_ptr, DummyDeleter);
         buffer_manager_.reset(new utils::StackBufferManager(allocator_ptr));
     } else if (mm_policy_ == MM_COMPACT) {
-        allocator_.reset(new utils::CpuBlockAllocator());
+        if (numa_node_id < 0) {
+            allocator_.reset(new utils::CpuBlockAllocator());
+        } else {
+            block_allocator_.reset(new utils::CpuBlockAllocator());
+            allocator_.reset(new NumaAllocator(block_allocator_.get(), numa_node_id));
+        }
         buffer_manager_.reset(new utils::CompactBufferManager(allocator_.get(), alignment, 64u));
     }
+
+    SetKernelAllocatorBase(allocator_.get());
 }
 
 RuntimeX86Device::~RuntimeX86Device() {
@@ -51,6 +60,10 @@ RuntimeX86Device::~RuntimeX86Device() {
 }
 
 RetCode RuntimeX86Device::AllocTmpBuffer(uint64_t bytes, BufferDesc* buffer) {
+    if (bytes > max_tmp_buffer_bytes_) {
+        max_tmp_buffer_bytes_ = bytes;
+    }
+
     if (mm_policy_ == MM_COMPACT) {
         auto ret = buffer_manager_->Realloc(bytes, &shared_tmp_buffer_);
         if (RC_SUCCESS != ret) {
@@ -75,6 +88,13 @@ void RuntimeX86Device::FreeTmpBuffer(BufferDesc* buffer) {
     }
 }
 
+void RuntimeX86Device::GetMemoryUsage(DeviceMemoryUsage* usage) const {
+    X86Device::GetMemoryUsage(usage);
+    usage->allocated_bytes += buffer_manager_->GetAllocatedBytes();
+    usage->peak_used_bytes += buffer_manager_->GetPeakUsedBytes();
+    usage->tmp_buffer_bytes += max_tmp_buffer_bytes_;
+}
+
 /* -------------------------------------------------------------------------- */
 
 RetCode RuntimeX86Device::DoMemDefrag(RuntimeX86Device* dev, va_list) {
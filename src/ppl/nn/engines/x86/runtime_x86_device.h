@@ -32,13 +32,9 @@ private:
     }
 
 public:
-    RuntimeX86Device(uint64_t alignment, ppl::common::isa_t isa, uint32_t mm_policy);
+    RuntimeX86Device(uint64_t alignment, ppl::common::isa_t isa, uint32_t mm_policy, int32_t numa_node_id = -1);
     ~RuntimeX86Device();
 
-    ppl::common::Allocator* GetAllocator() const override {
-        return allocator_.get();
-    }
-
     ppl::common::RetCode Realloc(uint64_t bytes, BufferDesc* buffer) override {
         return buffer_manager_->Realloc(bytes, buffer);
     }
@@ -50,6 +46,8 @@ public:
     ppl::common::RetCode AllocTmpBuffer(uint64_t bytes, BufferDesc* buffer) override;
     void FreeTmpBuffer(BufferDesc* buffer) override;
 
+    void GetMemoryUsage(DeviceMemoryUsage*) const override;
+
     // ----- configurations ----- //
 
     /**
@@ -67,7 +65,9 @@ private:
     uint32_t mm_policy_;
     BufferDesc shared_tmp_buffer_;
     uint64_t tmp_buffer_size_;
+    uint64_t max_tmp_buffer_bytes_;
     std::unique_ptr<utils::BufferManager> buffer_manager_;
+    std::unique_ptr<ppl::common::Allocator> block_allocator_;
     std::shared_ptr<ppl::common::Allocator> allocator_;
 };
 
@@ -18,12 +18,28 @@
 #ifndef _ST_HPC_PPL_NN_ENGINES_X86_X86_COMMON_PARAM_H_
 #define _ST_HPC_PPL_NN_ENGINES_X86_X86_COMMON_PARAM_H_
 
+#include "ppl/nn/common/types.h"
+#include "ppl/nn/common/tensor_shape.h"
 #include <stdint.h>
+#include <vector>
 
 namespace ppl { namespace nn { namespace x86 {
 
+/** a part of the output of a concat node which one of its inputs is written into directly */
+struct X86ConcatView final {
+    edgeid_t concat_output_id = INVALID_EDGEID;
+    uint64_t offset = 0; // in bytes
+    TensorShape shape; // expected shape of the input
+    TensorShape concat_output_shape; // expected shape of the concat output
+};
+
 struct X86CommonParam {
     std::vector<ppl::common::dataformat_t> output_formats;
+
+    /** empty or one for each output. outputs with valid `concat_output_id` are written into the concat output. */
+    std::vector<X86ConcatView> concat_dst_views;
+    /** empty or one for each input of a concat node whose inputs are written into its output by producers. */
+    std::vector<X86ConcatView> concat_src_views;
 };
 
 }}} // namespace ppl::nn::x86
@@ -20,14 +20,19 @@
 
 #include "ppl/nn/common/device.h"
 #include "ppl/nn/engines/x86/data_converter.h"
+#include "ppl/nn/engines/x86/numa_tools.h"
+#include "ppl/nn/utils/counting_allocator.h"
 #include "ppl/common/generic_cpu_allocator.h"
 #include <cstring> // memcpy
+#include <memory>
 
 namespace ppl { namespace nn { namespace x86 {
 
 class X86Device : public Device {
 public:
-    X86Device(uint64_t alignment, ppl::common::isa_t isa) : isa_(isa), data_converter_(isa), allocator_(alignment) {}
+    X86Device(uint64_t alignment, ppl::common::isa_t isa)
+        : isa_(isa), alignment_(alignment), data_converter_(isa), allocator_(alignment),
+          kernel_allocator_(&allocator_) {}
 
     void SetISA(ppl::common::isa_t isa) {
         isa_ = isa;
@@ -37,6 +42,16 @@ public:
         return isa_;
     }
 
+    /** @brief places memory allocated by this device on `numa_node_id`. negative value disables placement. */
+    void SetNumaNodeId(int32_t numa_node_id) {
+        if (numa_node_id < 0) {
+            numa_allocator_.reset();
+        } else {
+            numa_allocator_.reset(new NumaAllocator(&allocator_, numa_node_id));
+        }
+        kernel_allocator_.SetBase(GetRawAllocator());
+    }
+
     virtual ppl::common::RetCode AllocTmpBuffer(uint64_t bytes, BufferDesc* buffer) {
         return Realloc(bytes, buffer);
     }
@@ -45,13 +60,15 @@ public:
         Free(buffer);
     }
 
-    virtual ppl::common::Allocator* GetAllocator() const {
-        return &allocator_;
+    /** @brief returns the allocator used by kernels for their own data, such as converted weights. */
+    ppl::common::Allocator* GetAllocator() const {
+        return &kernel_allocator_;
     }
 
     ppl::common::RetCode Realloc(uint64_t bytes, BufferDesc* buffer) override {
+        auto allocator = GetRawAllocator();
         if (buffer->addr) {
-            allocator_.Free(buffer->addr);
+            allocator->Free(buffer->addr);
         }
 
         if (bytes == 0) {
@@ -59,7 +76,7 @@ public:
             return ppl::common::RC_SUCCESS;
         }
 
-        buffer->addr = allocator_.Alloc(bytes);
+        buffer->addr = allocator->Alloc(bytes);
         if (!buffer->addr) {
             return ppl::common::RC_OUT_OF_MEMORY;
         }
@@ -70,7 +87,7 @@ public:
 
     void Free(BufferDesc* buffer) override {
         if (buffer->addr) {
-            allocator_.Free(buffer->addr);
+            GetRawAllocator()->Free(buffer->addr);
             buffer->addr = nullptr;
         }
     }
@@ -107,6 +124,14 @@ public:
         return &data_converter_;
     }
 
+    bool IsHostMemory() const override final {
+        return true;
+    }
+
+    uint64_t GetAlignment() const override final {
+        return alignment_;
+    }
+
     const char* GetType() const override final {
         return "x86";
     }
@@ -115,10 +140,30 @@ public:
         return ppl::common::RC_UNSUPPORTED;
     }
 
+    void GetMemoryUsage(DeviceMemoryUsage* usage) const override {
+        usage->allocator_bytes += kernel_allocator_.GetAllocatedBytes();
+    }
+
+protected:
+    ppl::common::Allocator* GetRawAllocator() const {
+        if (numa_allocator_) {
+            return numa_allocator_.get();
+        }
+        return &allocator_;
+    }
+
+    /** @brief makes allocations of kernels go to `ar`. MUST be called before any kernel allocates memory. */
+    void SetKernelAllocatorBase(ppl::common::Allocator* ar) {
+        kernel_allocator_.SetBase(ar);
+    }
+
 private:
     ppl::common::isa_t isa_;
+    const uint64_t alignment_;
     X86DataConverter data_converter_;
     mutable ppl::common::GenericCpuAllocator allocator_;
+    std::unique_ptr<NumaAllocator> numa_allocator_;
+    mutable utils::CountingAllocator kernel_allocator_;
 };
 
 }}} // namespace ppl::nn::x86
@@ -23,28 +23,8 @@ using namespace ppl::common;
 
 namespace ppl { namespace nn { namespace ir {
 
-static Node* FindNode(const string& name, const unique_ptr<Node>* nodes, uint32_t count) {
-    for (uint32_t i = 0; i < count; ++i) {
-        auto node = nodes[i].get();
-        if (node && node->GetName() == name) {
-            return node;
-        }
-    }
-    return nullptr;
-}
-
-static Edge* FindEdge(const string& name, const unique_ptr<Edge>* edges, uint32_t count) {
-    for (uint32_t i = 0; i < count; ++i) {
-        auto edge = edges[i].get();
-        if (edge && edge->GetName() == name) {
-            return edge;
-        }
-    }
-    return nullptr;
-}
-
 pair<Node*, bool> FullGraphTopo::AddNode(const string& name) {
-    auto node = FindNode(name, nodes_.data(), nodes_.size());
+    auto node = GetNode(name);
     if (node) {
         return make_pair(node, false);
     }
@@ -52,9 +32,32 @@ pair<Node*, bool> FullGraphTopo::AddNode(const string& name) {
     node = new Node(nodes_.size());
     node->SetName(name);
     nodes_.emplace_back(unique_ptr<Node>(node));
+    name2nid_[name] = node->GetId();
     return make_pair(node, true);
 }
 
+Node* FullGraphTopo::GetNode(const string& name) const {
+    auto ref = name2nid_.find(name);
+    if (ref == name2nid_.end()) {
+        return nullptr;
+    }
+    return nodes_[ref->second].get();
+}
+
+void FullGraphTopo::RenameNode(nodeid_t nid, const string& name) {
+    auto node = GetNode(nid);
+    if (!node) {
+        return;
+    }
+
+    auto ref = name2nid_.find(node->GetName());
+    if (ref != name2nid_.end() && ref->second == nid) {
+        name2nid_.erase(ref);
+    }
+    node->SetName(name);
+    name2nid_[name] = nid;
+}
+
 Node* FullGraphTopo::GetNode(nodeid_t nid) const {
     if (nid >= nodes_.size()) {
         return nullptr;
@@ -64,20 +67,30 @@ Node* FullGraphTopo::GetNode(nodeid_t nid) const {
 
 void FullGraphTopo::DelNode(nodeid_t nid) {
     if (nid < nodes_.size() && nodes_[nid]) {
+        auto ref = name2nid_.find(nodes_[nid]->GetName());
+        if (ref != name2nid_.end() && ref->second == nid) {
+            name2nid_.erase(ref);
+        }
         nodes_[nid].reset();
     }
 }
 
 class FullGraphEdge final : public Edge {
 public:
-    FullGraphEdge(edgeid_t id) : id_(id), producer_(INVALID_NODEID) {}
+    FullGraphEdge(edgeid_t id, unordered_map<string, edgeid_t>* name2eid)
+        : id_(id), producer_(INVALID_NODEID), name2eid_(name2eid) {}
 
     edgeid_t GetId() const override {
         return id_;
     }
 
     void SetName(const std::string& name) override {
+        auto ref = name2eid_->find(name_);
+        if (ref != name2eid_->end() && ref->second == id_) {
+            name2eid_->erase(ref);
+        }
         name_ = name;
+        (*name2eid_)[name_] = id_;
     }
     const std::string& GetName() const override {
         return name_;
@@ -119,6 +132,7 @@ private:
     std::string name_;
     nodeid_t producer_;
     std::vector<nodeid_t> consumers_;
+    unordered_map<string, edgeid_t>* name2eid_;
 
 private:
     FullGraphEdge(const FullGraphEdge&) = delete;
@@ -126,12 +140,12 @@ private:
 };
 
 pair<Edge*, bool> FullGraphTopo::AddEdge(const string& name) {
-    auto edge = FindEdge(name, edges_.data(), edges_.size());
+    auto edge = GetEdge(name);
     if (edge) {
         return make_pair(edge, false);
     }
 
-    edge = new FullGraphEdge(GetMaxEdgeId());
+    edge = new FullGraphEdge(GetMaxEdgeId(), &name2eid_);
     edge->SetName(name);
     edges_.emplace_back(unique_ptr<Edge>(edge));
     return make_pair(edge, true);
@@ -144,6 +158,14 @@ Edge* FullGraphTopo::GetEdge(edgeid_t eid) const {
     return edges_[eid].get();
 }
 
+Edge* FullGraphTopo::GetEdge(const string& name) const {
+    auto ref = name2eid_.find(name);
+    if (ref == name2eid_.end()) {
+        return nullptr;
+    }
+    return edges_[ref->second].get();
+}
+
 void FullGraphTopo::DelEdge(edgeid_t eid) {
     if (eid >= edges_.size()) {
         return;
@@ -158,6 +180,12 @@ void FullGraphTopo::DelEdge(edgeid_t eid) {
     utils::VectorRemoveAllIf(outputs_, p);
     utils::VectorRemoveAllIf(constants_, p);
 
+    if (edges_[eid]) {
+        auto ref = name2eid_.find(edges_[eid]->GetName());
+        if (ref != name2eid_.end() && ref->second == eid) {
+            name2eid_.erase(ref);
+        }
+    }
     edges_[eid].reset();
 }
 
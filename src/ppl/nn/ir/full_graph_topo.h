@@ -19,6 +19,7 @@
 #define _ST_HPC_PPL_NN_IR_FULL_GRAPH_TOPO_H_
 
 #include "ppl/nn/ir/graph_topo.h"
+#include <unordered_map>
 
 namespace ppl { namespace nn { namespace ir {
 
@@ -90,6 +91,8 @@ public:
         return nodes_.size();
     }
     Node* GetNode(nodeid_t id) const override;
+    Node* GetNode(const std::string& name) const override;
+    void RenameNode(nodeid_t id, const std::string& name) override;
     void DelNode(nodeid_t id) override;
 
     // ----- //
@@ -105,12 +108,17 @@ public:
         return edges_.size();
     }
     Edge* GetEdge(edgeid_t id) const override;
+    Edge* GetEdge(const std::string& name) const override;
     void DelEdge(edgeid_t) override;
 
 private:
     std::vector<std::unique_ptr<Edge>> edges_;
     std::vector<std::unique_ptr<Node>> nodes_;
 
+    /** name => id indices. edges update `name2eid_` themselves when they are renamed. */
+    std::unordered_map<std::string, edgeid_t> name2eid_;
+    std::unordered_map<std::string, nodeid_t> name2nid_;
+
 private:
     FullGraphTopo(const FullGraphTopo&) = delete;
     FullGraphTopo& operator=(const FullGraphTopo&) = delete;
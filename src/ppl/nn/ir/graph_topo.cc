@@ -38,6 +38,13 @@ Node* GraphTopo::GetNode(const string& name) const {
     return FindNode(this, name);
 }
 
+void GraphTopo::RenameNode(nodeid_t nid, const string& name) {
+    auto node = GetNode(nid);
+    if (node) {
+        node->SetName(name);
+    }
+}
+
 static edgeid_t FindEdgeId(const string& name, const vector<edgeid_t>& edge_ids, const GraphTopo* topo) {
     for (uint32_t i = 0; i < edge_ids.size(); ++i) {
         auto eid = edge_ids[i];
@@ -88,7 +88,10 @@ public:
     virtual Node* GetNode(nodeid_t id) const = 0;
     virtual void DelNode(nodeid_t id) = 0;
 
-    Node* GetNode(const std::string& name) const;
+    virtual Node* GetNode(const std::string& name) const;
+
+    /** @brief renames a node. nodes in a graph should be renamed by this function to keep name indices valid. */
+    virtual void RenameNode(nodeid_t id, const std::string& name);
 
     // ----- //
 
@@ -109,7 +112,7 @@ public:
     virtual Edge* GetEdge(edgeid_t) const = 0;
     virtual void DelEdge(edgeid_t) = 0;
 
-    Edge* GetEdge(const std::string& name) const;
+    virtual Edge* GetEdge(const std::string& name) const;
 
     // ----- //
 
@@ -198,6 +198,20 @@ Node* PartialGraphTopo::GetNode(nodeid_t nid) const {
     return node_ptrs_[nid];
 }
 
+Node* PartialGraphTopo::GetNode(const string& name) const {
+    auto node = parent_->GetNode(name);
+    if (!node) {
+        return nullptr;
+    }
+    return GetNode(node->GetId());
+}
+
+void PartialGraphTopo::RenameNode(nodeid_t nid, const string& name) {
+    if (nid < node_ptrs_.size() && node_ptrs_[nid]) {
+        parent_->RenameNode(nid, name);
+    }
+}
+
 void PartialGraphTopo::DelNode(nodeid_t nid) {
     if (node_ptrs_[nid]) {
         node_ptrs_[nid] = nullptr;
@@ -231,6 +245,14 @@ Edge* PartialGraphTopo::GetEdge(edgeid_t eid) const {
     return edge_ptrs_[eid];
 }
 
+Edge* PartialGraphTopo::GetEdge(const string& name) const {
+    auto edge = parent_->GetEdge(name);
+    if (!edge) {
+        return nullptr;
+    }
+    return GetEdge(edge->GetId());
+}
+
 void PartialGraphTopo::DelEdge(edgeid_t eid) {
     if (eid < edge_ptrs_.size()) {
         if (edge_ptrs_[eid]) {
@@ -97,6 +97,8 @@ public:
         return parent_->GetMaxNodeId();
     }
     Node* GetNode(nodeid_t id) const override;
+    Node* GetNode(const std::string& name) const override;
+    void RenameNode(nodeid_t id, const std::string& name) override;
     void DelNode(nodeid_t id) override;
 
     // ----- //
@@ -116,6 +118,7 @@ public:
         return parent_->GetMaxEdgeId();
     }
     Edge* GetEdge(edgeid_t id) const override;
+    Edge* GetEdge(const std::string& name) const override;
     void DelEdge(edgeid_t) override;
 
 private:
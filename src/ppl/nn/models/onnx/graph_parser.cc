@@ -20,14 +20,54 @@
 #include "ppl/nn/models/onnx/utils.h"
 #include "ppl/nn/ir/full_graph_topo.h"
 #include "ppl/nn/common/logger.h"
+#include <atomic>
+#include <functional>
+#include <thread>
 using namespace std;
 using namespace ppl::common;
 
 namespace ppl { namespace nn { namespace onnx {
 
+/**
+   @brief calls `f(0)` ~ `f(n - 1)` on multiple threads. `f` MUST NOT modify shared states.
+   @note runs in the calling thread if there are only a few tasks.
+*/
+static void ParallelFor(uint32_t n, const function<void(uint32_t)>& f) {
+    static const uint32_t min_task_num_per_thread = 4;
+
+    uint32_t thread_num = std::min(std::thread::hardware_concurrency(), n / min_task_num_per_thread);
+    if (thread_num <= 1) {
+        for (uint32_t i = 0; i < n; ++i) {
+            f(i);
+        }
+        return;
+    }
+
+    atomic<uint32_t> next_task(0);
+    auto worker = [n, &f, &next_task]() -> void {
+        for (uint32_t i = next_task++; i < n; i = next_task++) {
+            f(i);
+        }
+    };
+
+    vector<thread> threads;
+    threads.reserve(thread_num - 1);
+    for (uint32_t i = 1; i < thread_num; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto t = threads.begin(); t != threads.end(); ++t) {
+        t->join();
+    }
+}
+
 static RetCode ParseGraphInitializer(const ::onnx::GraphProto& pb_graph, const char* model_file_dir,
                                      ir::GraphTopo* topo, ir::GraphData* data) {
-    for (int i = 0; i < pb_graph.initializer_size(); ++i) {
+    const uint32_t initializer_num = pb_graph.initializer_size();
+
+    // edges are created in order to keep ids unchanged
+    vector<edgeid_t> eids(initializer_num);
+    for (uint32_t i = 0; i < initializer_num; ++i) {
         const ::onnx::TensorProto& pb_initializer = pb_graph.initializer(i);
 
         auto ret_pair = topo->AddEdge(pb_initializer.name());
@@ -35,19 +75,27 @@ static RetCode ParseGraphInitializer(const ::onnx::GraphProto& pb_graph, const c
             LOG(ERROR) << "duplicated initializer[" << pb_initializer.name() << "].";
             return RC_EXISTS;
         }
-        auto edge = ret_pair.first;
+        eids[i] = ret_pair.first->GetId();
+    }
 
-        ir::Shape shape;
-        ir::Constant constant;
-        auto status = utils::ParseTensorProto(pb_initializer, model_file_dir, &constant.data, &shape);
-        if (status != RC_SUCCESS) {
-            LOG(ERROR) << "ParseTensorProto failed: " << GetRetCodeStr(status);
-            return status;
+    vector<ir::Shape> shapes(initializer_num);
+    vector<ir::Constant> constants(initializer_num);
+    vector<RetCode> status_list(initializer_num, RC_SUCCESS);
+    ParallelFor(initializer_num, [&](uint32_t i) -> void {
+        status_list[i] = utils::ParseTensorProto(pb_graph.initializer(i), model_file_dir, &constants[i].data,
+                                                 &shapes[i]);
+    });
+
+    for (uint32_t i = 0; i < initializer_num; ++i) {
+        if (status_list[i] != RC_SUCCESS) {
+            LOG(ERROR) << "ParseTensorProto of initializer[" << pb_graph.initializer(i).name()
+                       << "] failed: " << GetRetCodeStr(status_list[i]);
+            return status_list[i];
         }
 
-        data->shapes.insert(make_pair(edge->GetId(), shape));
-        data->constants.emplace(edge->GetId(), std::move(constant));
-        topo->MarkAsConstant(edge->GetId());
+        data->shapes.insert(make_pair(eids[i], std::move(shapes[i])));
+        data->constants.emplace(eids[i], std::move(constants[i]));
+        topo->MarkAsConstant(eids[i]);
     }
 
     return RC_SUCCESS;
@@ -109,8 +157,15 @@ static inline string GenNodeName(uint32_t anonymous_node_count) {
     return "ppl_anonymous_node_" + std::to_string(anonymous_node_count);
 }
 
+struct PendingParam final {
+    const ::onnx::NodeProto* pb_node;
+    ir::Node* node;
+    const ParserInfo* parser_info;
+};
+
+/** @note params that do not modify the topology are appended to `pending_params` and parsed later. */
 static RetCode ParseNodeInfo(const ::onnx::NodeProto& pb_node, const ParamParserExtraArgs& args, ir::GraphData* data,
-                             uint32_t* anonymous_node_count) {
+                             uint32_t* anonymous_node_count, vector<PendingParam>* pending_params) {
     auto topo = args.topo;
     string node_name;
     if (pb_node.name().empty()) {
@@ -177,6 +232,15 @@ static RetCode ParseNodeInfo(const ::onnx::NodeProto& pb_node, const ParamParser
         return RC_SUCCESS;
     }
 
+    if (!parser_info->modifies_topo) {
+        PendingParam pending;
+        pending.pb_node = &pb_node;
+        pending.node = node;
+        pending.parser_info = parser_info;
+        pending_params->push_back(pending);
+        return RC_SUCCESS;
+    }
+
     unique_ptr<ir::Attr, void (*)(ir::Attr*)> param(parser_info->create_param(), parser_info->destroy_param);
     auto status = parser_info->parse_param(pb_node, args, node, param.get());
     if (status != RC_SUCCESS) {
@@ -197,15 +261,40 @@ static RetCode ParseGraphNode(const ::onnx::GraphProto& pb_graph, const map<stri
     args.model_file_dir = model_file_dir;
     args.topo = topo;
 
+    vector<PendingParam> pending_params;
+    pending_params.reserve(pb_graph.node_size());
+
     for (int i = 0; i < pb_graph.node_size(); ++i) {
         auto& pb_node = pb_graph.node(i);
-        auto status = ParseNodeInfo(pb_node, args, data, anonymous_node_count);
+        auto status = ParseNodeInfo(pb_node, args, data, anonymous_node_count, &pending_params);
         if (status != RC_SUCCESS) {
             LOG(ERROR) << "ParseNodeInfo for node[" << pb_node.name() << "] failed: " << GetRetCodeStr(status);
             return status;
         }
     }
 
+    // the topology is complete now. params left only read their own nodes and can be parsed concurrently.
+    vector<unique_ptr<ir::Attr, void (*)(ir::Attr*)>> params;
+    params.reserve(pending_params.size());
+    for (auto p = pending_params.begin(); p != pending_params.end(); ++p) {
+        params.emplace_back(p->parser_info->create_param(), p->parser_info->destroy_param);
+    }
+
+    vector<RetCode> status_list(pending_params.size(), RC_SUCCESS);
+    ParallelFor(pending_params.size(), [&](uint32_t i) -> void {
+        auto& pending = pending_params[i];
+        status_list[i] = pending.parser_info->parse_param(*pending.pb_node, args, pending.node, params[i].get());
+    });
+
+    for (uint32_t i = 0; i < pending_params.size(); ++i) {
+        auto node = pending_params[i].node;
+        if (status_list[i] != RC_SUCCESS) {
+            LOG(ERROR) << "parse attr of node[" << node->GetName() << "] failed: " << GetRetCodeStr(status_list[i]);
+            return status_list[i];
+        }
+        data->attrs.emplace(node->GetId(), std::move(params[i]));
+    }
+
     return RC_SUCCESS;
 }
 
@@ -243,7 +332,7 @@ static RetCode ParseGraphOutput(const ::onnx::GraphProto& pb_graph, ir::GraphTop
 }
 
 RetCode GraphParser::Parse(const ::onnx::GraphProto& pb_graph, const map<string, uint64_t>& op_set,
-                           const char* model_file_dir, ir::Graph* graph) {
+                           const char* model_file_dir, ir::Graph* graph, ppl::nn::utils::StartupProfiler* profiler) {
     graph->topo = make_shared<ir::FullGraphTopo>();
     graph->data = make_shared<ir::GraphData>();
 
@@ -252,7 +341,11 @@ RetCode GraphParser::Parse(const ::onnx::GraphProto& pb_graph, const map<string,
 
     topo->SetName(pb_graph.name());
 
-    auto status = ParseGraphInitializer(pb_graph, model_file_dir, topo, data);
+    RetCode status;
+    {
+        ppl::nn::utils::StartupStageGuard __stage_guard(profiler, "ParseInitializers");
+        status = ParseGraphInitializer(pb_graph, model_file_dir, topo, data);
+    }
     if (status != RC_SUCCESS) {
         LOG(ERROR) << "ParseGraphInitializer failed.";
         return status;
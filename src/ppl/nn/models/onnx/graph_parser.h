@@ -20,14 +20,17 @@
 
 #include "ppl/common/retcode.h"
 #include "ppl/nn/ir/graph.h"
+#include "ppl/nn/utils/startup_profiler.h"
 #include "ppl/nn/models/onnx/generated/onnx.pb.h"
 
 namespace ppl { namespace nn { namespace onnx {
 
 class GraphParser final {
 public:
+    /** @param profiler records decoding initializers as a sub-stage if not nullptr */
     ppl::common::RetCode Parse(const ::onnx::GraphProto& pb_graph, const std::map<std::string, uint64_t>& op_sets,
-                               const char* model_file_dir, ir::Graph* graph);
+                               const char* model_file_dir, ir::Graph* graph,
+                               ppl::nn::utils::StartupProfiler* profiler = nullptr);
 
 private:
     uint32_t anonymous_node_count_ = 0; // used to generate anonymous node name
@@ -60,9 +60,15 @@ static map<string, uint64_t> ParseOpSets(const ::onnx::ModelProto pb_model) {
     return res;
 }
 
-RetCode ModelParser::Parse(const char* buf, uint64_t buf_len, const char* model_file_dir, ir::Graph* graph) {
+RetCode ModelParser::Parse(const char* buf, uint64_t buf_len, const char* model_file_dir, ir::Graph* graph,
+                           utils::StartupProfiler* profiler) {
     ::onnx::ModelProto pb_model;
-    if (!ParseFromBinaryBuffer(buf, buf_len, &pb_model)) {
+    bool ok;
+    {
+        utils::StartupStageGuard __stage_guard(profiler, "ParseProtobuf");
+        ok = ParseFromBinaryBuffer(buf, buf_len, &pb_model);
+    }
+    if (!ok) {
         LOG(ERROR) << "load onnx model from model buffer failed.";
         return RC_OTHER_ERROR;
     }
@@ -75,7 +81,11 @@ RetCode ModelParser::Parse(const char* buf, uint64_t buf_len, const char* model_
     map<string, uint64_t> op_sets = ParseOpSets(pb_model);
 
     GraphParser graph_parser;
-    auto status = graph_parser.Parse(pb_model.graph(), op_sets, model_file_dir, graph);
+    RetCode status;
+    {
+        utils::StartupStageGuard __stage_guard(profiler, "BuildGraph");
+        status = graph_parser.Parse(pb_model.graph(), op_sets, model_file_dir, graph, profiler);
+    }
     if (status != RC_SUCCESS) {
         LOG(ERROR) << "parse graph failed: " << GetRetCodeStr(status);
         return status;
@@ -20,13 +20,15 @@
 
 #include "ppl/common/retcode.h"
 #include "ppl/nn/ir/graph.h"
+#include "ppl/nn/utils/startup_profiler.h"
 
 namespace ppl { namespace nn { namespace onnx {
 
 class ModelParser final {
 public:
+    /** @param profiler records deserializing protobuf and building the graph as sub-stages if not nullptr */
     static ppl::common::RetCode Parse(const char* model_buf, uint64_t buf_len, const char* model_file_dir,
-                                      ir::Graph* graph);
+                                      ir::Graph* graph, ppl::nn::utils::StartupProfiler* profiler = nullptr);
 };
 
 }}} // namespace ppl::nn::onnx
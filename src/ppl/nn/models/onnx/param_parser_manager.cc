@@ -87,7 +87,8 @@ void DeleteParam(ir::Attr* ptr) {
     delete static_cast<T*>(ptr);
 }
 
-#define PPL_REGISTER_OP_WITH_PARAM(domain, type, first_version, last_version, param_type, parse_param_func)    \
+#define PPL_REGISTER_OP_WITH_PARAM_IMPL(domain, type, first_version, last_version, param_type, parse_param_func, \
+                                        modifies_topo_flag)                                                     \
     do {                                                                                                       \
         if (last_version < first_version) {                                                                    \
             LOG(ERROR) << "register op[" << domain << ":" << type << "] failed: last_version[" << last_version \
@@ -99,18 +100,27 @@ void DeleteParam(ir::Attr* ptr) {
         parse_info.create_param = CreateParam<param_type>;                                                     \
         parse_info.parse_param = parse_param_func;                                                             \
         parse_info.destroy_param = DeleteParam<param_type>;                                                    \
+        parse_info.modifies_topo = modifies_topo_flag;                                                         \
         auto status = Register(domain, type, utils::VersionRange(first_version, last_version), parse_info);    \
         if (status != RC_SUCCESS) {                                                                            \
             exit(-1);                                                                                          \
         }                                                                                                      \
     } while (0)
 
+#define PPL_REGISTER_OP_WITH_PARAM(domain, type, first_version, last_version, param_type, parse_param_func) \
+    PPL_REGISTER_OP_WITH_PARAM_IMPL(domain, type, first_version, last_version, param_type, parse_param_func, false)
+
+// for ops whose params contain subgraphs that may refer to edges of the parent graph
+#define PPL_REGISTER_OP_WITH_SUBGRAPH_PARAM(domain, type, first_version, last_version, param_type, parse_param_func) \
+    PPL_REGISTER_OP_WITH_PARAM_IMPL(domain, type, first_version, last_version, param_type, parse_param_func, true)
+
 #define PPL_REGISTER_OP_WITHOUT_PARAM(domain, type, first_version, last_version)              \
     do {                                                                                      \
         ParserInfo parse_info;                                                                \
         parse_info.create_param = nullptr;                                                    \
         parse_info.parse_param = nullptr;                                                     \
         parse_info.destroy_param = nullptr;                                                   \
+        parse_info.modifies_topo = false;                                                     \
         Register(domain, type, utils::VersionRange(first_version, last_version), parse_info); \
     } while (0)
 
@@ -157,14 +167,14 @@ ParamParserManager::ParamParserManager() {
     PPL_REGISTER_OP_WITHOUT_PARAM("", "Greater", 7, 16);
     // I
     PPL_REGISTER_OP_WITHOUT_PARAM("", "Identity", 1, 13);
-    PPL_REGISTER_OP_WITH_PARAM("", "If", 1, 12, ppl::nn::onnx::IfParam, ParseIfParam);
+    PPL_REGISTER_OP_WITH_SUBGRAPH_PARAM("", "If", 1, 12, ppl::nn::onnx::IfParam, ParseIfParam);
     PPL_REGISTER_OP_WITH_PARAM("", "InstanceNormalization", 6, 13, ppl::nn::onnx::InstanceNormalizationParam,
                                ParseInstanceNormalizationParam);
     // L
     PPL_REGISTER_OP_WITH_PARAM("", "LeakyRelu", 6, 16, ppl::nn::onnx::LeakyReluParam, ParseLeakyReluParam);
     PPL_REGISTER_OP_WITHOUT_PARAM("", "Less", 7, 16);
     PPL_REGISTER_OP_WITHOUT_PARAM("", "Log", 6, 16);
-    PPL_REGISTER_OP_WITH_PARAM("", "Loop", 1, 12, ppl::nn::onnx::LoopParam, ParseLoopParam);
+    PPL_REGISTER_OP_WITH_SUBGRAPH_PARAM("", "Loop", 1, 12, ppl::nn::onnx::LoopParam, ParseLoopParam);
     PPL_REGISTER_OP_WITH_PARAM("", "LRN", 1, 16, ppl::nn::onnx::LRNParam, ParseLRNParam);
     PPL_REGISTER_OP_WITH_PARAM("", "LSTM", 7, 13, ppl::nn::onnx::LSTMParam, ParseLSTMParam);
     // M
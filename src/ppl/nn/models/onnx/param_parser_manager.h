@@ -35,6 +35,12 @@ struct ParserInfo final {
     CreateParamFunc create_param;
     ParseParamFunc parse_param;
     DeleteParamFunc destroy_param;
+
+    /*
+      `parse_param` adds edges to `ParamParserExtraArgs::topo`(ops with subgraphs, for example). such params are
+      parsed in order with the graph topology. others may be parsed concurrently.
+    */
+    bool modifies_topo;
 };
 
 class ParamParserManager final {
@@ -21,6 +21,7 @@
 #include "ppl/nn/optimizers/utils.h"
 #include "ppl/nn/optimizers/engine_graph_partitioner.h"
 #include "ppl/nn/runtime/runtime_impl.h"
+#include "ppl/nn/runtime/memory_aware_sort.h"
 #include "ppl/nn/models/onnx/model_parser.h"
 #include "ppl/nn/models/onnx/runtime_builder_impl.h"
 using namespace std;
@@ -35,6 +36,7 @@ namespace ppl { namespace nn { namespace onnx {
 RuntimeBuilderImpl::RuntimeBuilderImpl() {
     graph_info_ = make_shared<RuntimeGraphInfo>();
     aux_info_ = make_shared<RuntimeAuxInfo>();
+    resource_.startup_profiler = &startup_profiler_;
 }
 
 RuntimeBuilderImpl::~RuntimeBuilderImpl() {
@@ -50,8 +52,13 @@ RetCode RuntimeBuilderImpl::Init(const char* model_buf, uint64_t buf_len, Engine
     }
 
     resource_.graph_partitioner = make_shared<EngineGraphPartitioner>();
+    resource_.graph_optimizer_options.engines = &resource_.engines;
 
-    auto status = ModelParser::Parse(model_buf, buf_len, model_file_dir, &graph_);
+    RetCode status;
+    {
+        utils::StartupStageGuard __stage_guard(&startup_profiler_, "ParseModel");
+        status = ModelParser::Parse(model_buf, buf_len, model_file_dir, &graph_, &startup_profiler_);
+    }
     if (status != RC_SUCCESS) {
         LOG(ERROR) << "parse graph failed: " << GetRetCodeStr(status);
         return status;
@@ -82,6 +89,8 @@ RetCode RuntimeBuilderImpl::Init(const char* model_file, Engine** engines, uint3
 }
 
 RetCode RuntimeBuilderImpl::Preprocess() {
+    utils::StartupStageGuard __stage_guard(&startup_profiler_, "Preprocess");
+
     auto status = utils::ProcessGraph(resource_, &graph_, graph_info_.get());
     if (status != RC_SUCCESS) {
         LOG(ERROR) << "process graph failed: " << GetRetCodeStr(status);
@@ -94,6 +103,15 @@ RetCode RuntimeBuilderImpl::Preprocess() {
         return status;
     }
 
+    if (enable_memory_aware_sort_) {
+        status = utils::ApplyMemoryAwareOrder(graph_.topo.get(), resource_.reserved_edgeids, graph_info_->shapes,
+                                              &aux_info_);
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "ApplyMemoryAwareOrder failed: " << GetRetCodeStr(status);
+            return status;
+        }
+    }
+
     status = init_info_.Init(graph_.topo.get());
     if (status != RC_SUCCESS) {
         LOG(ERROR) << "GenerateRuntimeInitInfo failed: " << GetRetCodeStr(status);
@@ -104,6 +122,8 @@ RetCode RuntimeBuilderImpl::Preprocess() {
 }
 
 Runtime* RuntimeBuilderImpl::CreateRuntime() {
+    utils::StartupStageGuard __stage_guard(&startup_profiler_, "CreateRuntime");
+
     auto runtime = new RuntimeImpl();
     if (!runtime) {
         return nullptr;
@@ -139,6 +159,14 @@ RetCode RuntimeBuilderImpl::Serialize(const char* output_file, const char* fmt)
 #endif
 }
 
+RetCode RuntimeBuilderImpl::GetStartupProfilingStatistics(StartupProfilingStatistics* stat) const {
+    if (!startup_profiler_.IsEnabled()) {
+        LOG(ERROR) << "startup profiling is not enabled.";
+        return RC_INVALID_VALUE;
+    }
+    return startup_profiler_.GetStatistics(stat);
+}
+
 /* -------------------------------------------------------------------------- */
 
 RetCode RuntimeBuilderImpl::ReserveTensor(RuntimeBuilderImpl* impl, va_list args) {
@@ -154,8 +182,40 @@ RetCode RuntimeBuilderImpl::ReserveTensor(RuntimeBuilderImpl* impl, va_list args
     return RC_SUCCESS;
 }
 
+RetCode RuntimeBuilderImpl::SetStartupProfilingFlag(RuntimeBuilderImpl* impl, va_list args) {
+    auto flag = va_arg(args, uint32_t);
+    bool profiling_flag = (flag > 0);
+    if (profiling_flag && !impl->startup_profiler_.IsEnabled()) {
+        impl->startup_profiler_.Clear();
+    }
+    impl->startup_profiler_.SetEnabled(profiling_flag);
+    return RC_SUCCESS;
+}
+
+RetCode RuntimeBuilderImpl::EnableMemoryAwareSort(RuntimeBuilderImpl* impl, va_list args) {
+    auto flag = va_arg(args, uint32_t);
+    impl->enable_memory_aware_sort_ = (flag > 0);
+    return RC_SUCCESS;
+}
+
+RetCode RuntimeBuilderImpl::EnableFixedInputDims(RuntimeBuilderImpl* impl, va_list args) {
+    auto flag = va_arg(args, uint32_t);
+    impl->resource_.graph_optimizer_options.fixed_input_dims = (flag > 0);
+    return RC_SUCCESS;
+}
+
+RetCode RuntimeBuilderImpl::EnableSiblingFusion(RuntimeBuilderImpl* impl, va_list args) {
+    auto flag = va_arg(args, uint32_t);
+    impl->resource_.graph_optimizer_options.enable_sibling_fusion = (flag > 0);
+    return RC_SUCCESS;
+}
+
 RuntimeBuilderImpl::ConfHandlerFunc RuntimeBuilderImpl::conf_handlers_[] = {
     RuntimeBuilderImpl::ReserveTensor,
+    RuntimeBuilderImpl::SetStartupProfilingFlag,
+    RuntimeBuilderImpl::EnableMemoryAwareSort,
+    RuntimeBuilderImpl::EnableFixedInputDims,
+    RuntimeBuilderImpl::EnableSiblingFusion,
 };
 
 RetCode RuntimeBuilderImpl::Configure(uint32_t option, ...) {
@@ -41,9 +41,14 @@ public:
     Runtime* CreateRuntime(const char** begin_ops, uint32_t begin_op_num, const char** end_ops,
                            uint32_t end_op_num) override;
     ppl::common::RetCode Serialize(const char* output_file, const char* fmt) const override;
+    ppl::common::RetCode GetStartupProfilingStatistics(StartupProfilingStatistics*) const override;
 
 private:
     static ppl::common::RetCode ReserveTensor(RuntimeBuilderImpl*, va_list);
+    static ppl::common::RetCode SetStartupProfilingFlag(RuntimeBuilderImpl*, va_list);
+    static ppl::common::RetCode EnableMemoryAwareSort(RuntimeBuilderImpl*, va_list);
+    static ppl::common::RetCode EnableFixedInputDims(RuntimeBuilderImpl*, va_list);
+    static ppl::common::RetCode EnableSiblingFusion(RuntimeBuilderImpl*, va_list);
 
     typedef ppl::common::RetCode (*ConfHandlerFunc)(RuntimeBuilderImpl*, va_list);
     static ConfHandlerFunc conf_handlers_[ORB_CONF_MAX];
@@ -55,6 +60,8 @@ private:
     std::shared_ptr<RuntimeAuxInfo> aux_info_;
     RuntimeInitInfo init_info_;
     PartialRuntimeCreator partial_runtime_creator_;
+    utils::StartupProfiler startup_profiler_;
+    bool enable_memory_aware_sort_ = false;
 
 private:
     RuntimeBuilderImpl(const RuntimeBuilderImpl&) = delete;
@@ -19,6 +19,7 @@
 #include "ppl/common/file_mapping.h"
 #include "ppl/nn/common/logger.h"
 #include "ppl/nn/runtime/runtime_impl.h"
+#include "ppl/nn/runtime/memory_aware_sort.h"
 #include "ppl/nn/ir/full_graph_topo.h"
 #include "ppl/nn/models/pmx/runtime_builder_impl.h"
 #include "ppl/nn/models/pmx/graph_parser.h"
@@ -123,6 +124,14 @@ RetCode RuntimeBuilderImpl::Preprocess() {
         return status;
     }
 
+    if (enable_memory_aware_sort_) {
+        status = utils::ApplyMemoryAwareOrder(topo_.get(), resource_.reserved_edgeids, graph_info_->shapes, &aux_info_);
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "ApplyMemoryAwareOrder failed: " << GetRetCodeStr(status);
+            return status;
+        }
+    }
+
     status = init_info_.Init(topo_.get());
     if (status != RC_SUCCESS) {
         LOG(ERROR) << "GenerateRuntimeInitInfo failed: " << GetRetCodeStr(status);
@@ -178,8 +187,15 @@ RetCode RuntimeBuilderImpl::ReserveTensor(RuntimeBuilderImpl* impl, va_list args
     return RC_SUCCESS;
 }
 
+RetCode RuntimeBuilderImpl::EnableMemoryAwareSort(RuntimeBuilderImpl* impl, va_list args) {
+    auto flag = va_arg(args, uint32_t);
+    impl->enable_memory_aware_sort_ = (flag > 0);
+    return RC_SUCCESS;
+}
+
 RuntimeBuilderImpl::ConfHandlerFunc RuntimeBuilderImpl::conf_handlers_[] = {
     RuntimeBuilderImpl::ReserveTensor,
+    RuntimeBuilderImpl::EnableMemoryAwareSort,
 };
 
 RetCode RuntimeBuilderImpl::Configure(uint32_t option, ...) {
@@ -46,6 +46,7 @@ public:
 
 private:
     static ppl::common::RetCode ReserveTensor(RuntimeBuilderImpl*, va_list);
+    static ppl::common::RetCode EnableMemoryAwareSort(RuntimeBuilderImpl*, va_list);
 
     typedef ppl::common::RetCode (*ConfHandlerFunc)(RuntimeBuilderImpl*, va_list);
     static ConfHandlerFunc conf_handlers_[PRB_CONF_MAX];
@@ -57,6 +58,7 @@ private:
     std::shared_ptr<RuntimeAuxInfo> aux_info_;
     RuntimeInitInfo init_info_;
     PartialRuntimeCreator partial_runtime_creator_;
+    bool enable_memory_aware_sort_ = false;
 };
 
 }}} // namespace ppl::nn::pmx
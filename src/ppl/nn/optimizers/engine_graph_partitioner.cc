@@ -16,11 +16,10 @@
 // under the License.
 
 #include "ppl/nn/optimizers/engine_graph_partitioner.h"
-#include "ppl/nn/ir/partial_graph_topo.h"
 #include "ppl/nn/ir/utils.h"
 #include "ppl/nn/common/logger.h"
-#include <set>
-#include <queue>
+#include <chrono>
+#include <functional>
 using namespace std;
 using namespace ppl::common;
 
@@ -37,124 +36,158 @@ static EngineImpl* FindEngine(const vector<EngineImpl*>& engines, const ir::Node
     return nullptr;
 }
 
+// a set of partition indices. bit `i` stands for the i-th partition.
+typedef vector<uint64_t> PartitionSet;
+
 struct PartitionInfo final {
     // whether nodes are special_types_
     bool is_special_types = false;
     EngineImpl* engine;
     vector<nodeid_t> nodes;
+    // partitions that this partition depends on, directly or indirectly
+    PartitionSet ancestors;
+    // partitions that depend on this partition, directly or indirectly
+    PartitionSet descendants;
 };
 
+static inline bool PartitionSetContains(const PartitionSet& s, uint32_t par_idx) {
+    auto word = par_idx / 64;
+    return (word < s.size() && (s[word] & (1ULL << (par_idx % 64))));
+}
+
+static inline void PartitionSetInsert(uint32_t par_idx, PartitionSet* s) {
+    auto word = par_idx / 64;
+    if (word >= s->size()) {
+        s->resize(word + 1, 0);
+    }
+    (*s)[word] |= (1ULL << (par_idx % 64));
+}
+
+static inline void PartitionSetMerge(const PartitionSet& src, PartitionSet* dst) {
+    if (src.size() > dst->size()) {
+        dst->resize(src.size(), 0);
+    }
+    for (uint32_t i = 0; i < src.size(); ++i) {
+        (*dst)[i] |= src[i];
+    }
+}
+
+static inline void PartitionSetForEach(const PartitionSet& s, const function<void(uint32_t)>& f) {
+    for (uint32_t word = 0; word < s.size(); ++word) {
+        if (s[word] == 0) {
+            continue;
+        }
+        for (uint32_t bit = 0; bit < 64; ++bit) {
+            if (s[word] & (1ULL << bit)) {
+                f(word * 64 + bit);
+            }
+        }
+    }
+}
+
 // returns the partition index if all predecessors are in the same partition, otherwise returns UINT32_MAX
-static uint32_t PredecessorsInTheSamePartition(const vector<nodeid_t>& prev_ids,
-                                               const map<nodeid_t, uint32_t>& nid2par) {
+static uint32_t PredecessorsInTheSamePartition(const vector<nodeid_t>& prev_ids, const vector<uint32_t>& nid2par) {
     uint32_t par_idx = UINT32_MAX;
     for (auto x = prev_ids.begin(); x != prev_ids.end(); ++x) {
-        auto ref = nid2par.find(*x);
+        auto prev_par_idx = nid2par[*x];
         if (par_idx == UINT32_MAX) {
-            par_idx = ref->second;
-        } else if (ref->second != par_idx) {
+            par_idx = prev_par_idx;
+        } else if (prev_par_idx != par_idx) {
             return UINT32_MAX;
         }
     }
     return par_idx;
 }
 
-static vector<nodeid_t> FindLowestCommonAncestors(nodeid_t a, nodeid_t b, const ir::GraphTopo* topo) {
-    set<nodeid_t> ancestors_of_a = topo->FindAncestors(a);
-    set<nodeid_t> ancestors_of_b = topo->FindAncestors(b);
-    vector<nodeid_t> common_nodes(ancestors_of_a.size() + ancestors_of_b.size());
-    auto end_iter = std::set_intersection(ancestors_of_a.begin(), ancestors_of_a.end(), ancestors_of_b.begin(),
-                                          ancestors_of_b.end(), common_nodes.begin());
-    common_nodes.resize(end_iter - common_nodes.begin());
-    ir::PartialGraphTopo sub_topo(const_cast<ir::GraphTopo*>(topo), common_nodes);
-    vector<nodeid_t> ret;
-    for (uint32_t i = 0; i < sub_topo.GetOutputCount(); ++i) {
-        ret.push_back(sub_topo.GetOutput(i));
-    }
-    return ret;
-}
-
-static bool IsInTheSamePartition(uint32_t par_idx, const vector<nodeid_t>& common_ancestors,
-                                 const map<nodeid_t, uint32_t>& nid2par) {
-    for (auto x = common_ancestors.begin(); x != common_ancestors.end(); ++x) {
-        auto par_prev_idx_ref = nid2par.find(*x);
-        if (par_prev_idx_ref->second == par_idx) {
-            return true;
+/*
+  makes partition `par_idx` depend on partitions of `prev_ids`. ancestors and descendants of partitions are kept
+  transitively closed. a node may join a partition created before some of its predecessors' partitions, so
+  descendants of `par_idx` are not necessarily created after it.
+*/
+static void AddPartitionDependencies(uint32_t par_idx, const vector<nodeid_t>& prev_ids,
+                                     const vector<uint32_t>& nid2par, vector<PartitionInfo>* par_infos) {
+    PartitionSet new_ancestors;
+    auto& ancestors = par_infos->at(par_idx).ancestors;
+    for (auto x = prev_ids.begin(); x != prev_ids.end(); ++x) {
+        auto prev_par_idx = nid2par[*x];
+        if (prev_par_idx != par_idx && !PartitionSetContains(ancestors, prev_par_idx)) {
+            PartitionSetInsert(prev_par_idx, &new_ancestors);
+            PartitionSetMerge(par_infos->at(prev_par_idx).ancestors, &new_ancestors);
         }
     }
-    return false;
+    if (new_ancestors.empty()) {
+        return;
+    }
+
+    // `par_idx` and its descendants depend on `new_ancestors`
+    PartitionSet new_descendants = par_infos->at(par_idx).descendants;
+    PartitionSetInsert(par_idx, &new_descendants);
+
+    PartitionSetForEach(new_descendants, [&new_ancestors, par_infos](uint32_t i) -> void {
+        PartitionSetMerge(new_ancestors, &par_infos->at(i).ancestors);
+    });
+    PartitionSetForEach(new_ancestors, [&new_descendants, par_infos](uint32_t i) -> void {
+        PartitionSetMerge(new_descendants, &par_infos->at(i).descendants);
+    });
 }
 
 // returns prev id, or INVALID_NODEID if none.
-static nodeid_t WhichPrevToJoin(const ir::GraphTopo* topo, const EngineImpl* engine, const vector<nodeid_t>& prev_ids,
-                                const vector<PartitionInfo>& par_infos, const map<nodeid_t, uint32_t>& nid2par) {
-    vector<bool> can_be_merged_with(prev_ids.size(), true);
-
+static nodeid_t WhichPrevToJoin(const EngineImpl* engine, const vector<nodeid_t>& prev_ids,
+                                const vector<PartitionInfo>& par_infos, const vector<uint32_t>& nid2par) {
     for (uint32_t i = 0; i < prev_ids.size(); ++i) {
-        if (!can_be_merged_with[i]) {
+        uint32_t prev_par_idx = nid2par[prev_ids[i]];
+        if (engine != par_infos[prev_par_idx].engine) {
             continue;
         }
 
-        uint32_t prev_par_idx = nid2par.find(prev_ids[i])->second;
-        auto& prev_par_info = par_infos[prev_par_idx];
-        if (engine != prev_par_info.engine) {
-            can_be_merged_with[i] = false;
-            continue;
-        }
+        /*
+          if the partition containing `prev-2` depends on the partition containing `prev-1`, e.g. one of
+          its nodes (not necessarily `prev-2`) has an ancestor in it, merging current node into the
+          partition of `prev-1` will form circular dependencies between these two partitions.
 
-        for (uint32_t j = i + 1; j < prev_ids.size(); ++j) {
-            /*
-              if `prev-1` is in the same partition as one of the common ancestors,
-              merging current node into that partition will form circular dependencies with
-              the partition which contains `prev-2`.
-
-               +--------------------------------------------------+
-               | common ancestors of predecessors of current node |
-               +--------------------------------------------------+
-                                        |
-                         +--------------+------------+
-                         |              |            |
-                         |           +++++++         |
-                         |           | ... |         |
-                         |           +++++++         |
-                         |              |            |
-                     +--------+     +========+     +-----+
-                     | prev-1 |     | prev-2 |     | ... |
-                     +--------+     +========+     +-----+
-                        |               |            |
-                        +---------------+------------+
-                                        |
-                                +--------------+
-                                | current node |
-                                +--------------+
-            */
-            auto common_ancestors = FindLowestCommonAncestors(prev_ids[i], prev_ids[j], topo);
-            if (IsInTheSamePartition(prev_par_idx, common_ancestors, nid2par)) {
-                can_be_merged_with[i] = false;
-                break;
-            }
-
-            auto prev2_par_idx = nid2par.find(prev_ids[j])->second;
-            if (IsInTheSamePartition(prev2_par_idx, common_ancestors, nid2par)) {
-                can_be_merged_with[j] = false;
+           +----------------------------------+
+           | partition of prev-1 and ancestor |
+           +----------------------------------+
+                 |                    |
+                 |                 +++++++
+                 |                 | ... |
+                 |                 +++++++
+                 |                    |
+             +--------+          +========+
+             | prev-1 |          | prev-2 |
+             +--------+          +========+
+                 |                    |
+                 +---------+----------+
+                           |
+                   +--------------+
+                   | current node |
+                   +--------------+
+        */
+        bool can_be_merged = true;
+        for (uint32_t j = 0; j < prev_ids.size(); ++j) {
+            auto prev2_par_idx = nid2par[prev_ids[j]];
+            if (prev2_par_idx != prev_par_idx &&
+                PartitionSetContains(par_infos[prev2_par_idx].ancestors, prev_par_idx)) {
+                can_be_merged = false;
                 break;
             }
         }
-    }
 
-    for (uint32_t i = 0; i < can_be_merged_with.size(); ++i) {
-        if (can_be_merged_with[i]) {
+        if (can_be_merged) {
             return prev_ids[i];
         }
     }
+
     return INVALID_NODEID;
 }
 
 // TODO optimize: use an alternative engine of ops in FindEngine()
 RetCode EngineGraphPartitioner::Partition(const vector<EngineImpl*>& engines, const ir::GraphTopo* topo,
                                           vector<pair<EngineImpl*, vector<nodeid_t>>>* partitions) const {
+    auto begin_ts = std::chrono::steady_clock::now();
+
     vector<PartitionInfo> par_infos;
-    map<nodeid_t, uint32_t> nid2par; // nodeid => index of par_infos
+    vector<uint32_t> nid2par(topo->GetMaxNodeId(), UINT32_MAX); // nodeid => index of par_infos
 
     vector<nodeid_t> sorted_nodes;
     utils::DfsDeeperFirst(topo, [&sorted_nodes](nodeid_t nid) -> void {
@@ -177,6 +210,7 @@ RetCode EngineGraphPartitioner::Partition(const vector<EngineImpl*>& engines, co
 
         bool is_special_type = IsSpecialType(node->GetType());
         auto prev_ids = topo->FindPredecessors(nid);
+
         if (prev_ids.empty()) {
             bool is_inserted = false;
             // try to merge a root node to existing root partitions
@@ -184,7 +218,7 @@ RetCode EngineGraphPartitioner::Partition(const vector<EngineImpl*>& engines, co
                 auto& partition = par_infos[*p];
                 if (is_special_type == partition.is_special_types && engine == partition.engine) {
                     partition.nodes.push_back(nid);
-                    nid2par.insert(make_pair(nid, *p));
+                    nid2par[nid] = *p;
                     is_inserted = true;
                     break;
                 }
@@ -196,7 +230,7 @@ RetCode EngineGraphPartitioner::Partition(const vector<EngineImpl*>& engines, co
                 new_par.nodes.push_back(nid);
                 auto new_par_idx = par_infos.size();
                 par_infos.emplace_back(std::move(new_par));
-                nid2par.insert(make_pair(nid, new_par_idx));
+                nid2par[nid] = new_par_idx;
                 root_partitions_idx.push_back(new_par_idx);
             }
         } else {
@@ -207,7 +241,7 @@ RetCode EngineGraphPartitioner::Partition(const vector<EngineImpl*>& engines, co
                 auto& prev_par = par_infos[prev_par_idx];
                 if (is_special_type == prev_par.is_special_types && engine == prev_par.engine) {
                     prev_par.nodes.push_back(nid);
-                    nid2par.insert(make_pair(nid, prev_par_idx));
+                    nid2par[nid] = prev_par_idx;
                 } else {
                     // creates a new partition for different types of consecutive nodes
                     PartitionInfo new_par;
@@ -215,33 +249,35 @@ RetCode EngineGraphPartitioner::Partition(const vector<EngineImpl*>& engines, co
                     new_par.engine = engine;
                     new_par.nodes.push_back(nid);
                     par_infos.emplace_back(std::move(new_par));
-                    nid2par.insert(make_pair(nid, par_infos.size() - 1));
+                    nid2par[nid] = par_infos.size() - 1;
                 }
             } else {
-                auto prev_id = WhichPrevToJoin(topo, engine, prev_ids, par_infos, nid2par);
+                auto prev_id = WhichPrevToJoin(engine, prev_ids, par_infos, nid2par);
                 if (prev_id == INVALID_NODEID) {
                     PartitionInfo new_par;
                     new_par.is_special_types = is_special_type;
                     new_par.engine = engine;
                     new_par.nodes.push_back(nid);
                     par_infos.emplace_back(std::move(new_par));
-                    nid2par.insert(make_pair(nid, par_infos.size() - 1));
+                    nid2par[nid] = par_infos.size() - 1;
                 } else {
-                    auto ref = nid2par.find(prev_id);
-                    auto& prev_par = par_infos[ref->second];
+                    auto prev_par_idx = nid2par[prev_id];
+                    auto& prev_par = par_infos[prev_par_idx];
                     if (is_special_type == prev_par.is_special_types && engine == prev_par.engine) {
                         prev_par.nodes.push_back(nid);
-                        nid2par.insert(make_pair(nid, ref->second));
+                        nid2par[nid] = prev_par_idx;
                     } else {
                         PartitionInfo new_par;
                         new_par.is_special_types = is_special_type;
                         new_par.engine = engine;
                         new_par.nodes.push_back(nid);
                         par_infos.emplace_back(std::move(new_par));
-                        nid2par.insert(make_pair(nid, par_infos.size() - 1));
+                        nid2par[nid] = par_infos.size() - 1;
                     }
                 }
             }
+
+            AddPartitionDependencies(nid2par[nid], prev_ids, nid2par, &par_infos);
         }
     }
 
@@ -250,6 +286,11 @@ RetCode EngineGraphPartitioner::Partition(const vector<EngineImpl*>& engines, co
         partitions->emplace_back(p->engine, std::move(p->nodes));
     }
 
+    auto end_ts = std::chrono::steady_clock::now();
+    auto diff = std::chrono::duration_cast<std::chrono::microseconds>(end_ts - begin_ts);
+    LOG(DEBUG) << "partitioning graph[" << topo->GetName() << "] with [" << sorted_nodes.size() << "] nodes into ["
+               << partitions->size() << "] partitions costs [" << (float)diff.count() / 1000 << "] ms";
+
     return RC_SUCCESS;
 }
 
@@ -0,0 +1,549 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <map>
+#include <memory>
+#include <set>
+
+#include "ppl/nn/optimizers/fold_constant_optimizer.h"
+#include "ppl/nn/optimizers/engine_graph_partitioner.h"
+#include "ppl/nn/optimizers/utils.h"
+#include "ppl/nn/ir/full_graph_topo.h"
+#include "ppl/nn/common/input_output_info.h"
+#include "ppl/nn/common/logger.h"
+#include "ppl/nn/runtime/runtime_impl.h"
+#include "ppl/nn/runtime/tensor_impl.h"
+#include "ppl/nn/utils/shared_resource.h"
+#include "ppl/nn/oputils/onnx/reshape_add.h"
+#include "ppl/nn/oputils/onnx/reshape_cast.h"
+#include "ppl/nn/oputils/onnx/reshape_concat.h"
+#include "ppl/nn/oputils/onnx/reshape_conv.h"
+#include "ppl/nn/oputils/onnx/reshape_flatten.h"
+#include "ppl/nn/oputils/onnx/reshape_gather.h"
+#include "ppl/nn/oputils/onnx/reshape_gemm.h"
+#include "ppl/nn/oputils/onnx/reshape_matmul.h"
+#include "ppl/nn/oputils/onnx/reshape_pooling.h"
+#include "ppl/nn/oputils/onnx/reshape_range.h"
+#include "ppl/nn/oputils/onnx/reshape_reshape.h"
+#include "ppl/nn/oputils/onnx/reshape_squeeze.h"
+#include "ppl/nn/oputils/onnx/reshape_transpose.h"
+#include "ppl/nn/oputils/onnx/reshape_unsqueeze.h"
+using namespace std;
+using namespace ppl::common;
+using namespace ppl::nn::onnx;
+
+namespace ppl { namespace nn {
+
+/*
+  tensors of edges whose shapes are known before running. buffers of constants refer to their data in
+  `ir::GraphData`, and other tensors have no buffers.
+*/
+typedef map<edgeid_t, unique_ptr<TensorImpl>> StaticTensors;
+
+// output shapes are inferred by the same functions as kernels
+typedef RetCode (*ReshapeFunc)(InputOutputInfo*, const void* param);
+
+/* -------------------------------------------------------------------------- */
+
+static RetCode ReshapeLikeInput0(InputOutputInfo* info, const void*) {
+    auto input = info->GetInput<TensorImpl>(0)->GetShape();
+    auto output = info->GetOutput<TensorImpl>(0)->GetShape();
+    if (input->IsScalar()) {
+        output->ReshapeAsScalar();
+    } else {
+        output->Reshape(input->GetDims(), input->GetRealDimCount());
+    }
+    return RC_SUCCESS;
+}
+
+static RetCode ReshapeShape(InputOutputInfo* info, const void*) {
+    auto input = info->GetInput<TensorImpl>(0)->GetShape();
+    auto output = info->GetOutput<TensorImpl>(0)->GetShape();
+    output->SetDataType(DATATYPE_INT64);
+    output->Reshape({(int64_t)input->GetRealDimCount()});
+    return RC_SUCCESS;
+}
+
+/* -------------------------------------------------------------------------- */
+
+enum {
+    // only the shape of the output is inferred
+    FOLD_NONE,
+    // the output is the dims of the input
+    FOLD_SHAPE,
+    // the output has the same data as input 0 and only its shape changes
+    FOLD_COPY,
+    // the output is computed by kernels of engines
+    FOLD_KERNEL,
+};
+
+struct FoldingInfo final {
+    ReshapeFunc reshape_func;
+    uint32_t fold_type;
+    bool need_param;
+    uint32_t input_count; // 0 means any count
+};
+
+/*
+  ops with `FOLD_NONE` are only used to propagate static shapes, which are available if dims of graph inputs
+  are fixed. data of other ops is either derived from shapes inferred by `ReshapeFunc`s or computed by kernels,
+  so that the semantics of ops are not implemented here again.
+*/
+static const map<string, FoldingInfo> g_folding_infos = {
+    {"Abs", {ReshapeLikeInput0, FOLD_NONE, false, 1}},
+    {"Add", {ReshapeAdd, FOLD_NONE, false, 2}},
+    {"AveragePool", {ReshapePooling, FOLD_NONE, true, 1}},
+    {"BatchNormalization", {ReshapeLikeInput0, FOLD_NONE, false, 5}},
+    {"Cast", {ReshapeCast, FOLD_KERNEL, true, 1}},
+    {"Clip", {ReshapeLikeInput0, FOLD_NONE, false, 0}},
+    {"Concat", {ReshapeConcat, FOLD_KERNEL, true, 0}},
+    {"Conv", {ReshapeConv, FOLD_NONE, true, 0}},
+    {"Div", {ReshapeAdd, FOLD_NONE, false, 2}},
+    {"Exp", {ReshapeLikeInput0, FOLD_NONE, false, 1}},
+    {"Flatten", {ReshapeFlatten, FOLD_COPY, true, 1}},
+    {"Gather", {ReshapeGather, FOLD_KERNEL, true, 2}},
+    {"Gemm", {ReshapeGemm, FOLD_NONE, true, 0}},
+    {"Identity", {ReshapeLikeInput0, FOLD_COPY, false, 1}},
+    {"LeakyRelu", {ReshapeLikeInput0, FOLD_NONE, false, 1}},
+    {"MatMul", {ReshapeMatMul, FOLD_NONE, false, 2}},
+    {"MaxPool", {ReshapePooling, FOLD_NONE, true, 1}},
+    {"Mul", {ReshapeAdd, FOLD_NONE, false, 2}},
+    {"Pow", {ReshapeAdd, FOLD_NONE, false, 2}},
+    {"Range", {ReshapeRange, FOLD_KERNEL, false, 3}},
+    {"Relu", {ReshapeLikeInput0, FOLD_NONE, false, 1}},
+    {"Reshape", {ReshapeReshape, FOLD_COPY, false, 2}},
+    {"Shape", {ReshapeShape, FOLD_SHAPE, false, 1}},
+    {"Sigmoid", {ReshapeLikeInput0, FOLD_NONE, false, 1}},
+    {"Softmax", {ReshapeLikeInput0, FOLD_NONE, false, 1}},
+    {"Sqrt", {ReshapeLikeInput0, FOLD_NONE, false, 1}},
+    {"Squeeze", {ReshapeSqueeze, FOLD_COPY, true, 1}},
+    {"Sub", {ReshapeAdd, FOLD_NONE, false, 2}},
+    {"Tanh", {ReshapeLikeInput0, FOLD_NONE, false, 1}},
+    {"Transpose", {ReshapeTranspose, FOLD_KERNEL, true, 1}},
+    {"Unsqueeze", {ReshapeUnsqueeze, FOLD_COPY, true, 1}},
+};
+
+static bool IsGraphOutput(const ir::GraphTopo* topo, edgeid_t eid) {
+    for (uint32_t i = 0; i < topo->GetOutputCount(); ++i) {
+        if (topo->GetOutput(i) == eid) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// returns the folding info of `node`, or nullptr if the shape of its output cannot be inferred.
+static const FoldingInfo* FindFoldingInfo(const ir::Graph* graph, const ir::Node* node, const StaticTensors& tensors) {
+    auto& type = node->GetType();
+    if (!type.domain.empty() || node->GetExtraInputCount() > 0 || node->GetOutputCount() != 1) {
+        return nullptr;
+    }
+
+    auto ref = g_folding_infos.find(type.name);
+    if (ref == g_folding_infos.end()) {
+        return nullptr;
+    }
+    auto info = &ref->second;
+
+    if (node->GetInputCount() == 0 || (info->input_count > 0 && node->GetInputCount() != info->input_count)) {
+        return nullptr;
+    }
+    if (info->need_param && graph->data->attrs.find(node->GetId()) == graph->data->attrs.end()) {
+        return nullptr;
+    }
+
+    for (uint32_t i = 0; i < node->GetInputCount(); ++i) {
+        if (tensors.find(node->GetInput(i)) == tensors.end()) {
+            return nullptr;
+        }
+    }
+
+    return info;
+}
+
+static bool IsStaticShape(const ir::Shape& shape) {
+    if (shape.data_format != DATAFORMAT_NDARRAY) {
+        return false;
+    }
+    for (auto x = shape.dims.begin(); x != shape.dims.end(); ++x) {
+        if (*x < 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static TensorImpl* CreateStaticTensor(const ir::Edge* edge, const ir::Shape& shape, StaticTensors* tensors) {
+    auto tensor = new TensorImpl(edge, TENSORTYPE_NORMAL);
+    auto tensor_shape = tensor->GetShape();
+    tensor_shape->SetDataType(shape.data_type);
+    tensor_shape->SetDataFormat(shape.data_format);
+    tensor_shape->Reshape(shape.dims);
+    (*tensors)[edge->GetId()] = unique_ptr<TensorImpl>(tensor);
+    return tensor;
+}
+
+static void InitStaticTensors(const ir::Graph* graph, bool fixed_input_dims, StaticTensors* tensors) {
+    auto topo = graph->topo.get();
+    auto& shapes = graph->data->shapes;
+
+    auto& constants = graph->data->constants;
+    for (auto x = constants.begin(); x != constants.end(); ++x) {
+        auto shape_ref = shapes.find(x->first);
+        auto edge = topo->GetEdge(x->first);
+        if (!edge || shape_ref == shapes.end() || !IsStaticShape(shape_ref->second)) {
+            continue;
+        }
+
+        auto tensor = CreateStaticTensor(edge, shape_ref->second, tensors);
+        if (tensor->GetShape()->GetBytesExcludingPadding() != x->second.data.size()) {
+            tensors->erase(x->first);
+            continue;
+        }
+        tensor->SetBufferPtr(const_cast<char*>(x->second.data.data()));
+    }
+
+    if (fixed_input_dims) {
+        for (uint32_t i = 0; i < topo->GetInputCount(); ++i) {
+            auto eid = topo->GetInput(i);
+            if (tensors->find(eid) != tensors->end()) {
+                continue;
+            }
+            auto shape_ref = shapes.find(eid);
+            if (shape_ref != shapes.end() && IsStaticShape(shape_ref->second)) {
+                CreateStaticTensor(topo->GetEdge(eid), shape_ref->second, tensors);
+            }
+        }
+    }
+}
+
+static void RemoveFoldedNode(ir::Graph* graph, ir::Node* node, StaticTensors* tensors) {
+    auto topo = graph->topo.get();
+    auto& constants = graph->data->constants;
+    auto nid = node->GetId();
+
+    for (uint32_t i = 0; i < node->GetInputCount(); ++i) {
+        auto eid = node->GetInput(i);
+        auto edge = topo->GetEdge(eid);
+        if (!edge) {
+            continue;
+        }
+
+        edge->DelConsumer(nid);
+        // constants that are only used by folded nodes are released
+        if (edge->CalcConsumerCount() == 0 && constants.find(eid) != constants.end() && !IsGraphOutput(topo, eid)) {
+            tensors->erase(eid);
+            constants.erase(eid);
+            graph->data->shapes.erase(eid);
+            topo->DelEdge(eid);
+        }
+    }
+
+    topo->GetEdge(node->GetOutput(0))->SetProducer(INVALID_NODEID);
+    topo->DelNode(nid);
+}
+
+static ir::Shape ToGraphShape(const TensorShape& tensor_shape) {
+    ir::Shape shape;
+    shape.data_type = tensor_shape.GetDataType();
+    shape.data_format = DATAFORMAT_NDARRAY;
+    shape.dims.assign(tensor_shape.GetDims(), tensor_shape.GetDims() + tensor_shape.GetRealDimCount());
+    return shape;
+}
+
+// makes `eid` a constant with `data`. returns the data stored in `graph`.
+static const string& SetConstant(edgeid_t eid, const ir::Shape& shape, string&& data, ir::Graph* graph) {
+    auto& constant = graph->data->constants[eid];
+    constant.data = std::move(data);
+    graph->data->shapes[eid] = shape;
+    graph->topo->MarkAsConstant(eid);
+    return constant.data;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/*
+  copies `nodes` into `sub_graph`. inputs that are not produced by `nodes` are constants, and outputs used by other
+  nodes become outputs of `sub_graph`.
+*/
+static void BuildConstantSubgraph(const ir::Graph* graph, const vector<nodeid_t>& nodes, ir::Graph* sub_graph) {
+    auto topo = graph->topo.get();
+    auto& data = *graph->data;
+
+    auto sub_topo = make_shared<ir::FullGraphTopo>();
+    auto sub_data = make_shared<ir::GraphData>();
+    sub_topo->SetName(topo->GetName() + ".fold_constant");
+
+    const set<nodeid_t> node_set(nodes.begin(), nodes.end());
+    for (auto x = nodes.begin(); x != nodes.end(); ++x) {
+        auto node = topo->GetNode(*x);
+        auto sub_node = sub_topo->AddNode(node->GetName()).first;
+        sub_node->SetType(node->GetType());
+
+        auto attr_ref = data.attrs.find(node->GetId());
+        if (attr_ref != data.attrs.end()) {
+            sub_data->attrs[sub_node->GetId()] = attr_ref->second;
+        }
+
+        for (uint32_t i = 0; i < node->GetInputCount(); ++i) {
+            auto edge = topo->GetEdge(node->GetInput(i));
+            // edges with the same name are the same one
+            auto sub_edge = sub_topo->AddEdge(edge->GetName()).first;
+            sub_node->AddInput(sub_edge->GetId());
+            sub_edge->AddConsumer(sub_node->GetId());
+
+            if (node_set.find(edge->GetProducer()) == node_set.end() &&
+                sub_data->constants.find(sub_edge->GetId()) == sub_data->constants.end()) {
+                sub_data->constants[sub_edge->GetId()] = data.constants.at(edge->GetId());
+                sub_data->shapes[sub_edge->GetId()] = data.shapes.at(edge->GetId());
+                sub_topo->MarkAsConstant(sub_edge->GetId());
+            }
+        }
+
+        auto edge = topo->GetEdge(node->GetOutput(0));
+        auto sub_edge = sub_topo->AddEdge(edge->GetName()).first;
+        sub_node->AddOutput(sub_edge->GetId());
+        sub_edge->SetProducer(sub_node->GetId());
+
+        for (auto it = edge->CreateConsumerIter(); it.IsValid(); it.Forward()) {
+            if (node_set.find(it.Get()) == node_set.end()) {
+                sub_topo->MarkAsOutput(sub_edge->GetId());
+                break;
+            }
+        }
+    }
+
+    sub_graph->topo = sub_topo;
+    sub_graph->data = sub_data;
+}
+
+struct FoldedOutput final {
+    ir::Shape shape;
+    string data;
+};
+
+/*
+  runs `sub_graph` once with new instances of `engines`, so that data of folded nodes is computed by the same
+  kernels as those used at runtime. results are returned in `outputs` with names of edges as keys.
+*/
+static RetCode EvaluateSubgraph(const vector<EngineImpl*>& engines, ir::Graph* sub_graph,
+                                map<string, FoldedOutput>* outputs) {
+    // engines are released after kernels created by them
+    vector<unique_ptr<EngineImpl>> engine_instances;
+    utils::SharedResource resource;
+    for (auto x = engines.begin(); x != engines.end(); ++x) {
+        auto engine = (*x)->Create();
+        if (!engine) {
+            LOG(ERROR) << "create instance of engine[" << (*x)->GetName() << "] failed.";
+            return RC_OTHER_ERROR;
+        }
+        engine_instances.emplace_back(unique_ptr<EngineImpl>(engine));
+        resource.engines.push_back(engine);
+    }
+    resource.graph_partitioner = make_shared<EngineGraphPartitioner>();
+
+    auto graph_info = make_shared<RuntimeGraphInfo>();
+    auto status = utils::ProcessGraph(resource, sub_graph, graph_info.get());
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "process graph[" << sub_graph->topo->GetName() << "] failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
+    auto aux_info = make_shared<RuntimeAuxInfo>();
+    status = aux_info->Init(sub_graph->topo.get(), {});
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "GenerateRuntimeAuxInfo failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
+    RuntimeInitInfo init_info;
+    status = init_info.Init(sub_graph->topo.get());
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "GenerateRuntimeInitInfo failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
+    RuntimeImpl runtime;
+    status = runtime.Init(sub_graph->topo, graph_info, aux_info, init_info);
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "init runtime failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
+    status = runtime.Run();
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "run graph[" << sub_graph->topo->GetName() << "] failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
+    for (uint32_t i = 0; i < runtime.GetOutputCount(); ++i) {
+        auto tensor = runtime.GetOutputTensorImpl(i);
+        TensorShape dst_desc = *tensor->GetShape();
+        dst_desc.SetDataFormat(DATAFORMAT_NDARRAY);
+
+        auto& output = (*outputs)[tensor->GetName()];
+        output.shape = ToGraphShape(dst_desc);
+        output.data.resize(dst_desc.GetBytesExcludingPadding());
+        if (!output.data.empty()) {
+            status = tensor->ConvertToHost(&output.data[0], dst_desc);
+            if (status != RC_SUCCESS) {
+                LOG(ERROR) << "convert data of tensor[" << tensor->GetName()
+                           << "] failed: " << GetRetCodeStr(status);
+                return status;
+            }
+        }
+    }
+
+    return RC_SUCCESS;
+}
+
+/* -------------------------------------------------------------------------- */
+
+RetCode FoldConstantOptimizer::Optimize(ir::Graph* graph) const {
+    auto topo = graph->topo.get();
+    auto& attrs = graph->data->attrs;
+
+    StaticTensors tensors;
+    InitStaticTensors(graph, options_.fixed_input_dims, &tensors);
+
+    vector<nodeid_t> sorted_nodes;
+    topo->TopologicalSort([&sorted_nodes](nodeid_t nid) -> void {
+        sorted_nodes.push_back(nid);
+    });
+
+    // nodes to be evaluated by kernels and their outputs, whose data is not available until they are evaluated
+    vector<nodeid_t> kernel_nodes;
+    set<edgeid_t> kernel_outputs;
+
+    uint32_t folded_node_count = 0;
+    uint64_t folded_bytes = 0;
+
+    for (auto x = sorted_nodes.begin(); x != sorted_nodes.end(); ++x) {
+        auto node = topo->GetNode(*x);
+        if (!node) {
+            continue;
+        }
+
+        auto info = FindFoldingInfo(graph, node, tensors);
+        if (!info) {
+            continue;
+        }
+
+        const ir::Attr* param = nullptr;
+        auto attr_ref = attrs.find(node->GetId());
+        if (attr_ref != attrs.end()) {
+            param = attr_ref->second.get();
+        }
+
+        vector<const TensorImpl*> inputs(node->GetInputCount());
+        bool all_inputs_are_constants = true;
+        bool all_inputs_will_be_constants = true;
+        for (uint32_t i = 0; i < node->GetInputCount(); ++i) {
+            auto eid = node->GetInput(i);
+            inputs[i] = tensors[eid].get();
+            if (!inputs[i]->GetBufferPtr()) {
+                all_inputs_are_constants = false;
+                if (kernel_outputs.find(eid) == kernel_outputs.end()) {
+                    all_inputs_will_be_constants = false;
+                }
+            }
+        }
+
+        auto output_eid = node->GetOutput(0);
+        auto output = CreateStaticTensor(topo->GetEdge(output_eid),
+                                         ir::Shape{inputs[0]->GetShape()->GetDataType(), DATAFORMAT_NDARRAY, {}},
+                                         &tensors);
+
+        InputOutputInfo io_info;
+        io_info.SetNode(node);
+        io_info.SetAcquireFunc([&tensors](edgeid_t eid, uint32_t) -> EdgeObject* {
+            auto ref = tensors.find(eid);
+            return (ref == tensors.end()) ? nullptr : ref->second.get();
+        });
+
+        auto status = info->reshape_func(&io_info, param);
+        if (status != RC_SUCCESS) {
+            LOG(DEBUG) << "cannot infer output shape of node[" << node->GetName() << "]: " << GetRetCodeStr(status);
+            tensors.erase(output_eid);
+            continue;
+        }
+
+        if (info->fold_type == FOLD_NONE || IsGraphOutput(topo, output_eid)) {
+            continue;
+        }
+
+        auto& output_shape = *output->GetShape();
+        string output_data;
+        if (info->fold_type == FOLD_SHAPE) {
+            auto input_shape = inputs[0]->GetShape();
+            output_data.assign((const char*)input_shape->GetDims(), input_shape->GetRealDimCount() * sizeof(int64_t));
+        } else if (info->fold_type == FOLD_COPY && all_inputs_are_constants) {
+            output_data.assign(inputs[0]->GetBufferPtr<const char>(), output_shape.GetBytesExcludingPadding());
+        } else {
+            if (all_inputs_will_be_constants && options_.engines) {
+                kernel_nodes.push_back(node->GetId());
+                kernel_outputs.insert(output_eid);
+            }
+            continue;
+        }
+
+        folded_bytes += output_data.size();
+        auto& data = SetConstant(output_eid, ToGraphShape(output_shape), std::move(output_data), graph);
+        output->SetBufferPtr(const_cast<char*>(data.data()));
+
+        RemoveFoldedNode(graph, node, &tensors);
+        ++folded_node_count;
+    }
+
+    if (!kernel_nodes.empty()) {
+        ir::Graph sub_graph;
+        BuildConstantSubgraph(graph, kernel_nodes, &sub_graph);
+
+        map<string, FoldedOutput> outputs;
+        auto status = EvaluateSubgraph(*options_.engines, &sub_graph, &outputs);
+        if (status == RC_SUCCESS) {
+            for (auto x = outputs.begin(); x != outputs.end(); ++x) {
+                folded_bytes += x->second.data.size();
+                SetConstant(topo->GetEdge(x->first)->GetId(), x->second.shape, std::move(x->second.data), graph);
+            }
+
+            for (auto x = kernel_nodes.begin(); x != kernel_nodes.end(); ++x) {
+                RemoveFoldedNode(graph, topo->GetNode(*x), &tensors);
+            }
+            // outputs only used by folded nodes
+            for (auto x = kernel_outputs.begin(); x != kernel_outputs.end(); ++x) {
+                if (graph->data->constants.find(*x) == graph->data->constants.end()) {
+                    tensors.erase(*x);
+                    topo->DelEdge(*x);
+                }
+            }
+            folded_node_count += kernel_nodes.size();
+        } else {
+            LOG(WARNING) << "evaluating [" << kernel_nodes.size() << "] constant node(s) of graph["
+                         << topo->GetName() << "] failed. they are kept.";
+        }
+    }
+
+    if (folded_node_count > 0) {
+        LOG(INFO) << "FoldConstantOptimizer of graph[" << topo->GetName() << "]: [" << folded_node_count
+                  << "] node(s) are folded, [" << folded_bytes << "] bytes of outputs are no longer computed per run.";
+    }
+
+    return RC_SUCCESS;
+}
+
+}} // namespace ppl::nn
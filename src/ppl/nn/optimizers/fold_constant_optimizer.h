@@ -0,0 +1,46 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_OPTIMIZERS_FOLD_CONSTANT_OPTIMIZER_H_
+#define _ST_HPC_PPL_NN_OPTIMIZERS_FOLD_CONSTANT_OPTIMIZER_H_
+
+#include "ppl/nn/optimizers/graph_optimizer.h"
+
+namespace ppl { namespace nn {
+
+/**
+   @class FoldConstantOptimizer
+   @brief evaluates nodes whose inputs are all constants and replaces their outputs with constants. `Shape` is also
+   folded if the dims of its input are known before running, which needs `GraphOptimizerOptions::fixed_input_dims`
+   for non-constant inputs.
+   @note only ops that are commonly used to compute shapes or preprocess weights are supported. output shapes are
+   inferred by the same functions as kernels, and data of ops other than `Shape` and those only changing shapes is
+   computed by running them once with kernels of `GraphOptimizerOptions::engines`.
+*/
+class FoldConstantOptimizer : public GraphOptimizer {
+public:
+    FoldConstantOptimizer(const GraphOptimizerOptions& options = GraphOptimizerOptions()) : options_(options) {}
+    virtual ~FoldConstantOptimizer() {}
+    ppl::common::RetCode Optimize(ir::Graph*) const override;
+
+private:
+    const GraphOptimizerOptions options_;
+};
+
+}} // namespace ppl::nn
+
+#endif
@@ -267,7 +267,7 @@ RetCode FuseShapeOptimizer::Optimize(ir::Graph* graph) const {
             continue;
         }
         node->SetType(ir::Node::Type{"pmx", "Shape", 1});
-        node->SetName(node->GetName() + "_Fused");
+        graph->topo->RenameNode(node->GetId(), node->GetName() + "_Fused");
 
         ShapeOperationParam shape_param;
         ShapeMatrix temp_matrix;
@@ -0,0 +1,467 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <string.h>
+#include <vector>
+
+#include "ppl/nn/optimizers/fuse_sibling_node_optimizer.h"
+#include "ppl/nn/common/logger.h"
+#include "ppl/nn/params/onnx/conv_param.h"
+#include "ppl/nn/params/onnx/gemm_param.h"
+#include "ppl/nn/params/onnx/split_param.h"
+using namespace std;
+using namespace ppl::common;
+using namespace ppl::nn::onnx;
+
+namespace ppl { namespace nn {
+
+enum { SIBLING_CONV, SIBLING_GEMM, SIBLING_MATMUL };
+
+/*
+  nodes whose reduction size(input channels * kernel size for Conv, K for Gemm/MatMul) is smaller than this are
+  memory-bound. the fused output split afterwards costs as much as the work saved by fusion.
+*/
+static const int64_t g_min_reduce_size = 64;
+
+// kernels already reach their peak efficiency with this many outputs, so wider nodes gain nothing from fusion.
+static const int64_t g_max_sibling_output_count = 512;
+
+/*
+  outputs of siblings except the last one are multiples of this, so that slices of the fused output start at
+  64-byte boundaries of fp32 data and are block-aligned in N16CX. Split can use them as views without copying.
+*/
+static const int64_t g_sibling_output_alignment = 16;
+
+struct SiblingInfo final {
+    ir::Node* node;
+    uint32_t type;
+    edgeid_t weight;
+    edgeid_t bias; // INVALID_EDGEID if not present
+    int64_t num_output;
+};
+
+static bool IsGraphOutput(const ir::Graph* graph, edgeid_t edge_id) {
+    for (uint32_t i = 0; i < graph->topo->GetOutputCount(); i++) {
+        if (graph->topo->GetOutput(i) == edge_id) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static int64_t CalcElementCount(const vector<int64_t>& dims) {
+    int64_t count = 1;
+    for (auto x = dims.begin(); x != dims.end(); ++x) {
+        count *= *x;
+    }
+    return count;
+}
+
+// `dim_count` == 0 means any dim count
+static bool IsFp32Constant(const ir::Graph* graph, edgeid_t eid, uint32_t dim_count) {
+    if (graph->data->constants.find(eid) == graph->data->constants.end()) {
+        return false;
+    }
+
+    auto ref = graph->data->shapes.find(eid);
+    if (ref == graph->data->shapes.end()) {
+        return false;
+    }
+
+    auto& shape = ref->second;
+    return (shape.data_type == DATATYPE_FLOAT32 && shape.data_format == DATAFORMAT_NDARRAY &&
+            (dim_count == 0 || shape.dims.size() == dim_count));
+}
+
+// weights used by other nodes are not fused, otherwise they are kept along with the fused copies.
+static bool IsUsedOnlyBy(const ir::Graph* graph, edgeid_t eid, nodeid_t nid) {
+    auto edge = graph->topo->GetEdge(eid);
+    return (edge && edge->CalcConsumerCount() == 1 && edge->CreateConsumerIter().Get() == nid &&
+            !IsGraphOutput(graph, eid));
+}
+
+// returns false if `node` cannot be fused with other consumers of `input`
+static bool GetSiblingInfo(const ir::Graph* graph, const GraphOptimizerOptions& options, edgeid_t input,
+                           ir::Node* node, SiblingInfo* info) {
+    auto& type = node->GetType();
+    if (!type.domain.empty() || node->GetExtraInputCount() > 0 || node->GetOutputCount() != 1 ||
+        node->GetInputCount() < 2 || node->GetInputCount() > 3 || node->GetInput(0) != input ||
+        node->GetInput(1) == input) {
+        return false;
+    }
+    auto reserved_edgeids = options.reserved_edgeids;
+    if (reserved_edgeids && reserved_edgeids->find(node->GetOutput(0)) != reserved_edgeids->end()) {
+        return false;
+    }
+
+    auto& attrs = graph->data->attrs;
+    auto& shapes = graph->data->shapes;
+
+    info->node = node;
+    info->weight = node->GetInput(1);
+    info->bias = INVALID_EDGEID;
+    if (!IsUsedOnlyBy(graph, info->weight, node->GetId())) {
+        return false;
+    }
+
+    int64_t reduce_size;
+
+    if (type.name == "Conv") {
+        auto attr_ref = attrs.find(node->GetId());
+        if (attr_ref == attrs.end() || !IsFp32Constant(graph, info->weight, 4)) {
+            return false;
+        }
+        auto param = static_cast<const ConvParam*>(attr_ref->second.get());
+        if (param->group != 1) {
+            return false;
+        }
+        auto& dims = shapes[info->weight].dims;
+        info->type = SIBLING_CONV;
+        info->num_output = dims[0];
+        reduce_size = dims[1] * dims[2] * dims[3];
+    } else if (type.name == "Gemm") {
+        auto attr_ref = attrs.find(node->GetId());
+        if (attr_ref == attrs.end() || !IsFp32Constant(graph, info->weight, 2)) {
+            return false;
+        }
+        auto param = static_cast<const GemmParam*>(attr_ref->second.get());
+        auto& dims = shapes[info->weight].dims;
+        info->type = SIBLING_GEMM;
+        info->num_output = dims[param->transB ? 0 : 1];
+        reduce_size = dims[param->transB ? 1 : 0];
+    } else if (type.name == "MatMul") {
+        if (node->GetInputCount() != 2 || !IsFp32Constant(graph, info->weight, 2)) {
+            return false;
+        }
+        info->type = SIBLING_MATMUL;
+        info->num_output = shapes[info->weight].dims[1];
+        reduce_size = shapes[info->weight].dims[0];
+    } else {
+        return false;
+    }
+
+    if (reduce_size < g_min_reduce_size || info->num_output > g_max_sibling_output_count) {
+        return false;
+    }
+
+    if (node->GetInputCount() > 2) {
+        auto bias = node->GetInput(2);
+        if (bias != INVALID_EDGEID) {
+            if (bias == input || bias == info->weight || !IsFp32Constant(graph, bias, 0) ||
+                !IsUsedOnlyBy(graph, bias, node->GetId())) {
+                return false;
+            }
+            // only per-channel biases are supported
+            auto& dims = shapes[bias].dims;
+            if (dims.empty() || dims.back() != info->num_output || CalcElementCount(dims) != info->num_output) {
+                return false;
+            }
+            info->bias = bias;
+        }
+    }
+
+    return true;
+}
+
+static bool CanBeFusedWith(const ir::Graph* graph, const SiblingInfo& a, const SiblingInfo& b) {
+    if (a.type != b.type) {
+        return false;
+    }
+
+    auto& attrs = graph->data->attrs;
+    auto& dims_a = graph->data->shapes[a.weight].dims;
+    auto& dims_b = graph->data->shapes[b.weight].dims;
+
+    if (a.type == SIBLING_CONV) {
+        auto param_a = attrs[a.node->GetId()].get();
+        auto param_b = attrs[b.node->GetId()].get();
+        return (param_a->Equals(param_b) && dims_a[1] == dims_b[1] && dims_a[2] == dims_b[2] &&
+                dims_a[3] == dims_b[3]);
+    }
+
+    if (a.type == SIBLING_GEMM) {
+        auto param_a = static_cast<const GemmParam*>(attrs[a.node->GetId()].get());
+        auto param_b = static_cast<const GemmParam*>(attrs[b.node->GetId()].get());
+        if (param_a->alpha != param_b->alpha || param_a->beta != param_b->beta ||
+            param_a->transA != param_b->transA || param_a->transB != param_b->transB) {
+            return false;
+        }
+        return param_a->transB ? (dims_a[1] == dims_b[1]) : (dims_a[0] == dims_b[0]);
+    }
+
+    // SIBLING_MATMUL
+    return (dims_a[0] == dims_b[0]);
+}
+
+// concatenates fp32 weights of `group` along `axis`
+static void ConcatWeights(const ir::Graph* graph, const vector<SiblingInfo>& group, uint32_t axis,
+                          ir::Constant* fused_weight, ir::Shape* fused_shape) {
+    auto& constants = graph->data->constants;
+    auto& shapes = graph->data->shapes;
+
+    auto& dims0 = shapes[group[0].weight].dims;
+    int64_t outer = 1, inner = 1;
+    for (uint32_t i = 0; i < axis; ++i) {
+        outer *= dims0[i];
+    }
+    for (uint32_t i = axis + 1; i < dims0.size(); ++i) {
+        inner *= dims0[i];
+    }
+
+    fused_shape->data_type = DATATYPE_FLOAT32;
+    fused_shape->data_format = DATAFORMAT_NDARRAY;
+    fused_shape->dims = dims0;
+    fused_shape->dims[axis] = 0;
+    for (auto x = group.begin(); x != group.end(); ++x) {
+        fused_shape->dims[axis] += shapes[x->weight].dims[axis];
+    }
+
+    fused_weight->data.resize(CalcElementCount(fused_shape->dims) * sizeof(float));
+    char* dst = &fused_weight->data[0];
+    for (int64_t o = 0; o < outer; ++o) {
+        for (auto x = group.begin(); x != group.end(); ++x) {
+            const uint64_t bytes = shapes[x->weight].dims[axis] * inner * sizeof(float);
+            memcpy(dst, constants[x->weight].data.data() + o * bytes, bytes);
+            dst += bytes;
+        }
+    }
+}
+
+static void ConcatBiases(const ir::Graph* graph, const vector<SiblingInfo>& group, ir::Constant* fused_bias,
+                         ir::Shape* fused_shape) {
+    auto& constants = graph->data->constants;
+
+    int64_t total = 0;
+    for (auto x = group.begin(); x != group.end(); ++x) {
+        total += x->num_output;
+    }
+
+    fused_shape->data_type = DATATYPE_FLOAT32;
+    fused_shape->data_format = DATAFORMAT_NDARRAY;
+    fused_shape->dims = {total};
+
+    // siblings without bias are filled with zeros
+    fused_bias->data.resize(total * sizeof(float), 0);
+    char* dst = &fused_bias->data[0];
+    for (auto x = group.begin(); x != group.end(); ++x) {
+        const uint64_t bytes = x->num_output * sizeof(float);
+        if (x->bias != INVALID_EDGEID) {
+            memcpy(dst, constants[x->bias].data.data(), bytes);
+        }
+        dst += bytes;
+    }
+}
+
+static void AddConstantEdge(ir::Graph* graph, ir::Edge* edge, ir::Constant&& constant, ir::Shape&& shape) {
+    auto eid = edge->GetId();
+    graph->topo->MarkAsConstant(eid);
+    graph->data->constants[eid] = std::move(constant);
+    graph->data->shapes[eid] = std::move(shape);
+}
+
+/*
+  fuses nodes in `group` into the first node, whose output is split to original outputs:
+
+        input                       input
+     /    |    \                      |
+  node0 node1 node2    =>    node0(fused weights)
+    |     |     |                     |
+   out0  out1  out2                 Split
+                                   /  |  \
+                               out0  out1  out2
+*/
+static bool FuseSiblings(ir::Graph* graph, edgeid_t input, const vector<SiblingInfo>& group) {
+    auto topo = graph->topo.get();
+    auto& constants = graph->data->constants;
+    auto& shapes = graph->data->shapes;
+
+    auto& first = group[0];
+    auto first_node = first.node;
+    const string weight_name = first_node->GetName() + "_sibling_fused_weight";
+    const string bias_name = first_node->GetName() + "_sibling_fused_bias";
+    const string output_name = first_node->GetName() + "_sibling_fused_output";
+    const string split_name = first_node->GetName() + "_sibling_split";
+    if (topo->GetEdge(weight_name) || topo->GetEdge(bias_name) || topo->GetEdge(output_name) ||
+        topo->GetNode(split_name)) {
+        LOG(DEBUG) << "names of fused sibling node[" << first_node->GetName() << "] exist.";
+        return false;
+    }
+
+    bool has_bias = false;
+    for (auto x = group.begin(); x != group.end(); ++x) {
+        if (x->bias != INVALID_EDGEID) {
+            has_bias = true;
+            break;
+        }
+    }
+
+    // output channels are the first dim of conv weights and transposed gemm weights, otherwise the second one
+    uint32_t weight_axis = 1;
+    if (first.type == SIBLING_CONV ||
+        (first.type == SIBLING_GEMM &&
+         static_cast<const GemmParam*>(graph->data->attrs[first_node->GetId()].get())->transB)) {
+        weight_axis = 0;
+    }
+
+    ir::Constant fused_weight, fused_bias;
+    ir::Shape fused_weight_shape, fused_bias_shape;
+    ConcatWeights(graph, group, weight_axis, &fused_weight, &fused_weight_shape);
+    if (has_bias) {
+        ConcatBiases(graph, group, &fused_bias, &fused_bias_shape);
+    }
+
+    // detach original weights and biases
+    for (auto x = group.begin(); x != group.end(); ++x) {
+        auto node = x->node;
+        for (uint32_t i = 1; i < node->GetInputCount(); ++i) {
+            auto eid = node->GetInput(i);
+            auto edge = topo->GetEdge(eid);
+            if (!edge) {
+                continue;
+            }
+            edge->DelConsumer(node->GetId());
+            if (edge->CalcConsumerCount() == 0 && !IsGraphOutput(graph, eid)) {
+                constants.erase(eid);
+                shapes.erase(eid);
+                topo->DelEdge(eid);
+            }
+        }
+    }
+
+    auto weight_edge = topo->AddEdge(weight_name).first;
+    AddConstantEdge(graph, weight_edge, std::move(fused_weight), std::move(fused_weight_shape));
+    first_node->ReplaceInput(first.weight, weight_edge->GetId());
+    weight_edge->AddConsumer(first_node->GetId());
+
+    if (has_bias) {
+        auto bias_edge = topo->AddEdge(bias_name).first;
+        AddConstantEdge(graph, bias_edge, std::move(fused_bias), std::move(fused_bias_shape));
+        if (first_node->GetInputCount() > 2) {
+            first_node->ReplaceInput(first.bias, bias_edge->GetId());
+        } else {
+            first_node->AddInput(bias_edge->GetId());
+        }
+        bias_edge->AddConsumer(first_node->GetId());
+    }
+
+    const edgeid_t first_output = first_node->GetOutput(0);
+    auto fused_output = topo->AddEdge(output_name).first;
+    first_node->ReplaceOutput(first_output, fused_output->GetId());
+    fused_output->SetProducer(first_node->GetId());
+
+    auto split_node = topo->AddNode(split_name).first;
+    split_node->SetType(ir::Node::Type("", "Split", 11));
+    split_node->AddInput(fused_output->GetId());
+    fused_output->AddConsumer(split_node->GetId());
+
+    auto split_param = make_shared<SplitParam>();
+    split_param->axis = (first.type == SIBLING_CONV) ? 1 : -1;
+    for (auto x = group.begin(); x != group.end(); ++x) {
+        auto output = (x->node == first_node) ? first_output : x->node->GetOutput(0);
+        split_node->AddOutput(output);
+        topo->GetEdge(output)->SetProducer(split_node->GetId());
+        split_param->split_point.push_back(x->num_output);
+    }
+    graph->data->attrs[split_node->GetId()] = split_param;
+
+    auto input_edge = topo->GetEdge(input);
+    for (uint32_t i = 1; i < group.size(); ++i) {
+        auto nid = group[i].node->GetId();
+        input_edge->DelConsumer(nid);
+        graph->data->attrs.erase(nid);
+        topo->DelNode(nid);
+    }
+
+    return true;
+}
+
+/*
+  keeps siblings whose outputs are aligned and at most one unaligned sibling, which is placed at the end, so that
+  every slice of the fused output starts at an aligned offset.
+*/
+static void AlignSiblings(vector<SiblingInfo>* group) {
+    vector<SiblingInfo> aligned_group;
+    const SiblingInfo* unaligned = nullptr;
+    for (auto x = group->begin(); x != group->end(); ++x) {
+        if (x->num_output % g_sibling_output_alignment == 0) {
+            aligned_group.push_back(*x);
+        } else if (!unaligned) {
+            unaligned = &(*x);
+        }
+    }
+    if (unaligned) {
+        aligned_group.push_back(*unaligned);
+    }
+    *group = std::move(aligned_group);
+}
+
+RetCode FuseSiblingNodeOptimizer::Optimize(ir::Graph* graph) const {
+    if (!options_.enable_sibling_fusion) {
+        return RC_SUCCESS;
+    }
+
+    auto topo = graph->topo.get();
+
+    // new edges are created during fusion
+    vector<edgeid_t> edge_ids;
+    for (auto it = topo->CreateEdgeIter(); it->IsValid(); it->Forward()) {
+        edge_ids.push_back(it->Get()->GetId());
+    }
+
+    uint32_t fused_count = 0;
+    for (auto x = edge_ids.begin(); x != edge_ids.end(); ++x) {
+        auto edge = topo->GetEdge(*x);
+        if (!edge || edge->CalcConsumerCount() < 2) {
+            continue;
+        }
+
+        vector<vector<SiblingInfo>> groups;
+        for (auto it = edge->CreateConsumerIter(); it.IsValid(); it.Forward()) {
+            SiblingInfo info;
+            if (!GetSiblingInfo(graph, options_, *x, topo->GetNode(it.Get()), &info)) {
+                continue;
+            }
+
+            bool found = false;
+            for (auto g = groups.begin(); g != groups.end(); ++g) {
+                if (CanBeFusedWith(graph, g->at(0), info)) {
+                    g->push_back(info);
+                    found = true;
+                    break;
+                }
+            }
+            if (!found) {
+                groups.push_back(vector<SiblingInfo>(1, info));
+            }
+        }
+
+        for (auto g = groups.begin(); g != groups.end(); ++g) {
+            AlignSiblings(&(*g));
+            if (g->size() > 1 && FuseSiblings(graph, *x, *g)) {
+                fused_count += g->size();
+            }
+        }
+    }
+
+    if (fused_count > 0) {
+        LOG(DEBUG) << "[" << fused_count << "] sibling nodes are fused in graph[" << topo->GetName() << "]";
+    }
+
+    return RC_SUCCESS;
+}
+
+}} // namespace ppl::nn
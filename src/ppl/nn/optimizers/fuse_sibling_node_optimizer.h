@@ -0,0 +1,45 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_OPTIMIZERS_FUSE_SIBLING_NODE_OPTIMIZER_H_
+#define _ST_HPC_PPL_NN_OPTIMIZERS_FUSE_SIBLING_NODE_OPTIMIZER_H_
+
+#include "ppl/nn/optimizers/graph_optimizer.h"
+
+namespace ppl { namespace nn {
+
+/**
+   @class FuseSiblingNodeOptimizer
+   @brief fuses Conv/Gemm/MatMul nodes that read the same input with different constant weights into
+   one wider node followed by a Split, e.g. QKV projections in transformers.
+   @note it is enabled by `GraphOptimizerOptions::enable_sibling_fusion`. only narrow nodes with enough work per
+   output are fused, and outputs are aligned so that the Split can share slices of the fused output without copying
+   when dims before the split axis are 1.
+*/
+class FuseSiblingNodeOptimizer : public GraphOptimizer {
+public:
+    FuseSiblingNodeOptimizer(const GraphOptimizerOptions& options = GraphOptimizerOptions()) : options_(options) {}
+    virtual ~FuseSiblingNodeOptimizer() {}
+    ppl::common::RetCode Optimize(ir::Graph*) const override;
+
+private:
+    const GraphOptimizerOptions options_;
+};
+
+}} // namespace ppl::nn
+
+#endif
@@ -20,9 +20,33 @@
 
 #include "ppl/common/retcode.h"
 #include "ppl/nn/ir/graph.h"
+#include <set>
+#include <vector>
 
 namespace ppl { namespace nn {
 
+class EngineImpl;
+
+struct GraphOptimizerOptions final {
+    /**
+       dims of graph inputs are fixed to those in the model(symbolic dims are taken as 1), so that shapes derived
+       from them can be folded into constants.
+    */
+    bool fixed_input_dims = false;
+
+    /** fuses Conv/Gemm/MatMul nodes sharing one input, see `FuseSiblingNodeOptimizer`. */
+    bool enable_sibling_fusion = false;
+
+    /** tensors reserved by users. producers of them are kept as they are. */
+    const std::set<edgeid_t>* reserved_edgeids = nullptr;
+
+    /**
+       engines whose kernels evaluate constant nodes in `FoldConstantOptimizer`. only nodes whose data is derived
+       from shapes are folded if it is null.
+    */
+    const std::vector<EngineImpl*>* engines = nullptr;
+};
+
 class GraphOptimizer {
 public:
     virtual ~GraphOptimizer() {}
@@ -19,9 +19,11 @@
 #include "ppl/nn/common/logger.h"
 
 #include "ppl/nn/optimizers/constant_node_optimizer.h"
+#include "ppl/nn/optimizers/fold_constant_optimizer.h"
 #include "ppl/nn/optimizers/fuse_parallel_node_optimizer.h"
 #include "ppl/nn/optimizers/fuse_bn_optimizer.h"
 #include "ppl/nn/optimizers/fuse_shape_optimizer.h"
+#include "ppl/nn/optimizers/fuse_sibling_node_optimizer.h"
 #include "ppl/nn/optimizers/skip_dropout_optimizer.h"
 
 using namespace std;
@@ -31,16 +33,21 @@ namespace ppl { namespace nn {
 
 #define REGISTER_OPTIMIZER(name, type) name2optimizer_.emplace(name, unique_ptr<GraphOptimizer>(new type()))
 
-GraphOptimizerManager::GraphOptimizerManager() {
+GraphOptimizerManager::GraphOptimizerManager(const GraphOptimizerOptions& options) {
     REGISTER_OPTIMIZER("ConstantNodeOptimizer", ConstantNodeOptimizer);
+    // optimizers are processed in the order of their names. FoldConstantOptimizer runs after ConstantNodeOptimizer.
+    name2optimizer_.emplace("FoldConstantOptimizer", unique_ptr<GraphOptimizer>(new FoldConstantOptimizer(options)));
     REGISTER_OPTIMIZER("FuseParallelNodeOptimizer", FuseParallelNodeOptimizer);
     REGISTER_OPTIMIZER("FuseBNOptimizer", FuseBNOptimizer);
     REGISTER_OPTIMIZER("FuseShapeOptimizer", FuseShapeOptimizer);
+    name2optimizer_.emplace("FuseSiblingNodeOptimizer",
+                            unique_ptr<GraphOptimizer>(new FuseSiblingNodeOptimizer(options)));
     REGISTER_OPTIMIZER("SkipDropoutOptimizer", SkipDropoutOptimizer);
 }
 
-RetCode GraphOptimizerManager::Process(ir::Graph* graph) const {
+RetCode GraphOptimizerManager::Process(ir::Graph* graph, utils::StartupProfiler* profiler) const {
     for (auto x = name2optimizer_.begin(); x != name2optimizer_.end(); ++x) {
+        utils::StartupStageGuard __stage_guard(profiler, "GraphOptimizer", x->first);
         auto status = x->second->Optimize(graph);
         if (status != RC_SUCCESS) {
             LOG(ERROR) << "optimizer[" << x->first << "] failed: " << GetRetCodeStr(status);
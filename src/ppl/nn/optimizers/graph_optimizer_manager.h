@@ -19,16 +19,20 @@
 #define _ST_HPC_PPL_NN_OPTIMIZERS_GRAPH_OPTIMIZER_MANAGER_H_
 
 #include "ppl/nn/optimizers/graph_optimizer.h"
+#include "ppl/nn/utils/startup_profiler.h"
 #include <map>
 
 namespace ppl { namespace nn {
 
 class GraphOptimizerManager final {
 public:
-    GraphOptimizerManager();
+    GraphOptimizerManager(const GraphOptimizerOptions& options = GraphOptimizerOptions());
 
-    /** @brief perform optimizations */
-    ppl::common::RetCode Process(ir::Graph*) const;
+    /**
+       @brief perform optimizations
+       @param profiler records time costs of each optimizer if not nullptr
+    */
+    ppl::common::RetCode Process(ir::Graph*, utils::StartupProfiler* profiler = nullptr) const;
 
 private:
     std::map<std::string, std::unique_ptr<GraphOptimizer>> name2optimizer_;
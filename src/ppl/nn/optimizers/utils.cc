@@ -260,6 +260,8 @@ static RetCode GenPartitionsInfoAndShapes(const vector<pair<EngineImpl*, vector<
 
         auto engine = partition.first;
         RuntimePartitionInfo subgraph_info;
+        utils::StartupStageGuard __stage_guard(resource.startup_profiler, "EngineProcessGraph",
+                                               sub_graph.topo->GetName() + "@" + engine->GetName());
         auto status = engine->ProcessGraph(resource, &sub_graph, &subgraph_info);
         if (status != RC_SUCCESS) {
             LOG(ERROR) << "process graph[" << sub_graph.topo->GetName() << "] by engine[" << engine->GetName()
@@ -439,15 +441,20 @@ static RetCode InsertConverterNodesForInputs(ir::Graph* graph, const vector<Engi
 }
 
 RetCode ProcessGraph(const utils::SharedResource& resource, ir::Graph* graph, RuntimeGraphInfo* info) {
-    GraphOptimizerManager optimizer_mgr;
-    auto status = optimizer_mgr.Process(graph);
+    auto optimizer_options = resource.graph_optimizer_options;
+    optimizer_options.reserved_edgeids = &resource.reserved_edgeids;
+    GraphOptimizerManager optimizer_mgr(optimizer_options);
+    auto status = optimizer_mgr.Process(graph, resource.startup_profiler);
     if (status != RC_SUCCESS) {
         LOG(ERROR) << "do optimization failed: " << GetRetCodeStr(status);
         return status;
     }
 
     vector<pair<EngineImpl*, vector<nodeid_t>>> partitions;
-    status = resource.graph_partitioner->Partition(resource.engines, graph->topo.get(), &partitions);
+    {
+        utils::StartupStageGuard __stage_guard(resource.startup_profiler, "PartitionGraph", graph->topo->GetName());
+        status = resource.graph_partitioner->Partition(resource.engines, graph->topo.get(), &partitions);
+    }
     if (status != RC_SUCCESS) {
         LOG(ERROR) << "partitioning graph[" << graph->topo->GetName() << "] failed: " << GetRetCodeStr(status);
         return status;
@@ -65,6 +65,10 @@ common::RetCode ReshapeRange(InputOutputInfo* info, const void*) {
         LOG(DEBUG) << "ERROR: unspoorted data type[" << GetDataTypeStr(data_type) << "].";
         return RC_UNSUPPORTED;
     }
+    if (delta == 0) {
+        LOG(DEBUG) << "ERROR: delta is 0.";
+        return RC_INVALID_VALUE;
+    }
 
     auto output = info->GetOutput<TensorImpl>(0);
     const uint32_t num_elements = std::max(std::ceil((limit - start) / delta), 0.0);
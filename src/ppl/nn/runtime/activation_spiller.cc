@@ -0,0 +1,229 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/runtime/activation_spiller.h"
+#include "ppl/nn/runtime/scheduler_common.h"
+#include "ppl/nn/common/logger.h"
+#include <algorithm>
+using namespace std;
+using namespace ppl::common;
+
+#ifdef _MSC_VER
+#define fseeko _fseeki64
+#endif
+
+namespace ppl { namespace nn {
+
+ActivationSpiller::~ActivationSpiller() {
+    if (fp_) {
+        fclose(fp_);
+    }
+}
+
+RetCode ActivationSpiller::Init(const ir::GraphTopo* topo, const RuntimeAuxInfo* aux_info) {
+    topo_ = topo;
+    aux_info_ = aux_info;
+
+    edge_use_pos_.clear();
+    edge_use_pos_.resize(topo->GetMaxEdgeId());
+    edge_producer_pos_.clear();
+    edge_producer_pos_.resize(topo->GetMaxEdgeId(), 0);
+    for (uint32_t pos = 0; pos < aux_info->sorted_nodes.size(); ++pos) {
+        auto node = topo->GetNode(aux_info->sorted_nodes[pos]);
+        for (uint32_t i = 0; i < node->GetOutputCount(); ++i) {
+            auto eid = node->GetOutput(i);
+            if (eid != INVALID_EDGEID) {
+                edge_producer_pos_[eid] = pos;
+            }
+        }
+        for (uint32_t i = 0; i < node->GetInputCount(); ++i) {
+            auto eid = node->GetInput(i);
+            if (eid != INVALID_EDGEID) {
+                edge_use_pos_[eid].push_back(pos);
+            }
+        }
+        for (uint32_t i = 0; i < node->GetExtraInputCount(); ++i) {
+            edge_use_pos_[node->GetExtraInput(i)].push_back(pos);
+        }
+    }
+
+    // positions are visited in ascending order, so each list is sorted already
+    for (auto x = edge_use_pos_.begin(); x != edge_use_pos_.end(); ++x) {
+        x->erase(std::unique(x->begin(), x->end()), x->end());
+    }
+
+    Reset();
+    return RC_SUCCESS;
+}
+
+void ActivationSpiller::Reset() {
+    for (auto x = slots_.begin(); x != slots_.end(); ++x) {
+        x->second.in_use = false;
+    }
+}
+
+uint32_t ActivationSpiller::GetNextUse(edgeid_t eid, uint32_t pos) const {
+    auto& use_pos = edge_use_pos_[eid];
+    auto ref = std::upper_bound(use_pos.begin(), use_pos.end(), pos);
+    if (ref == use_pos.end()) {
+        return UINT32_MAX;
+    }
+    return *ref;
+}
+
+RetCode ActivationSpiller::Spill(edgeid_t eid, TensorImpl* tensor) {
+    if (!fp_) {
+        fp_ = tmpfile();
+        if (!fp_) {
+            LOG(ERROR) << "create spill file failed.";
+            return RC_OTHER_ERROR;
+        }
+    }
+
+    auto bytes = tensor->GetShape()->GetBytesIncludingPadding();
+    auto slot = &slots_[eid];
+    if (slot->capacity < bytes) {
+        slot->offset = file_size_;
+        slot->capacity = bytes;
+        file_size_ += bytes;
+    }
+
+    if (fseeko(fp_, slot->offset, SEEK_SET) != 0 || fwrite(tensor->GetBufferPtr(), 1, bytes, fp_) != bytes) {
+        LOG(ERROR) << "write [" << bytes << "] bytes of tensor[" << tensor->GetName() << "] to spill file failed.";
+        return RC_OTHER_ERROR;
+    }
+
+    tensor->FreeBuffer();
+    slot->in_use = true;
+    spilled_bytes_ += bytes;
+    return RC_SUCCESS;
+}
+
+RetCode ActivationSpiller::Restore(edgeid_t eid, TensorImpl* tensor) {
+    auto status = tensor->ReallocBuffer();
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "ReallocBuffer for tensor[" << tensor->GetName() << "] failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
+    auto slot = &slots_[eid];
+    auto bytes = tensor->GetShape()->GetBytesIncludingPadding();
+    if (fseeko(fp_, slot->offset, SEEK_SET) != 0 || fread(tensor->GetBufferPtr(), 1, bytes, fp_) != bytes) {
+        LOG(ERROR) << "read [" << bytes << "] bytes of tensor[" << tensor->GetName() << "] from spill file failed.";
+        return RC_OTHER_ERROR;
+    }
+
+    slot->in_use = false;
+    return RC_SUCCESS;
+}
+
+RetCode ActivationSpiller::BeforeExecute(uint32_t pos, RuntimeGraphResource* graph) {
+    auto node = topo_->GetNode(aux_info_->sorted_nodes[pos]);
+
+    auto restore_func = [this, graph](edgeid_t eid) -> RetCode {
+        auto ref = slots_.find(eid);
+        if (ref == slots_.end() || !ref->second.in_use) {
+            return RC_SUCCESS;
+        }
+        return Restore(eid, static_cast<TensorImpl*>(graph->edgeid2object[eid]));
+    };
+
+    for (uint32_t i = 0; i < node->GetInputCount(); ++i) {
+        auto eid = node->GetInput(i);
+        if (eid != INVALID_EDGEID) {
+            auto status = restore_func(eid);
+            if (status != RC_SUCCESS) {
+                return status;
+            }
+        }
+    }
+    for (uint32_t i = 0; i < node->GetExtraInputCount(); ++i) {
+        auto status = restore_func(node->GetExtraInput(i));
+        if (status != RC_SUCCESS) {
+            return status;
+        }
+    }
+
+    return RC_SUCCESS;
+}
+
+RetCode ActivationSpiller::AfterExecute(uint32_t pos, RuntimeGraphResource* graph) {
+    vector<utils::LiveActivation> activations;
+    auto live_bytes = utils::CollectLiveActivations(*graph, &activations);
+    if (live_bytes <= budget_bytes_) {
+        return RC_SUCCESS;
+    }
+
+    struct Candidate final {
+        uint32_t next_use;
+        uint64_t bytes;
+        TensorImpl* tensor;
+    };
+
+    vector<Candidate> candidates;
+    for (auto x = activations.begin(); x != activations.end(); ++x) {
+        auto tensor = x->tensor;
+        if (tensor->GetType() != TENSORTYPE_NORMAL || !tensor->IsBufferOwner() || tensor->GetBoundBuffer() ||
+            !tensor->GetDevice() || !tensor->GetDevice()->IsHostMemory()) {
+            continue;
+        }
+
+        /*
+          buffers of tensors whose producers have not run are allocated ahead by other kernels, e.g. a concat output
+          whose inputs are written into it directly. views into them are still pending.
+        */
+        auto eid = tensor->GetEdge()->GetId();
+        if (edge_producer_pos_[eid] > pos) {
+            continue;
+        }
+
+        // tensors used by the next node would be read back immediately
+        auto next_use = GetNextUse(eid, pos);
+        if (next_use == UINT32_MAX || next_use <= pos + 1) {
+            continue;
+        }
+
+        Candidate c;
+        c.next_use = next_use;
+        c.bytes = x->end;
+        c.tensor = tensor;
+        candidates.push_back(c);
+    }
+
+    std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) -> bool {
+        return (a.next_use > b.next_use || (a.next_use == b.next_use && a.bytes > b.bytes));
+    });
+
+    for (auto c = candidates.begin(); c != candidates.end() && live_bytes > budget_bytes_; ++c) {
+        auto status = Spill(c->tensor->GetEdge()->GetId(), c->tensor);
+        if (status != RC_SUCCESS) {
+            return status;
+        }
+        live_bytes -= c->bytes;
+    }
+
+    if (live_bytes > budget_bytes_ && !budget_warning_logged_) {
+        LOG(WARNING) << "live activations [" << live_bytes << "] bytes after node["
+                     << topo_->GetNode(aux_info_->sorted_nodes[pos])->GetName() << "] exceed the memory budget ["
+                     << budget_bytes_ << "] bytes and cannot be spilled.";
+        budget_warning_logged_ = true;
+    }
+
+    return RC_SUCCESS;
+}
+
+}} // namespace ppl::nn
@@ -0,0 +1,93 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_RUNTIME_ACTIVATION_SPILLER_H_
+#define _ST_HPC_PPL_NN_RUNTIME_ACTIVATION_SPILLER_H_
+
+#include "ppl/nn/runtime/runtime_graph_resource.h"
+#include "ppl/nn/runtime/runtime_aux_info.h"
+#include <cstdio>
+#include <map>
+
+namespace ppl { namespace nn {
+
+/**
+   @class ActivationSpiller
+   @brief keeps live activations under a memory budget by moving those whose next use is the farthest into a
+   temporary file, and reading them back right before they are needed.
+   @note only tensors on host memory that are not shared with other tensors can be spilled. tensors bound to
+   external buffers and those whose producers have not run yet are left in place.
+*/
+class ActivationSpiller final {
+public:
+    ActivationSpiller(uint64_t budget_bytes) : budget_bytes_(budget_bytes) {}
+    ~ActivationSpiller();
+
+    ppl::common::RetCode Init(const ir::GraphTopo*, const RuntimeAuxInfo*);
+
+    /** @brief drops data spilled by previous runs. MUST be called before each run. */
+    void Reset();
+
+    /** @brief reads spilled inputs of the `pos`-th node in `sorted_nodes` back before the node is executed. */
+    ppl::common::RetCode BeforeExecute(uint32_t pos, RuntimeGraphResource*);
+
+    /** @brief spills activations if they exceed the budget after the `pos`-th node in `sorted_nodes` finishes. */
+    ppl::common::RetCode AfterExecute(uint32_t pos, RuntimeGraphResource*);
+
+    /** @brief total bytes written into the spill file so far. */
+    uint64_t GetSpilledBytes() const {
+        return spilled_bytes_;
+    }
+
+private:
+    ppl::common::RetCode Spill(edgeid_t eid, TensorImpl*);
+    ppl::common::RetCode Restore(edgeid_t eid, TensorImpl*);
+
+    /** @brief returns the position of the first consumer of `eid` after `pos`, or UINT32_MAX if there is none. */
+    uint32_t GetNextUse(edgeid_t eid, uint32_t pos) const;
+
+private:
+    struct SpillSlot final {
+        uint64_t offset = 0;
+        uint64_t capacity = 0;
+        bool in_use = false;
+    };
+
+    const uint64_t budget_bytes_;
+    const ir::GraphTopo* topo_ = nullptr;
+    const RuntimeAuxInfo* aux_info_ = nullptr;
+
+    /** positions in `sorted_nodes` of consumers of each edge in ascending order */
+    std::vector<std::vector<uint32_t>> edge_use_pos_;
+
+    /** position in `sorted_nodes` of the producer of each edge, or 0 if it has no producer */
+    std::vector<uint32_t> edge_producer_pos_;
+
+    std::map<edgeid_t, SpillSlot> slots_;
+    uint64_t file_size_ = 0;
+    uint64_t spilled_bytes_ = 0;
+    FILE* fp_ = nullptr;
+    bool budget_warning_logged_ = false;
+
+private:
+    ActivationSpiller(const ActivationSpiller&) = delete;
+    ActivationSpiller& operator=(const ActivationSpiller&) = delete;
+};
+
+}} // namespace ppl::nn
+
+#endif
@@ -0,0 +1,273 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/runtime/dynamic_batcher_impl.h"
+#include "ppl/nn/common/logger.h"
+#include <string.h> // memcpy
+using namespace std;
+using namespace ppl::common;
+
+namespace ppl { namespace nn {
+
+static inline uint64_t DiffUs(const chrono::steady_clock::time_point& begin,
+                              const chrono::steady_clock::time_point& end) {
+    return chrono::duration_cast<chrono::microseconds>(end - begin).count();
+}
+
+// dims except the first one must be known
+static bool IsSampleShapeKnown(const TensorShape& shape) {
+    if (shape.GetDimCount() == 0) {
+        return false;
+    }
+    for (uint32_t i = 1; i < shape.GetDimCount(); ++i) {
+        if (shape.GetDim(i) <= 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+RetCode DynamicBatcherImpl::Init(Runtime* runtime, const DynamicBatcherOptions& options) {
+    if (!runtime) {
+        LOG(ERROR) << "runtime is empty.";
+        return RC_INVALID_VALUE;
+    }
+    if (options.max_batch_size == 0) {
+        LOG(ERROR) << "max_batch_size cannot be 0.";
+        return RC_INVALID_VALUE;
+    }
+
+    runtime_ = runtime;
+    options_ = options;
+
+    input_descs_.resize(runtime->GetInputCount());
+    input_bytes_per_sample_.resize(runtime->GetInputCount());
+    input_buffers_.resize(runtime->GetInputCount());
+    for (uint32_t i = 0; i < runtime->GetInputCount(); ++i) {
+        auto tensor = runtime->GetInputTensor(i);
+        auto& desc = input_descs_[i];
+        desc = *tensor->GetShape();
+        if (!IsSampleShapeKnown(desc)) {
+            LOG(ERROR) << "dims of input[" << tensor->GetName() << "] except the batch dimension are not set.";
+            return RC_INVALID_VALUE;
+        }
+        desc.SetDataFormat(DATAFORMAT_NDARRAY);
+        desc.SetDim(0, 1);
+        input_bytes_per_sample_[i] = desc.GetBytesExcludingPadding();
+
+        auto status = buffer_device_.Realloc(input_bytes_per_sample_[i] * options.max_batch_size, &input_buffers_[i]);
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "alloc batch buffer of input[" << tensor->GetName() << "] failed: " << GetRetCodeStr(status);
+            return status;
+        }
+    }
+
+    output_bound_flags_.resize(runtime->GetOutputCount(), false);
+    output_buffers_.resize(runtime->GetOutputCount());
+    for (uint32_t i = 0; i < runtime->GetOutputCount(); ++i) {
+        TensorShape desc = *runtime->GetOutputTensor(i)->GetShape();
+        if (!IsSampleShapeKnown(desc)) {
+            continue;
+        }
+
+        desc.SetDataFormat(DATAFORMAT_NDARRAY);
+        desc.SetDim(0, options.max_batch_size);
+        auto status = buffer_device_.Realloc(desc.GetBytesExcludingPadding(), &output_buffers_[i]);
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "alloc batch buffer of output[" << i << "] failed: " << GetRetCodeStr(status);
+            return status;
+        }
+        status = runtime->BindOutputBuffer(i, output_buffers_[i].addr, desc);
+        if (status == RC_SUCCESS) {
+            output_bound_flags_[i] = true;
+        } else {
+            buffer_device_.Free(&output_buffers_[i]);
+        }
+    }
+
+    worker_ = thread(&DynamicBatcherImpl::Loop, this);
+    return RC_SUCCESS;
+}
+
+DynamicBatcherImpl::~DynamicBatcherImpl() {
+    {
+        lock_guard<mutex> lck(mutex_);
+        stop_ = true;
+    }
+    cond_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+
+    if (runtime_) {
+        for (uint32_t i = 0; i < output_bound_flags_.size(); ++i) {
+            if (output_bound_flags_[i]) {
+                runtime_->BindOutputBuffer(i, nullptr, TensorShape());
+            }
+        }
+        for (uint32_t i = 0; i < runtime_->GetInputCount(); ++i) {
+            runtime_->BindInputBuffer(i, nullptr, TensorShape());
+        }
+    }
+
+    for (auto x = input_buffers_.begin(); x != input_buffers_.end(); ++x) {
+        buffer_device_.Free(&(*x));
+    }
+    for (auto x = output_buffers_.begin(); x != output_buffers_.end(); ++x) {
+        buffer_device_.Free(&(*x));
+    }
+}
+
+RetCode DynamicBatcherImpl::Run(const void* const* inputs, void* const* outputs) {
+    Request req;
+    req.inputs = inputs;
+    req.outputs = outputs;
+    req.submit_time = chrono::steady_clock::now();
+    auto result = req.result.get_future();
+
+    {
+        lock_guard<mutex> lck(mutex_);
+        if (stop_) {
+            LOG(ERROR) << "batcher is stopped.";
+            return RC_PERMISSION_DENIED;
+        }
+        queue_.push_back(&req);
+    }
+    cond_.notify_all();
+
+    return result.get();
+}
+
+void DynamicBatcherImpl::Loop() {
+    vector<Request*> batch;
+    batch.reserve(options_.max_batch_size);
+
+    while (true) {
+        {
+            unique_lock<mutex> lck(mutex_);
+            cond_.wait(lck, [this]() -> bool {
+                return (stop_ || !queue_.empty());
+            });
+            if (queue_.empty()) {
+                break; // stopped and all requests are processed
+            }
+
+            // waits for more requests until the batch is full or the first request has waited long enough
+            auto deadline = queue_.front()->submit_time + chrono::microseconds(options_.max_delay_us);
+            cond_.wait_until(lck, deadline, [this]() -> bool {
+                return (stop_ || queue_.size() >= options_.max_batch_size);
+            });
+
+            const uint32_t batch_size = min<uint32_t>(queue_.size(), options_.max_batch_size);
+            batch.assign(queue_.begin(), queue_.begin() + batch_size);
+            queue_.erase(queue_.begin(), queue_.begin() + batch_size);
+        }
+
+        auto begin_ts = chrono::steady_clock::now();
+        auto status = RunBatch(batch);
+        auto end_ts = chrono::steady_clock::now();
+
+        {
+            lock_guard<mutex> lck(stat_mutex_);
+            stat_.request_count += batch.size();
+            ++stat_.batch_count;
+            stat_.total_run_time_us += DiffUs(begin_ts, end_ts);
+            for (auto x = batch.begin(); x != batch.end(); ++x) {
+                auto queue_time_us = DiffUs((*x)->submit_time, begin_ts);
+                stat_.total_queue_time_us += queue_time_us;
+                stat_.max_queue_time_us = max(stat_.max_queue_time_us, queue_time_us);
+            }
+        }
+
+        for (auto x = batch.begin(); x != batch.end(); ++x) {
+            (*x)->result.set_value(status);
+        }
+    }
+}
+
+RetCode DynamicBatcherImpl::RunBatch(const vector<Request*>& batch) {
+    const uint32_t batch_size = batch.size();
+
+    for (uint32_t i = 0; i < input_descs_.size(); ++i) {
+        const uint64_t bytes_per_sample = input_bytes_per_sample_[i];
+        auto buffer = (char*)input_buffers_[i].addr;
+        for (uint32_t j = 0; j < batch_size; ++j) {
+            memcpy(buffer + j * bytes_per_sample, batch[j]->inputs[i], bytes_per_sample);
+        }
+
+        TensorShape desc(input_descs_[i]);
+        desc.SetDim(0, batch_size);
+        auto status = runtime_->BindInputBuffer(i, buffer, desc);
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "bind buffer of input[" << i << "] failed: " << GetRetCodeStr(status);
+            return status;
+        }
+    }
+
+    auto status = runtime_->Run();
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "run batch of size [" << batch_size << "] failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
+    return ScatterOutputs(batch);
+}
+
+RetCode DynamicBatcherImpl::ScatterOutputs(const vector<Request*>& batch) {
+    const uint32_t batch_size = batch.size();
+
+    vector<char> tmp_buffer;
+    for (uint32_t i = 0; i < runtime_->GetOutputCount(); ++i) {
+        auto tensor = runtime_->GetOutputTensor(i);
+        auto shape = tensor->GetShape();
+        if (shape->GetDimCount() == 0 || shape->GetDim(0) != batch_size) {
+            LOG(ERROR) << "first dim of output[" << tensor->GetName() << "] is not batch size [" << batch_size << "]";
+            return RC_INVALID_VALUE;
+        }
+
+        TensorShape dst_desc(*shape);
+        dst_desc.SetDataFormat(DATAFORMAT_NDARRAY);
+        const uint64_t bytes_per_sample = dst_desc.GetBytesExcludingPadding() / batch_size;
+
+        const char* src;
+        if (output_bound_flags_[i]) {
+            src = (const char*)output_buffers_[i].addr;
+        } else {
+            tmp_buffer.resize(dst_desc.GetBytesExcludingPadding());
+            auto status = tensor->ConvertToHost(tmp_buffer.data(), dst_desc);
+            if (status != RC_SUCCESS) {
+                LOG(ERROR) << "convert data of output[" << tensor->GetName() << "] failed: " << GetRetCodeStr(status);
+                return status;
+            }
+            src = tmp_buffer.data();
+        }
+
+        for (uint32_t j = 0; j < batch_size; ++j) {
+            memcpy(batch[j]->outputs[i], src + j * bytes_per_sample, bytes_per_sample);
+        }
+    }
+
+    return RC_SUCCESS;
+}
+
+RetCode DynamicBatcherImpl::GetStatistics(DynamicBatcherStatistics* stat) const {
+    lock_guard<mutex> lck(stat_mutex_);
+    *stat = stat_;
+    return RC_SUCCESS;
+}
+
+}} // namespace ppl::nn
@@ -0,0 +1,93 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_RUNTIME_DYNAMIC_BATCHER_IMPL_H_
+#define _ST_HPC_PPL_NN_RUNTIME_DYNAMIC_BATCHER_IMPL_H_
+
+#include "ppl/nn/runtime/dynamic_batcher.h"
+#include "ppl/nn/runtime/runtime.h"
+#include "ppl/nn/utils/generic_cpu_device.h"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ppl { namespace nn {
+
+class DynamicBatcherImpl final : public DynamicBatcher {
+private:
+    struct Request final {
+        const void* const* inputs;
+        void* const* outputs;
+        std::chrono::steady_clock::time_point submit_time;
+        std::promise<ppl::common::RetCode> result;
+    };
+
+public:
+    DynamicBatcherImpl() {}
+    ~DynamicBatcherImpl();
+
+    ppl::common::RetCode Init(Runtime*, const DynamicBatcherOptions&);
+
+    ppl::common::RetCode Run(const void* const* inputs, void* const* outputs) override;
+    ppl::common::RetCode GetStatistics(DynamicBatcherStatistics*) const override;
+
+private:
+    void Loop();
+    ppl::common::RetCode RunBatch(const std::vector<Request*>&);
+    ppl::common::RetCode ScatterOutputs(const std::vector<Request*>&);
+
+private:
+    Runtime* runtime_ = nullptr;
+    DynamicBatcherOptions options_;
+
+    /**
+       batch buffers are bound to the runtime. they are allocated by `buffer_device_` so that kernels can use them
+       directly, which requires them to be aligned as device buffers.
+    */
+    utils::GenericCpuDevice buffer_device_;
+
+    /** shapes of inputs with batch size 1 in ndarray format */
+    std::vector<TensorShape> input_descs_;
+    std::vector<uint64_t> input_bytes_per_sample_;
+    /** can hold `max_batch_size` samples */
+    std::vector<BufferDesc> input_buffers_;
+
+    /** outputs with known shapes are written into bound buffers that can hold `max_batch_size` samples */
+    std::vector<bool> output_bound_flags_;
+    std::vector<BufferDesc> output_buffers_;
+
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::deque<Request*> queue_;
+    bool stop_ = false;
+    std::thread worker_;
+
+    mutable std::mutex stat_mutex_;
+    DynamicBatcherStatistics stat_;
+
+private:
+    DynamicBatcherImpl(const DynamicBatcherImpl&) = delete;
+    DynamicBatcherImpl& operator=(const DynamicBatcherImpl&) = delete;
+};
+
+}} // namespace ppl::nn
+
+#endif
@@ -19,6 +19,7 @@
 #define _ST_HPC_PPL_NN_RUNTIME_KERNEL_EXEC_CONTEXT_H_
 
 #include "ppl/nn/common/input_output_info.h"
+#include "ppl/nn/runtime/tensor_impl.h"
 
 namespace ppl { namespace nn {
 
@@ -37,13 +38,36 @@ public:
     void SetEdgeLastConsumerList(const std::vector<nodeid_t>* l) {
         edge_last_consumer_ = l;
     }
+
+    /**
+       @brief tells whether this kernel is the last consumer of input `idx`, which means that the buffer of this input
+       can be reused by outputs.
+       @note returns false if the input tensor shares its buffer with other tensors.
+    */
     bool IsLastConsumerOfInput(uint32_t idx) const {
         auto eid = node_->GetInput(idx);
-        return (edge_last_consumer_->at(eid) == node_->GetId());
+        if (edge_last_consumer_->at(eid) != node_->GetId()) {
+            return false;
+        }
+
+        auto object = GetInput<EdgeObject>(idx);
+        if (object && object->GetObjectType() == EdgeObject::T_TENSOR) {
+            return static_cast<const TensorImpl*>(object)->IsBufferExclusive();
+        }
+        return true;
+    }
+
+    /** @brief tells kernels that shapes of outputs are already set and `Reshape()` can be skipped. */
+    void SetOutputShapesReady(bool ready) {
+        is_output_shapes_ready_ = ready;
+    }
+    bool IsOutputShapesReady() const {
+        return is_output_shapes_ready_;
     }
 
 private:
     bool is_profiling_enabled_ = false;
+    bool is_output_shapes_ready_ = false;
     const std::vector<nodeid_t>* edge_last_consumer_ = nullptr;
 };
 
@@ -0,0 +1,344 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/runtime/memory_aware_sort.h"
+#include "ppl/nn/common/logger.h"
+#include <algorithm>
+using namespace std;
+using namespace ppl::common;
+
+namespace ppl { namespace nn { namespace utils {
+
+namespace {
+
+struct EdgeUsage final {
+    EdgeUsage(const ir::GraphTopo* topo, const vector<nodeid_t>& nodes, const set<edgeid_t>& reserved_edgeids)
+        : refcount(topo->GetMaxEdgeId(), 0), pinned(topo->GetMaxEdgeId(), false) {
+        for (auto x = nodes.begin(); x != nodes.end(); ++x) {
+            auto node = topo->GetNode(*x);
+            for (uint32_t i = 0; i < node->GetInputCount(); ++i) {
+                auto eid = node->GetInput(i);
+                if (eid != INVALID_EDGEID) {
+                    ++refcount[eid];
+                }
+            }
+            for (uint32_t i = 0; i < node->GetExtraInputCount(); ++i) {
+                ++refcount[node->GetExtraInput(i)];
+            }
+        }
+
+        for (uint32_t i = 0; i < topo->GetOutputCount(); ++i) {
+            pinned[topo->GetOutput(i)] = true;
+        }
+        for (auto x = reserved_edgeids.begin(); x != reserved_edgeids.end(); ++x) {
+            pinned[*x] = true;
+        }
+    }
+
+    /** @brief tells whether `eid` is an activation released after its last consumer. */
+    bool IsReleasable(const ir::GraphTopo* topo, edgeid_t eid) const {
+        return (!pinned[eid] && topo->GetEdge(eid)->GetProducer() != INVALID_NODEID);
+    }
+
+    vector<uint32_t> refcount;
+    vector<bool> pinned;
+};
+
+/** @brief calls `func` once for each distinct input and extra input of `node`. */
+template <typename Func>
+void ForEachDistinctInput(const ir::Node* node, vector<edgeid_t>* buf, const Func& func) {
+    buf->clear();
+    for (uint32_t i = 0; i < node->GetInputCount(); ++i) {
+        auto eid = node->GetInput(i);
+        if (eid != INVALID_EDGEID) {
+            buf->push_back(eid);
+        }
+    }
+    for (uint32_t i = 0; i < node->GetExtraInputCount(); ++i) {
+        buf->push_back(node->GetExtraInput(i));
+    }
+    std::sort(buf->begin(), buf->end());
+
+    for (uint32_t i = 0; i < buf->size();) {
+        uint32_t j = i + 1;
+        while (j < buf->size() && buf->at(j) == buf->at(i)) {
+            ++j;
+        }
+        func(buf->at(i), j - i);
+        i = j;
+    }
+}
+
+/** @brief dependencies between nodes in `nodes`, indexed by their positions */
+struct NodeDeps final {
+    NodeDeps(const ir::GraphTopo* topo, const vector<nodeid_t>& nodes)
+        : pred_count(nodes.size(), 0), successors(nodes.size()) {
+        vector<uint32_t> node2pos(topo->GetMaxNodeId(), UINT32_MAX);
+        for (uint32_t i = 0; i < nodes.size(); ++i) {
+            node2pos[nodes[i]] = i;
+        }
+
+        vector<edgeid_t> buf;
+        vector<uint32_t> preds;
+        for (uint32_t i = 0; i < nodes.size(); ++i) {
+            preds.clear();
+            ForEachDistinctInput(topo->GetNode(nodes[i]), &buf,
+                                 [topo, &node2pos, &preds](edgeid_t eid, uint32_t) -> void {
+                                     auto producer = topo->GetEdge(eid)->GetProducer();
+                                     if (producer != INVALID_NODEID && node2pos[producer] != UINT32_MAX) {
+                                         preds.push_back(node2pos[producer]);
+                                     }
+                                 });
+            std::sort(preds.begin(), preds.end());
+            preds.erase(std::unique(preds.begin(), preds.end()), preds.end());
+
+            pred_count[i] = preds.size();
+            for (auto p = preds.begin(); p != preds.end(); ++p) {
+                successors[*p].push_back(i);
+            }
+        }
+    }
+
+    vector<uint32_t> pred_count;
+    vector<vector<uint32_t>> successors;
+};
+
+/** @brief bytes added to live activations after `node` finishes. */
+int64_t CalcDelta(const ir::GraphTopo* topo, const ir::Node* node, const vector<uint64_t>& edge_bytes,
+                  const EdgeUsage& usage, vector<edgeid_t>* buf) {
+    int64_t delta = 0;
+    for (uint32_t i = 0; i < node->GetOutputCount(); ++i) {
+        delta += edge_bytes[node->GetOutput(i)];
+    }
+    ForEachDistinctInput(node, buf, [topo, &usage, &edge_bytes, &delta](edgeid_t eid, uint32_t n) -> void {
+        if (usage.refcount[eid] == n && usage.IsReleasable(topo, eid)) {
+            delta -= edge_bytes[eid];
+        }
+    });
+    return delta;
+}
+
+void ConsumeInputs(const ir::Node* node, EdgeUsage* usage, vector<edgeid_t>* buf) {
+    ForEachDistinctInput(node, buf, [usage](edgeid_t eid, uint32_t n) -> void {
+        usage->refcount[eid] -= n;
+    });
+}
+
+} // namespace
+
+uint64_t EstimatePeakActivationBytes(const ir::GraphTopo* topo, const vector<nodeid_t>& sorted_nodes,
+                                     const vector<uint64_t>& edge_bytes, const set<edgeid_t>& reserved_edgeids) {
+    EdgeUsage usage(topo, sorted_nodes, reserved_edgeids);
+
+    uint64_t live_bytes = 0, peak_bytes = 0;
+    vector<edgeid_t> buf;
+    for (auto x = sorted_nodes.begin(); x != sorted_nodes.end(); ++x) {
+        auto node = topo->GetNode(*x);
+
+        uint64_t unused_output_bytes = 0;
+        for (uint32_t i = 0; i < node->GetOutputCount(); ++i) {
+            auto eid = node->GetOutput(i);
+            live_bytes += edge_bytes[eid];
+            if (usage.refcount[eid] == 0 && !usage.pinned[eid]) {
+                unused_output_bytes += edge_bytes[eid];
+            }
+        }
+        peak_bytes = std::max(peak_bytes, live_bytes);
+
+        ForEachDistinctInput(node, &buf, [topo, &usage, &edge_bytes, &live_bytes](edgeid_t eid, uint32_t n) -> void {
+            usage.refcount[eid] -= n;
+            if (usage.refcount[eid] == 0 && usage.IsReleasable(topo, eid)) {
+                live_bytes -= edge_bytes[eid];
+            }
+        });
+        live_bytes -= unused_output_bytes;
+    }
+
+    return peak_bytes;
+}
+
+vector<uint64_t> CalcEdgeBytes(const ir::GraphTopo* topo, const map<edgeid_t, TensorShape>& shapes) {
+    vector<uint64_t> edge_bytes(topo->GetMaxEdgeId(), 0);
+    for (auto x = shapes.begin(); x != shapes.end(); ++x) {
+        auto& shape = x->second;
+
+        // dims that are unknown until running are not counted
+        bool is_known = true;
+        for (uint32_t i = 0; i < shape.GetDimCount(); ++i) {
+            if (shape.GetDim(i) < 0) {
+                is_known = false;
+                break;
+            }
+        }
+        if (is_known && x->first < edge_bytes.size()) {
+            edge_bytes[x->first] = shape.GetBytesIncludingPadding();
+        }
+    }
+    return edge_bytes;
+}
+
+void GreedyMemoryAwareSort(const ir::GraphTopo* topo, const vector<uint64_t>& edge_bytes,
+                           const set<edgeid_t>& reserved_edgeids, vector<nodeid_t>* sorted_nodes) {
+    const vector<nodeid_t> nodes = std::move(*sorted_nodes);
+    sorted_nodes->clear();
+    sorted_nodes->reserve(nodes.size());
+
+    NodeDeps deps(topo, nodes);
+    EdgeUsage usage(topo, nodes, reserved_edgeids);
+
+    // positions of nodes that are ready to run
+    vector<uint32_t> ready;
+    for (uint32_t i = 0; i < nodes.size(); ++i) {
+        if (deps.pred_count[i] == 0) {
+            ready.push_back(i);
+        }
+    }
+
+    vector<edgeid_t> buf;
+    while (!ready.empty()) {
+        uint32_t best = 0;
+        int64_t best_delta = INT64_MAX;
+        for (uint32_t r = 0; r < ready.size(); ++r) {
+            auto delta = CalcDelta(topo, topo->GetNode(nodes[ready[r]]), edge_bytes, usage, &buf);
+            if (delta < best_delta || (delta == best_delta && ready[r] < ready[best])) {
+                best = r;
+                best_delta = delta;
+            }
+        }
+
+        auto pos = ready[best];
+        ready[best] = ready.back();
+        ready.pop_back();
+
+        auto node = topo->GetNode(nodes[pos]);
+        sorted_nodes->push_back(node->GetId());
+        ConsumeInputs(node, &usage, &buf);
+        for (auto s = deps.successors[pos].begin(); s != deps.successors[pos].end(); ++s) {
+            if (--deps.pred_count[*s] == 0) {
+                ready.push_back(*s);
+            }
+        }
+    }
+}
+
+void DfsMemoryAwareSort(const ir::GraphTopo* topo, const vector<uint64_t>& edge_bytes,
+                        const set<edgeid_t>& reserved_edgeids, vector<nodeid_t>* sorted_nodes) {
+    const vector<nodeid_t> nodes = std::move(*sorted_nodes);
+    sorted_nodes->clear();
+    sorted_nodes->reserve(nodes.size());
+
+    NodeDeps deps(topo, nodes);
+    EdgeUsage usage(topo, nodes, reserved_edgeids);
+
+    struct ReadyNode final {
+        uint32_t pos;
+        int64_t delta;
+    };
+
+    // nodes on the top are picked first. roots are pushed in reversed order to keep their original order.
+    vector<uint32_t> stack;
+    for (uint32_t i = nodes.size(); i > 0; --i) {
+        if (deps.pred_count[i - 1] == 0) {
+            stack.push_back(i - 1);
+        }
+    }
+
+    vector<edgeid_t> buf;
+    vector<ReadyNode> new_ready;
+    while (!stack.empty()) {
+        auto pos = stack.back();
+        stack.pop_back();
+
+        auto node = topo->GetNode(nodes[pos]);
+        sorted_nodes->push_back(node->GetId());
+        ConsumeInputs(node, &usage, &buf);
+
+        new_ready.clear();
+        for (auto s = deps.successors[pos].begin(); s != deps.successors[pos].end(); ++s) {
+            if (--deps.pred_count[*s] == 0) {
+                ReadyNode r;
+                r.pos = *s;
+                r.delta = CalcDelta(topo, topo->GetNode(nodes[*s]), edge_bytes, usage, &buf);
+                new_ready.push_back(r);
+            }
+        }
+
+        // the one with the smallest delta is pushed last
+        std::sort(new_ready.begin(), new_ready.end(), [](const ReadyNode& a, const ReadyNode& b) -> bool {
+            return (a.delta > b.delta || (a.delta == b.delta && a.pos > b.pos));
+        });
+        for (auto r = new_ready.begin(); r != new_ready.end(); ++r) {
+            stack.push_back(r->pos);
+        }
+    }
+}
+
+uint64_t MemoryAwareSort(const ir::GraphTopo* topo, const vector<uint64_t>& edge_bytes,
+                         const set<edgeid_t>& reserved_edgeids, vector<nodeid_t>* sorted_nodes,
+                         uint32_t max_greedy_node_count) {
+    auto best_peak = EstimatePeakActivationBytes(topo, *sorted_nodes, edge_bytes, reserved_edgeids);
+
+    auto try_sort_func = [&](void (*sort_func)(const ir::GraphTopo*, const vector<uint64_t>&, const set<edgeid_t>&,
+                                               vector<nodeid_t>*)) -> void {
+        auto nodes = *sorted_nodes;
+        sort_func(topo, edge_bytes, reserved_edgeids, &nodes);
+        if (nodes.size() != sorted_nodes->size()) {
+            return;
+        }
+
+        auto peak = EstimatePeakActivationBytes(topo, nodes, edge_bytes, reserved_edgeids);
+        if (peak < best_peak) {
+            best_peak = peak;
+            *sorted_nodes = std::move(nodes);
+        }
+    };
+
+    if (sorted_nodes->size() <= max_greedy_node_count) {
+        try_sort_func(GreedyMemoryAwareSort);
+    }
+    try_sort_func(DfsMemoryAwareSort);
+
+    return best_peak;
+}
+
+RetCode ApplyMemoryAwareOrder(const ir::GraphTopo* topo, const set<edgeid_t>& reserved_edgeids,
+                              const map<edgeid_t, TensorShape>& shapes, shared_ptr<RuntimeAuxInfo>* aux_info) {
+    auto edge_bytes = CalcEdgeBytes(topo, shapes);
+    auto& old_nodes = (*aux_info)->sorted_nodes;
+    auto old_peak = EstimatePeakActivationBytes(topo, old_nodes, edge_bytes, reserved_edgeids);
+
+    auto sorted_nodes = old_nodes;
+    auto new_peak = MemoryAwareSort(topo, edge_bytes, reserved_edgeids, &sorted_nodes);
+    LOG(INFO) << "estimated peak activations of [" << old_nodes.size() << "] nodes: [" << old_peak << "] bytes => ["
+              << new_peak << "] bytes.";
+    if (new_peak >= old_peak) {
+        return RC_SUCCESS;
+    }
+
+    // `edge_last_consumer` of the old one cannot be reused
+    auto new_aux_info = make_shared<RuntimeAuxInfo>();
+    auto status = new_aux_info->Init(topo, reserved_edgeids, std::move(sorted_nodes));
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "init aux info with sorted nodes failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
+    *aux_info = new_aux_info;
+    return RC_SUCCESS;
+}
+
+}}} // namespace ppl::nn::utils
@@ -0,0 +1,79 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_RUNTIME_MEMORY_AWARE_SORT_H_
+#define _ST_HPC_PPL_NN_RUNTIME_MEMORY_AWARE_SORT_H_
+
+#include "ppl/nn/ir/graph_topo.h"
+#include "ppl/nn/common/tensor_shape.h"
+#include "ppl/nn/runtime/runtime_aux_info.h"
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+
+namespace ppl { namespace nn { namespace utils {
+
+/**
+   @brief estimates the max bytes of activations alive at the same time when nodes run in the order of `sorted_nodes`.
+   @param edge_bytes size of each edge indexed by edge id. edges without producers(inputs and constants) are ignored.
+   @param reserved_edgeids edges that are never released, as well as outputs of `topo`.
+*/
+uint64_t EstimatePeakActivationBytes(const ir::GraphTopo* topo, const std::vector<nodeid_t>& sorted_nodes,
+                                     const std::vector<uint64_t>& edge_bytes,
+                                     const std::set<edgeid_t>& reserved_edgeids);
+
+/** @brief bytes of each edge estimated from `shapes`. edges with unknown shapes or dims are 0 bytes. */
+std::vector<uint64_t> CalcEdgeBytes(const ir::GraphTopo* topo, const std::map<edgeid_t, TensorShape>& shapes);
+
+/**
+   @brief reorders `sorted_nodes`, which must be in topological order, so that the node increasing live activation
+   bytes the least is picked first among nodes whose predecessors are finished. ties keep the original order.
+   @note it takes O(n * w) time where n is the number of nodes and w is the width of the graph.
+*/
+void GreedyMemoryAwareSort(const ir::GraphTopo* topo, const std::vector<uint64_t>& edge_bytes,
+                           const std::set<edgeid_t>& reserved_edgeids, std::vector<nodeid_t>* sorted_nodes);
+
+/**
+   @brief reorders `sorted_nodes`, which must be in topological order, so that a branch is finished before another
+   one is started. among nodes that become ready at the same time, the one increasing live activation bytes the least
+   runs first.
+   @note it takes O(n * log(n)) time and is used for large graphs.
+*/
+void DfsMemoryAwareSort(const ir::GraphTopo* topo, const std::vector<uint64_t>& edge_bytes,
+                        const std::set<edgeid_t>& reserved_edgeids, std::vector<nodeid_t>* sorted_nodes);
+
+/**
+   @brief reorders `sorted_nodes` with the sorts above and keeps the order with the lowest estimated peak. the greedy
+   one is skipped for graphs with more than `max_greedy_node_count` nodes.
+   @return the estimated peak bytes of the result.
+*/
+uint64_t MemoryAwareSort(const ir::GraphTopo* topo, const std::vector<uint64_t>& edge_bytes,
+                         const std::set<edgeid_t>& reserved_edgeids, std::vector<nodeid_t>* sorted_nodes,
+                         uint32_t max_greedy_node_count = 4096);
+
+/**
+   @brief replaces `aux_info` with a new one whose nodes are reordered by `MemoryAwareSort()` if the estimated peak
+   decreases. `aux_info` is kept unchanged otherwise.
+*/
+ppl::common::RetCode ApplyMemoryAwareOrder(const ir::GraphTopo* topo, const std::set<edgeid_t>& reserved_edgeids,
+                                           const std::map<edgeid_t, TensorShape>& shapes,
+                                           std::shared_ptr<RuntimeAuxInfo>* aux_info);
+
+}}} // namespace ppl::nn::utils
+
+#endif
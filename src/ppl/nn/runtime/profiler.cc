@@ -16,6 +16,7 @@
 // under the License.
 
 #include "ppl/nn/runtime/profiler.h"
+#include "ppl/nn/runtime/scheduler_common.h"
 #include "ppl/nn/common/logger.h"
 using namespace std;
 using namespace ppl::common;
@@ -29,6 +30,42 @@ void Profiler::Init(const RuntimeInternalConf* conf, const RuntimeGraphResource*
     aux_info_ = aux_info;
 }
 
+void Profiler::CollectMemoryUsage(KernelImpl* kernel) {
+    vector<utils::LiveActivation> live_tensors;
+    auto total_bytes = utils::CollectLiveActivations(*graph_, &live_tensors);
+
+    if (total_bytes <= peak_activation_bytes_) {
+        return;
+    }
+
+    peak_activation_bytes_ = total_bytes;
+    peak_node_id_ = kernel->GetNode()->GetId();
+    peak_tensors_.clear();
+    peak_tensors_.reserve(live_tensors.size());
+    for (auto x = live_tensors.begin(); x != live_tensors.end(); ++x) {
+        TensorMemoryInfo info;
+        info.name = x->tensor->GetName();
+        info.bytes = x->tensor->GetShape()->GetBytesIncludingPadding();
+        peak_tensors_.emplace_back(std::move(info));
+    }
+}
+
+void Profiler::GetPeakActivationInfo(MemoryStatistics* stat) const {
+    stat->peak_activation_bytes = peak_activation_bytes_;
+    stat->peak_tensors = peak_tensors_;
+    if (peak_node_id_ != INVALID_NODEID) {
+        stat->peak_kernel_name = graph_->nodeid2kernel[peak_node_id_]->GetName();
+    } else {
+        stat->peak_kernel_name.clear();
+    }
+}
+
+void Profiler::ClearMemoryUsage() {
+    peak_activation_bytes_ = 0;
+    peak_node_id_ = INVALID_NODEID;
+    peak_tensors_.clear();
+}
+
 #ifdef PPLNN_ENABLE_KERNEL_PROFILING
 void Profiler::CollectStatistics(KernelImpl* kernel) {
     if (conf_->profiling_flag) {
@@ -22,6 +22,7 @@
 #include "ppl/nn/runtime/runtime_internal_conf.h"
 #include "ppl/nn/runtime/runtime_graph_resource.h"
 #include "ppl/nn/runtime/runtime_aux_info.h"
+#include "ppl/nn/runtime/memory_statistics.h"
 
 #ifdef PPLNN_ENABLE_KERNEL_PROFILING
 #include "ppl/nn/runtime/profiling_statistics.h"
@@ -42,6 +43,18 @@ public:
 #endif
     }
 
+    bool IsMemoryProfilingEnabled() const {
+        return conf_->memory_profiling_flag;
+    }
+
+    /** @brief records activations alive after `kernel` is executed and before its inputs are released. */
+    void CollectMemoryUsage(KernelImpl* kernel);
+
+    /** @brief fills peak activation fields of `stat`. */
+    void GetPeakActivationInfo(MemoryStatistics* stat) const;
+
+    void ClearMemoryUsage();
+
 #ifdef PPLNN_ENABLE_KERNEL_PROFILING
     void CollectStatistics(KernelImpl*);
 
@@ -59,6 +72,11 @@ private:
     std::vector<KernelExecInfo> nodeid2info_;
 #endif
 
+private:
+    uint64_t peak_activation_bytes_ = 0;
+    nodeid_t peak_node_id_ = INVALID_NODEID;
+    std::vector<TensorMemoryInfo> peak_tensors_;
+
 private:
     const RuntimeInternalConf* conf_;
     const RuntimeGraphResource* graph_;
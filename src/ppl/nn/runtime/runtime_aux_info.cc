@@ -161,4 +161,17 @@ RetCode RuntimeAuxInfo::Init(const ir::GraphTopo* topo, const set<edgeid_t>& res
     return RC_SUCCESS;
 }
 
+RetCode RuntimeAuxInfo::Init(const ir::GraphTopo* topo, const set<edgeid_t>& reserved_edgeids,
+                             vector<nodeid_t>&& nodes) {
+    sorted_nodes = std::move(nodes);
+
+    auto status = InitEdgeLastConsumer(topo, sorted_nodes, reserved_edgeids, &edge_last_consumer);
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "InitEdgeLastConsumer failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
+    return RC_SUCCESS;
+}
+
 }} // namespace ppl::nn
@@ -33,6 +33,9 @@ namespace ppl { namespace nn {
 struct RuntimeAuxInfo final {
     ppl::common::RetCode Init(const ir::GraphTopo*, const std::set<edgeid_t>&);
 
+    /** @brief uses `sorted_nodes`, which MUST be in topological order, instead of sorting nodes of `topo`. */
+    ppl::common::RetCode Init(const ir::GraphTopo*, const std::set<edgeid_t>&, std::vector<nodeid_t>&& sorted_nodes);
+
     /** node ids in topological order */
     std::vector<nodeid_t> sorted_nodes;
 
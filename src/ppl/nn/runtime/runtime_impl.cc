@@ -20,6 +20,7 @@
 #include "ppl/nn/runtime/runtime_impl.h"
 #include "ppl/nn/runtime/sequential_scheduler.h"
 #include "ppl/nn/runtime/runtime_internal_conf.h"
+#include "ppl/nn/runtime/memory_aware_sort.h"
 #include "ppl/nn/utils/utils.h"
 #include <stdarg.h>
 using namespace std;
@@ -29,6 +30,8 @@ namespace ppl { namespace nn {
 
 RuntimeImpl::~RuntimeImpl() {
     sched_.reset();
+    spiller_.reset();
+    shape_cache_.reset();
     graph_.Clear();
     engctx_.clear();
     graph_info_.reset();
@@ -291,6 +294,7 @@ RetCode RuntimeImpl::Init(const shared_ptr<ir::GraphTopo>& topo, const shared_pt
     graph_info_ = info;
     aux_info_ = aux_info;
     topo_ = topo;
+    reserved_edges_ = reserved_edgeids;
 
     profiler_.Init(&conf_, &graph_, aux_info.get());
 
@@ -304,6 +308,16 @@ RetCode RuntimeImpl::Init(const shared_ptr<ir::GraphTopo>& topo, const shared_pt
     return sched_->Init(topo.get(), aux_info.get(), &graph_);
 }
 
+RetCode RuntimeImpl::EnableShapeCache(uint32_t max_entry_num) {
+    if (!ShapeCache::IsApplicable(topo_.get())) {
+        return RC_UNSUPPORTED;
+    }
+
+    shape_cache_.reset(new ShapeCache(max_entry_num));
+    sched_->SetShapeCache(shape_cache_.get());
+    return RC_SUCCESS;
+}
+
 RetCode RuntimeImpl::Sync() {
     for (uint32_t i = 0; i < GetOutputCount(); ++i) {
         auto output = GetOutputTensorImpl(i);
@@ -319,9 +333,102 @@ RetCode RuntimeImpl::Sync() {
     return RC_SUCCESS;
 }
 
+RetCode RuntimeImpl::BindInputBuffer(uint32_t idx, void* buf, const TensorShape& desc) {
+    if (idx >= GetInputCount()) {
+        LOG(ERROR) << "input index[" << idx << "] >= input count[" << GetInputCount() << "]";
+        return RC_INVALID_VALUE;
+    }
+
+    GetInputTensorImpl(idx)->BindBuffer(buf, desc);
+    return RC_SUCCESS;
+}
+
+RetCode RuntimeImpl::BindOutputBuffer(uint32_t idx, void* buf, const TensorShape& desc) {
+    if (idx >= GetOutputCount()) {
+        LOG(ERROR) << "output index[" << idx << "] >= output count[" << GetOutputCount() << "]";
+        return RC_INVALID_VALUE;
+    }
+
+    GetOutputTensorImpl(idx)->BindBuffer(buf, desc);
+    return RC_SUCCESS;
+}
+
+RetCode RuntimeImpl::PrepareBoundInputs() {
+    for (uint32_t i = 0; i < GetInputCount(); ++i) {
+        auto tensor = GetInputTensorImpl(i);
+        auto buf = tensor->GetBoundBuffer();
+        if (!buf) {
+            continue;
+        }
+
+        auto& desc = tensor->GetBoundBufferDesc();
+        auto shape = tensor->GetShape();
+        if (desc.IsScalar()) {
+            shape->ReshapeAsScalar();
+        } else {
+            shape->Reshape(desc.GetDims(), desc.GetRealDimCount());
+        }
+
+        // uses `buf` directly if possible
+        auto status = tensor->ReallocBuffer();
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "ReallocBuffer for input[" << tensor->GetName() << "] failed: " << GetRetCodeStr(status);
+            return status;
+        }
+        if (tensor->GetBufferPtr() == buf) {
+            continue;
+        }
+
+        status = tensor->ConvertFromHost(buf, desc);
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "convert data of input[" << tensor->GetName() << "] failed: " << GetRetCodeStr(status);
+            return status;
+        }
+    }
+
+    return RC_SUCCESS;
+}
+
+RetCode RuntimeImpl::FinishBoundOutputs() {
+    for (uint32_t i = 0; i < GetOutputCount(); ++i) {
+        auto tensor = GetOutputTensorImpl(i);
+        auto buf = tensor->GetBoundBuffer();
+        if (!buf || tensor->GetBufferPtr() == buf) {
+            continue;
+        }
+
+        auto& desc = tensor->GetBoundBufferDesc();
+        TensorShape dst_desc = *tensor->GetShape();
+        dst_desc.SetDataType(desc.GetDataType());
+        dst_desc.SetDataFormat(desc.GetDataFormat());
+        if (dst_desc.GetBytesIncludingPadding() > desc.GetBytesIncludingPadding()) {
+            LOG(ERROR) << "output[" << tensor->GetName() << "] needs [" << dst_desc.GetBytesIncludingPadding()
+                       << "] bytes but bound buffer has only [" << desc.GetBytesIncludingPadding() << "] bytes.";
+            return RC_INVALID_VALUE;
+        }
+        if (dst_desc.GetBytesIncludingPadding() == 0) {
+            continue;
+        }
+
+        auto status = tensor->ConvertToHost(buf, dst_desc);
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "convert data of output[" << tensor->GetName() << "] failed: " << GetRetCodeStr(status);
+            return status;
+        }
+    }
+
+    return RC_SUCCESS;
+}
+
 RetCode RuntimeImpl::Run() {
     RetCode status;
 
+    status = PrepareBoundInputs();
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "PrepareBoundInputs failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
     for (auto x = engctx_.begin(); x != engctx_.end(); ++x) {
         status = x->get()->BeforeRun(topo_.get(), &graph_);
         if (status != RC_SUCCESS) {
@@ -337,7 +444,12 @@ RetCode RuntimeImpl::Run() {
         return status;
     }
 
-    return Sync();
+    status = Sync();
+    if (status != RC_SUCCESS) {
+        return status;
+    }
+
+    return FinishBoundOutputs();
 }
 
 RetCode RuntimeImpl::GetProfilingStatistics(ProfilingStatistics* stat) const {
@@ -349,6 +461,86 @@ RetCode RuntimeImpl::GetProfilingStatistics(ProfilingStatistics* stat) const {
 #endif
 }
 
+RetCode RuntimeImpl::GetMemoryStatistics(MemoryStatistics* stat) const {
+    *stat = MemoryStatistics();
+
+    set<EngineImpl*> engines;
+    for (auto p = graph_info_->partitions.begin(); p != graph_info_->partitions.end(); ++p) {
+        engines.insert(p->engine);
+        for (auto c = p->constants.begin(); c != p->constants.end(); ++c) {
+            // constants of nodes that are not used by this runtime are skipped
+            auto ref = graph_.tensors.find(c->first);
+            if (ref != graph_.tensors.end()) {
+                stat->constant_bytes += ref->second.GetShape()->GetBytesIncludingPadding();
+            }
+        }
+    }
+
+    DeviceMemoryUsage usage;
+    for (auto x = engines.begin(); x != engines.end(); ++x) {
+        (*x)->GetMemoryUsage(&usage);
+    }
+    for (auto x = engctx_.begin(); x != engctx_.end(); ++x) {
+        x->get()->GetDevice()->GetMemoryUsage(&usage);
+    }
+
+    stat->converted_weight_bytes = usage.allocator_bytes;
+    stat->tmp_buffer_bytes = usage.tmp_buffer_bytes;
+    stat->allocated_bytes = usage.allocated_bytes;
+    stat->peak_used_bytes = usage.peak_used_bytes;
+    if (usage.allocated_bytes > usage.peak_used_bytes) {
+        stat->fragmented_bytes = usage.allocated_bytes - usage.peak_used_bytes;
+    }
+
+    profiler_.GetPeakActivationInfo(stat);
+    if (spiller_) {
+        stat->spilled_bytes = spiller_->GetSpilledBytes();
+    }
+    return RC_SUCCESS;
+}
+
+RetCode RuntimeImpl::ApplyMemoryBudget(uint64_t budget_bytes) {
+    if (budget_bytes == 0) {
+        sched_->SetActivationSpiller(nullptr);
+        spiller_.reset();
+        budget_aux_info_.reset();
+        return sched_->Init(topo_.get(), aux_info_.get(), &graph_);
+    }
+
+    auto edge_bytes = utils::CalcEdgeBytes(topo_.get(), graph_info_->shapes);
+    auto old_peak = utils::EstimatePeakActivationBytes(topo_.get(), aux_info_->sorted_nodes, edge_bytes,
+                                                       reserved_edges_);
+    auto sorted_nodes = aux_info_->sorted_nodes;
+    auto new_peak = utils::MemoryAwareSort(topo_.get(), edge_bytes, reserved_edges_, &sorted_nodes);
+    LOG(INFO) << "estimated peak activations: [" << old_peak << "] bytes => [" << new_peak << "] bytes, budget ["
+              << budget_bytes << "] bytes.";
+
+    unique_ptr<RuntimeAuxInfo> aux_info(new RuntimeAuxInfo());
+    auto status = aux_info->Init(topo_.get(), reserved_edges_, std::move(sorted_nodes));
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "init aux info failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
+    unique_ptr<ActivationSpiller> spiller(new ActivationSpiller(budget_bytes));
+    status = spiller->Init(topo_.get(), aux_info.get());
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "init activation spiller failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
+    status = sched_->Init(topo_.get(), aux_info.get(), &graph_);
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "init scheduler failed: " << GetRetCodeStr(status);
+        return status;
+    }
+    sched_->SetActivationSpiller(spiller.get());
+
+    budget_aux_info_ = std::move(aux_info);
+    spiller_ = std::move(spiller);
+    return RC_SUCCESS;
+}
+
 Tensor* RuntimeImpl::GetTensorByName(const char* name) const {
     const string name_s(name);
     for (auto x = graph_.tensors.begin(); x != graph_.tensors.end(); ++x) {
@@ -380,8 +572,22 @@ RetCode RuntimeImpl::SetProfilingFlag(RuntimeImpl* rt, va_list args) {
 #endif
 }
 
+RetCode RuntimeImpl::SetMemoryProfilingFlag(RuntimeImpl* rt, va_list args) {
+    auto flag = va_arg(args, uint32_t);
+    rt->conf_.memory_profiling_flag = (flag > 0);
+    rt->profiler_.ClearMemoryUsage();
+    return RC_SUCCESS;
+}
+
+RetCode RuntimeImpl::SetMemoryBudget(RuntimeImpl* rt, va_list args) {
+    auto budget_bytes = va_arg(args, uint64_t);
+    return rt->ApplyMemoryBudget(budget_bytes);
+}
+
 RuntimeImpl::ConfHandlerFunc RuntimeImpl::conf_handlers_[] = {
     RuntimeImpl::SetProfilingFlag,
+    RuntimeImpl::SetMemoryProfilingFlag,
+    RuntimeImpl::SetMemoryBudget,
 };
 
 RetCode RuntimeImpl::Configure(uint32_t option, ...) {
@@ -28,6 +28,7 @@
 #include "ppl/nn/runtime/runtime_internal_conf.h"
 #include "ppl/nn/runtime/scheduler.h"
 #include "ppl/nn/runtime/profiler.h"
+#include "ppl/nn/runtime/activation_spiller.h"
 
 namespace ppl { namespace nn {
 
@@ -57,6 +58,13 @@ public:
         return static_cast<TensorImpl*>(graph_.edgeid2object[eid]);
     }
 
+    /**
+       @brief caches tensor shapes for each signature of input shapes so that reshaping is skipped
+       when the same input shapes are seen again.
+       @return RC_UNSUPPORTED if some shapes in this graph depend on values of non-constant tensors.
+    */
+    ppl::common::RetCode EnableShapeCache(uint32_t max_entry_num = 16);
+
     // ----- //
 
     ppl::common::RetCode Configure(uint32_t, ...) override;
@@ -79,6 +87,9 @@ public:
 
     Tensor* GetTensorByName(const char* name) const override;
 
+    ppl::common::RetCode BindInputBuffer(uint32_t idx, void* buf, const TensorShape& desc) override;
+    ppl::common::RetCode BindOutputBuffer(uint32_t idx, void* buf, const TensorShape& desc) override;
+
     ppl::common::RetCode Run() override;
 
     uint32_t GetDeviceContextCount() const override {
@@ -89,6 +100,7 @@ public:
     }
 
     ppl::common::RetCode GetProfilingStatistics(ProfilingStatistics* stat) const override;
+    ppl::common::RetCode GetMemoryStatistics(MemoryStatistics* stat) const override;
 
 private:
     /**
@@ -97,9 +109,20 @@ private:
     */
     ppl::common::RetCode Sync();
 
+    /** @brief sets shapes and data of inputs that have bound buffers. */
+    ppl::common::RetCode PrepareBoundInputs();
+
+    /** @brief converts results into bound buffers of outputs that are not written directly. */
+    ppl::common::RetCode FinishBoundOutputs();
+
+    /** @brief reorders nodes and enables spilling to keep live activations under `budget_bytes`. */
+    ppl::common::RetCode ApplyMemoryBudget(uint64_t budget_bytes);
+
 private:
     RuntimeGraphResource graph_;
     std::unique_ptr<Scheduler> sched_;
+    std::unique_ptr<ShapeCache> shape_cache_;
+    std::unique_ptr<ActivationSpiller> spiller_;
     std::vector<std::unique_ptr<EngineContext>> engctx_;
     RuntimeInternalConf conf_;
     Profiler profiler_;
@@ -109,6 +132,10 @@ private:
     std::shared_ptr<ir::GraphTopo> topo_;
     std::shared_ptr<const RuntimeAuxInfo> aux_info_;
     std::shared_ptr<const RuntimeGraphInfo> graph_info_;
+    std::set<edgeid_t> reserved_edges_;
+
+    /** node order of this runtime under a memory budget. `aux_info_` is used if it is nullptr. */
+    std::unique_ptr<RuntimeAuxInfo> budget_aux_info_;
 
 private:
     /*
@@ -116,6 +143,8 @@ private:
       defined as member functions can avoid exporting unnecessary APIs
     */
     static ppl::common::RetCode SetProfilingFlag(RuntimeImpl*, va_list);
+    static ppl::common::RetCode SetMemoryProfilingFlag(RuntimeImpl*, va_list);
+    static ppl::common::RetCode SetMemoryBudget(RuntimeImpl*, va_list);
 
     typedef ppl::common::RetCode (*ConfHandlerFunc)(RuntimeImpl*, va_list);
     static ConfHandlerFunc conf_handlers_[RUNTIME_CONF_MAX];
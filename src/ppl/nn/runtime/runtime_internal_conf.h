@@ -24,6 +24,7 @@ struct RuntimeInternalConf {
 #ifdef PPLNN_ENABLE_KERNEL_PROFILING
     bool profiling_flag = false;
 #endif
+    bool memory_profiling_flag = false;
 };
 
 }} // namespace ppl::nn
@@ -21,6 +21,8 @@
 #include "ppl/common/retcode.h"
 #include "ppl/nn/runtime/runtime_graph_resource.h"
 #include "ppl/nn/runtime/profiler.h"
+#include "ppl/nn/runtime/shape_cache.h"
+#include "ppl/nn/runtime/activation_spiller.h"
 
 namespace ppl { namespace nn {
 
@@ -29,6 +31,12 @@ public:
     virtual ~Scheduler() {}
     virtual ppl::common::RetCode Init(const ir::GraphTopo*, const RuntimeAuxInfo*, RuntimeGraphResource*) = 0;
     virtual ppl::common::RetCode Run(Profiler*) = 0;
+
+    /** @brief sets a cache of tensor shapes. `cache` is owned by the caller and may be nullptr. */
+    virtual void SetShapeCache(ShapeCache* cache) {}
+
+    /** @brief sets a spiller to keep activations under a memory budget. `spiller` is owned by the caller. */
+    virtual void SetActivationSpiller(ActivationSpiller* spiller) {}
 };
 
 }} // namespace ppl::nn
@@ -17,6 +17,7 @@
 
 #include "ppl/nn/runtime/scheduler_common.h"
 #include "ppl/nn/common/logger.h"
+#include <algorithm>
 using namespace std;
 using namespace ppl::common;
 
@@ -72,6 +73,10 @@ RetCode ExecuteKernel(KernelImpl* kernel, KernelExecContext* ctx,
     profiler->CollectStatistics(kernel);
 #endif
 
+    if (profiler->IsMemoryProfilingEnabled()) {
+        profiler->CollectMemoryUsage(kernel);
+    }
+
     auto status = AfterExecuteKernel(kernel, ctx, release_func);
 
     if (exec_status != RC_SUCCESS) {
@@ -84,4 +89,46 @@ RetCode ExecuteKernel(KernelImpl* kernel, KernelExecContext* ctx,
     return status;
 }
 
+uint64_t CollectLiveActivations(const RuntimeGraphResource& graph, vector<LiveActivation>* activations) {
+    activations->clear();
+    for (auto x = graph.edgeid2object.begin(); x != graph.edgeid2object.end(); ++x) {
+        auto object = *x;
+        if (!object || object->GetObjectType() != EdgeObject::T_TENSOR) {
+            continue;
+        }
+
+        auto tensor = static_cast<TensorImpl*>(object);
+        auto base = tensor->GetManagedBufferPtr();
+        if (!base) {
+            continue;
+        }
+
+        uint64_t end = tensor->GetShape()->GetBytesIncludingPadding();
+        auto device = tensor->GetDevice();
+        if (device && device->IsHostMemory()) {
+            end += static_cast<const char*>(tensor->GetBufferPtr()) - static_cast<const char*>(base);
+        }
+
+        LiveActivation info;
+        info.base = base;
+        info.end = end;
+        info.tensor = tensor;
+        activations->push_back(info);
+    }
+
+    std::sort(activations->begin(), activations->end(),
+              [](const LiveActivation& a, const LiveActivation& b) -> bool {
+                  return (a.base < b.base || (a.base == b.base && a.end > b.end));
+              });
+
+    uint64_t total_bytes = 0;
+    for (uint32_t i = 0; i < activations->size(); ++i) {
+        if (i == 0 || activations->at(i).base != activations->at(i - 1).base) {
+            total_bytes += activations->at(i).end;
+        }
+    }
+
+    return total_bytes;
+}
+
 }}} // namespace ppl::nn::utils
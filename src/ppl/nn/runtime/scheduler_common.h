@@ -20,6 +20,7 @@
 
 #include "ppl/nn/runtime/edge_object.h"
 #include "ppl/nn/runtime/profiler.h"
+#include "ppl/nn/runtime/tensor_impl.h"
 #include <functional>
 
 namespace ppl { namespace nn { namespace utils {
@@ -28,6 +29,19 @@ ppl::common::RetCode ExecuteKernel(KernelImpl*, KernelExecContext*,
                                    const std::function<ppl::common::RetCode(EdgeObject*, nodeid_t)>& release_func,
                                    Profiler*);
 
+struct LiveActivation final {
+    void* base; // start of the device-managed buffer
+    uint64_t end; // offset of the end of this tensor in `base`
+    TensorImpl* tensor;
+};
+
+/**
+   @brief collects tensors in `graph` that hold device-managed buffers. constants and caller-owned buffers are skipped.
+   @return total bytes of `activations`, in which views of the same buffer are counted once.
+   @note `activations` are sorted by `base`.
+*/
+uint64_t CollectLiveActivations(const RuntimeGraphResource& graph, std::vector<LiveActivation>* activations);
+
 }}} // namespace ppl::nn::utils
 
 #endif
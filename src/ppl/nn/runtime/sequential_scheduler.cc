@@ -35,6 +35,18 @@ RetCode SequentialScheduler::Init(const ir::GraphTopo* topo, const RuntimeAuxInf
 }
 
 RetCode SequentialScheduler::Run(Profiler* profiler) {
+    vector<int64_t> shape_key;
+    const vector<TensorShape>* cached_shapes = nullptr;
+    vector<TensorShape> recorded_shapes;
+    bool is_recording_shapes = false;
+    if (shape_cache_ && ShapeCache::GenerateKey(topo_, *graph_, &shape_key)) {
+        cached_shapes = shape_cache_->Find(shape_key);
+        if (!cached_shapes) {
+            recorded_shapes.resize(topo_->GetMaxEdgeId());
+            is_recording_shapes = true;
+        }
+    }
+
     auto acquire_object_func = [this](edgeid_t eid, uint32_t etype) -> EdgeObject* {
         if (eid >= graph_->edgeid2object.size()) {
             return nullptr;
@@ -65,12 +77,21 @@ RetCode SequentialScheduler::Run(Profiler* profiler) {
         return object;
     };
 
-    auto release_object_func = [this](EdgeObject* object, nodeid_t user) -> RetCode {
+    auto release_object_func = [this, is_recording_shapes, &recorded_shapes](EdgeObject* object,
+                                                                             nodeid_t user) -> RetCode {
         auto eid = object->GetEdge()->GetId();
+        if (is_recording_shapes && object->GetEdge()->GetProducer() == user &&
+            object->GetObjectType() == EdgeObject::T_TENSOR) {
+            recorded_shapes[eid] = *static_cast<TensorImpl*>(object)->GetShape();
+        }
+
         if (aux_info_->edge_last_consumer[eid] == user) {
             auto obj = graph_->edgeid2object[eid];
             if (obj->GetObjectType() == EdgeObject::T_TENSOR) {
-                tensor_pool_.Free(static_cast<TensorImpl*>(obj));
+                auto tensor = static_cast<TensorImpl*>(obj);
+                // drops the reference of a shared buffer. it is freed only when the last view is released.
+                tensor->FreeBuffer();
+                tensor_pool_.Free(tensor);
             } else if (obj->GetObjectType() == EdgeObject::T_TENSOR_SEQUENCE) {
                 tensor_sequence_pool_.Free(static_cast<TensorSequence*>(obj));
             } else {
@@ -95,16 +116,54 @@ RetCode SequentialScheduler::Run(Profiler* profiler) {
     ctx.SetAcquireFunc(acquire_object_func);
     ctx.SetProfilingFlag(profiler->IsProfilingEnabled());
     ctx.SetEdgeLastConsumerList(&aux_info_->edge_last_consumer);
+    ctx.SetOutputShapesReady(cached_shapes != nullptr);
 
-    for (auto x = aux_info_->sorted_nodes.begin(); x != aux_info_->sorted_nodes.end(); ++x) {
-        auto kernel = graph_->nodeid2kernel[*x].get();
+    if (spiller_) {
+        spiller_->Reset();
+    }
+
+    for (uint32_t pos = 0; pos < aux_info_->sorted_nodes.size(); ++pos) {
+        auto kernel = graph_->nodeid2kernel[aux_info_->sorted_nodes[pos]].get();
         ctx.SetNode(kernel->GetNode());
 
+        if (cached_shapes) {
+            for (uint32_t i = 0; i < ctx.GetOutputCount(); ++i) {
+                auto tensor = ctx.GetOutput<TensorImpl>(i);
+                if (!tensor) {
+                    LOG(ERROR) << "get output[" << i << "] of kernel[" << kernel->GetName() << "] failed.";
+                    return RC_NOT_FOUND;
+                }
+                *tensor->GetShape() = cached_shapes->at(tensor->GetEdge()->GetId());
+            }
+        }
+
+        if (spiller_) {
+            auto status = spiller_->BeforeExecute(pos, graph_);
+            if (status != RC_SUCCESS) {
+                LOG(ERROR) << "restore spilled inputs of kernel[" << kernel->GetName()
+                           << "] failed: " << GetRetCodeStr(status);
+                return status;
+            }
+        }
+
         auto status = utils::ExecuteKernel(kernel, &ctx, release_object_func, profiler);
         if (status != RC_SUCCESS) {
             LOG(ERROR) << "execute kernel[" << kernel->GetName() << "] failed: " << GetRetCodeStr(status);
             return status;
         }
+
+        if (spiller_) {
+            status = spiller_->AfterExecute(pos, graph_);
+            if (status != RC_SUCCESS) {
+                LOG(ERROR) << "spill activations after kernel[" << kernel->GetName()
+                           << "] failed: " << GetRetCodeStr(status);
+                return status;
+            }
+        }
+    }
+
+    if (is_recording_shapes) {
+        shape_cache_->Insert(std::move(shape_key), std::move(recorded_shapes));
     }
 
 #ifndef NDEBUG
@@ -29,11 +29,19 @@ public:
     ppl::common::RetCode Init(const ir::GraphTopo* topo, const RuntimeAuxInfo* aux_info,
                               RuntimeGraphResource* g) override;
     ppl::common::RetCode Run(Profiler*) override;
+    void SetShapeCache(ShapeCache* cache) override {
+        shape_cache_ = cache;
+    }
+    void SetActivationSpiller(ActivationSpiller* spiller) override {
+        spiller_ = spiller;
+    }
 
 private:
     const ir::GraphTopo* topo_;
     const RuntimeAuxInfo* aux_info_;
     RuntimeGraphResource* graph_;
+    ShapeCache* shape_cache_ = nullptr;
+    ActivationSpiller* spiller_ = nullptr;
 
     /** used to accelerlate tensor allocations */
     ppl::common::ObjectPool<TensorImpl> tensor_pool_;
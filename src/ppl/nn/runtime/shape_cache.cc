@@ -0,0 +1,238 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/runtime/shape_cache.h"
+#include "ppl/nn/runtime/tensor_impl.h"
+#include <map>
+#include <set>
+#include <string>
+using namespace std;
+
+namespace ppl { namespace nn {
+
+/**
+   output shapes of these ops are determined by shapes of inputs and attributes only.
+   ops not listed here or in `g_shape_input_ops`, including custom ops, are assumed to depend on
+   values of all inputs.
+*/
+static const map<string, set<string>> g_shape_static_ops = {
+    {"",
+     {
+         "Abs",
+         "Add",
+         "And",
+         "ArgMax",
+         "AveragePool",
+         "BatchNormalization",
+         "Cast",
+         "Ceil",
+         "Clip",
+         "Concat",
+         "Conv",
+         "ConvTranspose",
+         "Cos",
+         "CumSum",
+         "DepthToSpace",
+         "Div",
+         "Dropout",
+         "Equal",
+         "Erf",
+         "Exp",
+         "Flatten",
+         "Floor",
+         "Gather",
+         "GatherElements",
+         "GatherND",
+         "Gemm",
+         "GlobalAveragePool",
+         "GlobalMaxPool",
+         "Greater",
+         "HardSigmoid",
+         "Identity",
+         "InstanceNormalization",
+         "LeakyRelu",
+         "Less",
+         "Log",
+         "LogSoftmax",
+         "LRN",
+         "LSTM",
+         "MatMul",
+         "Max",
+         "MaxPool",
+         "Min",
+         "Mul",
+         "Neg",
+         "Not",
+         "Or",
+         "PRelu",
+         "Pow",
+         "Reciprocal",
+         "ReduceL2",
+         "ReduceMax",
+         "ReduceMean",
+         "ReduceMin",
+         "ReduceProd",
+         "Relu",
+         "RoiAlign",
+         "ScatterElements",
+         "ScatterND",
+         "Shape",
+         "Sigmoid",
+         "Sign",
+         "Sin",
+         "Softmax",
+         "SpaceToDepth",
+         "Sqrt",
+         "Sub",
+         "Sum",
+         "Tanh",
+         "Transpose",
+         "Where",
+         "Xor",
+     }},
+    {"pmx",
+     {
+         "ChannelShuffle",
+         "PostDepthwiseConv",
+         "PostPoolingConv",
+         "Reorder",
+         "Shape",
+         "Swish",
+     }},
+    {"mmcv",
+     {
+         "MMCVModulatedDeformConv2d",
+         "MMCVRoiAlign",
+     }},
+};
+
+/** output shapes of these ops depend on values of inputs except the first one, e.g. `shape` of Reshape */
+static const map<string, set<string>> g_shape_input_ops = {
+    {"",
+     {
+         "Expand",
+         "MaxUnpool",
+         "OneHot",
+         "Pad",
+         "ReduceSum",
+         "Reshape",
+         "Resize",
+         "Slice",
+         "Split",
+         "Squeeze",
+         "Tile",
+         "TopK",
+         "Unsqueeze",
+         "Upsample",
+     }},
+};
+
+static bool IsOneOf(const map<string, set<string>>& ops, const ir::Node::Type& type) {
+    auto ref = ops.find(type.domain);
+    if (ref == ops.end()) {
+        return false;
+    }
+    return (ref->second.find(type.name) != ref->second.end());
+}
+
+bool ShapeCache::IsApplicable(const ir::GraphTopo* topo) {
+    /*
+      values of edges in `value_known` are determined by constants and input shapes only.
+      they can be used as shape arguments safely.
+    */
+    vector<bool> value_known(topo->GetMaxEdgeId(), false);
+    for (uint32_t i = 0; i < topo->GetConstantCount(); ++i) {
+        value_known[topo->GetConstant(i)] = true;
+    }
+
+    bool applicable = true;
+    topo->TopologicalSort([topo, &value_known, &applicable](nodeid_t nid) -> void {
+        if (!applicable) {
+            return;
+        }
+
+        auto node = topo->GetNode(nid);
+        auto& type_name = node->GetType().name;
+
+        bool all_inputs_known = true;
+        bool shape_inputs_known = true;
+        for (uint32_t i = 0; i < node->GetInputCount(); ++i) {
+            auto eid = node->GetInput(i);
+            if (eid != INVALID_EDGEID && !value_known[eid]) {
+                all_inputs_known = false;
+                if (i > 0) {
+                    shape_inputs_known = false;
+                }
+            }
+        }
+        for (uint32_t i = 0; i < node->GetExtraInputCount(); ++i) {
+            if (!value_known[node->GetExtraInput(i)]) {
+                all_inputs_known = false;
+            }
+        }
+
+        if (type_name.find("Sequence") != string::npos) {
+            // only tensors are handled
+            applicable = false;
+        } else if (IsOneOf(g_shape_input_ops, node->GetType())) {
+            applicable = shape_inputs_known;
+        } else if (!IsOneOf(g_shape_static_ops, node->GetType())) {
+            applicable = all_inputs_known;
+        }
+
+        // outputs of `Shape` are determined by input shapes
+        const bool outputs_known = (all_inputs_known || type_name == "Shape");
+        for (uint32_t i = 0; i < node->GetOutputCount(); ++i) {
+            value_known[node->GetOutput(i)] = outputs_known;
+        }
+    });
+
+    return applicable;
+}
+
+static bool AppendTensorShape(const EdgeObject* object, vector<int64_t>* key) {
+    if (!object || object->GetObjectType() != EdgeObject::T_TENSOR) {
+        return false;
+    }
+
+    auto shape = static_cast<const TensorImpl*>(object)->GetShape();
+    key->push_back(shape->GetDataType());
+    key->push_back(shape->GetDataFormat());
+    key->push_back(shape->IsScalar());
+    key->push_back(shape->GetRealDimCount());
+    for (uint32_t i = 0; i < shape->GetRealDimCount(); ++i) {
+        key->push_back(shape->GetDim(i));
+    }
+    return true;
+}
+
+bool ShapeCache::GenerateKey(const ir::GraphTopo* topo, const RuntimeGraphResource& graph, vector<int64_t>* key) {
+    key->clear();
+    for (uint32_t i = 0; i < topo->GetInputCount(); ++i) {
+        if (!AppendTensorShape(graph.edgeid2object[topo->GetInput(i)], key)) {
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < topo->GetExtraInputCount(); ++i) {
+        if (!AppendTensorShape(graph.edgeid2object[topo->GetExtraInput(i)], key)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}} // namespace ppl::nn
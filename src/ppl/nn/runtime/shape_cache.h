@@ -0,0 +1,79 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_RUNTIME_SHAPE_CACHE_H_
+#define _ST_HPC_PPL_NN_RUNTIME_SHAPE_CACHE_H_
+
+#include "ppl/nn/ir/graph_topo.h"
+#include "ppl/nn/common/tensor_shape.h"
+#include "ppl/nn/runtime/runtime_graph_resource.h"
+#include <map>
+#include <vector>
+
+namespace ppl { namespace nn {
+
+/**
+   @class ShapeCache
+   @brief caches shapes of all tensors in a graph for each signature of input shapes,
+   so that kernels can skip reshaping when the same input shapes appear again.
+*/
+class ShapeCache final {
+public:
+    ShapeCache(uint32_t max_entry_num = 16) : max_entry_num_(max_entry_num) {}
+
+    /**
+       @brief tells whether shapes of all tensors in `topo` are determined by shapes of its inputs only.
+       @note ops unknown to the cache, e.g. custom ops, are treated as depending on values of their inputs.
+    */
+    static bool IsApplicable(const ir::GraphTopo* topo);
+
+    /**
+       @brief generates the signature of input shapes.
+       @return false if any of the inputs is not a tensor.
+    */
+    static bool GenerateKey(const ir::GraphTopo*, const RuntimeGraphResource&, std::vector<int64_t>* key);
+
+    /** @brief returns shapes indexed by edge ids, or nullptr if `key` is not found. */
+    const std::vector<TensorShape>* Find(const std::vector<int64_t>& key) const {
+        auto ref = entries_.find(key);
+        if (ref == entries_.end()) {
+            return nullptr;
+        }
+        return &ref->second;
+    }
+
+    /** @return false if the cache is full. */
+    bool Insert(std::vector<int64_t>&& key, std::vector<TensorShape>&& shapes) {
+        if (entries_.size() >= max_entry_num_) {
+            return false;
+        }
+        entries_.insert(std::make_pair(std::move(key), std::move(shapes)));
+        return true;
+    }
+
+    uint32_t GetEntryCount() const {
+        return entries_.size();
+    }
+
+private:
+    uint32_t max_entry_num_;
+    std::map<std::vector<int64_t>, std::vector<TensorShape>> entries_;
+};
+
+}} // namespace ppl::nn
+
+#endif
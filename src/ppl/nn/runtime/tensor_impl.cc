@@ -17,13 +17,40 @@
 
 #include "ppl/nn/runtime/tensor_impl.h"
 #include "ppl/nn/common/logger.h"
+#include <atomic>
 using namespace std;
 using namespace ppl::common;
 
 namespace ppl { namespace nn {
 
+static std::atomic<uint64_t> g_generation_counter(0);
+
+void TensorImpl::UpdateGeneration() {
+    generation_ = ++g_generation_counter;
+}
+
 RetCode TensorImpl::ReallocBuffer() {
-    if (!buffer_info_.IsBufferOwner() && buffer_info_.GetBufferPtr()) {
+    UpdateGeneration();
+
+    if (bound_buffer_) {
+        auto device = buffer_info_.GetDevice();
+        auto shape = buffer_info_.GetShape();
+        // kernels may use aligned loads and non-temporal stores, e.g. _mm512_stream_ps, on buffers of the device
+        if (device && device->IsHostMemory() && (uintptr_t)bound_buffer_ % device->GetAlignment() == 0 &&
+            shape->GetDataType() == bound_desc_.GetDataType() &&
+            shape->GetDataFormat() == bound_desc_.GetDataFormat() &&
+            shape->GetBytesIncludingPadding() <= bound_desc_.GetBytesIncludingPadding()) {
+            buffer_info_.SetBuffer(BufferDesc(bound_buffer_));
+            return RC_SUCCESS;
+        }
+
+        // bound buffer cannot be used. falls back to a buffer allocated by device.
+        if (!buffer_info_.IsBufferOwner() && buffer_info_.GetBufferPtr() == bound_buffer_) {
+            buffer_info_.DetachBuffer();
+        }
+    }
+
+    if (!buffer_info_.IsBufferOwner() && !buffer_info_.IsBufferShared() && buffer_info_.GetBufferPtr()) {
         LOG(WARNING) << "tensor[" << GetName() << "] is not the buffer owner. ReallocBuffer() does nothing.";
         return RC_SUCCESS;
     }
@@ -36,6 +63,7 @@ RetCode TensorImpl::CopyToHost(void* dst) const {
 }
 
 RetCode TensorImpl::CopyFromHost(const void* src) {
+    UpdateGeneration();
     return buffer_info_.GetDevice()->CopyFromHost(&buffer_info_.GetBufferDesc(), src, *buffer_info_.GetShape());
 }
 
@@ -45,6 +73,7 @@ RetCode TensorImpl::ConvertToHost(void* dst, const TensorShape& dst_desc) const
 }
 
 RetCode TensorImpl::ConvertFromHost(const void* src, const TensorShape& src_desc) {
+    UpdateGeneration();
     auto converter = buffer_info_.GetDevice()->GetDataConverter();
     return converter->ConvertFromHost(&buffer_info_.GetBufferDesc(), *buffer_info_.GetShape(), src, src_desc);
 }
@@ -55,6 +55,11 @@ public:
         return buffer_info_.IsBufferOwner();
     }
 
+    /** @brief tells whether the buffer can be modified in place without affecting other tensors. */
+    bool IsBufferExclusive() const {
+        return buffer_info_.IsBufferExclusive();
+    }
+
     ppl::common::RetCode SetDevice(Device* dev) {
         return buffer_info_.SetDevice(dev);
     }
@@ -65,6 +70,7 @@ public:
 
     void SetBuffer(const BufferDesc& buf, Device* device = nullptr, bool is_buffer_owner = false) {
         buffer_info_.SetBuffer(buf, device, is_buffer_owner);
+        UpdateGeneration();
     }
 
     /**
@@ -72,8 +78,19 @@ public:
        @note this tensor will inherits the ownership of `another`.
     */
     void TransferBufferFrom(TensorImpl* another) {
-        buffer_info_.SetBuffer(another->GetBufferDesc(), another->GetDevice(), another->IsBufferOwner());
-        another->DetachBuffer();
+        buffer_info_.TransferBufferFrom(&another->buffer_info_);
+        UpdateGeneration();
+    }
+
+    /**
+       @brief makes this tensor a view of the buffer of `another` starting at `offset` bytes without copying.
+       old buffer of this tensor will be freed(or detached).
+       @note the buffer is reference-counted and is freed when the last tensor referring to it is freed. buffers not
+       owned by `another`(constants or caller-owned buffers, for example) are borrowed.
+    */
+    void ShareBufferFrom(TensorImpl* another, uint64_t offset = 0) {
+        buffer_info_.ShareBufferFrom(&another->buffer_info_, offset);
+        UpdateGeneration();
     }
 
     BufferDesc DetachBuffer() {
@@ -84,10 +101,33 @@ public:
         buffer_info_.FreeBuffer();
     }
 
+    /**
+       @brief ReallocBuffer() uses a caller-owned host buffer `buf` described by `desc` instead of allocating a new
+       one if the device of this tensor is host memory, `buf` is aligned to the alignment of the device, and the
+       shape of this tensor has the same data type and format as `desc` and fits in it.
+       @param buf nullptr unbinds the buffer.
+    */
+    void BindBuffer(void* buf, const TensorShape& desc) {
+        if (!buffer_info_.IsBufferOwner() && buffer_info_.GetBufferPtr() == bound_buffer_) {
+            buffer_info_.DetachBuffer();
+        }
+        bound_buffer_ = buf;
+        bound_desc_ = desc;
+        UpdateGeneration();
+    }
+
+    void* GetBoundBuffer() const {
+        return bound_buffer_;
+    }
+    const TensorShape& GetBoundBufferDesc() const {
+        return bound_desc_;
+    }
+
     ppl::common::RetCode ReallocBuffer() override;
 
     void SetBufferPtr(void* ptr) override {
         buffer_info_.SetBuffer(BufferDesc(ptr));
+        UpdateGeneration();
     }
 
     void* GetBufferPtr() const override {
@@ -99,6 +139,11 @@ public:
         return buffer_info_.GetBufferPtr<T>();
     }
 
+    /** @brief refer to `BufferInfo::GetManagedBufferPtr()` for details. */
+    void* GetManagedBufferPtr() const {
+        return buffer_info_.GetManagedBufferPtr();
+    }
+
     BufferDesc& GetBufferDesc() {
         return buffer_info_.GetBufferDesc();
     }
@@ -116,10 +161,28 @@ public:
     ppl::common::RetCode ConvertToHost(void* dst, const TensorShape& dst_desc) const override;
     ppl::common::RetCode ConvertFromHost(const void* src, const TensorShape& src_desc) override;
 
+    /**
+       @brief returns a value that changes whenever the buffer of this tensor is replaced, reallocated or written
+       via this class. generations are unique among all tensors, so kernels can use it to tell whether data derived
+       from this tensor(converted weights, for example) is out of date.
+       @note writing to the buffer directly via `GetBufferPtr()` is not tracked.
+    */
+    uint64_t GetGeneration() const {
+        return generation_;
+    }
+
+private:
+    void UpdateGeneration();
+
 private:
     tensortype_t type_;
     TensorBufferInfo buffer_info_;
 
+    void* bound_buffer_ = nullptr;
+    TensorShape bound_desc_;
+
+    uint64_t generation_ = 0;
+
 private:
     TensorImpl(const TensorImpl&) = delete;
     TensorImpl& operator=(const TensorImpl&) = delete;
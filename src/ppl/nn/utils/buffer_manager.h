@@ -36,6 +36,11 @@ public:
     virtual void Free(BufferDesc* buffer) = 0;
     virtual uint64_t GetAllocatedBytes() const = 0;
 
+    /** @brief max bytes handed out at the same time. managers that do not track it return allocated bytes. */
+    virtual uint64_t GetPeakUsedBytes() const {
+        return GetAllocatedBytes();
+    }
+
 private:
     const std::string name_;
 };
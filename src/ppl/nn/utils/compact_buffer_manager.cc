@@ -29,6 +29,7 @@ static inline uint64_t Align(uint64_t x, uint64_t n) {
 RetCode CompactBufferManager::Realloc(uint64_t bytes, BufferDesc* buffer) {
     if (buffer->addr) {
         mgr_.Free(buffer->addr, buffer->desc);
+        used_bytes_ -= buffer->desc;
     }
 
     if (bytes == 0) {
@@ -45,12 +46,17 @@ RetCode CompactBufferManager::Realloc(uint64_t bytes, BufferDesc* buffer) {
     }
 
     buffer->desc = bytes;
+    used_bytes_ += bytes;
+    if (used_bytes_ > peak_used_bytes_) {
+        peak_used_bytes_ = used_bytes_;
+    }
     return RC_SUCCESS;
 }
 
 void CompactBufferManager::Free(BufferDesc* buffer) {
     if (buffer->addr) {
         mgr_.Free(buffer->addr, buffer->desc);
+        used_bytes_ -= buffer->desc;
         buffer->addr = nullptr;
     }
 }
@@ -49,11 +49,26 @@ public:
         return mgr_.GetAllocatedBytes();
     }
 
+    /** @brief bytes handed out and not freed yet. */
+    uint64_t GetUsedBytes() const {
+        return used_bytes_;
+    }
+
+    /**
+       @brief max bytes handed out at the same time. `GetAllocatedBytes() - GetPeakUsedBytes()` is the memory lost to
+       fragmentation.
+    */
+    uint64_t GetPeakUsedBytes() const override {
+        return peak_used_bytes_;
+    }
+
     ppl::common::RetCode Realloc(uint64_t bytes, BufferDesc* buffer) override;
     void Free(BufferDesc* buffer) override;
 
 private:
     uint64_t alignment_;
+    uint64_t used_bytes_ = 0;
+    uint64_t peak_used_bytes_ = 0;
     ppl::common::CompactMemoryManager mgr_;
 };
 
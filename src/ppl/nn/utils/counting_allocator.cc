@@ -0,0 +1,54 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/utils/counting_allocator.h"
+using namespace std;
+
+namespace ppl { namespace nn { namespace utils {
+
+void* CountingAllocator::Alloc(uint64_t bytes) {
+    auto ptr = base_->Alloc(bytes);
+    if (ptr) {
+        lock_guard<mutex> lck(mutex_);
+        addr2size_.insert(make_pair(ptr, bytes));
+        allocated_bytes_ += bytes;
+    }
+    return ptr;
+}
+
+void CountingAllocator::Free(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+
+    {
+        lock_guard<mutex> lck(mutex_);
+        auto ref = addr2size_.find(ptr);
+        if (ref != addr2size_.end()) {
+            allocated_bytes_ -= ref->second;
+            addr2size_.erase(ref);
+        }
+    }
+    base_->Free(ptr);
+}
+
+uint64_t CountingAllocator::GetAllocatedBytes() const {
+    lock_guard<mutex> lck(mutex_);
+    return allocated_bytes_;
+}
+
+}}} // namespace ppl::nn::utils
@@ -0,0 +1,59 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_UTILS_COUNTING_ALLOCATOR_H_
+#define _ST_HPC_PPL_NN_UTILS_COUNTING_ALLOCATOR_H_
+
+#include "ppl/common/allocator.h"
+#include <unordered_map>
+#include <mutex>
+
+namespace ppl { namespace nn { namespace utils {
+
+/**
+   @brief an allocator that forwards requests to another allocator and records how many bytes are still in use.
+   it is meant for allocations that are few and long-lived, such as converted weights of kernels.
+*/
+class CountingAllocator final : public ppl::common::Allocator {
+public:
+    /** @note `base` is not owned by this allocator. */
+    CountingAllocator(ppl::common::Allocator* base = nullptr) : base_(base) {}
+
+    /** @note MUST be called before any allocation. */
+    void SetBase(ppl::common::Allocator* base) {
+        base_ = base;
+    }
+
+    void* Alloc(uint64_t bytes) override;
+    void Free(void* ptr) override;
+
+    uint64_t GetAllocatedBytes() const;
+
+private:
+    ppl::common::Allocator* base_;
+    mutable std::mutex mutex_;
+    uint64_t allocated_bytes_ = 0;
+    std::unordered_map<void*, uint64_t> addr2size_;
+
+private:
+    CountingAllocator(const CountingAllocator&) = delete;
+    void operator=(const CountingAllocator&) = delete;
+};
+
+}}} // namespace ppl::nn::utils
+
+#endif
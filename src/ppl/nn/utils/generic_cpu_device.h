@@ -26,7 +26,7 @@ namespace ppl { namespace nn { namespace utils {
 
 class GenericCpuDevice final : public Device {
 public:
-    GenericCpuDevice(uint64_t alignment = 64) : allocator_(alignment) {}
+    GenericCpuDevice(uint64_t alignment = 64) : alignment_(alignment), allocator_(alignment) {}
 
     ppl::common::RetCode Realloc(uint64_t bytes, BufferDesc*) override;
     ppl::common::RetCode Realloc(const TensorShape&, BufferDesc*) override final;
@@ -44,6 +44,14 @@ public:
         return &data_converter_;
     }
 
+    bool IsHostMemory() const override final {
+        return true;
+    }
+
+    uint64_t GetAlignment() const override final {
+        return alignment_;
+    }
+
     const char* GetType() const override {
         return "cpu";
     }
@@ -53,6 +61,7 @@ public:
     }
 
 private:
+    const uint64_t alignment_;
     mutable ppl::common::GenericCpuAllocator allocator_;
     GenericCpuDataConverter data_converter_;
 };
@@ -19,7 +19,9 @@
 #define _ST_HPC_PPL_NN_UTILS_SHARED_RESOURCE_H_
 
 #include "ppl/nn/engines/engine_impl.h"
+#include "ppl/nn/optimizers/graph_optimizer.h"
 #include "ppl/nn/optimizers/graph_partitioner.h"
+#include "ppl/nn/utils/startup_profiler.h"
 #include <memory>
 #include <vector>
 
@@ -29,6 +31,8 @@ struct SharedResource final {
     std::vector<EngineImpl*> engines; // engines are allocated/freed by the caller
     std::shared_ptr<GraphPartitioner> graph_partitioner;
     std::set<edgeid_t> reserved_edgeids;
+    GraphOptimizerOptions graph_optimizer_options;
+    StartupProfiler* startup_profiler = nullptr; // optional
 };
 
 }}} // namespace ppl::nn::utils
@@ -0,0 +1,101 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/utils/startup_profiler.h"
+#include "ppl/nn/common/logger.h"
+#ifdef __linux__
+#include <stdio.h>
+#include <string.h>
+#endif
+using namespace std;
+using namespace ppl::common;
+
+namespace ppl { namespace nn { namespace utils {
+
+static void GetMemoryUsage(uint64_t* memory_bytes, uint64_t* peak_memory_bytes) {
+    *memory_bytes = 0;
+    *peak_memory_bytes = 0;
+#ifdef __linux__
+    FILE* fp = fopen("/proc/self/status", "r");
+    if (!fp) {
+        return;
+    }
+
+    char line[128];
+    unsigned long long value_kb;
+    while (fgets(line, sizeof(line), fp)) {
+        if (strncmp(line, "VmRSS:", 6) == 0 && sscanf(line + 6, "%llu", &value_kb) == 1) {
+            *memory_bytes = value_kb * 1024;
+        } else if (strncmp(line, "VmHWM:", 6) == 0 && sscanf(line + 6, "%llu", &value_kb) == 1) {
+            *peak_memory_bytes = value_kb * 1024;
+        }
+    }
+    fclose(fp);
+#endif
+}
+
+void StartupProfiler::BeginStage(const string& name) {
+    StartupStageInfo info;
+    info.name = name;
+    info.depth = running_stages_.size();
+    info.exec_microseconds = 0;
+    info.memory_bytes = 0;
+    info.memory_delta_bytes = 0;
+    info.process_peak_memory_bytes = 0;
+
+    RunningStage stage;
+    stage.idx = stage_info_.size();
+    stage_info_.emplace_back(std::move(info));
+
+    uint64_t peak_memory_bytes;
+    GetMemoryUsage(&stage.begin_memory_bytes, &peak_memory_bytes);
+
+    stage.begin_ts = std::chrono::steady_clock::now();
+    running_stages_.push_back(stage);
+}
+
+void StartupProfiler::EndStage() {
+    if (running_stages_.empty()) {
+        LOG(WARNING) << "EndStage() is called without a running stage.";
+        return;
+    }
+
+    auto end_ts = std::chrono::steady_clock::now();
+    auto& stage = running_stages_.back();
+    auto& info = stage_info_[stage.idx];
+    info.exec_microseconds = std::chrono::duration_cast<std::chrono::microseconds>(end_ts - stage.begin_ts).count();
+    GetMemoryUsage(&info.memory_bytes, &info.process_peak_memory_bytes);
+    info.memory_delta_bytes = (int64_t)info.memory_bytes - (int64_t)stage.begin_memory_bytes;
+    running_stages_.pop_back();
+}
+
+void StartupProfiler::Clear() {
+    stage_info_.clear();
+    running_stages_.clear();
+}
+
+RetCode StartupProfiler::GetStatistics(StartupProfilingStatistics* stat) const {
+    if (!running_stages_.empty()) {
+        LOG(ERROR) << "stage[" << stage_info_[running_stages_.back().idx].name << "] is still running.";
+        return RC_INVALID_VALUE;
+    }
+
+    stat->stage_info = stage_info_;
+    return RC_SUCCESS;
+}
+
+}}} // namespace ppl::nn::utils
@@ -0,0 +1,81 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_UTILS_STARTUP_PROFILER_H_
+#define _ST_HPC_PPL_NN_UTILS_STARTUP_PROFILER_H_
+
+#include "ppl/common/retcode.h"
+#include "ppl/nn/common/startup_profiling_statistics.h"
+#include <chrono>
+
+namespace ppl { namespace nn { namespace utils {
+
+/** @brief records time and memory usage of each stage when building runtimes. */
+class StartupProfiler final {
+public:
+    void SetEnabled(bool enabled) {
+        enabled_ = enabled;
+    }
+    bool IsEnabled() const {
+        return enabled_;
+    }
+
+    /** @brief stages begun before the matching `EndStage()` are recorded as sub-stages. */
+    void BeginStage(const std::string& name);
+    void EndStage();
+
+    void Clear();
+    ppl::common::RetCode GetStatistics(StartupProfilingStatistics*) const;
+
+private:
+    struct RunningStage final {
+        uint32_t idx; // index in `stage_info_`
+        uint64_t begin_memory_bytes;
+        std::chrono::time_point<std::chrono::steady_clock> begin_ts;
+    };
+
+    bool enabled_ = false;
+    std::vector<StartupStageInfo> stage_info_;
+    std::vector<RunningStage> running_stages_;
+};
+
+/** @brief records a stage named `name` or `name:detail` until it is destroyed. does nothing if `p` is disabled. */
+class StartupStageGuard final {
+public:
+    StartupStageGuard(StartupProfiler* p, const char* name, const std::string& detail = std::string())
+        : profiler_((p && p->IsEnabled()) ? p : nullptr) {
+        if (profiler_) {
+            profiler_->BeginStage(detail.empty() ? std::string(name) : std::string(name) + ":" + detail);
+        }
+    }
+    ~StartupStageGuard() {
+        if (profiler_) {
+            profiler_->EndStage();
+        }
+    }
+
+private:
+    StartupProfiler* profiler_;
+
+private:
+    StartupStageGuard(const StartupStageGuard&) = delete;
+    StartupStageGuard& operator=(const StartupStageGuard&) = delete;
+};
+
+}}} // namespace ppl::nn::utils
+
+#endif
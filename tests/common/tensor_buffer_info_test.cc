@@ -52,3 +52,74 @@ TEST(TensorBufferInfoTest, setbuffer) {
     EXPECT_EQ(nullptr, info.GetBufferPtr());
     device.Free(&buf);
 }
+
+TEST(TensorBufferInfoTest, sharebuffer) {
+    utils::GenericCpuDevice device;
+    auto src = GenRandomTensorBufferInfo(&device);
+    auto base = src.GetBufferPtr<char>();
+    EXPECT_TRUE(src.IsBufferOwner());
+    EXPECT_TRUE(src.IsBufferExclusive());
+
+    TensorBufferInfo view;
+    view.ShareBufferFrom(&src, 64);
+    EXPECT_EQ(base + 64, view.GetBufferPtr<char>());
+    EXPECT_TRUE(src.IsBufferShared());
+    EXPECT_FALSE(src.IsBufferExclusive());
+    EXPECT_FALSE(view.IsBufferExclusive());
+
+    // the buffer is still alive after `src` is freed
+    src.FreeBuffer();
+    EXPECT_EQ(nullptr, src.GetBufferPtr());
+    EXPECT_TRUE(view.IsBufferExclusive());
+    view.GetBufferPtr<char>()[0] = 1;
+
+    // the last reference with an offset cannot be reused
+    EXPECT_EQ(RC_SUCCESS, view.ReallocBuffer());
+    EXPECT_TRUE(view.IsBufferOwner());
+    EXPECT_FALSE(view.IsBufferShared());
+    view.FreeBuffer();
+}
+
+TEST(TensorBufferInfoTest, sharebuffer_borrowed) {
+    utils::GenericCpuDevice device;
+    BufferDesc buffer;
+    device.Realloc(1000, &buffer);
+
+    TensorBufferInfo src;
+    src.SetBuffer(buffer, &device, false);
+
+    TensorBufferInfo view;
+    view.ShareBufferFrom(&src);
+    EXPECT_EQ(buffer.addr, view.GetBufferPtr());
+    EXPECT_FALSE(src.IsBufferShared());
+    EXPECT_TRUE(view.IsBufferShared());
+    EXPECT_FALSE(view.IsBufferExclusive());
+
+    // borrowed buffers are not freed by views
+    view.FreeBuffer();
+    EXPECT_EQ(buffer.addr, src.GetBufferPtr());
+    device.Free(&buffer);
+}
+
+TEST(TensorBufferInfoTest, transfer_sharedbuffer) {
+    utils::GenericCpuDevice device;
+    auto src = GenRandomTensorBufferInfo(&device);
+    auto base = src.GetBufferPtr();
+
+    TensorBufferInfo view, dst;
+    view.ShareBufferFrom(&src);
+    dst.TransferBufferFrom(&view);
+    EXPECT_EQ(nullptr, view.GetBufferPtr());
+    EXPECT_FALSE(view.IsBufferShared());
+    EXPECT_EQ(base, dst.GetBufferPtr());
+    EXPECT_TRUE(dst.IsBufferShared());
+
+    dst.FreeBuffer();
+    EXPECT_TRUE(src.IsBufferExclusive());
+
+    // takes the last reference back and becomes the owner again
+    EXPECT_EQ(RC_SUCCESS, src.ReallocBuffer());
+    EXPECT_TRUE(src.IsBufferOwner());
+    EXPECT_FALSE(src.IsBufferShared());
+    src.FreeBuffer();
+}
@@ -0,0 +1,208 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/engines/x86/kernels/onnx/conv2d_dynamic_kernel.h"
+#include "ppl/nn/runtime/kernel_exec_context.h"
+#include "tests/ir/graph_builder.h"
+#include "gtest/gtest.h"
+#include <memory>
+#include <vector>
+using namespace std;
+using namespace ppl::nn;
+using namespace ppl::nn::x86;
+using namespace ppl::nn::test;
+using namespace ppl::common;
+
+static const int64_t g_batch = 1;
+static const int64_t g_channels = 16;
+static const int64_t g_num_output = 32;
+static const int64_t g_height = 6;
+static const int64_t g_width = 6;
+
+// 3x3 conv with pads 1, in which the weight `w` and the bias `b` are inputs of the graph
+class Conv2dDynamicKernelTest : public testing::Test {
+protected:
+    void SetUp() override {
+        builder_.AddNode("conv", ir::Node::Type("", "Conv", 1), {"x", "w", "b"}, {"y"});
+        builder_.Finalize();
+
+        param_.group = 1;
+        param_.kernel_shape = {3, 3};
+        param_.dilations = {1, 1};
+        param_.strides = {1, 1};
+        param_.pads = {1, 1, 1, 1};
+
+        auto topo = builder_.GetGraph()->topo.get();
+        objects_.resize(topo->GetMaxEdgeId());
+        for (auto it = topo->CreateEdgeIter(); it->IsValid(); it->Forward()) {
+            auto edge = it->Get();
+            objects_[edge->GetId()].reset(new TensorImpl(edge, TENSORTYPE_NORMAL));
+        }
+
+        x_data_ = GenData(g_batch * g_channels * g_height * g_width, 1);
+        w_data_ = GenData(g_num_output * g_channels * 9, 2);
+        b_data_ = GenData(g_num_output, 3);
+    }
+
+    void TearDown() override {
+        kernel_.reset();
+        for (auto x = objects_.begin(); x != objects_.end(); ++x) {
+            if (*x) {
+                (*x)->FreeBuffer();
+            }
+        }
+    }
+
+    static vector<float> GenData(uint64_t size, uint32_t seed) {
+        vector<float> data(size);
+        for (uint64_t i = 0; i < size; ++i) {
+            seed = seed * 1103515245 + 12345;
+            data[i] = (float)((seed >> 16) % 2001) / 1000.0f - 1.0f;
+        }
+        return data;
+    }
+
+    TensorImpl* GetObject(const string& name) {
+        return objects_[builder_.GetGraph()->topo->GetEdge(name)->GetId()].get();
+    }
+
+    void SetTensor(const string& name, const vector<int64_t>& dims, dataformat_t format) {
+        auto tensor = GetObject(name);
+        auto shape = tensor->GetShape();
+        shape->SetDataType(DATATYPE_FLOAT32);
+        shape->SetDataFormat(format);
+        shape->Reshape(dims);
+        tensor->SetDevice(device_.get());
+    }
+
+    // `x` and `y` are in `format`
+    void InitTensors(dataformat_t format, isa_t isa) {
+        device_.reset(new X86Device(64, isa));
+        SetTensor("x", {g_batch, g_channels, g_height, g_width}, format);
+        SetTensor("w", {g_num_output, g_channels, 3, 3}, DATAFORMAT_NDARRAY);
+        SetTensor("b", {g_num_output}, DATAFORMAT_NDARRAY);
+        SetTensor("y", {g_batch, g_num_output, g_height, g_width}, format);
+        CopyFrom("x", x_data_);
+        CopyFrom("w", w_data_);
+        CopyFrom("b", b_data_);
+
+        kernel_.reset(new Conv2dDynamicKernel(builder_.GetGraph()->topo->GetNode("conv")));
+        kernel_->SetParam(&param_);
+        kernel_->SetDevice(device_.get());
+    }
+
+    // `data` is in ndarray
+    void CopyFrom(const string& name, const vector<float>& data) {
+        auto tensor = GetObject(name);
+        auto shape = tensor->GetShape();
+        vector<float> buffer(shape->GetElementsIncludingPadding(), 0.0f);
+        for (uint64_t i = 0; i < data.size(); ++i) {
+            buffer[ToFormat(*shape, i)] = data[i];
+        }
+        ASSERT_EQ(RC_SUCCESS, tensor->ReallocBuffer());
+        ASSERT_EQ(RC_SUCCESS, tensor->CopyFromHost(buffer.data()));
+    }
+
+    // maps offset `i` of the ndarray layout to the one of the layout of `shape`
+    static uint64_t ToFormat(const TensorShape& shape, uint64_t i) {
+        if (shape.GetDataFormat() != DATAFORMAT_N16CX) {
+            return i;
+        }
+        const uint64_t channels = shape.GetDim(1);
+        const uint64_t spatial = shape.GetDim(2) * shape.GetDim(3);
+        const uint64_t padded_channels = (channels + 15) / 16 * 16;
+        const uint64_t n = i / (channels * spatial);
+        const uint64_t c = i / spatial % channels;
+        const uint64_t s = i % spatial;
+        return n * padded_channels * spatial + (c / 16) * spatial * 16 + s * 16 + c % 16;
+    }
+
+    RetCode Execute() {
+        KernelExecContext ctx;
+        ctx.SetNode(kernel_->GetNode());
+        ctx.SetAcquireFunc([this](edgeid_t eid, uint32_t) -> EdgeObject* {
+            return objects_[eid].get();
+        });
+        ctx.SetOutputShapesReady(true);
+        return kernel_->Execute(&ctx);
+    }
+
+    void CheckOutput(const vector<float>& w_data) {
+        auto y = GetObject("y");
+        auto y_data = y->GetBufferPtr<float>();
+        for (int64_t n = 0; n < g_batch; ++n) {
+            for (int64_t oc = 0; oc < g_num_output; ++oc) {
+                for (int64_t oh = 0; oh < g_height; ++oh) {
+                    for (int64_t ow = 0; ow < g_width; ++ow) {
+                        float expected = b_data_[oc];
+                        for (int64_t ic = 0; ic < g_channels; ++ic) {
+                            for (int64_t kh = 0; kh < 3; ++kh) {
+                                for (int64_t kw = 0; kw < 3; ++kw) {
+                                    const int64_t ih = oh + kh - 1;
+                                    const int64_t iw = ow + kw - 1;
+                                    if (ih < 0 || ih >= g_height || iw < 0 || iw >= g_width) {
+                                        continue;
+                                    }
+                                    expected += x_data_[((n * g_channels + ic) * g_height + ih) * g_width + iw] *
+                                        w_data[((oc * g_channels + ic) * 3 + kh) * 3 + kw];
+                                }
+                            }
+                        }
+                        const uint64_t i = ((n * g_num_output + oc) * g_height + oh) * g_width + ow;
+                        ASSERT_NEAR(expected, y_data[ToFormat(*y->GetShape(), i)], 1e-3)
+                            << "y[" << n << ", " << oc << ", " << oh << ", " << ow << "]";
+                    }
+                }
+            }
+        }
+    }
+
+    // runs twice with weights updated in between
+    void RunAndCheck(dataformat_t format, isa_t isa) {
+        InitTensors(format, isa);
+        ASSERT_EQ(RC_SUCCESS, Execute());
+        CheckOutput(w_data_);
+
+        // converted weights are not reused after the content of `w` changes
+        auto new_w_data = GenData(w_data_.size(), 4);
+        CopyFrom("w", new_w_data);
+        ASSERT_EQ(RC_SUCCESS, Execute());
+        CheckOutput(new_w_data);
+    }
+
+protected:
+    GraphBuilder builder_;
+    ppl::nn::onnx::ConvParam param_;
+    unique_ptr<X86Device> device_;
+    unique_ptr<Conv2dDynamicKernel> kernel_;
+    vector<unique_ptr<TensorImpl>> objects_;
+    vector<float> x_data_, w_data_, b_data_;
+};
+
+TEST_F(Conv2dDynamicKernelTest, ndarray) {
+    RunAndCheck(DATAFORMAT_NDARRAY, ISA_X86_FMA | ISA_X86_AVX | ISA_X86_SSE);
+}
+
+TEST_F(Conv2dDynamicKernelTest, n16cx) {
+    RunAndCheck(DATAFORMAT_N16CX, ISA_X86_FMA | ISA_X86_AVX | ISA_X86_SSE);
+}
+
+// only the ndarray kernel is left if no optimized algorithm is available
+TEST_F(Conv2dDynamicKernelTest, n16cx_without_algo) {
+    InitTensors(DATAFORMAT_N16CX, ISA_UNKNOWN);
+    EXPECT_EQ(RC_UNSUPPORTED, Execute());
+}
@@ -0,0 +1,400 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/engines/x86/optimizer/rules/eliminate_concat.h"
+#include "ppl/nn/engines/x86/optimizer/ops/onnx/concat_op.h"
+#include "ppl/nn/engines/x86/kernel.h"
+#include "ppl/nn/runtime/kernel_exec_context.h"
+#include "ppl/nn/runtime/activation_spiller.h"
+#include "ppl/nn/params/onnx/concat_param.h"
+#include "tests/ir/graph_builder.h"
+#include "gtest/gtest.h"
+#include <map>
+#include <set>
+#include <vector>
+using namespace std;
+using namespace ppl::nn;
+using namespace ppl::nn::x86;
+using namespace ppl::nn::test;
+using namespace ppl::common;
+
+/** fills outputs with `value` */
+class FillKernel final : public X86Kernel {
+public:
+    FillKernel(const ir::Node* node, float value) : X86Kernel(node), value_(value) {}
+
+private:
+    RetCode DoExecute(KernelExecContext* ctx) override {
+        for (uint32_t i = 0; i < ctx->GetOutputCount(); ++i) {
+            auto output = ctx->GetOutput<TensorImpl>(i);
+            PPLNN_X86_REALLOC_TENSOR_BUFFER(output);
+            auto data = output->GetBufferPtr<float>();
+            for (uint64_t j = 0; j < output->GetShape()->GetElementsIncludingPadding(); ++j) {
+                data[j] = value_;
+            }
+        }
+        return RC_SUCCESS;
+    }
+
+private:
+    const float value_;
+};
+
+/** adds 1 to its input in place, like element-wise kernels reusing buffers of inputs they consume last */
+class InplaceKernel final : public X86Kernel {
+public:
+    InplaceKernel(const ir::Node* node) : X86Kernel(node) {}
+
+private:
+    RetCode DoExecute(KernelExecContext* ctx) override {
+        auto input = ctx->GetInput<TensorImpl>(0);
+        auto output = ctx->GetOutput<TensorImpl>(0);
+        output->TransferBufferFrom(input);
+        auto data = output->GetBufferPtr<float>();
+        for (uint64_t j = 0; j < output->GetShape()->GetElementsIncludingPadding(); ++j) {
+            data[j] += 1;
+        }
+        return RC_SUCCESS;
+    }
+};
+
+class TestOp final : public X86OptKernel {
+public:
+    TestOp(const ir::Node* node, bool inplace, float value) : X86OptKernel(node), inplace_(inplace), value_(value) {}
+    RetCode Init(const OptKernelOptions&) override {
+        return RC_SUCCESS;
+    }
+    KernelImpl* CreateKernelImpl() const override {
+        X86Kernel* kernel;
+        if (inplace_) {
+            kernel = new InplaceKernel(GetNode());
+        } else {
+            kernel = new FillKernel(GetNode(), value_);
+        }
+        kernel->SetCommonParam(&common_param_);
+        return kernel;
+    }
+
+private:
+    const bool inplace_;
+    const float value_;
+};
+
+/*
+  every producer named `a`, `b`, `c`... fills its output with 1, 2, 3... except those in `inplace_nodes_` which add 1
+  to their inputs. 16 channels of fp32 keep the views aligned. concat outputs are consumed by `e` because outputs of
+  the graph are never eliminated.
+*/
+class EliminateConcatTest : public testing::Test {
+protected:
+    EliminateConcatTest() : device_(64, ISA_UNKNOWN) {}
+
+    ~EliminateConcatTest() {
+        for (auto x = objects_.begin(); x != objects_.end(); ++x) {
+            if (*x) {
+                (*x)->FreeBuffer();
+            }
+        }
+    }
+
+    void Init() {
+        builder_.Finalize();
+        auto graph = builder_.GetGraph();
+        auto topo = graph->topo.get();
+        set<edgeid_t> io_edgeids;
+        for (uint32_t i = 0; i < topo->GetInputCount(); ++i) {
+            io_edgeids.insert(topo->GetInput(i));
+        }
+        for (uint32_t i = 0; i < topo->GetOutputCount(); ++i) {
+            io_edgeids.insert(topo->GetOutput(i));
+        }
+
+        objects_.resize(topo->GetMaxEdgeId());
+        for (auto it = topo->CreateEdgeIter(); it->IsValid(); it->Forward()) {
+            auto edge = it->Get();
+            auto type = (io_edgeids.find(edge->GetId()) == io_edgeids.end()) ? TENSORTYPE_NORMAL : TENSORTYPE_RESERVED;
+            tensors_[edge->GetId()].reset(new TensorImpl(edge, type));
+            objects_[edge->GetId()].reset(new TensorImpl(edge, TENSORTYPE_NORMAL));
+            SetShape(tensors_[edge->GetId()].get());
+        }
+
+        options_.graph_topo = topo;
+        options_.graph_data = graph->data.get();
+        options_.device = &device_;
+        options_.info = &info_;
+        options_.tensors = &tensors_;
+
+        for (auto it = topo->CreateNodeIter(); it->IsValid(); it->Forward()) {
+            auto node = it->Get();
+            X86OptKernel* op;
+            if (node->GetType().name == "Concat") {
+                auto param = make_shared<ppl::nn::onnx::ConcatParam>();
+                param->axis = 1;
+                graph->data->attrs[node->GetId()] = param;
+                op = new ConcatOp(node);
+            } else {
+                bool inplace = (inplace_nodes_.find(node->GetName()) != inplace_nodes_.end());
+                op = new TestOp(node, inplace, node->GetName()[0] - 'a' + 1);
+            }
+            info_.kernels[node->GetId()].reset(op);
+            ASSERT_EQ(RC_SUCCESS, op->Init(options_));
+        }
+
+        // inputs are not used by test kernels but cannot be empty
+        auto input = objects_[topo->GetInput(0)].get();
+        input->SetDevice(&device_);
+        ASSERT_EQ(RC_SUCCESS, input->ReallocBuffer());
+    }
+
+    // spills activations exceeding `budget_bytes` after each node like runtimes with a memory budget
+    void EnableSpiller(uint64_t budget_bytes) {
+        auto topo = builder_.GetGraph()->topo.get();
+        vector<nodeid_t> sorted_nodes;
+        for (auto it = topo->CreateNodeIter(); it->IsValid(); it->Forward()) {
+            sorted_nodes.push_back(it->Get()->GetId());
+        }
+        ASSERT_EQ(RC_SUCCESS, aux_info_.Init(topo, {}, std::move(sorted_nodes)));
+
+        graph_.edgeid2object.resize(objects_.size(), nullptr);
+        for (uint32_t i = 0; i < objects_.size(); ++i) {
+            graph_.edgeid2object[i] = objects_[i].get();
+        }
+
+        spiller_.reset(new ActivationSpiller(budget_bytes));
+        ASSERT_EQ(RC_SUCCESS, spiller_->Init(topo, &aux_info_));
+    }
+
+    void SetShape(TensorImpl* tensor) const {
+        auto shape = tensor->GetShape();
+        shape->SetDataType(DATATYPE_FLOAT32);
+        shape->SetDataFormat(DATAFORMAT_NDARRAY);
+        auto ref = dims_.find(tensor->GetName());
+        if (ref == dims_.end()) {
+            shape->Reshape({1, 16, 2, 2});
+        } else {
+            shape->Reshape(ref->second);
+        }
+    }
+
+    // runs nodes in topological order like the scheduler. intermediate tensors are freed unless `keep` is true.
+    void Run(bool keep = false) {
+        auto topo = builder_.GetGraph()->topo.get();
+        for (auto x = objects_.begin(); x != objects_.end(); ++x) {
+            if (*x) {
+                SetShape(x->get());
+            }
+        }
+
+        if (kernels_.empty()) {
+            for (auto it = topo->CreateNodeIter(); it->IsValid(); it->Forward()) {
+                auto kernel = info_.kernels[it->Get()->GetId()]->CreateKernelImpl();
+                kernel->SetDevice(&device_);
+                kernels_.emplace_back(kernel);
+            }
+        }
+
+        if (spiller_) {
+            spiller_->Reset();
+        }
+        for (uint32_t pos = 0; pos < kernels_.size(); ++pos) {
+            if (spiller_) {
+                ASSERT_EQ(RC_SUCCESS, spiller_->BeforeExecute(pos, &graph_));
+            }
+            KernelExecContext ctx;
+            ctx.SetNode(kernels_[pos]->GetNode());
+            ctx.SetAcquireFunc([this](edgeid_t eid, uint32_t) -> EdgeObject* {
+                return objects_[eid].get();
+            });
+            ctx.SetOutputShapesReady(true);
+            ASSERT_EQ(RC_SUCCESS, kernels_[pos]->Execute(&ctx));
+            if (spiller_) {
+                ASSERT_EQ(RC_SUCCESS, spiller_->AfterExecute(pos, &graph_));
+            }
+        }
+
+        if (!keep) {
+            FreeIntermediateTensors();
+        }
+    }
+
+    void FreeIntermediateTensors() {
+        for (auto it = tensors_.begin(); it != tensors_.end(); ++it) {
+            if (it->second->GetType() == TENSORTYPE_NORMAL) {
+                objects_[it->first]->FreeBuffer();
+            }
+        }
+    }
+
+    TensorImpl* GetObject(const string& name) {
+        return objects_[builder_.GetGraph()->topo->GetEdge(name)->GetId()].get();
+    }
+
+    // `values` of each 16 * 2 * 2 elements of `name`
+    void CheckValues(const string& name, const vector<float>& values) {
+        auto tensor = GetObject(name);
+        ASSERT_EQ(values.size() * 64, tensor->GetShape()->GetElementsIncludingPadding());
+        auto data = tensor->GetBufferPtr<float>();
+        for (uint32_t i = 0; i < values.size() * 64; ++i) {
+            ASSERT_EQ(values[i / 64], data[i]) << "element [" << i << "] of [" << name << "]";
+        }
+    }
+
+    bool IsInConcatOutput(const string& name, const string& concat_output_name, uint64_t offset) {
+        return (GetObject(name)->GetBufferPtr<char>() == GetObject(concat_output_name)->GetBufferPtr<char>() + offset);
+    }
+
+protected:
+    GraphBuilder builder_;
+    map<string, vector<int64_t>> dims_;
+    set<string> inplace_nodes_;
+
+    X86Device device_;
+    RuntimePartitionInfo info_;
+    map<edgeid_t, unique_ptr<TensorImpl>> tensors_;
+    OptKernelOptions options_;
+
+    vector<unique_ptr<TensorImpl>> objects_;
+    vector<unique_ptr<KernelImpl>> kernels_;
+
+    RuntimeAuxInfo aux_info_;
+    RuntimeGraphResource graph_;
+    unique_ptr<ActivationSpiller> spiller_;
+};
+
+TEST_F(EliminateConcatTest, write_into_concat_output) {
+    builder_.AddNode("a", ir::Node::Type("test", "op", 1), {"x"}, {"a_out"});
+    builder_.AddNode("b", ir::Node::Type("test", "op", 1), {"x"}, {"b_out"});
+    builder_.AddNode("concat", ir::Node::Type("", "Concat", 1), {"a_out", "b_out"}, {"out"});
+    builder_.AddNode("e", ir::Node::Type("test", "op", 1), {"out"}, {"e_out"});
+    dims_["out"] = {1, 32, 2, 2};
+    Init();
+    EXPECT_FALSE(EliminateConcat(options_));
+
+    for (uint32_t i = 0; i < 2; ++i) {
+        Run(true);
+        EXPECT_TRUE(IsInConcatOutput("a_out", "out", 0));
+        EXPECT_TRUE(IsInConcatOutput("b_out", "out", 256));
+        CheckValues("out", {1, 2});
+        FreeIntermediateTensors();
+    }
+}
+
+TEST_F(EliminateConcatTest, inplace_producer) {
+    builder_.AddNode("a", ir::Node::Type("test", "op", 1), {"x"}, {"a_out"});
+    builder_.AddNode("c", ir::Node::Type("test", "op", 1), {"x"}, {"c_out"});
+    builder_.AddNode("b", ir::Node::Type("test", "op", 1), {"c_out"}, {"b_out"});
+    builder_.AddNode("concat", ir::Node::Type("", "Concat", 1), {"a_out", "b_out"}, {"out"});
+    builder_.AddNode("e", ir::Node::Type("test", "op", 1), {"out"}, {"e_out"});
+    dims_["out"] = {1, 32, 2, 2};
+    inplace_nodes_.insert("b");
+    Init();
+    EliminateConcat(options_);
+
+    // `b` writes into the buffer of its input and concat copies it
+    Run(true);
+    EXPECT_TRUE(IsInConcatOutput("a_out", "out", 0));
+    EXPECT_FALSE(IsInConcatOutput("b_out", "out", 256));
+    CheckValues("out", {1, 4});
+}
+
+TEST_F(EliminateConcatTest, producer_consumed_elsewhere) {
+    builder_.AddNode("a", ir::Node::Type("test", "op", 1), {"x"}, {"a_out"});
+    builder_.AddNode("b", ir::Node::Type("test", "op", 1), {"x"}, {"b_out"});
+    builder_.AddNode("concat", ir::Node::Type("", "Concat", 1), {"a_out", "b_out"}, {"out"});
+    builder_.AddNode("e", ir::Node::Type("test", "op", 1), {"out"}, {"e_out"});
+    builder_.AddNode("d", ir::Node::Type("test", "op", 1), {"a_out"}, {"d_out"});
+    dims_["out"] = {1, 32, 2, 2};
+    Init();
+    EliminateConcat(options_);
+
+    Run(true);
+    EXPECT_FALSE(IsInConcatOutput("a_out", "out", 0));
+    EXPECT_FALSE(IsInConcatOutput("b_out", "out", 256));
+    CheckValues("out", {1, 2});
+}
+
+TEST_F(EliminateConcatTest, shapes_differ_from_plan) {
+    builder_.AddNode("a", ir::Node::Type("test", "op", 1), {"x"}, {"a_out"});
+    builder_.AddNode("b", ir::Node::Type("test", "op", 1), {"x"}, {"b_out"});
+    builder_.AddNode("concat", ir::Node::Type("", "Concat", 1), {"a_out", "b_out"}, {"out"});
+    builder_.AddNode("e", ir::Node::Type("test", "op", 1), {"out"}, {"e_out"});
+    dims_["out"] = {1, 32, 2, 2};
+    Init();
+    EliminateConcat(options_);
+    Run();
+
+    // `b` still writes into the planned place. concat copies both inputs into an output of the real shape.
+    dims_["a_out"] = {1, 32, 2, 2};
+    dims_["out"] = {1, 48, 2, 2};
+    Run(true);
+    EXPECT_FALSE(IsInConcatOutput("a_out", "out", 0));
+    CheckValues("out", {1, 1, 2});
+    FreeIntermediateTensors();
+
+    // views bound in the previous run are not reused
+    dims_.erase("a_out");
+    dims_["out"] = {1, 32, 2, 2};
+    Run(true);
+    EXPECT_TRUE(IsInConcatOutput("a_out", "out", 0));
+    EXPECT_TRUE(IsInConcatOutput("b_out", "out", 256));
+    CheckValues("out", {1, 2});
+}
+
+TEST_F(EliminateConcatTest, nested_concats) {
+    builder_.AddNode("a", ir::Node::Type("test", "op", 1), {"x"}, {"a_out"});
+    builder_.AddNode("b", ir::Node::Type("test", "op", 1), {"x"}, {"b_out"});
+    builder_.AddNode("concat1", ir::Node::Type("", "Concat", 1), {"a_out", "b_out"}, {"mid"});
+    builder_.AddNode("c", ir::Node::Type("test", "op", 1), {"x"}, {"c_out"});
+    builder_.AddNode("concat2", ir::Node::Type("", "Concat", 1), {"c_out", "mid"}, {"out"});
+    builder_.AddNode("e", ir::Node::Type("test", "op", 1), {"out"}, {"e_out"});
+    dims_["mid"] = {1, 32, 2, 2};
+    dims_["out"] = {1, 48, 2, 2};
+    Init();
+    EliminateConcat(options_);
+
+    // concat outputs of previous runs are freed and must not be written into
+    for (uint32_t i = 0; i < 3; ++i) {
+        Run(true);
+        EXPECT_TRUE(IsInConcatOutput("a_out", "mid", 0));
+        EXPECT_TRUE(IsInConcatOutput("c_out", "out", 0));
+        CheckValues("out", {3, 1, 2});
+        FreeIntermediateTensors();
+    }
+}
+
+TEST_F(EliminateConcatTest, memory_budget) {
+    builder_.AddNode("a", ir::Node::Type("test", "op", 1), {"x"}, {"a_out"});
+    builder_.AddNode("z", ir::Node::Type("test", "op", 1), {"x"}, {"z_out"});
+    builder_.AddNode("b", ir::Node::Type("test", "op", 1), {"x"}, {"b_out"});
+    builder_.AddNode("concat", ir::Node::Type("", "Concat", 1), {"a_out", "b_out"}, {"out"});
+    builder_.AddNode("e", ir::Node::Type("test", "op", 1), {"out", "z_out"}, {"e_out"});
+    dims_["out"] = {1, 32, 2, 2};
+    Init();
+    EliminateConcat(options_);
+    EnableSpiller(0);
+
+    // `out` is allocated by `a` but is not spilled before `concat` runs. only `z_out` is spilled.
+    for (uint32_t i = 0; i < 2; ++i) {
+        Run(true);
+        EXPECT_TRUE(IsInConcatOutput("a_out", "out", 0));
+        EXPECT_TRUE(IsInConcatOutput("b_out", "out", 256));
+        CheckValues("out", {1, 2});
+        CheckValues("z_out", {26});
+        FreeIntermediateTensors();
+    }
+    EXPECT_EQ(512, spiller_->GetSpilledBytes());
+}
@@ -0,0 +1,152 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/optimizers/fold_constant_optimizer.h"
+#include "ppl/nn/engines/x86/engine_factory.h"
+#include "ppl/nn/engines/x86/ops.h"
+#include "ppl/nn/engines/engine_impl.h"
+#include "ppl/nn/params/onnx/cast_param.h"
+#include "ppl/nn/params/onnx/concat_param.h"
+#include "ppl/nn/params/onnx/gather_param.h"
+#include "ppl/nn/params/onnx/transpose_param.h"
+#include "tests/ir/graph_builder.h"
+#include "gtest/gtest.h"
+#include <memory>
+#include <vector>
+using namespace std;
+using namespace ppl::nn;
+using namespace ppl::nn::test;
+using namespace ppl::common;
+
+// data of nodes is computed by kernels of the x86 engine
+class FoldConstantTest : public testing::Test {
+protected:
+    static void SetUpTestCase() {
+        x86::RegisterBuiltinOpImpls();
+    }
+
+    void SetUp() override {
+        engine_.reset(x86::EngineFactory::Create(x86::EngineOptions()));
+        engines_.push_back(static_cast<EngineImpl*>(engine_.get()));
+        options_.engines = &engines_;
+    }
+
+    template <typename T>
+    void SetConstant(const string& name, datatype_t data_type, const vector<int64_t>& dims, const vector<T>& values) {
+        auto graph = builder_.GetGraph();
+        auto eid = graph->topo->GetEdge(name)->GetId();
+        graph->topo->MarkAsConstant(eid);
+        graph->data->constants[eid].data.assign((const char*)values.data(), values.size() * sizeof(T));
+
+        auto& shape = graph->data->shapes[eid];
+        shape.data_type = data_type;
+        shape.data_format = DATAFORMAT_NDARRAY;
+        shape.dims = dims;
+    }
+
+    void SetAttr(const string& node_name, const shared_ptr<ir::Attr>& attr) {
+        auto graph = builder_.GetGraph();
+        graph->data->attrs[graph->topo->GetNode(node_name)->GetId()] = attr;
+    }
+
+    template <typename T>
+    vector<T> GetConstant(const string& name) {
+        auto graph = builder_.GetGraph();
+        auto& data = graph->data->constants[graph->topo->GetEdge(name)->GetId()].data;
+        return vector<T>((const T*)data.data(), (const T*)(data.data() + data.size()));
+    }
+
+protected:
+    unique_ptr<Engine> engine_;
+    vector<EngineImpl*> engines_;
+    GraphOptimizerOptions options_;
+    GraphBuilder builder_;
+};
+
+TEST_F(FoldConstantTest, shape_gather_concat) {
+    builder_.AddNode("relu", ir::Node::Type("", "Relu", 6), {"x"}, {"relu_out"});
+    builder_.AddNode("shape", ir::Node::Type("", "Shape", 1), {"relu_out"}, {"shape_out"});
+    builder_.AddNode("gather", ir::Node::Type("", "Gather", 1), {"shape_out", "idx"}, {"gather_out"});
+    builder_.AddNode("concat", ir::Node::Type("", "Concat", 4), {"gather_out", "minus_one"}, {"concat_out"});
+    builder_.AddNode("reshape", ir::Node::Type("", "Reshape", 5), {"relu_out", "concat_out"}, {"out"});
+    builder_.Finalize();
+
+    auto graph = builder_.GetGraph();
+    auto& x_shape = graph->data->shapes[graph->topo->GetEdge("x")->GetId()];
+    x_shape.data_type = DATATYPE_FLOAT32;
+    x_shape.data_format = DATAFORMAT_NDARRAY;
+    x_shape.dims = {2, 3, 4, 5};
+
+    // negative indices are handled by the kernel
+    SetConstant<int64_t>("idx", DATATYPE_INT64, {1}, {-1});
+    SetConstant<int64_t>("minus_one", DATATYPE_INT64, {1}, {-1});
+
+    auto gather_param = make_shared<ppl::nn::onnx::GatherParam>();
+    gather_param->axis = 0;
+    SetAttr("gather", gather_param);
+    auto concat_param = make_shared<ppl::nn::onnx::ConcatParam>();
+    concat_param->axis = 0;
+    SetAttr("concat", concat_param);
+
+    options_.fixed_input_dims = true;
+    FoldConstantOptimizer optimizer(options_);
+    EXPECT_EQ(RC_SUCCESS, optimizer.Optimize(graph));
+
+    EXPECT_NE(nullptr, graph->topo->GetNode("relu"));
+    EXPECT_EQ(nullptr, graph->topo->GetNode("shape"));
+    EXPECT_EQ(nullptr, graph->topo->GetNode("gather"));
+    EXPECT_EQ(nullptr, graph->topo->GetNode("concat"));
+    EXPECT_NE(nullptr, graph->topo->GetNode("reshape"));
+    EXPECT_EQ(nullptr, graph->topo->GetEdge("gather_out"));
+    EXPECT_EQ(vector<int64_t>({5, -1}), GetConstant<int64_t>("concat_out"));
+}
+
+TEST_F(FoldConstantTest, cast) {
+    builder_.AddNode("cast", ir::Node::Type("", "Cast", 9), {"c"}, {"cast_out"});
+    builder_.AddNode("reshape", ir::Node::Type("", "Reshape", 5), {"x", "cast_out"}, {"out"});
+    builder_.Finalize();
+
+    SetConstant<float>("c", DATATYPE_FLOAT32, {2}, {-3.5f, 4.0f});
+    auto cast_param = make_shared<ppl::nn::onnx::CastParam>();
+    cast_param->to = DATATYPE_INT64;
+    SetAttr("cast", cast_param);
+
+    FoldConstantOptimizer optimizer(options_);
+    auto graph = builder_.GetGraph();
+    EXPECT_EQ(RC_SUCCESS, optimizer.Optimize(graph));
+    EXPECT_EQ(nullptr, graph->topo->GetNode("cast"));
+    EXPECT_EQ(nullptr, graph->topo->GetEdge("c"));
+    EXPECT_EQ(vector<int64_t>({-3, 4}), GetConstant<int64_t>("cast_out"));
+}
+
+TEST_F(FoldConstantTest, transpose_weight) {
+    builder_.AddNode("transpose", ir::Node::Type("", "Transpose", 1), {"w"}, {"w_t"});
+    builder_.AddNode("matmul", ir::Node::Type("", "MatMul", 1), {"x", "w_t"}, {"out"});
+    builder_.Finalize();
+
+    SetConstant<float>("w", DATATYPE_FLOAT32, {2, 3}, {0, 1, 2, 3, 4, 5});
+    auto transpose_param = make_shared<ppl::nn::onnx::TransposeParam>();
+    transpose_param->perm = {1, 0};
+    SetAttr("transpose", transpose_param);
+
+    FoldConstantOptimizer optimizer(options_);
+    auto graph = builder_.GetGraph();
+    EXPECT_EQ(RC_SUCCESS, optimizer.Optimize(graph));
+    EXPECT_EQ(nullptr, graph->topo->GetNode("transpose"));
+    EXPECT_EQ(vector<int64_t>({3, 2}), graph->data->shapes[graph->topo->GetEdge("w_t")->GetId()].dims);
+    EXPECT_EQ(vector<float>({0, 3, 1, 4, 2, 5}), GetConstant<float>("w_t"));
+}
@@ -110,6 +110,29 @@ TEST_F(FullGraphTopoTest, full_graph_topo_DelEdgeById_Test) {
     EXPECT_EQ(res, nullptr);
 }
 
+TEST_F(FullGraphTopoTest, full_graph_topo_GetByName_Test) {
+    auto topo = graph_builder_.GetGraph()->topo.get();
+
+    auto node = topo->GetNode("b");
+    EXPECT_NE(nullptr, node);
+    topo->RenameNode(node->GetId(), "renamed_b");
+    EXPECT_EQ(nullptr, topo->GetNode("b"));
+    EXPECT_EQ(node, topo->GetNode("renamed_b"));
+
+    auto edge = topo->GetEdge("ab");
+    EXPECT_NE(nullptr, edge);
+    edge->SetName("renamed_ab");
+    EXPECT_EQ(nullptr, topo->GetEdge("ab"));
+    EXPECT_EQ(edge, topo->GetEdge("renamed_ab"));
+
+    auto eid = edge->GetId();
+    topo->DelEdge(eid);
+    EXPECT_EQ(nullptr, topo->GetEdge("renamed_ab"));
+    auto ret_pair = topo->AddEdge("renamed_ab");
+    EXPECT_TRUE(ret_pair.second);
+    EXPECT_NE(eid, ret_pair.first->GetId());
+}
+
 // test FullGrahpEdge's api
 TEST_F(FullGraphTopoTest, full_edge_GetId_Test) {
     auto topo = graph_builder_.GetGraph()->topo.get();
@@ -16,6 +16,7 @@
 // under the License.
 
 #include "ppl/nn/models/onnx/graph_parser.h"
+#include "ppl/nn/params/onnx/transpose_param.h"
 #include "gtest/gtest.h"
 
 #include "google/protobuf/io/coded_stream.h"
@@ -51,3 +52,62 @@ TEST_F(GraphParserTest, Parse_Test) {
     auto status = graph_parser.Parse(pb_model.graph(), op_sets, nullptr, &graph);
     EXPECT_EQ(status, ppl::common::RC_SUCCESS);
 }
+
+TEST_F(GraphParserTest, ParseManyInitializersAndNodes) {
+    static const int nr_node = 64;
+
+    ::onnx::GraphProto pb_graph;
+    pb_graph.add_input()->set_name("input");
+    for (int i = 0; i < nr_node; ++i) {
+        auto pb_initializer = pb_graph.add_initializer();
+        pb_initializer->set_name("w" + std::to_string(i));
+        pb_initializer->set_data_type(::onnx::TensorProto_DataType_FLOAT);
+        pb_initializer->add_dims(2);
+        pb_initializer->add_float_data(i);
+        pb_initializer->add_float_data(-i);
+
+        auto pb_add = pb_graph.add_node();
+        pb_add->set_op_type("Add");
+        pb_add->add_input(i == 0 ? "input" : "t" + std::to_string(i - 1));
+        pb_add->add_input("w" + std::to_string(i));
+        pb_add->add_output("a" + std::to_string(i));
+
+        auto pb_transpose = pb_graph.add_node();
+        pb_transpose->set_op_type("Transpose");
+        pb_transpose->add_input("a" + std::to_string(i));
+        pb_transpose->add_output("t" + std::to_string(i));
+        auto pb_attr = pb_transpose->add_attribute();
+        pb_attr->set_name("perm");
+        pb_attr->add_ints(i);
+    }
+    pb_graph.add_output()->set_name("t" + std::to_string(nr_node - 1));
+
+    map<string, uint64_t> op_sets = {{"", 11}};
+    ppl::nn::onnx::GraphParser graph_parser;
+    ppl::nn::ir::Graph graph;
+    EXPECT_EQ(ppl::common::RC_SUCCESS, graph_parser.Parse(pb_graph, op_sets, nullptr, &graph));
+
+    auto topo = graph.topo.get();
+    auto data = graph.data.get();
+    for (int i = 0; i < nr_node; ++i) {
+        // initializers are added first and keep their order
+        auto edge = topo->GetEdge("w" + std::to_string(i));
+        EXPECT_NE(nullptr, edge);
+        EXPECT_EQ((ppl::nn::edgeid_t)i, edge->GetId());
+
+        auto constant_ref = data->constants.find(edge->GetId());
+        EXPECT_NE(data->constants.end(), constant_ref);
+        auto values = (const float*)constant_ref->second.data.data();
+        EXPECT_EQ(2 * sizeof(float), constant_ref->second.data.size());
+        EXPECT_EQ((float)i, values[0]);
+        EXPECT_EQ((float)-i, values[1]);
+
+        auto node = topo->GetNode(topo->GetEdge("t" + std::to_string(i))->GetProducer());
+        EXPECT_EQ((ppl::nn::nodeid_t)(2 * i + 1), node->GetId());
+        auto attr_ref = data->attrs.find(node->GetId());
+        EXPECT_NE(data->attrs.end(), attr_ref);
+        auto param = static_cast<const ppl::nn::onnx::TransposeParam*>(attr_ref->second.get());
+        EXPECT_EQ(1, param->perm.size());
+        EXPECT_EQ(i, param->perm[0]);
+    }
+}
@@ -219,3 +219,100 @@ TEST_F(TestEngineGraphPartioner, partition_by_types) {
         }
     }
 }
+
+static bool HasCircularDependencies(const ir::GraphTopo* topo,
+                                    const vector<pair<EngineImpl*, vector<nodeid_t>>>& partitions) {
+    vector<uint32_t> nid2par(topo->GetMaxNodeId(), UINT32_MAX);
+    for (uint32_t i = 0; i < partitions.size(); ++i) {
+        for (auto nid : partitions[i].second) {
+            nid2par[nid] = i;
+        }
+    }
+
+    // par_deps[i][j] is true if partition i depends on partition j
+    vector<vector<bool>> par_deps(partitions.size(), vector<bool>(partitions.size(), false));
+    for (uint32_t i = 0; i < partitions.size(); ++i) {
+        for (auto nid : partitions[i].second) {
+            auto prev_ids = topo->FindPredecessors(nid);
+            for (auto prev_id : prev_ids) {
+                if (nid2par[prev_id] != i) {
+                    par_deps[i][nid2par[prev_id]] = true;
+                }
+            }
+        }
+    }
+
+    // transitive closure
+    for (uint32_t k = 0; k < partitions.size(); ++k) {
+        for (uint32_t i = 0; i < partitions.size(); ++i) {
+            for (uint32_t j = 0; j < partitions.size(); ++j) {
+                if (par_deps[i][k] && par_deps[k][j]) {
+                    par_deps[i][j] = true;
+                }
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < partitions.size(); ++i) {
+        if (par_deps[i][i]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+  `b` joins the partition of `d` and makes it depend on the partition of `a`. `e` must not join the partition
+  of `a`/`c` although `d`, its predecessor in the other partition, has no ancestor in it.
+*/
+TEST_F(TestEngineGraphPartioner, partition_diamond_across_engines) {
+    GraphBuilder builder;
+    builder.AddNode("a", ir::Node::Type("test", "op1", 1), {"in1"}, {"out1"});
+    builder.AddNode("c", ir::Node::Type("test", "op1", 1), {"out1"}, {"out2"});
+    builder.AddNode("d", ir::Node::Type("test", "op2", 1), {"in2"}, {"out3"});
+    builder.AddNode("b", ir::Node::Type("test", "op2", 1), {"out1", "out3"}, {"out4"});
+    builder.AddNode("e", ir::Node::Type("test", "op1", 1), {"out2", "out3"}, {"out5"});
+    builder.Finalize();
+    auto topo = builder.GetGraph()->topo.get();
+
+    EngineGraphPartitioner partitioner;
+    vector<pair<EngineImpl*, vector<nodeid_t>>> partitions;
+    auto status = partitioner.Partition(engine_ptrs_, topo, &partitions);
+    EXPECT_EQ(RC_SUCCESS, status);
+    EXPECT_FALSE(HasCircularDependencies(topo, partitions));
+
+    uint32_t nr_nodes = 0;
+    for (auto p = partitions.begin(); p != partitions.end(); ++p) {
+        nr_nodes += p->second.size();
+    }
+    EXPECT_EQ(5, nr_nodes);
+}
+
+/*
+  a node joins a partition created earlier than one of the partitions it depends on. partitions that already
+  depend on the joined one must inherit its new ancestors, otherwise later merges may form a cycle.
+*/
+TEST_F(TestEngineGraphPartioner, partition_joins_older_partition) {
+    GraphBuilder builder;
+    builder.AddNode("n0", ir::Node::Type("test", "op2", 1), {"in0"}, {"e0"});
+    builder.AddNode("n1", ir::Node::Type("test", "op3", 1), {"in1"}, {"e1"});
+    builder.AddNode("n2", ir::Node::Type("test", "op1", 1), {"in2"}, {"e2"});
+    builder.AddNode("n3", ir::Node::Type("test", "op3", 1), {"e2", "e1"}, {"e3"});
+    builder.AddNode("n4", ir::Node::Type("test", "op2", 1), {"e1", "e0"}, {"e4"});
+    builder.AddNode("n5", ir::Node::Type("test", "op1", 1), {"e0", "e2"}, {"e5"});
+    builder.AddNode("n6", ir::Node::Type("test", "op2", 1), {"e1"}, {"e6"});
+    builder.Finalize();
+    auto topo = builder.GetGraph()->topo.get();
+
+    EngineGraphPartitioner partitioner;
+    vector<pair<EngineImpl*, vector<nodeid_t>>> partitions;
+    auto status = partitioner.Partition(engine_ptrs_, topo, &partitions);
+    EXPECT_EQ(RC_SUCCESS, status);
+    EXPECT_FALSE(HasCircularDependencies(topo, partitions));
+
+    uint32_t nr_nodes = 0;
+    for (auto p = partitions.begin(); p != partitions.end(); ++p) {
+        nr_nodes += p->second.size();
+    }
+    EXPECT_EQ(7, nr_nodes);
+}
@@ -0,0 +1,172 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/optimizers/fold_constant_optimizer.h"
+#include "ppl/nn/params/onnx/concat_param.h"
+#include "ppl/nn/params/onnx/gather_param.h"
+#include "tests/ir/graph_builder.h"
+#include "gtest/gtest.h"
+#include <string.h>
+#include <vector>
+using namespace std;
+using namespace ppl::nn;
+using namespace ppl::nn::test;
+using namespace ppl::common;
+
+class FoldConstantOptimizerTest : public testing::Test {};
+
+static void SetConstant(const string& name, const vector<int64_t>& dims, const vector<int64_t>& values,
+                        ir::Graph* graph) {
+    auto eid = graph->topo->GetEdge(name)->GetId();
+    graph->topo->MarkAsConstant(eid);
+    graph->data->constants[eid].data.assign((const char*)values.data(), values.size() * sizeof(int64_t));
+
+    auto& shape = graph->data->shapes[eid];
+    shape.data_type = DATATYPE_INT64;
+    shape.data_format = DATAFORMAT_NDARRAY;
+    shape.dims = dims;
+}
+
+// data of Gather is computed by kernels, so only Shape is folded without engines
+TEST_F(FoldConstantOptimizerTest, shape_gather_reshape_without_engines) {
+    GraphBuilder builder;
+    builder.AddNode("shape", ir::Node::Type("", "Shape", 1), {"w"}, {"shape_out"});
+    builder.AddNode("gather", ir::Node::Type("", "Gather", 1), {"shape_out", "idx"}, {"gather_out"});
+    builder.AddNode("reshape", ir::Node::Type("", "Reshape", 5), {"x", "gather_out"}, {"out"});
+    builder.Finalize();
+
+    auto graph = builder.GetGraph();
+    SetConstant("w", {2, 3, 4}, vector<int64_t>(24, 0), graph);
+    SetConstant("idx", {2}, {2, 0}, graph);
+
+    auto gather_param = make_shared<ppl::nn::onnx::GatherParam>();
+    gather_param->axis = 0;
+    graph->data->attrs[graph->topo->GetNode("gather")->GetId()] = gather_param;
+
+    FoldConstantOptimizer optimizer;
+    EXPECT_EQ(RC_SUCCESS, optimizer.Optimize(graph));
+
+    EXPECT_EQ(nullptr, graph->topo->GetNode("shape"));
+    EXPECT_NE(nullptr, graph->topo->GetNode("gather"));
+    EXPECT_NE(nullptr, graph->topo->GetNode("reshape"));
+    EXPECT_EQ(nullptr, graph->topo->GetEdge("w"));
+
+    auto eid = graph->topo->GetEdge("shape_out")->GetId();
+    EXPECT_EQ(INVALID_NODEID, graph->topo->GetEdge(eid)->GetProducer());
+
+    auto& data = graph->data->constants[eid].data;
+    ASSERT_EQ(3 * sizeof(int64_t), data.size());
+    auto values = (const int64_t*)data.data();
+    EXPECT_EQ(2, values[0]);
+    EXPECT_EQ(3, values[1]);
+    EXPECT_EQ(4, values[2]);
+}
+
+TEST_F(FoldConstantOptimizerTest, reshape_of_constant) {
+    GraphBuilder builder;
+    builder.AddNode("reshape", ir::Node::Type("", "Reshape", 5), {"w", "new_shape"}, {"reshape_out"});
+    builder.AddNode("add", ir::Node::Type("", "Add", 7), {"x", "reshape_out"}, {"out"});
+    builder.Finalize();
+
+    auto graph = builder.GetGraph();
+    vector<int64_t> values = {0, 1, 2, 3, 4, 5};
+    SetConstant("w", {2, 3}, values, graph);
+    SetConstant("new_shape", {2}, {3, -1}, graph);
+
+    FoldConstantOptimizer optimizer;
+    EXPECT_EQ(RC_SUCCESS, optimizer.Optimize(graph));
+    EXPECT_EQ(nullptr, graph->topo->GetNode("reshape"));
+
+    auto eid = graph->topo->GetEdge("reshape_out")->GetId();
+    EXPECT_EQ(vector<int64_t>({3, 2}), graph->data->shapes[eid].dims);
+    auto& data = graph->data->constants[eid].data;
+    ASSERT_EQ(values.size() * sizeof(int64_t), data.size());
+    EXPECT_EQ(0, memcmp(values.data(), data.data(), data.size()));
+}
+
+TEST_F(FoldConstantOptimizerTest, non_constant_input) {
+    GraphBuilder builder;
+    builder.AddNode("shape", ir::Node::Type("", "Shape", 1), {"x"}, {"shape_out"});
+    builder.AddNode("reshape", ir::Node::Type("", "Reshape", 5), {"y", "shape_out"}, {"out"});
+    builder.Finalize();
+
+    auto graph = builder.GetGraph();
+    FoldConstantOptimizer optimizer;
+    EXPECT_EQ(RC_SUCCESS, optimizer.Optimize(graph));
+    EXPECT_NE(nullptr, graph->topo->GetNode("shape"));
+}
+
+static void SetInputShape(const string& name, const vector<int64_t>& dims, ir::Graph* graph) {
+    auto& shape = graph->data->shapes[graph->topo->GetEdge(name)->GetId()];
+    shape.data_type = DATATYPE_FLOAT32;
+    shape.data_format = DATAFORMAT_NDARRAY;
+    shape.dims = dims;
+}
+
+static ir::Graph* BuildShapeOfActivationGraph(GraphBuilder* builder) {
+    builder->AddNode("relu", ir::Node::Type("", "Relu", 1), {"x"}, {"relu_out"});
+    builder->AddNode("shape", ir::Node::Type("", "Shape", 1), {"relu_out"}, {"shape_out"});
+    builder->AddNode("gather", ir::Node::Type("", "Gather", 1), {"shape_out", "idx"}, {"gather_out"});
+    builder->AddNode("concat", ir::Node::Type("", "Concat", 1), {"gather_out", "minus_one"}, {"concat_out"});
+    builder->AddNode("reshape", ir::Node::Type("", "Reshape", 5), {"relu_out", "concat_out"}, {"out"});
+    builder->Finalize();
+
+    auto graph = builder->GetGraph();
+    SetInputShape("x", {2, 3, 4, 5}, graph);
+    SetConstant("idx", {1}, {0}, graph);
+    SetConstant("minus_one", {1}, {-1}, graph);
+
+    auto gather_param = make_shared<ppl::nn::onnx::GatherParam>();
+    gather_param->axis = 0;
+    graph->data->attrs[graph->topo->GetNode("gather")->GetId()] = gather_param;
+    auto concat_param = make_shared<ppl::nn::onnx::ConcatParam>();
+    concat_param->axis = 0;
+    graph->data->attrs[graph->topo->GetNode("concat")->GetId()] = concat_param;
+
+    return graph;
+}
+
+TEST_F(FoldConstantOptimizerTest, shape_of_activation_with_fixed_input_dims) {
+    GraphBuilder builder;
+    auto graph = BuildShapeOfActivationGraph(&builder);
+
+    GraphOptimizerOptions options;
+    options.fixed_input_dims = true;
+    FoldConstantOptimizer optimizer(options);
+    EXPECT_EQ(RC_SUCCESS, optimizer.Optimize(graph));
+
+    EXPECT_NE(nullptr, graph->topo->GetNode("relu"));
+    EXPECT_EQ(nullptr, graph->topo->GetNode("shape"));
+    EXPECT_NE(nullptr, graph->topo->GetNode("gather"));
+    EXPECT_NE(nullptr, graph->topo->GetEdge("relu_out"));
+
+    auto& data = graph->data->constants[graph->topo->GetEdge("shape_out")->GetId()].data;
+    ASSERT_EQ(4 * sizeof(int64_t), data.size());
+    auto values = (const int64_t*)data.data();
+    EXPECT_EQ(2, values[0]);
+    EXPECT_EQ(5, values[3]);
+}
+
+TEST_F(FoldConstantOptimizerTest, shape_of_activation_without_fixed_input_dims) {
+    GraphBuilder builder;
+    auto graph = BuildShapeOfActivationGraph(&builder);
+
+    FoldConstantOptimizer optimizer;
+    EXPECT_EQ(RC_SUCCESS, optimizer.Optimize(graph));
+    EXPECT_NE(nullptr, graph->topo->GetNode("shape"));
+    EXPECT_NE(nullptr, graph->topo->GetNode("concat"));
+}
@@ -0,0 +1,256 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/optimizers/fuse_sibling_node_optimizer.h"
+#include "ppl/nn/params/onnx/conv_param.h"
+#include "ppl/nn/params/onnx/gemm_param.h"
+#include "ppl/nn/params/onnx/split_param.h"
+#include "tests/ir/graph_builder.h"
+#include "gtest/gtest.h"
+#include <set>
+#include <vector>
+using namespace std;
+using namespace ppl::nn;
+using namespace ppl::nn::test;
+using namespace ppl::common;
+
+class FuseSiblingNodeOptimizerTest : public testing::Test {
+protected:
+    void SetUp() override {
+        options_.enable_sibling_fusion = true;
+    }
+
+    GraphOptimizerOptions options_;
+};
+
+static void SetWeight(const string& name, const vector<int64_t>& dims, float value, ir::Graph* graph) {
+    auto eid = graph->topo->GetEdge(name)->GetId();
+    graph->topo->MarkAsConstant(eid);
+
+    int64_t count = 1;
+    for (auto x = dims.begin(); x != dims.end(); ++x) {
+        count *= *x;
+    }
+    vector<float> data(count, value);
+    graph->data->constants[eid].data.assign((const char*)data.data(), data.size() * sizeof(float));
+
+    auto& shape = graph->data->shapes[eid];
+    shape.data_type = DATATYPE_FLOAT32;
+    shape.data_format = DATAFORMAT_NDARRAY;
+    shape.dims = dims;
+}
+
+TEST_F(FuseSiblingNodeOptimizerTest, matmul) {
+    GraphBuilder builder;
+    builder.AddNode("q", ir::Node::Type("", "MatMul", 1), {"x", "wq"}, {"out_q"});
+    builder.AddNode("k", ir::Node::Type("", "MatMul", 1), {"x", "wk"}, {"out_k"});
+    builder.AddNode("v", ir::Node::Type("", "MatMul", 1), {"x", "wv"}, {"out_v"});
+    builder.Finalize();
+
+    auto graph = builder.GetGraph();
+    SetWeight("wq", {64, 16}, 1, graph);
+    SetWeight("wk", {64, 8}, 2, graph);
+    SetWeight("wv", {64, 32}, 3, graph);
+
+    FuseSiblingNodeOptimizer optimizer(options_);
+    EXPECT_EQ(RC_SUCCESS, optimizer.Optimize(graph));
+
+    auto topo = graph->topo.get();
+    EXPECT_EQ(nullptr, topo->GetNode("k"));
+    EXPECT_EQ(nullptr, topo->GetNode("v"));
+    EXPECT_EQ(nullptr, topo->GetEdge("wk"));
+
+    auto fused_node = topo->GetNode("q");
+    EXPECT_NE(nullptr, fused_node);
+    auto& weight_shape = graph->data->shapes[fused_node->GetInput(1)];
+    EXPECT_EQ(64, weight_shape.dims[0]);
+    EXPECT_EQ(56, weight_shape.dims[1]);
+
+    // unaligned `k` is moved to the end
+    auto weight = (const float*)graph->data->constants[fused_node->GetInput(1)].data.data();
+    EXPECT_EQ(1, weight[15]);
+    EXPECT_EQ(3, weight[16]);
+    EXPECT_EQ(2, weight[48]);
+
+    auto split_node = topo->GetNode("q_sibling_split");
+    EXPECT_NE(nullptr, split_node);
+    EXPECT_EQ(3, split_node->GetOutputCount());
+    EXPECT_EQ(topo->GetEdge("out_v")->GetId(), split_node->GetOutput(1));
+    EXPECT_EQ(topo->GetEdge("out_k")->GetId(), split_node->GetOutput(2));
+    EXPECT_EQ(split_node->GetId(), topo->GetEdge("out_q")->GetProducer());
+
+    auto param = static_cast<const ppl::nn::onnx::SplitParam*>(graph->data->attrs[split_node->GetId()].get());
+    EXPECT_EQ(vector<int32_t>({16, 32, 8}), param->split_point);
+}
+
+TEST_F(FuseSiblingNodeOptimizerTest, disabled_by_default) {
+    GraphBuilder builder;
+    builder.AddNode("q", ir::Node::Type("", "MatMul", 1), {"x", "wq"}, {"out_q"});
+    builder.AddNode("k", ir::Node::Type("", "MatMul", 1), {"x", "wk"}, {"out_k"});
+    builder.Finalize();
+
+    auto graph = builder.GetGraph();
+    SetWeight("wq", {64, 16}, 1, graph);
+    SetWeight("wk", {64, 16}, 2, graph);
+
+    FuseSiblingNodeOptimizer optimizer;
+    EXPECT_EQ(RC_SUCCESS, optimizer.Optimize(graph));
+    EXPECT_NE(nullptr, graph->topo->GetNode("k"));
+}
+
+static void SetConvParam(const string& node_name, int32_t stride, ir::Graph* graph) {
+    auto param = make_shared<ppl::nn::onnx::ConvParam>();
+    param->group = 1;
+    param->kernel_shape = {3, 3};
+    param->dilations = {1, 1};
+    param->strides = {stride, stride};
+    param->pads = {1, 1, 1, 1};
+    graph->data->attrs[graph->topo->GetNode(node_name)->GetId()] = param;
+}
+
+TEST_F(FuseSiblingNodeOptimizerTest, conv) {
+    GraphBuilder builder;
+    builder.AddNode("a", ir::Node::Type("", "Conv", 1), {"x", "wa", "ba"}, {"out_a"});
+    builder.AddNode("b", ir::Node::Type("", "Conv", 1), {"x", "wb"}, {"out_b"});
+    builder.Finalize();
+
+    auto graph = builder.GetGraph();
+    SetWeight("wa", {16, 8, 3, 3}, 1, graph);
+    SetWeight("ba", {16}, 5, graph);
+    SetWeight("wb", {32, 8, 3, 3}, 2, graph);
+    SetConvParam("a", 1, graph);
+    SetConvParam("b", 1, graph);
+
+    FuseSiblingNodeOptimizer optimizer(options_);
+    EXPECT_EQ(RC_SUCCESS, optimizer.Optimize(graph));
+
+    auto topo = graph->topo.get();
+    EXPECT_EQ(nullptr, topo->GetNode("b"));
+    auto fused_node = topo->GetNode("a");
+    ASSERT_NE(nullptr, fused_node);
+    EXPECT_EQ(vector<int64_t>({48, 8, 3, 3}), graph->data->shapes[fused_node->GetInput(1)].dims);
+
+    // `b` has no bias and is filled with zeros
+    auto& bias_shape = graph->data->shapes[fused_node->GetInput(2)];
+    EXPECT_EQ(vector<int64_t>({48}), bias_shape.dims);
+    auto bias = (const float*)graph->data->constants[fused_node->GetInput(2)].data.data();
+    EXPECT_EQ(5, bias[15]);
+    EXPECT_EQ(0, bias[16]);
+
+    auto split_node = topo->GetNode("a_sibling_split");
+    ASSERT_NE(nullptr, split_node);
+    auto param = static_cast<const ppl::nn::onnx::SplitParam*>(graph->data->attrs[split_node->GetId()].get());
+    EXPECT_EQ(1, param->axis);
+    EXPECT_EQ(vector<int32_t>({16, 32}), param->split_point);
+}
+
+TEST_F(FuseSiblingNodeOptimizerTest, conv_with_different_attrs) {
+    GraphBuilder builder;
+    builder.AddNode("a", ir::Node::Type("", "Conv", 1), {"x", "wa"}, {"out_a"});
+    builder.AddNode("b", ir::Node::Type("", "Conv", 1), {"x", "wb"}, {"out_b"});
+    builder.Finalize();
+
+    auto graph = builder.GetGraph();
+    SetWeight("wa", {16, 8, 3, 3}, 1, graph);
+    SetWeight("wb", {16, 8, 3, 3}, 2, graph);
+    SetConvParam("a", 1, graph);
+    SetConvParam("b", 2, graph);
+
+    FuseSiblingNodeOptimizer optimizer(options_);
+    EXPECT_EQ(RC_SUCCESS, optimizer.Optimize(graph));
+    EXPECT_NE(nullptr, graph->topo->GetNode("b"));
+    EXPECT_EQ(nullptr, graph->topo->GetNode("a_sibling_split"));
+}
+
+TEST_F(FuseSiblingNodeOptimizerTest, gemm) {
+    GraphBuilder builder;
+    builder.AddNode("a", ir::Node::Type("", "Gemm", 1), {"x", "wa", "ba"}, {"out_a"});
+    builder.AddNode("b", ir::Node::Type("", "Gemm", 1), {"x", "wb", "bb"}, {"out_b"});
+    builder.AddNode("c", ir::Node::Type("", "Gemm", 1), {"x", "wc", "bc"}, {"out_c"});
+    builder.Finalize();
+
+    auto graph = builder.GetGraph();
+    SetWeight("wa", {16, 64}, 1, graph);
+    SetWeight("ba", {16}, 1, graph);
+    SetWeight("wb", {32, 64}, 2, graph);
+    SetWeight("bb", {32}, 2, graph);
+    SetWeight("wc", {64, 32}, 3, graph);
+    SetWeight("bc", {32}, 3, graph);
+
+    for (auto name : {"a", "b", "c"}) {
+        auto param = make_shared<ppl::nn::onnx::GemmParam>();
+        param->alpha = 1;
+        param->beta = 1;
+        param->transA = 0;
+        param->transB = (name[0] == 'c') ? 0 : 1;
+        graph->data->attrs[graph->topo->GetNode(name)->GetId()] = param;
+    }
+    // `c` is not transposed and cannot be fused with the others
+
+    FuseSiblingNodeOptimizer optimizer(options_);
+    EXPECT_EQ(RC_SUCCESS, optimizer.Optimize(graph));
+
+    auto topo = graph->topo.get();
+    EXPECT_EQ(nullptr, topo->GetNode("b"));
+    EXPECT_NE(nullptr, topo->GetNode("c"));
+    auto fused_node = topo->GetNode("a");
+    ASSERT_NE(nullptr, fused_node);
+    EXPECT_EQ(vector<int64_t>({48, 64}), graph->data->shapes[fused_node->GetInput(1)].dims);
+    EXPECT_EQ(vector<int64_t>({48}), graph->data->shapes[fused_node->GetInput(2)].dims);
+
+    auto split_node = topo->GetNode("a_sibling_split");
+    ASSERT_NE(nullptr, split_node);
+    EXPECT_EQ(topo->GetEdge("out_b")->GetId(), split_node->GetOutput(1));
+}
+
+TEST_F(FuseSiblingNodeOptimizerTest, reserved_output) {
+    GraphBuilder builder;
+    builder.AddNode("q", ir::Node::Type("", "MatMul", 1), {"x", "wq"}, {"out_q"});
+    builder.AddNode("k", ir::Node::Type("", "MatMul", 1), {"x", "wk"}, {"out_k"});
+    builder.AddNode("v", ir::Node::Type("", "MatMul", 1), {"x", "wv"}, {"out_v"});
+    builder.Finalize();
+
+    auto graph = builder.GetGraph();
+    SetWeight("wq", {64, 16}, 1, graph);
+    SetWeight("wk", {64, 16}, 2, graph);
+    SetWeight("wv", {64, 16}, 3, graph);
+
+    set<edgeid_t> reserved_edgeids = {graph->topo->GetEdge("out_k")->GetId()};
+    options_.reserved_edgeids = &reserved_edgeids;
+    FuseSiblingNodeOptimizer optimizer(options_);
+    EXPECT_EQ(RC_SUCCESS, optimizer.Optimize(graph));
+
+    auto topo = graph->topo.get();
+    EXPECT_NE(nullptr, topo->GetNode("k"));
+    EXPECT_EQ(nullptr, topo->GetNode("v"));
+    EXPECT_EQ(topo->GetNode("k")->GetId(), topo->GetEdge("out_k")->GetProducer());
+}
+
+TEST_F(FuseSiblingNodeOptimizerTest, small_reduce_size) {
+    GraphBuilder builder;
+    builder.AddNode("q", ir::Node::Type("", "MatMul", 1), {"x", "wq"}, {"out_q"});
+    builder.AddNode("k", ir::Node::Type("", "MatMul", 1), {"x", "wk"}, {"out_k"});
+    builder.Finalize();
+
+    auto graph = builder.GetGraph();
+    SetWeight("wq", {8, 16}, 1, graph);
+    SetWeight("wk", {8, 16}, 2, graph);
+
+    FuseSiblingNodeOptimizer optimizer(options_);
+    EXPECT_EQ(RC_SUCCESS, optimizer.Optimize(graph));
+    EXPECT_NE(nullptr, graph->topo->GetNode("k"));
+}
@@ -0,0 +1,78 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/runtime/activation_spiller.h"
+#include "ppl/nn/utils/generic_cpu_device.h"
+#include "tests/ir/graph_builder.h"
+#include "gtest/gtest.h"
+#include <vector>
+using namespace std;
+using namespace ppl::nn;
+using namespace ppl::nn::test;
+using namespace ppl::common;
+
+TEST(ActivationSpillerTest, spill_and_restore) {
+    GraphBuilder builder;
+    builder.AddNode("a", ir::Node::Type("test", "op1", 1), {"x"}, {"a_out"});
+    builder.AddNode("b", ir::Node::Type("test", "op1", 1), {"x"}, {"b_out"});
+    builder.AddNode("c", ir::Node::Type("test", "op1", 1), {"b_out"}, {"c_out"});
+    builder.AddNode("d", ir::Node::Type("test", "op2", 1), {"a_out", "c_out"}, {"out"});
+    builder.Finalize();
+    auto topo = builder.GetGraph()->topo.get();
+
+    vector<nodeid_t> sorted_nodes = {topo->GetNode("a")->GetId(), topo->GetNode("b")->GetId(),
+                                     topo->GetNode("c")->GetId(), topo->GetNode("d")->GetId()};
+    RuntimeAuxInfo aux_info;
+    ASSERT_EQ(RC_SUCCESS, aux_info.Init(topo, {}, std::move(sorted_nodes)));
+
+    utils::GenericCpuDevice device;
+    RuntimeGraphResource graph;
+    graph.edgeid2object.resize(topo->GetMaxEdgeId(), nullptr);
+
+    TensorImpl a_out(topo->GetEdge("a_out"), TENSORTYPE_NORMAL);
+    TensorImpl b_out(topo->GetEdge("b_out"), TENSORTYPE_NORMAL);
+    for (auto t : {&a_out, &b_out}) {
+        t->SetDevice(&device);
+        t->GetShape()->SetDataType(DATATYPE_FLOAT32);
+        t->GetShape()->Reshape({1000});
+        ASSERT_EQ(RC_SUCCESS, t->ReallocBuffer());
+        auto data = t->GetBufferPtr<float>();
+        for (uint32_t i = 0; i < 1000; ++i) {
+            data[i] = i;
+        }
+        graph.edgeid2object[t->GetEdge()->GetId()] = t;
+    }
+
+    ActivationSpiller spiller(5000);
+    ASSERT_EQ(RC_SUCCESS, spiller.Init(topo, &aux_info));
+
+    // `a_out` is not used until `d`, while `b_out` is used by the next node `c`
+    ASSERT_EQ(RC_SUCCESS, spiller.AfterExecute(1, &graph));
+    EXPECT_EQ(nullptr, a_out.GetBufferPtr());
+    EXPECT_NE(nullptr, b_out.GetBufferPtr());
+    EXPECT_EQ(4000, spiller.GetSpilledBytes());
+
+    ASSERT_EQ(RC_SUCCESS, spiller.BeforeExecute(2, &graph));
+    EXPECT_EQ(nullptr, a_out.GetBufferPtr());
+
+    ASSERT_EQ(RC_SUCCESS, spiller.BeforeExecute(3, &graph));
+    ASSERT_NE(nullptr, a_out.GetBufferPtr());
+    auto data = a_out.GetBufferPtr<float>();
+    for (uint32_t i = 0; i < 1000; ++i) {
+        EXPECT_EQ(i, data[i]);
+    }
+}
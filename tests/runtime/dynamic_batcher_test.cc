@@ -0,0 +1,200 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/runtime/dynamic_batcher_factory.h"
+#include "ppl/nn/runtime/tensor_impl.h"
+#include "ppl/nn/utils/generic_cpu_device.h"
+#include "tests/ir/graph_builder.h"
+#include "gtest/gtest.h"
+#include <thread>
+#include <vector>
+using namespace std;
+using namespace ppl::nn;
+using namespace ppl::nn::test;
+using namespace ppl::common;
+
+static const int64_t g_sample_size = 4;
+
+/** computes `output = input * 2` and refuses to bind output buffers. */
+class FakeRuntime final : public Runtime {
+public:
+    FakeRuntime(ir::Edge* input_edge, ir::Edge* output_edge)
+        : input_(input_edge, EdgeObject::T_TENSOR), output_(output_edge, EdgeObject::T_TENSOR) {
+        for (auto t : {&input_, &output_}) {
+            auto shape = t->GetShape();
+            shape->Reshape({1, g_sample_size});
+            shape->SetDataType(DATATYPE_FLOAT32);
+            shape->SetDataFormat(DATAFORMAT_NDARRAY);
+            t->SetDevice(&cpu_device_);
+        }
+    }
+    ~FakeRuntime() {
+        output_.FreeBuffer();
+    }
+
+    RetCode Configure(uint32_t, ...) override {
+        return RC_UNSUPPORTED;
+    }
+    uint32_t GetInputCount() const override {
+        return 1;
+    }
+    Tensor* GetInputTensor(uint32_t) const override {
+        return const_cast<TensorImpl*>(&input_);
+    }
+    uint32_t GetOutputCount() const override {
+        return 1;
+    }
+    Tensor* GetOutputTensor(uint32_t) const override {
+        return const_cast<TensorImpl*>(&output_);
+    }
+    Tensor* GetTensorByName(const char*) const override {
+        return nullptr;
+    }
+
+    RetCode BindInputBuffer(uint32_t, void* buf, const TensorShape& desc) override {
+        if (buf) {
+            input_.GetShape()->Reshape(desc.GetDims(), desc.GetDimCount());
+            if ((uintptr_t)buf % cpu_device_.GetAlignment() != 0) {
+                has_unaligned_input_ = true;
+            }
+        }
+        input_.SetBufferPtr(buf);
+        return RC_SUCCESS;
+    }
+    RetCode BindOutputBuffer(uint32_t, void*, const TensorShape&) override {
+        return RC_UNSUPPORTED;
+    }
+
+    RetCode Run() override {
+        output_.GetShape()->Reshape(input_.GetShape()->GetDims(), input_.GetShape()->GetDimCount());
+        auto status = output_.ReallocBuffer();
+        if (status != RC_SUCCESS) {
+            return status;
+        }
+
+        max_batch_size_ = max<int64_t>(max_batch_size_, input_.GetShape()->GetDim(0));
+
+        auto src = input_.GetBufferPtr<float>();
+        auto dst = output_.GetBufferPtr<float>();
+        for (uint32_t i = 0; i < input_.GetShape()->GetElementsIncludingPadding(); ++i) {
+            dst[i] = src[i] * 2;
+        }
+        return RC_SUCCESS;
+    }
+
+    uint32_t GetDeviceContextCount() const override {
+        return 0;
+    }
+    DeviceContext* GetDeviceContext(uint32_t) const override {
+        return nullptr;
+    }
+    RetCode GetProfilingStatistics(ProfilingStatistics*) const override {
+        return RC_UNSUPPORTED;
+    }
+    RetCode GetMemoryStatistics(MemoryStatistics*) const override {
+        return RC_UNSUPPORTED;
+    }
+
+    int64_t GetMaxBatchSize() const {
+        return max_batch_size_;
+    }
+    bool HasUnalignedInput() const {
+        return has_unaligned_input_;
+    }
+
+private:
+    int64_t max_batch_size_ = 0;
+    bool has_unaligned_input_ = false;
+    utils::GenericCpuDevice cpu_device_;
+    TensorImpl input_;
+    TensorImpl output_;
+};
+
+class DynamicBatcherTest : public testing::Test {
+protected:
+    void SetUp() override {
+        builder_.AddNode("a", ir::Node::Type("test", "op1", 1), {"input_of_a"}, {"output_of_a"});
+        builder_.Finalize();
+    }
+
+protected:
+    GraphBuilder builder_;
+};
+
+TEST_F(DynamicBatcherTest, concurrent_requests) {
+    auto topo = builder_.GetGraph()->topo.get();
+    FakeRuntime runtime(topo->GetEdge(topo->GetInput(0)), topo->GetEdge(topo->GetOutput(0)));
+
+    DynamicBatcherOptions options;
+    options.max_batch_size = 4;
+    options.max_delay_us = 20000;
+    unique_ptr<DynamicBatcher> batcher(DynamicBatcherFactory::Create(&runtime, options));
+    ASSERT_NE(nullptr, batcher);
+
+    const uint32_t thread_num = 8;
+    const uint32_t run_times = 16;
+    vector<RetCode> results(thread_num * run_times, RC_OTHER_ERROR);
+    vector<uint32_t> mismatch_counts(thread_num, 0);
+
+    vector<thread> workers;
+    for (uint32_t t = 0; t < thread_num; ++t) {
+        workers.emplace_back([&, t]() {
+            for (uint32_t r = 0; r < run_times; ++r) {
+                float in[g_sample_size], out[g_sample_size];
+                for (int64_t i = 0; i < g_sample_size; ++i) {
+                    in[i] = t * 1000 + r * 10 + i;
+                }
+                const void* inputs[] = {in};
+                void* outputs[] = {out};
+                results[t * run_times + r] = batcher->Run(inputs, outputs);
+                for (int64_t i = 0; i < g_sample_size; ++i) {
+                    if (out[i] != in[i] * 2) {
+                        ++mismatch_counts[t];
+                    }
+                }
+            }
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+
+    for (auto status : results) {
+        EXPECT_EQ(RC_SUCCESS, status);
+    }
+    for (auto count : mismatch_counts) {
+        EXPECT_EQ(0u, count);
+    }
+
+    DynamicBatcherStatistics stat;
+    EXPECT_EQ(RC_SUCCESS, batcher->GetStatistics(&stat));
+    EXPECT_EQ(thread_num * run_times, stat.request_count);
+    EXPECT_LE(stat.batch_count, stat.request_count);
+    EXPECT_LE(runtime.GetMaxBatchSize(), options.max_batch_size);
+    // batch buffers can be used by kernels directly
+    EXPECT_FALSE(runtime.HasUnalignedInput());
+}
+
+TEST_F(DynamicBatcherTest, invalid_options) {
+    auto topo = builder_.GetGraph()->topo.get();
+    FakeRuntime runtime(topo->GetEdge(topo->GetInput(0)), topo->GetEdge(topo->GetOutput(0)));
+
+    DynamicBatcherOptions options;
+    options.max_batch_size = 0;
+    unique_ptr<DynamicBatcher> batcher(DynamicBatcherFactory::Create(&runtime, options));
+    EXPECT_EQ(nullptr, batcher);
+}
@@ -0,0 +1,96 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/runtime/memory_aware_sort.h"
+#include "tests/ir/graph_builder.h"
+#include "gtest/gtest.h"
+#include <vector>
+using namespace std;
+using namespace ppl::nn;
+using namespace ppl::nn::test;
+
+class MemoryAwareSortTest : public testing::Test {
+protected:
+    void SetUp() override {
+        builder_.AddNode("a", ir::Node::Type("test", "op1", 1), {"x"}, {"a_out"});
+        builder_.AddNode("a2", ir::Node::Type("test", "op1", 1), {"a_out"}, {"a2_out"});
+        builder_.AddNode("b", ir::Node::Type("test", "op1", 1), {"x"}, {"b_out"});
+        builder_.AddNode("b2", ir::Node::Type("test", "op1", 1), {"b_out"}, {"b2_out"});
+        builder_.AddNode("c", ir::Node::Type("test", "op2", 1), {"a2_out", "b2_out"}, {"out"});
+        builder_.Finalize();
+
+        auto topo = builder_.GetGraph()->topo.get();
+        edge_bytes_.resize(topo->GetMaxEdgeId(), 1);
+        edge_bytes_[topo->GetEdge("a_out")->GetId()] = 100;
+        edge_bytes_[topo->GetEdge("b_out")->GetId()] = 100;
+    }
+
+    nodeid_t GetNodeId(const char* name) const {
+        return builder_.GetGraph()->topo->GetNode(name)->GetId();
+    }
+
+protected:
+    GraphBuilder builder_;
+    vector<uint64_t> edge_bytes_;
+};
+
+TEST_F(MemoryAwareSortTest, greedy) {
+    auto topo = builder_.GetGraph()->topo.get();
+
+    // both large intermediate tensors are alive at the same time
+    vector<nodeid_t> sorted_nodes = {GetNodeId("a"), GetNodeId("b"), GetNodeId("a2"), GetNodeId("b2"),
+                                     GetNodeId("c")};
+    EXPECT_EQ(201, utils::EstimatePeakActivationBytes(topo, sorted_nodes, edge_bytes_, {}));
+
+    utils::GreedyMemoryAwareSort(topo, edge_bytes_, {}, &sorted_nodes);
+    const vector<nodeid_t> expected = {GetNodeId("a"), GetNodeId("a2"), GetNodeId("b"), GetNodeId("b2"),
+                                       GetNodeId("c")};
+    EXPECT_EQ(expected, sorted_nodes);
+    EXPECT_EQ(102, utils::EstimatePeakActivationBytes(topo, sorted_nodes, edge_bytes_, {}));
+}
+
+TEST_F(MemoryAwareSortTest, dfs) {
+    auto topo = builder_.GetGraph()->topo.get();
+    vector<nodeid_t> sorted_nodes = {GetNodeId("b"), GetNodeId("a"), GetNodeId("b2"), GetNodeId("a2"),
+                                     GetNodeId("c")};
+    utils::DfsMemoryAwareSort(topo, edge_bytes_, {}, &sorted_nodes);
+
+    // the branch started first is finished before the other one
+    const vector<nodeid_t> expected = {GetNodeId("b"), GetNodeId("b2"), GetNodeId("a"), GetNodeId("a2"),
+                                       GetNodeId("c")};
+    EXPECT_EQ(expected, sorted_nodes);
+    EXPECT_EQ(102, utils::EstimatePeakActivationBytes(topo, sorted_nodes, edge_bytes_, {}));
+}
+
+TEST_F(MemoryAwareSortTest, keep_the_best_order) {
+    auto topo = builder_.GetGraph()->topo.get();
+    vector<nodeid_t> sorted_nodes = {GetNodeId("a"), GetNodeId("b"), GetNodeId("a2"), GetNodeId("b2"),
+                                     GetNodeId("c")};
+    EXPECT_EQ(102, utils::MemoryAwareSort(topo, edge_bytes_, {}, &sorted_nodes, 0));
+
+    const vector<nodeid_t> optimal = sorted_nodes;
+    EXPECT_EQ(102, utils::MemoryAwareSort(topo, edge_bytes_, {}, &sorted_nodes));
+    EXPECT_EQ(optimal, sorted_nodes);
+}
+
+TEST_F(MemoryAwareSortTest, reserved_edges_are_not_released) {
+    auto topo = builder_.GetGraph()->topo.get();
+    vector<nodeid_t> sorted_nodes = {GetNodeId("a"), GetNodeId("a2"), GetNodeId("b"), GetNodeId("b2"),
+                                     GetNodeId("c")};
+    EXPECT_EQ(202, utils::EstimatePeakActivationBytes(topo, sorted_nodes, edge_bytes_,
+                                                      {topo->GetEdge("a_out")->GetId()}));
+}
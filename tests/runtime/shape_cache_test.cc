@@ -0,0 +1,100 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/runtime/shape_cache.h"
+#include "tests/ir/graph_builder.h"
+#include "gtest/gtest.h"
+#include <vector>
+using namespace std;
+using namespace ppl::nn;
+using namespace ppl::nn::test;
+using namespace ppl::common;
+
+class ShapeCacheTest : public testing::Test {};
+
+TEST_F(ShapeCacheTest, reshape_with_non_constant_shape) {
+    GraphBuilder builder;
+    builder.AddNode("a", ir::Node::Type("", "Relu", 1), {"x"}, {"relu_out"});
+    builder.AddNode("b", ir::Node::Type("", "Reshape", 1), {"relu_out", "shape"}, {"out"});
+    builder.Finalize();
+    EXPECT_FALSE(ShapeCache::IsApplicable(builder.GetGraph()->topo.get()));
+}
+
+TEST_F(ShapeCacheTest, reshape_with_constant_shape) {
+    GraphBuilder builder;
+    builder.AddNode("a", ir::Node::Type("", "Relu", 1), {"x"}, {"relu_out"});
+    builder.AddNode("b", ir::Node::Type("", "Reshape", 1), {"relu_out", "shape"}, {"out"});
+    builder.Finalize();
+
+    auto topo = builder.GetGraph()->topo.get();
+    topo->MarkAsConstant(topo->GetEdge("shape")->GetId());
+    EXPECT_TRUE(ShapeCache::IsApplicable(topo));
+}
+
+TEST_F(ShapeCacheTest, reshape_with_shape_of_input) {
+    GraphBuilder builder;
+    builder.AddNode("a", ir::Node::Type("", "Shape", 1), {"x"}, {"shape"});
+    builder.AddNode("b", ir::Node::Type("", "Reshape", 1), {"y", "shape"}, {"out"});
+    builder.Finalize();
+    EXPECT_TRUE(ShapeCache::IsApplicable(builder.GetGraph()->topo.get()));
+}
+
+TEST_F(ShapeCacheTest, upsample_with_non_constant_scales) {
+    GraphBuilder builder;
+    builder.AddNode("a", ir::Node::Type("", "Relu", 1), {"x"}, {"relu_out"});
+    builder.AddNode("b", ir::Node::Type("", "Upsample", 9), {"relu_out", "scales"}, {"out"});
+    builder.Finalize();
+    EXPECT_FALSE(ShapeCache::IsApplicable(builder.GetGraph()->topo.get()));
+}
+
+TEST_F(ShapeCacheTest, unknown_op_with_non_constant_inputs) {
+    GraphBuilder builder;
+    builder.AddNode("a", ir::Node::Type("", "Relu", 1), {"x"}, {"relu_out"});
+    builder.AddNode("b", ir::Node::Type("custom", "Relu", 1), {"relu_out"}, {"out"});
+    builder.Finalize();
+    EXPECT_FALSE(ShapeCache::IsApplicable(builder.GetGraph()->topo.get()));
+}
+
+TEST_F(ShapeCacheTest, unknown_op_with_constant_inputs) {
+    GraphBuilder builder;
+    builder.AddNode("a", ir::Node::Type("custom", "MyOp", 1), {"c"}, {"my_out"});
+    builder.AddNode("b", ir::Node::Type("", "Add", 1), {"x", "my_out"}, {"out"});
+    builder.Finalize();
+
+    auto topo = builder.GetGraph()->topo.get();
+    topo->MarkAsConstant(topo->GetEdge("c")->GetId());
+    EXPECT_TRUE(ShapeCache::IsApplicable(topo));
+}
+
+TEST_F(ShapeCacheTest, find_and_insert) {
+    ShapeCache cache(1);
+
+    vector<int64_t> key = {1, 2, 3};
+    EXPECT_EQ(nullptr, cache.Find(key));
+
+    TensorShape shape;
+    shape.Reshape({2, 3});
+    EXPECT_TRUE(cache.Insert(vector<int64_t>(key), vector<TensorShape>(1, shape)));
+
+    auto shapes = cache.Find(key);
+    EXPECT_NE(nullptr, shapes);
+    EXPECT_EQ(1, shapes->size());
+    EXPECT_EQ(3, shapes->at(0).GetDim(1));
+
+    EXPECT_FALSE(cache.Insert(vector<int64_t>{4}, vector<TensorShape>()));
+    EXPECT_EQ(1, cache.GetEntryCount());
+}
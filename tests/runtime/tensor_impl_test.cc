@@ -100,3 +100,72 @@ TEST_F(TensorImplTest, SetAndGetBufferPtr) {
     EXPECT_EQ(RC_SUCCESS, tensor.CopyToHost(buf2.data()));
     EXPECT_EQ(buf, buf2);
 }
+
+TEST_F(TensorImplTest, BindBuffer) {
+    auto tensor = ConstructFp32TensorWithCpuDevice();
+    auto shape = tensor.GetShape();
+
+    TensorShape desc(*shape);
+    const uint64_t alignment = cpu_device_.GetAlignment();
+    vector<char> storage(shape->GetBytesIncludingPadding() + alignment * 2);
+    auto aligned_addr = ((uintptr_t)storage.data() + alignment - 1) / alignment * alignment;
+    auto buf = (float*)aligned_addr;
+
+    // unaligned buffers are not used directly
+    tensor.BindBuffer((char*)buf + sizeof(float), desc);
+    EXPECT_EQ(RC_SUCCESS, tensor.ReallocBuffer());
+    EXPECT_NE((char*)buf + sizeof(float), tensor.GetBufferPtr());
+    EXPECT_TRUE(tensor.IsBufferOwner());
+
+    tensor.BindBuffer(buf, desc);
+    EXPECT_EQ(RC_SUCCESS, tensor.ReallocBuffer());
+    EXPECT_EQ(buf, tensor.GetBufferPtr());
+    EXPECT_FALSE(tensor.IsBufferOwner());
+
+    // result needs more space than the bound buffer
+    shape->SetDim(0, 2);
+    EXPECT_EQ(RC_SUCCESS, tensor.ReallocBuffer());
+    EXPECT_NE(buf, tensor.GetBufferPtr());
+    EXPECT_TRUE(tensor.IsBufferOwner());
+
+    // data type mismatch
+    shape->SetDim(0, 1);
+    desc.SetDataType(DATATYPE_FLOAT16);
+    tensor.BindBuffer(buf, desc);
+    EXPECT_EQ(RC_SUCCESS, tensor.ReallocBuffer());
+    EXPECT_NE(buf, tensor.GetBufferPtr());
+
+    // unbinding detaches the bound buffer
+    desc.SetDataType(DATATYPE_FLOAT32);
+    tensor.BindBuffer(buf, desc);
+    EXPECT_EQ(RC_SUCCESS, tensor.ReallocBuffer());
+    EXPECT_EQ(buf, tensor.GetBufferPtr());
+    tensor.BindBuffer(nullptr, desc);
+    EXPECT_EQ(nullptr, tensor.GetBufferPtr());
+}
+
+TEST_F(TensorImplTest, Generation) {
+    auto tensor = ConstructFp32TensorWithCpuDevice();
+    auto shape = tensor.GetShape();
+    vector<float> buf(shape->GetElementsIncludingPadding());
+
+    auto gen = tensor.GetGeneration();
+    EXPECT_EQ(RC_SUCCESS, tensor.ReallocBuffer());
+    EXPECT_NE(gen, tensor.GetGeneration());
+
+    gen = tensor.GetGeneration();
+    EXPECT_EQ(RC_SUCCESS, tensor.CopyToHost(buf.data()));
+    EXPECT_EQ(gen, tensor.GetGeneration());
+    EXPECT_EQ(RC_SUCCESS, tensor.CopyFromHost(buf.data()));
+    EXPECT_NE(gen, tensor.GetGeneration());
+
+    // generations are unique among tensors
+    auto another = ConstructFp32TensorWithCpuDevice();
+    EXPECT_EQ(RC_SUCCESS, another.ReallocBuffer());
+    EXPECT_NE(tensor.GetGeneration(), another.GetGeneration());
+
+    gen = tensor.GetGeneration();
+    tensor.TransferBufferFrom(&another);
+    EXPECT_NE(gen, tensor.GetGeneration());
+    tensor.FreeBuffer();
+}
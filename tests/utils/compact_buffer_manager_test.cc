@@ -37,3 +37,24 @@ TEST(CompactBufferManagerTest, alloc_and_free) {
     mgr.Free(&buffer);
     EXPECT_EQ(mgr.GetAllocatedBytes(), block_size);
 }
+
+TEST(CompactBufferManagerTest, peak_used_bytes) {
+    const uint64_t block_size = 1024;
+    const uint64_t alignment = 128;
+
+    GenericCpuAllocator ar(alignment);
+    utils::CompactBufferManager mgr(&ar, alignment, block_size);
+    BufferDesc b1, b2;
+    EXPECT_EQ(RC_SUCCESS, mgr.Realloc(100, &b1));
+    EXPECT_EQ(RC_SUCCESS, mgr.Realloc(200, &b2));
+    EXPECT_EQ(384, mgr.GetUsedBytes());
+    mgr.Free(&b1);
+    EXPECT_EQ(256, mgr.GetUsedBytes());
+    EXPECT_EQ(RC_SUCCESS, mgr.Realloc(50, &b1));
+    EXPECT_EQ(384, mgr.GetUsedBytes());
+    mgr.Free(&b1);
+    mgr.Free(&b2);
+    EXPECT_EQ(0, mgr.GetUsedBytes());
+    EXPECT_EQ(384, mgr.GetPeakUsedBytes());
+    EXPECT_LE(mgr.GetPeakUsedBytes(), mgr.GetAllocatedBytes());
+}
@@ -0,0 +1,97 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/utils/startup_profiler.h"
+#include "gtest/gtest.h"
+#include <vector>
+using namespace std;
+using namespace ppl::nn;
+using namespace ppl::common;
+
+TEST(StartupProfilerTest, nested_stages) {
+    utils::StartupProfiler profiler;
+    profiler.SetEnabled(true);
+    {
+        utils::StartupStageGuard g0(&profiler, "Preprocess");
+        {
+            utils::StartupStageGuard g1(&profiler, "GraphOptimizer", "FuseBNOptimizer");
+        }
+        {
+            utils::StartupStageGuard g1(&profiler, "EngineProcessGraph");
+            utils::StartupStageGuard g2(&profiler, "SelectAlgorithm", "conv1");
+        }
+    }
+
+    StartupProfilingStatistics stat;
+    EXPECT_EQ(RC_SUCCESS, profiler.GetStatistics(&stat));
+    EXPECT_EQ(4, stat.stage_info.size());
+    EXPECT_EQ("Preprocess", stat.stage_info[0].name);
+    EXPECT_EQ(0, stat.stage_info[0].depth);
+    EXPECT_EQ("GraphOptimizer:FuseBNOptimizer", stat.stage_info[1].name);
+    EXPECT_EQ(1, stat.stage_info[1].depth);
+    EXPECT_EQ("EngineProcessGraph", stat.stage_info[2].name);
+    EXPECT_EQ(1, stat.stage_info[2].depth);
+    EXPECT_EQ("SelectAlgorithm:conv1", stat.stage_info[3].name);
+    EXPECT_EQ(2, stat.stage_info[3].depth);
+    EXPECT_LE(stat.stage_info[3].exec_microseconds, stat.stage_info[2].exec_microseconds);
+    EXPECT_LE(stat.stage_info[2].exec_microseconds, stat.stage_info[0].exec_microseconds);
+#ifdef __linux__
+    EXPECT_LT(0, stat.stage_info[0].memory_bytes);
+    EXPECT_LE(stat.stage_info[0].memory_bytes, stat.stage_info[0].process_peak_memory_bytes);
+#endif
+}
+
+#ifdef __linux__
+TEST(StartupProfilerTest, memory_delta) {
+    utils::StartupProfiler profiler;
+    profiler.SetEnabled(true);
+    vector<char> buffer;
+    {
+        utils::StartupStageGuard g0(&profiler, "ParseModel");
+        buffer.assign(64 * 1048576, 1);
+    }
+
+    StartupProfilingStatistics stat;
+    EXPECT_EQ(RC_SUCCESS, profiler.GetStatistics(&stat));
+    EXPECT_LE(32 * 1048576, stat.stage_info[0].memory_delta_bytes);
+    EXPECT_LE(stat.stage_info[0].memory_bytes, stat.stage_info[0].process_peak_memory_bytes);
+}
+#endif
+
+TEST(StartupProfilerTest, disabled) {
+    utils::StartupProfiler profiler;
+    {
+        utils::StartupStageGuard g0(&profiler, "Preprocess");
+        utils::StartupStageGuard g1(nullptr, "CreateRuntime");
+    }
+
+    StartupProfilingStatistics stat;
+    EXPECT_EQ(RC_SUCCESS, profiler.GetStatistics(&stat));
+    EXPECT_TRUE(stat.stage_info.empty());
+}
+
+TEST(StartupProfilerTest, running_stage) {
+    utils::StartupProfiler profiler;
+    profiler.SetEnabled(true);
+    profiler.BeginStage("ParseModel");
+
+    StartupProfilingStatistics stat;
+    EXPECT_NE(RC_SUCCESS, profiler.GetStatistics(&stat));
+    profiler.EndStage();
+    EXPECT_EQ(RC_SUCCESS, profiler.GetStatistics(&stat));
+    EXPECT_EQ(1, stat.stage_info.size());
+}
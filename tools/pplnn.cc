@@ -37,10 +37,12 @@ using namespace std;
 
 #ifdef PPLNN_ENABLE_ONNX_MODEL
 #include "ppl/nn/models/onnx/runtime_builder_factory.h"
+#include "ppl/nn/models/onnx/runtime_builder_options.h"
 #endif
 
 #ifdef PPLNN_ENABLE_PMX_MODEL
 #include "ppl/nn/models/pmx/runtime_builder_factory.h"
+#include "ppl/nn/models/pmx/runtime_builder_options.h"
 #endif
 
 /* -------------------------------------------------------------------------- */
@@ -52,6 +54,8 @@ Define_bool_opt("--version", g_flag_version, false, "show version info");
 
 #ifdef PPLNN_ENABLE_ONNX_MODEL
 Define_string_opt("--onnx-model", g_flag_onnx_model, "", "onnx model file");
+Define_bool_opt("--enable-startup-profiling", g_flag_enable_startup_profiling, false,
+                "print time and memory usage of each stage when loading onnx models");
 #endif
 
 #ifdef PPLNN_ENABLE_PMX_MODEL
@@ -63,6 +67,16 @@ Define_string_opt("--mm-policy", g_flag_mm_policy, "mem",
                   "\"perf\" => better performance, or \"mem\" => less memory usage");
 
 Define_bool_opt("--enable-profiling", g_flag_enable_profiling, false, "enable profiling and print profiling info");
+Define_bool_opt("--enable-memory-statistics", g_flag_enable_memory_statistics, false,
+                "print memory usage by category and activations alive at the peak");
+Define_uint32_opt("--memory-budget-mb", g_flag_memory_budget_mb, 0,
+                  "keep live activations under this size by reordering nodes and spilling to a temporary file");
+Define_bool_opt("--enable-memory-aware-sort", g_flag_enable_memory_aware_sort, false,
+                "reorder nodes when loading models to reduce the peak memory usage of activations");
+Define_bool_opt("--enable-fixed-input-dims", g_flag_enable_fixed_input_dims, false,
+                "fold shape computations of onnx models with dims of inputs in the model, which cannot be changed");
+Define_bool_opt("--enable-sibling-fusion", g_flag_enable_sibling_fusion, false,
+                "fuse Conv/Gemm/MatMul nodes of onnx models that read the same input into one wider node");
 Define_float_opt("--min-profiling-seconds", g_flag_min_profiling_seconds, 1.0f,
                  "min execute time by seconds for profiling");
 Define_uint32_opt("--min-profiling-iterations", g_flag_min_profiling_iterations, 1, "declare profiling iteration");
@@ -178,6 +192,11 @@ static bool ParseInputShapes(const string& shape_str, vector<vector<int64_t>>* i
     return true;
 }
 
+#if defined(PPLNN_USE_X86) || defined(PPLNN_USE_ARM)
+Define_int32_opt("--numa-node-id", g_flag_numa_node_id, -1,
+                 "bind x86/arm engine to specified numa node, range [0, numa_max_node], -1 means not bind");
+#endif
+
 /* -------------------------------------------------------------------------- */
 
 #ifdef PPLNN_USE_CUDA
@@ -315,6 +334,11 @@ Define_bool_opt("--use-x86", g_flag_use_x86, false, "use x86 engine");
 Define_bool_opt("--disable-avx512", g_flag_disable_avx512, false, "disable avx512 feature");
 Define_bool_opt("--disable-avx-fma3", g_flag_disable_avx_fma3, false, "disable avx, fma3 and avx512 feature");
 Define_bool_opt("--core-binding", g_flag_core_binding, false, "core binding");
+Define_uint32_opt("--x86-thread-num", g_flag_x86_thread_num, 0, "number of threads used by x86 engine");
+Define_string_opt("--x86-core-list", g_flag_x86_core_list, "",
+                  "cores that x86 engine threads are bound to, separated by comma, e.g. 0,1,2,3");
+Define_string_opt("--x86-weight-compression", g_flag_x86_weight_compression, "none",
+                  "storage type of fully connected weights of x86 engine: none, fp16 or int8");
 
 #include "ppl/nn/engines/x86/engine_factory.h"
 #include "ppl/nn/engines/x86/options.h"
@@ -329,8 +353,38 @@ static inline bool RegisterX86Engine(vector<unique_ptr<Engine>>* engines) {
         options.mm_policy = x86::MM_COMPACT;
     }
 
+    options.thread_num = g_flag_x86_thread_num;
+    options.numa_node_id = g_flag_numa_node_id;
+    if (g_flag_x86_weight_compression == "fp16") {
+        options.weight_compression = x86::WEIGHT_COMPRESSION_FP16;
+    } else if (g_flag_x86_weight_compression == "int8") {
+        options.weight_compression = x86::WEIGHT_COMPRESSION_INT8;
+    } else if (g_flag_x86_weight_compression != "none") {
+        LOG(ERROR) << "unknown weight compression type [" << g_flag_x86_weight_compression << "]";
+        return false;
+    }
+    if (!g_flag_x86_core_list.empty()) {
+        bool ok = true;
+        SplitString(g_flag_x86_core_list.data(), g_flag_x86_core_list.size(), ",", 1,
+                    [&ok, &options](const char* s, unsigned int l) -> bool {
+                        if (l > 0) {
+                            options.core_list.push_back(atoi(string(s, l).c_str()));
+                            return true;
+                        }
+                        LOG(ERROR) << "empty core id in option '--x86-core-list'";
+                        ok = false;
+                        return false;
+                    });
+        if (!ok) {
+            return false;
+        }
+    }
+
     x86::RegisterBuiltinOpImpls();
     auto x86_engine = x86::EngineFactory::Create(options);
+    if (!x86_engine) {
+        return false;
+    }
 
     if (g_flag_disable_avx512) {
         x86_engine->Configure(x86::ENGINE_CONF_DISABLE_AVX512);
@@ -400,8 +454,6 @@ Define_int32_opt("--wg-level", g_flag_wg_level, 3,
                  "select winograd level[0-3]. 0: wingorad off. 1: turn on winograd and automatically select block "
                  "size. 2: use winograd block 2 if possible. 3: use winograd block 4 if possible");
 Define_int32_opt("--tuning-level", g_flag_tuning_level, 1, "select conv algo dynamic tuning level[0-1]. 0: off. 1: on");
-Define_int32_opt("--numa-node-id", g_flag_numa_node_id, -1,
-                 "bind arm engine to specified numa node, range [0, numa_max_node), -1 means not bind");
 
 #include "ppl/nn/engines/arm/engine_factory.h"
 #include "ppl/nn/engines/arm/ops.h"
@@ -1005,6 +1057,36 @@ static bool GetOutputs(const Runtime* runtime) {
     return true;
 }
 
+#ifdef PPLNN_ENABLE_ONNX_MODEL
+static void PrintStartupProfilingStatistics(const StartupProfilingStatistics& stat) {
+    LOG(INFO) << "----- startup profiling statistics -----";
+    for (auto s = stat.stage_info.begin(); s != stat.stage_info.end(); ++s) {
+        LOG(INFO) << string(s->depth * 2, ' ') << s->name << ": " << (float)s->exec_microseconds / 1000
+                  << " ms, rss " << (float)s->memory_bytes / 1048576 << " MB, rss delta "
+                  << (float)s->memory_delta_bytes / 1048576 << " MB, process peak rss "
+                  << (float)s->process_peak_memory_bytes / 1048576 << " MB";
+    }
+}
+#endif
+
+static void PrintMemoryStatistics(const MemoryStatistics& stat) {
+    LOG(INFO) << "----- memory statistics -----";
+    LOG(INFO) << "constants: " << (float)stat.constant_bytes / 1048576 << " MB";
+    LOG(INFO) << "converted weights: " << (float)stat.converted_weight_bytes / 1048576 << " MB";
+    LOG(INFO) << "temporary buffers: " << (float)stat.tmp_buffer_bytes / 1048576 << " MB";
+    LOG(INFO) << "allocated by memory managers: " << (float)stat.allocated_bytes / 1048576 << " MB, peak used "
+              << (float)stat.peak_used_bytes / 1048576 << " MB, fragmented " << (float)stat.fragmented_bytes / 1048576
+              << " MB";
+    LOG(INFO) << "peak activations: " << (float)stat.peak_activation_bytes / 1048576 << " MB after kernel["
+              << stat.peak_kernel_name << "]";
+    for (auto x = stat.peak_tensors.begin(); x != stat.peak_tensors.end(); ++x) {
+        LOG(INFO) << "    " << x->name << ": " << (float)x->bytes / 1048576 << " MB";
+    }
+    if (stat.spilled_bytes > 0) {
+        LOG(INFO) << "spilled activations: " << (float)stat.spilled_bytes / 1048576 << " MB";
+    }
+}
+
 static bool Profiling(const vector<string>& input_data, Runtime* runtime) {
     if (g_flag_warmup_iterations > 0) {
         LOG(INFO) << "Warm up start for " << g_flag_warmup_iterations << " times.";
@@ -1116,6 +1198,23 @@ int main(int argc, char* argv[]) {
             return -1;
         }
 
+        if (g_flag_enable_startup_profiling) {
+            builder->Configure(onnx::ORB_CONF_SET_STARTUP_PROFILING_FLAG, true);
+        }
+        if (g_flag_enable_memory_aware_sort) {
+            builder->Configure(onnx::ORB_CONF_ENABLE_MEMORY_AWARE_SORT, true);
+        }
+        if (g_flag_enable_fixed_input_dims) {
+            if (!g_flag_input_shapes.empty()) {
+                LOG(ERROR) << "'--enable-fixed-input-dims' cannot be used with '--in-shapes'.";
+                return -1;
+            }
+            builder->Configure(onnx::ORB_CONF_ENABLE_FIXED_INPUT_DIMS, true);
+        }
+        if (g_flag_enable_sibling_fusion) {
+            builder->Configure(onnx::ORB_CONF_ENABLE_SIBLING_FUSION, true);
+        }
+
         status = builder->Init(g_flag_onnx_model.c_str(), engine_ptrs.data(), engine_ptrs.size());
         if (status != RC_SUCCESS) {
             LOG(ERROR) << "create OnnxRuntimeBuilder failed: " << GetRetCodeStr(status);
@@ -1139,6 +1238,16 @@ int main(int argc, char* argv[]) {
 #endif
 
         runtime.reset(builder->CreateRuntime());
+
+        if (g_flag_enable_startup_profiling) {
+            StartupProfilingStatistics stat;
+            status = builder->GetStartupProfilingStatistics(&stat);
+            if (status != RC_SUCCESS) {
+                LOG(ERROR) << "GetStartupProfilingStatistics failed: " << GetRetCodeStr(status);
+                return -1;
+            }
+            PrintStartupProfilingStatistics(stat);
+        }
     }
 #endif
 
@@ -1160,6 +1269,10 @@ int main(int argc, char* argv[]) {
             return -1;
         }
 
+        if (g_flag_enable_memory_aware_sort) {
+            builder->Configure(pmx::PRB_CONF_ENABLE_MEMORY_AWARE_SORT, true);
+        }
+
         status = builder->Preprocess();
         if (status != RC_SUCCESS) {
             LOG(ERROR) << "pmx preprocess failed: " << GetRetCodeStr(status);
@@ -1242,6 +1355,21 @@ int main(int argc, char* argv[]) {
     auto prepare_diff = std::chrono::duration_cast<std::chrono::microseconds>(prepare_end_ts - prepare_begin_ts);
     LOG(INFO) << "Prepare costs: " << (float)prepare_diff.count() / 1000 << " ms.";
 
+    if (g_flag_memory_budget_mb > 0) {
+        status = runtime->Configure(RUNTIME_CONF_SET_MEMORY_BUDGET, (uint64_t)g_flag_memory_budget_mb * 1048576);
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "set memory budget failed: " << GetRetCodeStr(status);
+            return -1;
+        }
+    }
+
+    if (g_flag_enable_memory_statistics) {
+        status = runtime->Configure(RUNTIME_CONF_SET_MEMORY_PROFILING_FLAG, true);
+        if (status != RC_SUCCESS) {
+            LOG(WARNING) << "enable memory profiling failed: " << GetRetCodeStr(status);
+        }
+    }
+
     auto run_begin_ts = std::chrono::system_clock::now();
     status = runtime->Run();
     auto run_end_ts = std::chrono::system_clock::now();
@@ -1263,6 +1391,18 @@ int main(int argc, char* argv[]) {
 
     LOG(INFO) << "Run ok";
 
+    if (g_flag_enable_memory_statistics) {
+        MemoryStatistics stat;
+        status = runtime->GetMemoryStatistics(&stat);
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "GetMemoryStatistics failed: " << GetRetCodeStr(status);
+            return -1;
+        }
+        PrintMemoryStatistics(stat);
+
+        runtime->Configure(RUNTIME_CONF_SET_MEMORY_PROFILING_FLAG, false);
+    }
+
     if (g_flag_enable_profiling) {
         if (!Profiling(input_data, runtime.get())) {
             LOG(ERROR) << "Profiling() failed.";